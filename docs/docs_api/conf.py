@@ -161,7 +161,7 @@ api_doc_structure = {
              'mitsuba.Loop', 'mitsuba.MemoryMappedFile',
              'mitsuba.ParamFlags', 'mitsuba.PluginManager', r'mitsuba.Scoped([\w]+)',
              'mitsuba.Spiral', r'mitsuba.Struct([\w]*)',
-             r'mitsuba.Thread([\w]*)', 'mitsuba.Timer',
+             r'mitsuba.Thread([\w]*)', 'mitsuba.Timer', 'mitsuba.Tracer',
              r'mitsuba.filesystem.([\w]+)', 'mitsuba.has_flag',
              r'mitsuba.register_([\w]+)', 'mitsuba.TraversalCallback'],
     'Parsing': [r'mitsuba.load_([\w]+)', r'mitsuba.xml.([\w]+)'],
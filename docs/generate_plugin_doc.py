@@ -68,6 +68,7 @@ TEXTURE_ORDERING = [
     'bitmap',
     'checkerboard',
     'mesh_attribute',
+    'noise',
     'volume'
 ]
 
@@ -82,6 +83,7 @@ SPECTRUM_ORDERING = [
 
 SAMPLER_ORDERING = [
     'independent',
+    'stateless',
     'stratified',
     'multijitter',
     'orthogonal',
@@ -91,6 +93,7 @@ SAMPLER_ORDERING = [
 INTEGRATOR_ORDERING = [
     'direct',
     'path',
+    'irrcache',
     'aov',
     'volpath',
     'volpathmis',
@@ -128,7 +131,9 @@ PHASE_ORDERING = [
 
 VOLUME_ORDERING = [
     'constvolume',
-    'gridvolume'
+    'gridvolume',
+    'gridsequence',
+    'sparsegridvolume'
 ]
 
 
@@ -292,6 +292,7 @@ template <typename Float_> struct CoreAliases {
 
 #define MI_MASKED_FUNCTION(profiler_phase, mask)                               \
     ScopedPhase scope_phase(profiler_phase);                                   \
+    ScopedObjectCost<!dr::is_jit_v<Float>> scope_cost(this, profiler_phase);   \
     (void) mask;                                                               \
     if constexpr (!dr::is_array_v<Float>)                                      \
         mask = true;
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <mitsuba/core/object.h>
+#include <memory>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**
+ * \brief Table of the parameters exposed by a scene graph
+ *
+ * This class traverses a scene graph (see \ref Object::traverse()) entirely
+ * in C++ and records its parameters in a compact table with O(1) lookup by
+ * name. It is used by <tt>mitsuba.traverse()</tt>, whose Python-side
+ * dictionary accesses entries on demand instead of materializing one Python
+ * record per parameter, which matters for scenes with hundreds of thousands
+ * of shapes.
+ *
+ * The traversal itself is lazy: objects are visited one at a time in
+ * depth-first order, and only as far as needed to answer a query. Looking up
+ * a parameter thus only visits the part of the graph that precedes it, while
+ * queries such as \ref size() or a lookup of a missing name complete the
+ * traversal.
+ *
+ * Parameter names follow the conventions of <tt>mitsuba.traverse()</tt>:
+ * nested objects are separated by a dot, and objects whose name was already
+ * used elsewhere in the graph receive a numbered suffix (e.g.
+ * <tt>bsdf_1</tt>). Objects that are referenced several times are only
+ * visited once.
+ *
+ * An optional list of name prefixes restricts the recorded parameters. The
+ * graph is still visited in the same order to ensure that names don't depend
+ * on the filter, but only matching parameters are stored.
+ */
+class MI_EXPORT_LIB ParameterRegistry : public Object {
+public:
+    /// Record describing a single parameter
+    struct Entry {
+        /// Full name of the parameter (e.g. <tt>shape.bsdf.reflectance.value</tt>)
+        std::string key;
+
+        /// Pointer to the parameter value
+        void *ptr;
+
+        /**
+         * Type of the value referenced by \c ptr, or \c nullptr when the
+         * value is an opaque handle that is kept alive by \c holder (e.g. a
+         * parameter exposed by a plugin implemented in Python).
+         */
+        const std::type_info *type;
+
+        /// Object exposing the parameter
+        Object *node;
+
+        /// Combination of \ref ParamFlags
+        uint32_t flags;
+
+        /// Keeps opaque values alive
+        std::shared_ptr<void> holder;
+    };
+
+    /// Position of an object within the scene graph
+    struct Node {
+        /// Parent object (\c nullptr for the root)
+        Object *parent;
+
+        /// Distance from the root
+        uint32_t depth;
+    };
+
+    /// Traversal callback that fills the registry
+    class Recorder;
+
+    /**
+     * \brief Traverse the scene graph below \c root
+     *
+     * \param root
+     *     Root of the scene graph (usually the scene)
+     *
+     * \param prefixes
+     *     Only parameters whose name starts with one of these prefixes are
+     *     recorded. All parameters are recorded when the list is empty.
+     */
+    ParameterRegistry(Object *root,
+                      const std::vector<std::string> &prefixes = {});
+
+    /// Return the number of recorded parameters (completes the traversal)
+    size_t size();
+
+    /// Look up a parameter by name (returns \c nullptr if it doesn't exist)
+    const Entry *find(const std::string &key);
+
+    /// Remove a parameter. Returns \c false if it doesn't exist.
+    bool erase(const std::string &key);
+
+    /// Only keep the parameters whose name starts with one of the given prefixes
+    void keep(const std::vector<std::string> &prefixes);
+
+    /// Return the position of an object in the graph (or \c nullptr if it isn't part of it)
+    const Node *node(const Object *obj);
+
+    /// Return the number of objects in the graph (completes the traversal)
+    size_t node_count();
+
+    /// Return the objects of the graph in traversal order (completes the traversal)
+    const std::vector<Object *> &nodes();
+
+    /**
+     * \brief Return the record with the given index in traversal order
+     *
+     * The traversal continues until the record exists. Returns \c nullptr
+     * when the graph has fewer records. Records of removed parameters are
+     * included, their \c node field is set to \c nullptr.
+     */
+    const Entry *entry(size_t index);
+
+    /// Has the whole graph been visited?
+    bool complete() const { return m_stack.empty(); }
+
+    /// Return the root of the scene graph
+    Object *root() const { return m_root.get(); }
+
+    std::string to_string() const override;
+
+    MI_DECLARE_CLASS()
+
+protected:
+    ~ParameterRegistry();
+
+private:
+    /// Parameter or child object reported by \ref Object::traverse()
+    struct Event {
+        std::string name;
+        Object *obj;
+        void *ptr;
+        const std::type_info *type;
+        uint32_t flags;
+        std::shared_ptr<void> holder;
+    };
+
+    /// Object whose events haven't all been processed yet
+    struct Frame {
+        Object *node;
+        std::string name;
+        uint32_t depth;
+        uint32_t flags;
+        std::vector<Event> events;
+        size_t next = 0;
+    };
+
+    /// Traverse \c obj and push its events onto the stack
+    void push(Object *obj, std::string name, uint32_t depth, uint32_t flags);
+
+    /// Process a single event of the traversal
+    void step();
+
+    /// Add an entry if it matches the prefix filters
+    void record(const Frame &frame, Event &event);
+
+private:
+    ref<Object> m_root;
+    std::vector<std::string> m_prefixes;
+    /// Additional filters registered via \ref keep()
+    std::vector<std::vector<std::string>> m_keep;
+    std::vector<Entry> m_entries;
+    std::unordered_map<std::string, size_t> m_index;
+    /// Names of removed parameters, which later definitions don't restore
+    std::unordered_set<std::string> m_erased;
+    std::unordered_map<const Object *, Node> m_nodes;
+    std::vector<Object *> m_node_order;
+    std::unordered_set<std::string> m_names;
+    std::vector<Frame> m_stack;
+};
+
+/**
+ * \brief Traversal callback used by \ref ParameterRegistry
+ *
+ * It collects the parameters and child objects of a single object, which the
+ * registry processes later on. It is exposed so that bindings can register
+ * opaque values (see \ref put_opaque()) in addition to the typed values
+ * passed to \ref TraversalCallback::put_parameter().
+ */
+class MI_EXPORT_LIB ParameterRegistry::Recorder : public TraversalCallback {
+public:
+    Recorder(std::vector<Event> *events);
+
+    void put_object(const std::string &name, Object *obj,
+                    uint32_t flags) override;
+
+    /// Register a value that is kept alive by \c holder (no type information)
+    void put_opaque(const std::string &name, std::shared_ptr<void> holder,
+                    uint32_t flags);
+
+protected:
+    void put_parameter_impl(const std::string &name, void *ptr,
+                            uint32_t flags,
+                            const std::type_info &type) override;
+
+private:
+    std::vector<Event> *m_events;
+};
+
+NAMESPACE_END(mitsuba)
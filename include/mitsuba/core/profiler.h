@@ -1,6 +1,9 @@
 #pragma once
 
 #include <mitsuba/core/object.h>
+#include <mitsuba/core/filesystem.h>
+#include <atomic>
+#include <vector>
 
 #if defined(MI_ENABLE_ITTNOTIFY)
 #  include <ittnotify.h>
@@ -30,6 +33,7 @@ enum class ProfilerPhase : int {
     SampleEmitterDirection,     /* Scene::sample_emitter_direction() */
     RayTest,                    /* Scene::ray_test() */
     RayIntersect,               /* Scene::ray_intersect() */
+    ShapeIntersect,             /* Shape intersection tests of the kd-tree */
     CreateSurfaceInteraction,   /* KDTree::create_surface_interaction() */
     ImageBlockPut,              /* ImageBlock::put() */
     BSDFEvaluate,               /* BSDF::eval() and BSDF::pdf() */
@@ -62,6 +66,7 @@ constexpr const char
         "Scene::sample_emitter_direction()",
         "Scene::ray_test()",
         "Scene::ray_intersect()",
+        "Shape::ray_intersect_preliminary()",
         "KDTree::create_surface_interaction()",
         "ImageBlock::put()",
         "BSDF::eval(), pdf()",
@@ -84,6 +89,203 @@ extern MI_EXPORT_LIB __itt_string_handle *
     mitsuba_itt_phase[int(ProfilerPhase::ProfilerPhaseCount)];
 #endif
 
+/**
+ * \brief Built-in timeline recorder that exports Chrome trace JSON
+ *
+ * When recording is enabled, the coarse profiler phases (scene
+ * initialization, geometry and bitmap I/O, acceleration data structure
+ * construction, and rendering) as well as regions marked with \ref
+ * ScopedTraceEvent (e.g. the instantiation of individual objects) are
+ * recorded with their start time, duration, and thread. Fine-grained phases
+ * like \ref ProfilerPhase::BSDFEvaluate are not recorded.
+ *
+ * Every thread appends events to its own buffer without any synchronization.
+ * The events are written when \ref stop() is called or at shutdown, using
+ * the Trace Event format that is understood by <tt>chrome://tracing</tt> and
+ * <tt>ui.perfetto.dev</tt>.
+ *
+ * Recording can also be enabled by setting the environment variable
+ * <tt>MI_TRACE_FILE</tt> to the path of the output file.
+ */
+class MI_EXPORT_LIB Tracer {
+public:
+    /// Start recording events that will be written to \c filename
+    static void start(const fs::path &filename);
+
+    /// Stop recording and write the events recorded so far
+    static void stop();
+
+    /// Is recording currently enabled?
+    static bool enabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+    /// Return the current time in nanoseconds
+    static uint64_t timestamp();
+
+    /// Record an event that started at time \c start and ends now
+    static void record(const char *category, const char *name, uint64_t start);
+
+    /// Variant of \ref record() for names that aren't known at compile time
+    static void record(const char *category, std::string &&name, uint64_t start);
+
+private:
+    static std::atomic<bool> m_enabled;
+};
+
+/**
+ * \brief Records the lifetime of this object as an event of the timeline
+ * (see \ref Tracer). This does nothing while recording is disabled.
+ */
+struct ScopedTraceEvent {
+    ScopedTraceEvent(const char *category, const char *name)
+        : m_category(category), m_name(name) {
+        if (Tracer::enabled())
+            m_start = Tracer::timestamp();
+    }
+
+    /// The label is only built if recording is enabled
+    template <typename Func>
+    ScopedTraceEvent(const char *category, Func &&label)
+        : m_category(category) {
+        if (Tracer::enabled()) {
+            m_label = label();
+            m_start = Tracer::timestamp();
+        }
+    }
+
+    ~ScopedTraceEvent() {
+        if (m_start == 0 || !Tracer::enabled())
+            return;
+        if (m_name)
+            Tracer::record(m_category, m_name, m_start);
+        else
+            Tracer::record(m_category, std::move(m_label), m_start);
+    }
+
+    ScopedTraceEvent(const ScopedTraceEvent &) = delete;
+    ScopedTraceEvent &operator=(const ScopedTraceEvent &) = delete;
+
+private:
+    const char *m_category;
+    const char *m_name = nullptr;
+    std::string m_label;
+    uint64_t m_start = 0;
+};
+
+/**
+ * \brief Per-object accounting of rendering costs
+ *
+ * While enabled, methods marked with \ref MI_MASKED_FUNCTION in scalar
+ * variants record their number of invocations and their (inclusive) running
+ * time under the object they were called on, e.g. a specific BSDF, texture or
+ * emitter instance. Primitive intersection tests performed by the built-in
+ * kd-tree are counted per shape. This reveals which assets of a scene are
+ * responsible for the costs reported by the coarse profiler phases.
+ *
+ * Every thread accumulates costs in its own table, and the tables are merged
+ * when a report is requested. \ref SamplingIntegrator::render() logs a
+ * report at the end of each render. Accounting can also be enabled by
+ * setting the environment variable <tt>MI_OBJECT_PROFILER</tt>.
+ *
+ * Objects referenced by the tables are kept alive until \ref reset() is
+ * called.
+ */
+class MI_EXPORT_LIB ObjectProfiler {
+public:
+    /// Costs of a method of a specific object
+    struct Record {
+        ref<Object> object;
+        ProfilerPhase phase;
+        /// Number of invocations
+        uint64_t count;
+        /// Accumulated running time in nanoseconds (zero for counted events)
+        uint64_t time;
+    };
+
+    /// Enable or disable accounting
+    static void set_enabled(bool enabled);
+
+    /// Is accounting currently enabled?
+    static bool enabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+    /// Add an invocation of \c phase on \c object that took \c time nanoseconds
+    static void record(const Object *object, ProfilerPhase phase, uint64_t time);
+
+    /// Return the merged costs of all threads, sorted by decreasing time and count
+    static std::vector<Record> records();
+
+    /// Return a human-readable table of the \c limit most expensive records
+    static std::string report(size_t limit = 25);
+
+    /// Discard all recorded costs
+    static void reset();
+
+private:
+    static std::atomic<bool> m_enabled;
+};
+
+/**
+ * \brief Per-thread counters of the work performed by scalar variants
+ *
+ * The scene and the built-in kd-tree increment these counters while at least
+ * one client has requested them via \ref acquire(). The \c aov integrator
+ * uses them to produce per-pixel cost images.
+ */
+class MI_EXPORT_LIB CostCounters {
+public:
+    struct Counters {
+        /// Number of ray intersection and visibility queries
+        uint64_t ray_queries = 0;
+        /// Number of visited inner kd-tree nodes
+        uint64_t traversal_steps = 0;
+        /// Number of primitive intersection tests of the kd-tree
+        uint64_t prim_tests = 0;
+    };
+
+    /// Is counting currently enabled?
+    static bool enabled() { return m_users.load(std::memory_order_relaxed) > 0; }
+
+    /// Request counting (must be paired with a call to \ref release())
+    static void acquire();
+
+    /// Release a previous request made via \ref acquire()
+    static void release();
+
+    /// Return the counters of the calling thread
+    static Counters &local();
+
+private:
+    static std::atomic<uint32_t> m_users;
+};
+
+/// Records the duration of a method invocation (see \ref ObjectProfiler)
+template <bool Enabled> struct ScopedObjectCost {
+    ScopedObjectCost(const Object *, ProfilerPhase) { }
+};
+
+template <> struct ScopedObjectCost<true> {
+    ScopedObjectCost(const Object *object, ProfilerPhase phase) {
+        if (ObjectProfiler::enabled()) {
+            m_object = object;
+            m_phase = phase;
+            m_start = Tracer::timestamp();
+        }
+    }
+
+    ~ScopedObjectCost() {
+        if (m_object)
+            ObjectProfiler::record(m_object, m_phase,
+                                   Tracer::timestamp() - m_start);
+    }
+
+    ScopedObjectCost(const ScopedObjectCost &) = delete;
+    ScopedObjectCost &operator=(const ScopedObjectCost &) = delete;
+
+private:
+    const Object *m_object = nullptr;
+    ProfilerPhase m_phase;
+    uint64_t m_start;
+};
+
 struct ScopedPhase {
     ScopedPhase(ProfilerPhase phase) {
         /// Interface with various external visual profilers
@@ -95,7 +297,12 @@ struct ScopedPhase {
 #if defined(MI_ENABLE_NVTX)
         nvtxRangePush(profiler_phase_id[(int) phase]);
 #endif
-        (void) phase;
+
+        /// Only coarse phases are recorded by the built-in timeline recorder
+        if ((int) phase <= (int) ProfilerPhase::Render && Tracer::enabled()) {
+            m_trace_phase = (int) phase;
+            m_trace_start = Tracer::timestamp();
+        }
     }
 
     ~ScopedPhase() {
@@ -106,10 +313,18 @@ struct ScopedPhase {
 #if defined(MI_ENABLE_NVTX)
         nvtxRangePop();
 #endif
+
+        if (m_trace_phase >= 0 && Tracer::enabled())
+            Tracer::record("phase", profiler_phase_id[m_trace_phase],
+                           m_trace_start);
     }
 
     ScopedPhase(const ScopedPhase &) = delete;
     ScopedPhase &operator=(const ScopedPhase &) = delete;
+
+private:
+    int m_trace_phase = -1;
+    uint64_t m_trace_start = 0;
 };
 
 class MI_EXPORT_LIB Profiler {
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <mitsuba/core/object.h>
+#include <mitsuba/core/filesystem.h>
+#include <drjit/array.h>
+#include <drjit/jit.h>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**
+ * \brief Named shared memory region used by the node-level asset cache
+ *
+ * When several Mitsuba processes run on the same machine and load identical
+ * assets (e.g. a multi-GB mesh), each of them would normally decode the asset
+ * into private memory. The node-level cache avoids this: the first process
+ * publishes the decoded data into a named POSIX shared memory object, and all
+ * subsequent processes map it instead of decoding the asset again. Since the
+ * pages are backed by the same physical memory, the aggregate resident
+ * memory of the processes shrinks accordingly.
+ *
+ * Every call to \ref open() creates a separate private copy-on-write
+ * mapping, hence modifications made through one of them (e.g. when optimizing
+ * vertex positions) never leak into the cache, into other processes, or into
+ * other objects of the same process.
+ *
+ * The cache is opt-in: it is disabled unless \ref set_enabled() is called or
+ * the environment variable <tt>MI_SHM_CACHE</tt> is set to \c 1. Published
+ * regions persist (typically in <tt>/dev/shm</tt>) until they are removed via
+ * \ref remove() or the machine is restarted. Entries are keyed by a hash of
+ * a descriptive string, which includes the file path, size and modification
+ * time of the source asset (see \ref file_descriptor()) and all loading
+ * parameters that influence the decoded data.
+ *
+ * A region is unmapped once the last reference to it goes away. Arrays
+ * returned by \ref view() in JIT variants hold such a reference, while
+ * scalar variants must keep the region alive for as long as the arrays are
+ * in use.
+ *
+ * \remark The node-level cache is only available on Linux and macOS.
+ */
+class MI_EXPORT_LIB SharedMemoryRegion : public Object {
+public:
+    /// Alignment of the region contents (and recommended alignment of sub-buffers)
+    static constexpr size_t Alignment = 64;
+
+    /**
+     * \brief Map a published region into memory
+     *
+     * Returns \c nullptr when no region with the given key exists, when
+     * its creator has not finished publishing it yet, or when it is not
+     * exclusively owned by the current user.
+     */
+    static ref<SharedMemoryRegion> open(const std::string &key);
+
+    /**
+     * \brief Create a new writable region of the given size
+     *
+     * Returns \c nullptr when the region already exists (e.g. because another
+     * process is publishing the same asset), or when the system does not
+     * have enough shared memory available. The caller should fill the region
+     * and then invoke \ref publish().
+     */
+    static ref<SharedMemoryRegion> create(const std::string &key, size_t size);
+
+    /**
+     * \brief Make a region created via \ref create() visible to other processes
+     *
+     * Afterwards, the region is remapped using a private copy-on-write
+     * mapping, like the ones returned by \ref open().
+     */
+    void publish();
+
+    /// Remove a region from the node-level cache. Existing mappings remain valid.
+    static bool remove(const std::string &key);
+
+    /// Is the node-level shared memory cache enabled?
+    static bool enabled();
+
+    /// Enable or disable the node-level shared memory cache
+    static void set_enabled(bool value);
+
+    /// Turn a descriptive string into a short key suitable for \ref open()
+    static std::string make_key(const std::string &descr);
+
+    /// Return a string identifying the file and its current contents
+    static std::string file_descriptor(const fs::path &path);
+
+    /// Round up a byte offset to the region's alignment
+    static size_t align(size_t offset) {
+        return (offset + Alignment - 1) / Alignment * Alignment;
+    }
+
+    /// Return a pointer to the region contents
+    void *data();
+
+    /// Return a pointer to the region contents (const version)
+    const void *data() const;
+
+    /// Return the size of the region contents in bytes
+    size_t size() const;
+
+    /// Return the key of the region
+    const std::string &key() const;
+
+    /**
+     * \brief Return a Dr.Jit array referencing \c count elements at the given
+     * byte offset
+     *
+     * Host-based array types directly reference the mapped memory, while
+     * device arrays (CUDA) receive a copy. LLVM arrays keep the region
+     * mapped until they are freed. The caller is responsible for this in
+     * scalar variants.
+     */
+    template <typename Storage>
+    Storage view(size_t offset, size_t count) const {
+        using Value = dr::value_t<Storage>;
+        const Value *ptr = (const Value *) ((const uint8_t *) data() + offset);
+        if constexpr (dr::is_cuda_v<Storage>) {
+            return dr::load<Storage>(ptr, count);
+        } else if constexpr (dr::is_jit_v<Storage>) {
+            Storage result = dr::map<Storage>((void *) ptr, count, false);
+            inc_ref();
+            jit_var_set_callback(
+                result.index(),
+                [](uint32_t /* index */, int free, void *payload) {
+                    if (free) {
+                        // Kernels may still be reading the mapped memory
+                        dr::sync_thread();
+                        ((const SharedMemoryRegion *) payload)->dec_ref();
+                    }
+                },
+                (void *) this);
+            return result;
+        } else {
+            return dr::map<Storage>((void *) ptr, count, false);
+        }
+    }
+
+    /// Return a string representation
+    std::string to_string() const override;
+
+    MI_DECLARE_CLASS()
+protected:
+    SharedMemoryRegion(const std::string &key);
+
+    /// Release all resources
+    virtual ~SharedMemoryRegion();
+
+private:
+    struct SharedMemoryRegionPrivate;
+    std::unique_ptr<SharedMemoryRegionPrivate> d;
+};
+
+NAMESPACE_END(mitsuba)
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <mitsuba/core/bitmap.h>
+#include <mitsuba/core/filesystem.h>
+#include <mutex>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**
+ * \brief Incrementally writes a tiled OpenEXR file
+ *
+ * This class creates a tiled OpenEXR image (single resolution level, random
+ * tile order) and streams individual tiles to disk as soon as they become
+ * available. This makes it possible to produce images that exceed the amount
+ * of available memory, since only the tiles that are currently being worked
+ * on must be stored.
+ *
+ * All tiles must share the pixel format, component format, and channel names
+ * of the prototype bitmap that is passed to the constructor. Tiles that were
+ * never written are filled with zeros by \ref close().
+ *
+ * The \ref write_tile() function is thread-safe.
+ */
+class MI_EXPORT_LIB TiledEXRWriter : public Object {
+public:
+    using Vector2u = Bitmap::Vector2u;
+    using Point2u = Bitmap::Point2u;
+
+    /**
+     * \brief Create a new tiled OpenEXR file
+     *
+     * \param filename
+     *     Path of the output file
+     *
+     * \param size
+     *     Resolution of the complete image
+     *
+     * \param tile_size
+     *     Size of the (square) tiles in pixels
+     *
+     * \param prototype
+     *     Bitmap that specifies the pixel format, component format, channel
+     *     names, and metadata of the output file. Its contents are ignored.
+     */
+    TiledEXRWriter(const fs::path &filename, const Vector2u &size,
+                   uint32_t tile_size, const Bitmap *prototype);
+
+    /**
+     * \brief Write a tile to the file
+     *
+     * \param offset
+     *     Position of the top left corner of the tile in pixels. Must be a
+     *     multiple of the tile size.
+     *
+     * \param tile
+     *     Tile contents. Its size must equal the tile size, except for tiles
+     *     on the right and bottom boundary of the image, which are clipped.
+     */
+    void write_tile(const Point2u &offset, const Bitmap *tile);
+
+    /// Fill in missing tiles and close the file. Further writes raise an error.
+    void close();
+
+    /// Has the file been closed?
+    bool closed() const;
+
+    /// Return the resolution of the complete image
+    const Vector2u &size() const { return m_size; }
+
+    /// Return the size of the (square) tiles in pixels
+    uint32_t tile_size() const { return m_tile_size; }
+
+    /// Return the number of tiles in the file
+    uint32_t tile_count() const { return dr::prod(m_tiles); }
+
+    /// Return the number of tiles written so far
+    uint32_t tiles_written() const;
+
+    /// Return the path of the output file
+    const fs::path &filename() const { return m_filename; }
+
+    /// Return a string representation
+    std::string to_string() const override;
+
+    MI_DECLARE_CLASS()
+protected:
+    /**
+     * \brief Release the file
+     *
+     * Unlike \ref close(), this does not fill in missing tiles, hence the
+     * file will be incomplete unless all tiles were written.
+     */
+    virtual ~TiledEXRWriter();
+
+    /// Write a tile without acquiring the lock
+    void write_tile_nolock(const Vector2u &index, const Bitmap *tile);
+
+private:
+    struct TiledEXRWriterPrivate;
+    std::unique_ptr<TiledEXRWriterPrivate> d;
+    mutable std::mutex m_mutex;
+    fs::path m_filename;
+    Vector2u m_size;
+    Vector2u m_tiles;
+    uint32_t m_tile_size;
+    ref<Struct> m_struct;
+    Bitmap::PixelFormat m_pixel_format;
+    std::vector<bool> m_written;
+    uint32_t m_tiles_written;
+};
+
+NAMESPACE_END(mitsuba)
@@ -29,6 +29,12 @@ extern MI_EXPORT_LIB std::string time_string(float time, bool precise = false);
 /// Turn a memory size into a human-readable string
 extern MI_EXPORT_LIB std::string mem_string(size_t size, bool precise = false);
 
+/// Determine the amount of physical memory (in bytes), or 0 if unknown
+extern MI_EXPORT_LIB size_t physical_memory();
+
+/// Determine the peak resident set size of the process (in bytes), or 0 if unknown
+extern MI_EXPORT_LIB size_t peak_memory_usage();
+
 /// Returns 'true' if the application is running inside a debugger
 extern MI_EXPORT_LIB bool detect_debugger();
 
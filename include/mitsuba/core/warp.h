@@ -369,6 +369,207 @@ square_to_uniform_spherical_lune_pdf(const Vector<Value, 3> &d,
 
 // =======================================================================
 
+/**
+ * \brief Solid angle of a spherical triangle
+ *
+ * The triangle is specified by unit vectors \c a, \c b, and \c c that point
+ * to its vertices. Based on "The Solid Angle of a Plane Triangle" by A. van
+ * Oosterom and J. Strackee, which remains accurate for small triangles.
+ */
+template <typename Value>
+MI_INLINE Value spherical_triangle_solid_angle(const Vector<Value, 3> &a,
+                                               const Vector<Value, 3> &b,
+                                               const Vector<Value, 3> &c) {
+    Value num = dr::abs(dr::dot(a, dr::cross(b, c))),
+          den = 1.f + dr::dot(a, b) + dr::dot(a, c) + dr::dot(b, c);
+    return 2.f * dr::atan2(num, den);
+}
+
+/**
+ * \brief Uniformly sample a direction within a spherical triangle with
+ * respect to solid angles
+ *
+ * The triangle is specified by unit vectors \c a, \c b, and \c c that point
+ * to its vertices. Based on "Stratified Sampling of Spherical Triangles" by
+ * James Arvo.
+ */
+template <typename Value>
+MI_INLINE Vector<Value, 3>
+square_to_uniform_spherical_triangle(const Point<Value, 2> &sample,
+                                     const Vector<Value, 3> &a,
+                                     const Vector<Value, 3> &b,
+                                     const Vector<Value, 3> &c) {
+    using Vector3 = Vector<Value, 3>;
+
+    // Interior angle at vertex 'a'
+    Vector3 n_ab = dr::normalize(dr::cross(a, b)),
+            n_ac = dr::normalize(dr::cross(a, c));
+    Value cos_alpha = dr::clamp(dr::dot(n_ab, n_ac), -1.f, 1.f),
+          sin_alpha = circ(cos_alpha),
+          alpha     = dr::acos(cos_alpha);
+
+    // Pick the sub-triangle with the desired area, which determines 'c_hat'
+    Value area = spherical_triangle_solid_angle(a, b, c);
+    auto [s, t] = dr::sincos(dr::fmsub(sample.x(), area, alpha));
+
+    Value u = t - cos_alpha,
+          v = dr::fmadd(sin_alpha, dr::dot(a, b), s);
+
+    Value q_num = (v * t - u * s) * cos_alpha - v,
+          q_den = (v * s + u * t) * sin_alpha,
+          q     = dr::clamp(dr::select(dr::neq(q_den, 0.f), q_num / q_den, 1.f),
+                            -1.f, 1.f);
+
+    Vector3 c_perp = dr::normalize(dr::fnmadd(dr::dot(c, a), a, c)),
+            c_hat  = dr::fmadd(q, a, circ(q) * c_perp);
+
+    // Sample along the arc between 'b' and 'c_hat'
+    Value z = dr::fnmadd(sample.y(), 1.f - dr::dot(c_hat, b), 1.f);
+    Vector3 c_hat_perp = dr::fnmadd(dr::dot(c_hat, b), b, c_hat);
+    Value c_hat_norm = dr::norm(c_hat_perp);
+
+    return dr::select(c_hat_norm > 0.f,
+                      dr::fmadd(z, b, circ(z) * (c_hat_perp / c_hat_norm)),
+                      b);
+}
+
+/// Density of \ref square_to_uniform_spherical_triangle() w.r.t. solid angles
+template <typename Value>
+MI_INLINE Value
+square_to_uniform_spherical_triangle_pdf(const Vector<Value, 3> &d,
+                                         const Vector<Value, 3> &a,
+                                         const Vector<Value, 3> &b,
+                                         const Vector<Value, 3> &c) {
+    DRJIT_MARK_USED(d);
+    return dr::rcp(spherical_triangle_solid_angle(a, b, c));
+}
+
+// =======================================================================
+
+namespace detail {
+    /**
+     * Quantities shared by the spherical rectangle routines below, see
+     * "An Area-Preserving Parametrization for Spherical Rectangles" by
+     * Carlos Ureña, Marcos Fajardo, and Alan King.
+     */
+    template <typename Value> struct SphericalRectangle {
+        using Vector3 = Vector<Value, 3>;
+
+        // Local frame, oriented so that the rectangle lies at 'z = z0 <= 0'
+        Vector3 x, y, z;
+        Value x0, x1, y0, y1, z0;
+        Value b0, b1, k, solid_angle;
+
+        SphericalRectangle(const Vector3 &o, const Vector3 &ex,
+                           const Vector3 &ey) {
+            Value ex_len = dr::norm(ex),
+                  ey_len = dr::norm(ey);
+
+            x = ex / ex_len;
+            y = ey / ey_len;
+            z = dr::cross(x, y);
+
+            x0 = dr::dot(o, x);
+            y0 = dr::dot(o, y);
+            z0 = dr::dot(o, z);
+            x1 = x0 + ex_len;
+            y1 = y0 + ey_len;
+
+            z  = dr::select(z0 > 0.f, -z, z);
+            z0 = -dr::abs(z0);
+
+            // Normals of the planes spanned by the reference point and each edge
+            Vector3 v00(x0, y0, z0), v01(x0, y1, z0),
+                    v10(x1, y0, z0), v11(x1, y1, z0);
+
+            Vector3 n0 = dr::normalize(dr::cross(v00, v10)),
+                    n1 = dr::normalize(dr::cross(v10, v11)),
+                    n2 = dr::normalize(dr::cross(v11, v01)),
+                    n3 = dr::normalize(dr::cross(v01, v00));
+
+            // Interior angles of the spherical rectangle
+            Value g0 = dr::safe_acos(-dr::dot(n0, n1)),
+                  g1 = dr::safe_acos(-dr::dot(n1, n2)),
+                  g2 = dr::safe_acos(-dr::dot(n2, n3)),
+                  g3 = dr::safe_acos(-dr::dot(n3, n0));
+
+            b0 = n0.z();
+            b1 = n2.z();
+            k  = dr::TwoPi<Value> - g2 - g3;
+            solid_angle = dr::maximum(g0 + g1 - k, 0.f);
+        }
+    };
+}
+
+/**
+ * \brief Solid angle of a rectangle as seen from a reference point
+ *
+ * The rectangle is specified by the offset \c o from the reference point to
+ * one of its corners and by two orthogonal edge vectors \c ex and \c ey.
+ */
+template <typename Value>
+MI_INLINE Value spherical_rectangle_solid_angle(const Vector<Value, 3> &o,
+                                                const Vector<Value, 3> &ex,
+                                                const Vector<Value, 3> &ey) {
+    return detail::SphericalRectangle<Value>(o, ex, ey).solid_angle;
+}
+
+/**
+ * \brief Uniformly sample the solid angle subtended by a rectangle
+ *
+ * The rectangle is specified by the offset \c o from the reference point to
+ * one of its corners and by two orthogonal edge vectors \c ex and \c ey.
+ * Unlike the other warping functions, this function returns the offset from
+ * the reference point to the sampled point on the rectangle (i.e., an
+ * unnormalized direction).
+ *
+ * Based on "An Area-Preserving Parametrization for Spherical Rectangles" by
+ * Carlos Ureña, Marcos Fajardo, and Alan King.
+ */
+template <typename Value>
+MI_INLINE Vector<Value, 3>
+square_to_uniform_spherical_rectangle(const Point<Value, 2> &sample,
+                                      const Vector<Value, 3> &o,
+                                      const Vector<Value, 3> &ex,
+                                      const Vector<Value, 3> &ey) {
+    detail::SphericalRectangle<Value> sr(o, ex, ey);
+
+    // Compute the 'x' coordinate from the first sample
+    auto [sin_au, cos_au] = dr::sincos(dr::fmadd(sample.x(), sr.solid_angle, sr.k));
+    Value fu = dr::fmsub(cos_au, sr.b0, sr.b1) / sin_au,
+          cu = dr::mulsign(dr::rsqrt(dr::fmadd(fu, fu, dr::sqr(sr.b0))), fu);
+    cu = dr::clamp(cu, -dr::OneMinusEpsilon<Value>, dr::OneMinusEpsilon<Value>);
+
+    Value xu = dr::clamp(-(cu * sr.z0) * dr::rsqrt(dr::fnmadd(cu, cu, 1.f)),
+                         sr.x0, sr.x1);
+
+    // Compute the 'y' coordinate from the second sample
+    Value d2 = dr::fmadd(xu, xu, dr::sqr(sr.z0)),
+          d  = dr::sqrt(d2),
+          h0 = sr.y0 * dr::rsqrt(d2 + dr::sqr(sr.y0)),
+          h1 = sr.y1 * dr::rsqrt(d2 + dr::sqr(sr.y1)),
+          hv = dr::fmadd(sample.y(), h1 - h0, h0),
+          hv2 = dr::sqr(hv);
+
+    Value yv = dr::select(hv2 < 1.f - 1e-6f, hv * d * dr::rsqrt(1.f - hv2), sr.y1);
+    yv = dr::clamp(yv, sr.y0, sr.y1);
+
+    return dr::fmadd(sr.x, xu, dr::fmadd(sr.y, yv, sr.z * sr.z0));
+}
+
+/// Density of \ref square_to_uniform_spherical_rectangle() w.r.t. solid angles
+template <typename Value>
+MI_INLINE Value
+square_to_uniform_spherical_rectangle_pdf(const Vector<Value, 3> &d,
+                                          const Vector<Value, 3> &o,
+                                          const Vector<Value, 3> &ex,
+                                          const Vector<Value, 3> &ey) {
+    DRJIT_MARK_USED(d);
+    return dr::rcp(spherical_rectangle_solid_angle(o, ex, ey));
+}
+
+// =======================================================================
+
 /// Uniformly sample a vector on the unit hemisphere with respect to solid angles
 template <typename Value>
 MI_INLINE Vector<Value, 3> square_to_uniform_hemisphere(const Point<Value, 2> &sample) {
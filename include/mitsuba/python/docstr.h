@@ -932,6 +932,21 @@ static const char *__doc_mitsuba_BSDF_flags = R"doc(Flags for all components com
 
 static const char *__doc_mitsuba_BSDF_flags_2 = R"doc(Flags for a specific component of this BSDF.)doc";
 
+static const char *__doc_mitsuba_BSDF_flatten =
+R"doc(Fuse a chain of adapter BSDFs into a single BSDF
+
+Material stacks such as ``twosided(normalmap(bumpmap(mask(...))))``
+normally perform one virtual function call per adapter and query. This
+function collapses chains of the ``twosided`` (with a single nested
+material), ``normalmap``, ``bumpmap``, and ``mask`` adapters into a
+single object that applies the frame perturbations of all adapters
+inline before dispatching to the innermost BSDF. The result is
+identical to that of the original chain, and the parameters exposed
+via traverse() are unchanged.
+
+Returns ``bsdf`` itself when it does not contain at least two
+adapters.)doc";
+
 static const char *__doc_mitsuba_BSDF_has_attribute =
 R"doc(Returns whether this BSDF contains the specified attribute.
 
@@ -1029,6 +1044,13 @@ zero spectrum indicates that sampling failed.)doc";
 
 static const char *__doc_mitsuba_BSDF_set_id = R"doc(Set a string identifier)doc";
 
+static const char *__doc_mitsuba_BSDF_split_opacity =
+R"doc(Separate the opacity texture from a ``mask`` BSDF
+
+When ``bsdf`` is an instance of the ``mask`` plugin, this function
+returns its nested BSDF and its opacity texture. Otherwise, it returns
+``bsdf`` and ``nullptr``.)doc";
+
 static const char *__doc_mitsuba_BSDF_to_string = R"doc(Return a human-readable representation of the BSDF)doc";
 
 static const char *__doc_mitsuba_Bitmap =
@@ -1968,6 +1990,31 @@ static const char *__doc_mitsuba_ContinuousDistribution_size = R"doc(Return the
 
 static const char *__doc_mitsuba_ContinuousDistribution_update = R"doc(Update the internal state. Must be invoked when changing the pdf.)doc";
 
+static const char *__doc_mitsuba_CostCounters =
+R"doc(Per-thread counters of the work performed by scalar variants
+
+The scene and the built-in kd-tree increment these counters while at
+least one client has requested them via acquire(). The ``aov``
+integrator uses them to produce per-pixel cost images.)doc";
+
+static const char *__doc_mitsuba_CostCounters_Counters = R"doc()doc";
+
+static const char *__doc_mitsuba_CostCounters_Counters_prim_tests = R"doc(Number of primitive intersection tests of the kd-tree)doc";
+
+static const char *__doc_mitsuba_CostCounters_Counters_ray_queries = R"doc(Number of ray intersection and visibility queries)doc";
+
+static const char *__doc_mitsuba_CostCounters_Counters_traversal_steps = R"doc(Number of visited inner kd-tree nodes)doc";
+
+static const char *__doc_mitsuba_CostCounters_acquire = R"doc(Request counting (must be paired with a call to release()))doc";
+
+static const char *__doc_mitsuba_CostCounters_enabled = R"doc(Is counting currently enabled?)doc";
+
+static const char *__doc_mitsuba_CostCounters_local = R"doc(Return the counters of the calling thread)doc";
+
+static const char *__doc_mitsuba_CostCounters_m_users = R"doc()doc";
+
+static const char *__doc_mitsuba_CostCounters_release = R"doc(Release a previous request made via acquire())doc";
+
 static const char *__doc_mitsuba_DefaultFormatter =
 R"doc(The default formatter used to turn log messages into a human-readable
 form)doc";
@@ -2985,6 +3032,21 @@ static const char *__doc_mitsuba_Film_prepare =
 R"doc(Configure the film for rendering a specified set of extra channels
 (AOVS). Returns the total number of channels that the film will store)doc";
 
+static const char *__doc_mitsuba_Film_prepare_blocks =
+R"doc(Inform the film about the block decomposition of the next render
+
+This function is invoked by the CPU rendering code path of sampling
+integrators before any image blocks are submitted via put_block().
+Films that stream finished image regions to disk use this information
+to determine when a region has received all of its contributions. The
+default implementation does nothing.
+
+Parameter ``block_size``:
+    Size of the (square) image blocks in pixels, excluding the border
+
+Parameter ``passes``:
+    Number of times that every block will be submitted)doc";
+
 static const char *__doc_mitsuba_Film_prepare_sample =
 R"doc(Prepare spectrum samples to be in the format expected by the film
 
@@ -3029,6 +3091,15 @@ R"doc(Should regions slightly outside the image plane be sampled to improve
 the quality of the reconstruction at the edges? This only makes sense
 when reconstruction filters other than the box filter are used.)doc";
 
+static const char *__doc_mitsuba_Film_scanline_order =
+R"doc(Should image blocks be rendered in scanline order?
+
+When this function returns ``True``, the integrator generates image
+blocks row by row (instead of following a spiral) and renders all
+passes of a block before moving on to the next one, so that image
+regions complete in order. The default implementation returns
+``False``.)doc";
+
 static const char *__doc_mitsuba_Film_schedule_storage = R"doc(dr::schedule() variables that represent the internal film storage)doc";
 
 static const char *__doc_mitsuba_Film_sensor_response_function = R"doc(Returns the specific Sensor Response Function (SRF) used by the film)doc";
@@ -4596,6 +4667,20 @@ Internally, this method relies on the directed edge data structure. A
 call to build_directed_edges before a call to this method is therefore
 necessary.)doc";
 
+static const char *__doc_mitsuba_Mesh_build_silhouette_bvh =
+R"doc(Build (or refit) the bounding volume hierarchy over the edges of the
+mesh that accelerates precompute_silhouette().
+
+Every node stores the bounding box of its edges along with a cone that
+bounds the normals of all faces adjacent to them. For a given
+viewpoint, this is sufficient to conservatively reject subtrees where
+all of these faces are either front- or back-facing, and which
+therefore cannot contain silhouette edges.
+
+The hierarchy is rebuilt from scratch when the topology changed and is
+otherwise only refitted to the current vertex positions. The directed
+edge data structure is created on demand.)doc";
+
 static const char *__doc_mitsuba_Mesh_build_parameterization =
 R"doc(Initialize the ``m_parameterization`` field for mapping UV coordinates
 to positions
@@ -4736,6 +4821,12 @@ static const char *__doc_mitsuba_Mesh_parameters_changed = R"doc()doc";
 
 static const char *__doc_mitsuba_Mesh_parameters_grad_enabled = R"doc()doc";
 
+static const char *__doc_mitsuba_Mesh_pdf_direction =
+R"doc(Query the probability density of sample_direction()
+
+The density depends on the triangle containing the sampled position,
+which is given by PositionSample::prim_index.)doc";
+
 static const char *__doc_mitsuba_Mesh_pdf_position = R"doc()doc";
 
 static const char *__doc_mitsuba_Mesh_precompute_silhouette = R"doc()doc";
@@ -4777,20 +4868,58 @@ static const char *__doc_mitsuba_Mesh_recompute_bbox = R"doc(Recompute the bound
 
 static const char *__doc_mitsuba_Mesh_recompute_vertex_normals = R"doc(Compute smooth vertex normals and replace the current normal values)doc";
 
+static const char *__doc_mitsuba_Mesh_sample_direction =
+R"doc(Sample a direction towards the mesh
+
+A triangle is chosen proportionally to its surface area, and a
+direction is then sampled uniformly within the solid angle that it
+subtends from the reference position. Triangles that are distant or
+tiny as seen from the reference position revert to area sampling.)doc";
+
 static const char *__doc_mitsuba_Mesh_sample_position = R"doc()doc";
 
 static const char *__doc_mitsuba_Mesh_sample_precomputed_silhouette = R"doc()doc";
 
 static const char *__doc_mitsuba_Mesh_sample_silhouette = R"doc()doc";
 
+static const char *__doc_mitsuba_Mesh_set_buffers =
+R"doc(Replace the vertex positions and faces (and optionally the texture
+coordinates) of the mesh
+
+The given buffers are adopted without copying them, after which all
+derived data (bounding box, vertex normals, sampling tables, ...) is
+updated as in parameters_changed(). An empty texture coordinate buffer
+leaves the current one untouched. This is the fast path for meshes
+whose geometry is generated outside of Mitsuba: the Python bindings
+load host arrays (NumPy, PyTorch, ...) in a single copy and call this
+method without holding the GIL.
+
+As with ``mi.traverse()``, a scene containing this mesh must be
+notified afterwards via Scene::parameters_changed().)doc";
+
 static const char *__doc_mitsuba_Mesh_set_scene = R"doc()doc";
 
+static const char *__doc_mitsuba_Mesh_silhouette_edges =
+R"doc(Return the directed edges that lie on the silhouette of the mesh as
+seen from ``viewpoint``
+
+This is a convenience wrapper around precompute_silhouette() that
+drops the sampling weights. Each edge is reported once (by its smaller
+directed edge index) and boundary edges are always included. The
+returned indices can be passed to sample_precomputed_silhouette().)doc";
+
 static const char *__doc_mitsuba_Mesh_surface_area = R"doc()doc";
 
 static const char *__doc_mitsuba_Mesh_to_string = R"doc(Return a human-readable string representation of the shape contents.)doc";
 
 static const char *__doc_mitsuba_Mesh_traverse = R"doc(@})doc";
 
+static const char *__doc_mitsuba_Mesh_triangle_position_sample =
+R"doc(Create a position sample for the point with barycentric coordinates
+``b`` on the face ``face_idx``
+
+The ``pdf`` field of the returned record is left at zero.)doc";
+
 static const char *__doc_mitsuba_Mesh_vertex_count = R"doc(Return the total number of vertices)doc";
 
 static const char *__doc_mitsuba_Mesh_vertex_data_bytes = R"doc()doc";
@@ -5063,6 +5192,54 @@ In contrast, the ``Object`` class allows for a highly efficient
 implementation that only adds 32 bits to the base object (for the
 counter) and has no overhead for references.)doc";
 
+static const char *__doc_mitsuba_ObjectProfiler =
+R"doc(Per-object accounting of rendering costs
+
+While enabled, methods marked with MI_MASKED_FUNCTION in scalar
+variants record their number of invocations and their (inclusive)
+running time under the object they were called on, e.g. a specific
+BSDF, texture or emitter instance. Primitive intersection tests
+performed by the built-in kd-tree are counted per shape. This reveals
+which assets of a scene are responsible for the costs reported by the
+coarse profiler phases.
+
+Every thread accumulates costs in its own table, and the tables are
+merged when a report is requested. SamplingIntegrator::render() logs a
+report at the end of each render. Accounting can also be enabled by
+setting the environment variable ``MI_OBJECT_PROFILER``.
+
+Objects referenced by the tables are kept alive until reset() is
+called.)doc";
+
+static const char *__doc_mitsuba_ObjectProfiler_Record = R"doc(Costs of a method of a specific object)doc";
+
+static const char *__doc_mitsuba_ObjectProfiler_Record_count = R"doc(Number of invocations)doc";
+
+static const char *__doc_mitsuba_ObjectProfiler_Record_object = R"doc()doc";
+
+static const char *__doc_mitsuba_ObjectProfiler_Record_phase = R"doc()doc";
+
+static const char *__doc_mitsuba_ObjectProfiler_Record_time = R"doc(Accumulated running time in nanoseconds (zero for counted events))doc";
+
+static const char *__doc_mitsuba_ObjectProfiler_enabled = R"doc(Is accounting currently enabled?)doc";
+
+static const char *__doc_mitsuba_ObjectProfiler_m_enabled = R"doc()doc";
+
+static const char *__doc_mitsuba_ObjectProfiler_record = R"doc(Add an invocation of ``phase`` on ``object`` that took ``time`` nanoseconds)doc";
+
+static const char *__doc_mitsuba_ObjectProfiler_records =
+R"doc(Return the merged costs of all threads, sorted by decreasing time and
+count
+
+In Python, each record is a tuple ``(object, method, count, time)``
+where ``time`` is given in seconds.)doc";
+
+static const char *__doc_mitsuba_ObjectProfiler_report = R"doc(Return a human-readable table of the ``limit`` most expensive records)doc";
+
+static const char *__doc_mitsuba_ObjectProfiler_reset = R"doc(Discard all recorded costs)doc";
+
+static const char *__doc_mitsuba_ObjectProfiler_set_enabled = R"doc(Enable or disable accounting)doc";
+
 static const char *__doc_mitsuba_Object_Object = R"doc(Default constructor)doc";
 
 static const char *__doc_mitsuba_Object_Object_2 = R"doc(Copy constructor)doc";
@@ -5398,6 +5575,144 @@ discontinuities)doc";
 
 static const char *__doc_mitsuba_ParamFlags_NonDifferentiable = R"doc(Tracking gradients w.r.t. this parameter is not allowed)doc";
 
+static const char *__doc_mitsuba_ParameterRegistry =
+R"doc(Table of the parameters exposed by a scene graph
+
+This class traverses a scene graph (see Object::traverse()) entirely
+in C++ and records its parameters in a compact table with O(1) lookup
+by name. It is used by ``mitsuba.traverse()``, whose Python-side
+dictionary accesses entries on demand instead of materializing one
+Python record per parameter, which matters for scenes with hundreds of
+thousands of shapes.
+
+The traversal itself is lazy: objects are visited one at a time in
+depth-first order, and only as far as needed to answer a query.
+Looking up a parameter thus only visits the part of the graph that
+precedes it, while queries such as size() or a lookup of a missing
+name complete the traversal.
+
+Parameter names follow the conventions of ``mitsuba.traverse()``:
+nested objects are separated by a dot, and objects whose name was
+already used elsewhere in the graph receive a numbered suffix (e.g.
+``bsdf_1``). Objects that are referenced several times are only
+visited once.
+
+An optional list of name prefixes restricts the recorded parameters.
+The graph is still visited in the same order to ensure that names
+don't depend on the filter, but only matching parameters are stored.)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Entry = R"doc(Record describing a single parameter)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Entry_flags = R"doc(Combination of ParamFlags)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Entry_holder = R"doc(Keeps opaque values alive)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Entry_key = R"doc(Full name of the parameter (e.g. ``shape.bsdf.reflectance.value``))doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Entry_node = R"doc(Object exposing the parameter)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Entry_ptr = R"doc(Pointer to the parameter value)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Entry_type =
+R"doc(Type of the value referenced by ``ptr``, or ``nullptr`` when the
+value is an opaque handle that is kept alive by ``holder`` (e.g. a
+parameter exposed by a plugin implemented in Python).)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Event = R"doc(Parameter or child object reported by Object::traverse())doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Event_flags = R"doc()doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Event_holder = R"doc()doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Event_name = R"doc()doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Event_obj = R"doc()doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Event_ptr = R"doc()doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Event_type = R"doc()doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Frame = R"doc(Object whose events haven't all been processed yet)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Frame_depth = R"doc()doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Frame_events = R"doc()doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Frame_flags = R"doc()doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Frame_name = R"doc()doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Frame_next = R"doc()doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Frame_node = R"doc()doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Node = R"doc(Position of an object within the scene graph)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Node_depth = R"doc(Distance from the root)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Node_parent = R"doc(Parent object (``nullptr`` for the root))doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_ParameterRegistry =
+R"doc(Traverse the scene graph below ``root``
+
+Parameter ``root``:
+    Root of the scene graph (usually the scene)
+
+Parameter ``prefixes``:
+    Only parameters whose name starts with one of these prefixes are
+    recorded. All parameters are recorded when the list is empty.)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Recorder =
+R"doc(Traversal callback used by ParameterRegistry
+
+It collects the parameters and child objects of a single object, which
+the registry processes later on. It is exposed so that bindings can
+register opaque values (see put_opaque()) in addition to the typed
+values passed to TraversalCallback::put_parameter().)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Recorder_Recorder = R"doc()doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Recorder_put_object = R"doc()doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Recorder_put_opaque = R"doc(Register a value that is kept alive by ``holder`` (no type information))doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_Recorder_put_parameter_impl = R"doc()doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_class = R"doc()doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_complete = R"doc(Has the whole graph been visited?)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_entry =
+R"doc(Return the record with the given index in traversal order
+
+The traversal continues until the record exists. Returns ``nullptr``
+when the graph has fewer records. Records of removed parameters are
+included, their ``node`` field is set to ``nullptr``.)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_erase = R"doc(Remove a parameter. Returns ``False`` if it doesn't exist.)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_find = R"doc(Look up a parameter by name (returns ``nullptr`` if it doesn't exist))doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_keep = R"doc(Only keep the parameters whose name starts with one of the given prefixes)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_node = R"doc(Return the position of an object in the graph (or ``nullptr`` if it isn't part of it))doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_node_count = R"doc(Return the number of objects in the graph (completes the traversal))doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_nodes = R"doc(Return the objects of the graph in traversal order (completes the traversal))doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_push = R"doc(Traverse ``obj`` and push its events onto the stack)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_record = R"doc(Add an entry if it matches the prefix filters)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_root = R"doc(Return the root of the scene graph)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_size = R"doc(Return the number of recorded parameters (completes the traversal))doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_step = R"doc(Process a single event of the traversal)doc";
+
+static const char *__doc_mitsuba_ParameterRegistry_to_string = R"doc()doc";
+
 static const char *__doc_mitsuba_PhaseFunction = R"doc()doc";
 
 static const char *__doc_mitsuba_PhaseFunction_2 = R"doc()doc";
@@ -5656,6 +5971,12 @@ static const char *__doc_mitsuba_PositionSample_p = R"doc(Sampled position)doc";
 
 static const char *__doc_mitsuba_PositionSample_pdf = R"doc(Probability density at the sample)doc";
 
+static const char *__doc_mitsuba_PositionSample_prim_index =
+R"doc(Optional: index of the primitive containing the sampled position
+
+Shapes consisting of several primitives (e.g. triangle meshes) use
+this to evaluate sampling densities that depend on the primitive.)doc";
+
 static const char *__doc_mitsuba_PositionSample_time = R"doc(Associated time value)doc";
 
 static const char *__doc_mitsuba_PositionSample_uv =
@@ -6267,16 +6588,28 @@ static const char *__doc_mitsuba_RayFlags_All = R"doc(//! Compound compute flags
 
 static const char *__doc_mitsuba_RayFlags_AllNonDifferentiable = R"doc(Compute all fields of the surface interaction ignoring shape's motion)doc";
 
+static const char *__doc_mitsuba_RayFlags_CameraRay = R"doc(Only intersect shapes that are visible to camera rays)doc";
+
 static const char *__doc_mitsuba_RayFlags_DetachShape = R"doc(Derivatives of the SurfaceInteraction fields ignore shape's motion)doc";
 
+static const char *__doc_mitsuba_RayFlags_DiffuseRay = R"doc(Only intersect shapes that are visible to diffuse (non-delta) indirect rays)doc";
+
 static const char *__doc_mitsuba_RayFlags_Empty = R"doc(No flags set)doc";
 
 static const char *__doc_mitsuba_RayFlags_FollowShape = R"doc(Derivatives of the SurfaceInteraction fields follow shape's motion)doc";
 
 static const char *__doc_mitsuba_RayFlags_Minimal = R"doc(Compute position and geometric normal)doc";
 
+static const char *__doc_mitsuba_RayFlags_RayTypes =
+R"doc(Combination of all ray visibility flags. When none of them are set,
+rays intersect all shapes)doc";
+
 static const char *__doc_mitsuba_RayFlags_ShadingFrame = R"doc(Compute shading normal and shading frame)doc";
 
+static const char *__doc_mitsuba_RayFlags_ShadowRay = R"doc(Only intersect shapes that cast shadows)doc";
+
+static const char *__doc_mitsuba_RayFlags_SpecularRay = R"doc(Only intersect shapes that are visible to specular (delta) indirect rays)doc";
+
 static const char *__doc_mitsuba_RayFlags_UV = R"doc(Compute UV coordinates)doc";
 
 static const char *__doc_mitsuba_RayFlags_dNGdUV = R"doc(Compute the geometric normal partials wrt. the UV coordinates)doc";
@@ -6638,7 +6971,25 @@ Must be a multiple of the total sample count per pixel. If set to
 
 static const char *__doc_mitsuba_SamplingIntegrator_render = R"doc(//! @{ \name Integrator interface implementation)doc";
 
-static const char *__doc_mitsuba_SamplingIntegrator_render_block = R"doc()doc";
+static const char *__doc_mitsuba_SamplingIntegrator_render_block =
+R"doc(Render a block of the image (scalar variants)
+
+This is invoked by render() for every block of the spiral. The default
+implementation claims the pixels of the block in small chunks, which
+allows threads that ran out of blocks to help with the remaining
+pixels. Overriding implementations are still called for every block,
+but their blocks are never split in this way.)doc";
+
+static const char *__doc_mitsuba_SamplingIntegrator_render_block_pixels =
+R"doc(Render the pixels of a block with Morton indices in ``[pixel_begin,
+pixel_end)``
+
+The samples of each pixel are seeded based on the block ID and the
+Morton index of the pixel, which allows several threads to render
+disjoint pixel ranges of the same block (into separate image blocks)
+with the same samples. This is used by render_block() and render() to
+split the remaining blocks at the end of a render. Contrary to
+render_block(), the image block is not cleared.)doc";
 
 static const char *__doc_mitsuba_SamplingIntegrator_render_sample = R"doc()doc";
 
@@ -6735,6 +7086,8 @@ static const char *__doc_mitsuba_Scene_class = R"doc()doc";
 
 static const char *__doc_mitsuba_Scene_clear_shapes_dirty = R"doc(Unmarks all shapes as dirty)doc";
 
+static const char *__doc_mitsuba_Scene_count_ray_query = R"doc(Count a ray query in scalar variants (see CostCounters))doc";
+
 static const char *__doc_mitsuba_Scene_emitters = R"doc(Return the list of emitters)doc";
 
 static const char *__doc_mitsuba_Scene_emitters_2 = R"doc(Return the list of emitters (const version))doc";
@@ -6946,6 +7299,40 @@ Returns:
     A detailed surface interaction record. Its ``is_valid()`` method
     should be queried to check if an intersection was actually found.)doc";
 
+static const char *__doc_mitsuba_Scene_ray_intersect_3 =
+R"doc(Intersect a ray with the shapes comprising the scene and return a
+detailed data structure describing the intersection, if one is found.
+
+This overload additionally takes a per-lane ``ray_types`` parameter
+that combines the ray visibility flags of RayFlags (``CameraRay``,
+``ShadowRay``, ``DiffuseRay``, and ``SpecularRay``). Unlike the
+visibility bits of ``ray_flags``, which apply to all rays of the call,
+it can differ between the lanes of vectorized variants, e.g. to
+distinguish diffuse from specular bounces within a single wavefront.
+Lanes that don't specify any visibility flag intersect all shapes. The
+visibility bits of ``ray_flags`` are ignored.
+
+Parameter ``ray``:
+    A 3D ray including maximum extent (Ray::maxt) and time (Ray::time)
+    information, which matters when the shapes are in motion
+
+Parameter ``ray_flags``:
+    An integer combining flag bits from RayFlags (merged using binary
+    or).
+
+Parameter ``ray_types``:
+    The ray visibility flags of each ray (merged using binary or).
+
+Parameter ``coherent``:
+    Setting this flag to ``True`` can noticeably improve performance
+    when ``ray`` contains a coherent set of rays (e.g. primary camera
+    rays), and when using ``llvm_*`` variants of the renderer along
+    with Embree. It has no effect in scalar or CUDA/OptiX variants.
+
+Returns:
+    A detailed surface interaction record. Its ``is_valid()`` method
+    should be queried to check if an intersection was actually found.)doc";
+
 static const char *__doc_mitsuba_Scene_ray_intersect_cpu = R"doc(Trace a ray)doc";
 
 static const char *__doc_mitsuba_Scene_ray_intersect_gpu = R"doc()doc";
@@ -7010,6 +7397,15 @@ Returns:
     method should be queried to check if an intersection was actually
     found.)doc";
 
+static const char *__doc_mitsuba_Scene_ray_intersect_preliminary_2 =
+R"doc(Intersect a ray with the shapes comprising the scene and return
+preliminary information, if one is found
+
+This overload additionally takes a ``ray_flags`` parameter. Only its
+ray visibility flags (e.g. RayFlags::CameraRay) are used: when any of
+them are set, shapes that are not visible to the specified types of
+rays are skipped during traversal.)doc";
+
 static const char *__doc_mitsuba_Scene_ray_intersect_preliminary_cpu = R"doc(Trace a ray and only return a preliminary intersection data structure)doc";
 
 static const char *__doc_mitsuba_Scene_ray_intersect_preliminary_gpu = R"doc()doc";
@@ -7072,6 +7468,32 @@ Parameter ``coherent``:
 Returns:
     ``True`` if an intersection was found)doc";
 
+static const char *__doc_mitsuba_Scene_ray_test_3 =
+R"doc(Intersect a ray with the shapes comprising the scene and return a
+boolean specifying whether or not an intersection was found.
+
+This overload additionally takes a ``ray_flags`` parameter. Only its
+ray visibility flags (e.g. RayFlags::ShadowRay) are used: when any of
+them are set, shapes that are not visible to the specified types of
+rays are skipped during traversal.
+
+Parameter ``ray``:
+    A 3D ray including maximum extent (Ray::maxt) and time (Ray::time)
+    information, which matters when the shapes are in motion
+
+Parameter ``ray_flags``:
+    An integer combining flag bits from RayFlags (merged using binary
+    or).
+
+Parameter ``coherent``:
+    Setting this flag to ``True`` can noticeably improve performance
+    when ``ray`` contains a coherent set of rays (e.g. primary camera
+    rays), and when using ``llvm_*`` variants of the renderer along
+    with Embree. It has no effect in scalar or CUDA/OptiX variants.
+
+Returns:
+    ``True`` if an intersection was found)doc";
+
 static const char *__doc_mitsuba_Scene_ray_test_cpu = R"doc(Trace a shadow ray)doc";
 
 static const char *__doc_mitsuba_Scene_ray_test_gpu = R"doc()doc";
@@ -7228,12 +7650,20 @@ static const char *__doc_mitsuba_Scene_update_emitter_sampling_distribution = R"
 
 static const char *__doc_mitsuba_Scene_update_silhouette_sampling_distribution = R"doc(Updates the discrete distribution used to select a shape's silhouette)doc";
 
+static const char *__doc_mitsuba_ScopedObjectCost = R"doc(Records the duration of a method invocation (see ObjectProfiler))doc";
+
+static const char *__doc_mitsuba_ScopedObjectCost_ScopedObjectCost = R"doc()doc";
+
 static const char *__doc_mitsuba_ScopedPhase = R"doc()doc";
 
 static const char *__doc_mitsuba_ScopedPhase_ScopedPhase = R"doc()doc";
 
 static const char *__doc_mitsuba_ScopedPhase_ScopedPhase_2 = R"doc()doc";
 
+static const char *__doc_mitsuba_ScopedPhase_m_trace_phase = R"doc()doc";
+
+static const char *__doc_mitsuba_ScopedPhase_m_trace_start = R"doc()doc";
+
 static const char *__doc_mitsuba_ScopedPhase_operator_assign = R"doc()doc";
 
 static const char *__doc_mitsuba_ScopedSetThreadEnvironment =
@@ -7250,6 +7680,26 @@ static const char *__doc_mitsuba_ScopedSetThreadEnvironment_m_logger = R"doc()do
 
 static const char *__doc_mitsuba_ScopedSetThreadEnvironment_operator_assign = R"doc()doc";
 
+static const char *__doc_mitsuba_ScopedTraceEvent =
+R"doc(Records the lifetime of this object as an event of the timeline (see
+Tracer). This does nothing while recording is disabled.)doc";
+
+static const char *__doc_mitsuba_ScopedTraceEvent_ScopedTraceEvent = R"doc()doc";
+
+static const char *__doc_mitsuba_ScopedTraceEvent_ScopedTraceEvent_2 = R"doc(The label is only built if recording is enabled)doc";
+
+static const char *__doc_mitsuba_ScopedTraceEvent_ScopedTraceEvent_3 = R"doc()doc";
+
+static const char *__doc_mitsuba_ScopedTraceEvent_m_category = R"doc()doc";
+
+static const char *__doc_mitsuba_ScopedTraceEvent_m_label = R"doc()doc";
+
+static const char *__doc_mitsuba_ScopedTraceEvent_m_name = R"doc()doc";
+
+static const char *__doc_mitsuba_ScopedTraceEvent_m_start = R"doc()doc";
+
+static const char *__doc_mitsuba_ScopedTraceEvent_operator_assign = R"doc()doc";
+
 static const char *__doc_mitsuba_Sensor = R"doc()doc";
 
 static const char *__doc_mitsuba_Sensor_2 = R"doc()doc";
@@ -7544,6 +7994,33 @@ static const char *__doc_mitsuba_Shape_Shape = R"doc(//! @})doc";
 
 static const char *__doc_mitsuba_Shape_Shape_2 = R"doc()doc";
 
+static const char *__doc_mitsuba_Shape_SolidAngleSamplingMin =
+R"doc(Range of subtended solid angles (in steradians) for which shapes use
+solid angle sampling in sample_direction(). Smaller regions (distant
+or tiny shapes) and regions close to a full hemisphere are numerically
+fragile and revert to area sampling instead.)doc";
+
+static const char *__doc_mitsuba_Shape_alpha_test_scalar =
+R"doc(Stochastically decide whether a candidate intersection is kept
+
+The opacity texture is evaluated at the intersection, and the hit is
+kept with a probability equal to the opacity. The decision uses a hash
+of the ray, distance, and primitive index, hence it is deterministic.
+
+Parameter ``ray``:
+    The ray in world space
+
+Parameter ``t``:
+    Distance to the candidate intersection along the ray
+
+Parameter ``prim_uv``:
+    Primitive-local UV coordinates of the candidate intersection
+
+Parameter ``prim_index``:
+    Index of the intersected primitive)doc";
+
+static const char *__doc_mitsuba_Shape_alpha_texture = R"doc(Return the opacity texture used to alpha-test intersections (if any))doc";
+
 static const char *__doc_mitsuba_Shape_bbox =
 R"doc(Return an axis aligned box that bounds all shape primitives (including
 any transformations that may have been applied to them))doc";
@@ -7743,6 +8220,11 @@ static const char *__doc_mitsuba_Shape_is_sensor = R"doc(Is this shape also an a
 
 static const char *__doc_mitsuba_Shape_is_shapegroup = R"doc(Is this shape a shapegroup?)doc";
 
+static const char *__doc_mitsuba_Shape_is_visible =
+R"doc(Can rays traced with the given RayFlags intersect this shape?
+
+Rays that don't specify any ray visibility flag intersect all shapes.)doc";
+
 static const char *__doc_mitsuba_Shape_m_bsdf = R"doc()doc";
 
 static const char *__doc_mitsuba_Shape_m_dirty = R"doc(True if the shape's geometry has changed)doc";
@@ -7967,6 +8449,25 @@ Parameter ``ray``:
 Parameter ``flags``:
     Describe how the detailed information should be computed)doc";
 
+static const char *__doc_mitsuba_Shape_ray_intersect_alpha_tested_scalar =
+R"doc(Find the nearest intersection of an analytic shape that passes the
+alpha test
+
+Unlike triangles, analytic shapes can be intersected several times by
+the same ray (e.g. the near and far side of a sphere). A rejected hit
+therefore doesn't end the query: the shape is intersected again past
+the rejected distance until a hit is accepted or none is left.
+
+Parameter ``ray``:
+    The ray in world space
+
+Parameter ``prim_index``:
+    Index of the primitive, forwarded to alpha_test_scalar()
+
+Returns:
+    The distance to the accepted hit (infinity if there is none) and
+    its primitive-local UV coordinates)doc";
+
 static const char *__doc_mitsuba_Shape_ray_intersect_preliminary =
 R"doc(Fast ray intersection
 
@@ -8032,6 +8533,12 @@ static const char *__doc_mitsuba_Shape_ray_test_packet_3 = R"doc()doc";
 
 static const char *__doc_mitsuba_Shape_ray_test_scalar = R"doc()doc";
 
+static const char *__doc_mitsuba_Shape_ray_visibility =
+R"doc(Return the ray types that can intersect this shape
+
+The result combines the ray visibility flags of RayFlags (i.e.,
+``CameraRay``, ``ShadowRay``, ``DiffuseRay``, and ``SpecularRay``).)doc";
+
 static const char *__doc_mitsuba_Shape_sample_direction =
 R"doc(Sample a direction towards this shape with respect to solid angles
 measured at a reference position within the scene
@@ -8121,6 +8628,16 @@ static const char *__doc_mitsuba_Shape_sensor = R"doc(Return the area sensor ass
 
 static const char *__doc_mitsuba_Shape_sensor_2 = R"doc(Return the area sensor associated with this shape (if any))doc";
 
+static const char *__doc_mitsuba_Shape_set_alpha_texture =
+R"doc(Set an opacity texture that is used to alpha-test intersections
+during ray traversal
+
+This is only supported by the scalar variants, whose ray tracing
+backends (kd-tree and Embree) call alpha_test_scalar() for every
+candidate intersection with this shape.)doc";
+
+static const char *__doc_mitsuba_Shape_set_bsdf = R"doc(Replace the shape's BSDF)doc";
+
 static const char *__doc_mitsuba_Shape_set_id = R"doc(Set a string identifier)doc";
 
 static const char *__doc_mitsuba_Shape_shape_type = R"doc(Returns the shape type ShapeType of this shape)doc";
@@ -8139,6 +8656,99 @@ The default implementation throws an exception.)doc";
 
 static const char *__doc_mitsuba_Shape_traverse = R"doc()doc";
 
+static const char *__doc_mitsuba_SharedMemoryRegion =
+R"doc(Named shared memory region used by the node-level asset cache
+
+When several Mitsuba processes run on the same machine and load
+identical assets (e.g. a multi-GB mesh), each of them would normally
+decode the asset into private memory. The node-level cache avoids
+this: the first process publishes the decoded data into a named POSIX
+shared memory object, and all subsequent processes map it instead of
+decoding the asset again. Since the pages are backed by the same
+physical memory, the aggregate resident memory of the processes
+shrinks accordingly.
+
+Every call to open() creates a separate private copy-on-write mapping,
+hence modifications made through one of them (e.g. when optimizing
+vertex positions) never leak into the cache, into other processes, or
+into other objects of the same process.
+
+The cache is opt-in: it is disabled unless set_enabled() is called or
+the environment variable ``MI_SHM_CACHE`` is set to ``1``. Published
+regions persist (typically in ``/dev/shm``) until they are removed via
+remove() or the machine is restarted. Entries are keyed by a hash of a
+descriptive string, which includes the file path, size and
+modification time of the source asset (see file_descriptor()) and all
+loading parameters that influence the decoded data.
+
+A region is unmapped once the last reference to it goes away. Arrays
+returned by view() in JIT variants hold such a reference, while scalar
+variants must keep the region alive for as long as the arrays are in
+use.
+
+Remark:
+    The node-level cache is only available on Linux and macOS.)doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_SharedMemoryRegion = R"doc()doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_SharedMemoryRegionPrivate = R"doc()doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_align = R"doc(Round up a byte offset to the region's alignment)doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_class = R"doc()doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_create =
+R"doc(Create a new writable region of the given size
+
+Returns ``nullptr`` when the region already exists (e.g. because
+another process is publishing the same asset), or when the system does
+not have enough shared memory available. The caller should fill the
+region and then invoke publish().)doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_d = R"doc()doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_data = R"doc(Return a pointer to the region contents)doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_data_2 = R"doc(Return a pointer to the region contents (const version))doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_enabled = R"doc(Is the node-level shared memory cache enabled?)doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_file_descriptor = R"doc(Return a string identifying the file and its current contents)doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_key = R"doc(Return the key of the region)doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_make_key = R"doc(Turn a descriptive string into a short key suitable for open())doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_open =
+R"doc(Map a published region into memory
+
+Returns ``nullptr`` when no region with the given key exists, when
+its creator has not finished publishing it yet, or when it is not
+exclusively owned by the current user.)doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_publish =
+R"doc(Make a region created via create() visible to other processes
+
+Afterwards, the region is remapped using a private copy-on-write
+mapping, like the ones returned by open().)doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_remove = R"doc(Remove a region from the node-level cache. Existing mappings remain valid.)doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_set_enabled = R"doc(Enable or disable the node-level shared memory cache)doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_size = R"doc(Return the size of the region contents in bytes)doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_to_string = R"doc(Return a string representation)doc";
+
+static const char *__doc_mitsuba_SharedMemoryRegion_view =
+R"doc(Return a Dr.Jit array referencing ``count`` elements at the given
+byte offset
+
+Host-based array types directly reference the mapped memory, while
+device arrays (CUDA) receive a copy. LLVM arrays keep the region
+mapped until they are freed. The caller is responsible for this in
+scalar variants.)doc";
+
 static const char *__doc_mitsuba_SilhouetteSample =
 R"doc(Data structure holding the result of visibility silhouette sampling
 operations on geometry.)doc";
@@ -8222,6 +8832,202 @@ offsetting, during a ray intersection, the ray could potentially find
 an intersection point at its origin due to numerical instabilities in
 the intersection routines.)doc";
 
+static const char *__doc_mitsuba_SparseVolumeGrid =
+R"doc(Sparse 3D volume grid with a pointer-free tree layout
+
+The voxels are organized in a shallow tree with the same configuration
+as NanoVDB: a root table references upper internal nodes that each span
+4096^3 voxels, which reference lower internal nodes spanning 128^3
+voxels, which in turn reference leaf nodes holding blocks of 8^3
+voxels. The nodes of each level are stored in flat arrays and reference
+their children by index, so the tree is loaded using a few bulk reads
+and can be uploaded to the GPU as is. Voxels that are not covered by a
+leaf node take the background value.
+
+Every node also stores the per-channel minimum and maximum of the
+voxels that it covers (including the background of missing children),
+which is useful to compute local majorants.
+
+Please see the documentation of the ``sparsegridvolume`` plugin for the
+file format specification.)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_SparseVolumeGrid =
+R"doc(Load a SparseVolumeGrid from a given filename
+
+Parameter ``path``:
+    Name of the file to be loaded)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_SparseVolumeGrid_2 =
+R"doc(Load a SparseVolumeGrid from an arbitrary stream data source
+
+Parameter ``stream``:
+    Pointer to an arbitrary stream data source)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_SparseVolumeGrid_3 =
+R"doc(Create a sparse grid from dense voxel data
+
+Only the blocks of 8^3 voxels that contain values different from the
+background are stored.
+
+Parameter ``size``:
+    Resolution of the voxel grid
+
+Parameter ``channel_count``:
+    Number of channels per voxel
+
+Parameter ``data``:
+    Voxel data ordered as ``data[((z*yres + y)*xres + x)*channels +
+    chan]``
+
+Parameter ``background``:
+    Background value per channel (zero if ``nullptr``))doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_SparseVolumeGrid_4 =
+R"doc(Create a sparse grid from a list of active voxels
+
+Parameter ``size``:
+    Resolution of the voxel grid
+
+Parameter ``channel_count``:
+    Number of channels per voxel
+
+Parameter ``coords``:
+    Integer coordinates of the active voxels (``3 * count`` values)
+
+Parameter ``values``:
+    Values of the active voxels (``channel_count * count`` values)
+
+Parameter ``count``:
+    Number of active voxels
+
+Parameter ``background``:
+    Background value per channel (zero if ``nullptr``))doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_background = R"doc(Return the background value (one entry per channel))doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_bbox = R"doc(Return the bounding box of the grid data)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_bbox_transform =
+R"doc(Estimates the transformation from a unit axis-aligned bounding box to
+the given one.)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_buffer_size = R"doc(Return the size in bytes of the node tables and voxel values)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_channel_count = R"doc(Return the number of channels)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_child_offset =
+R"doc(Index of a voxel within a leaf, or of a child within an internal node
+
+Follows the NanoVDB convention, where the ``x`` coordinate varies the
+slowest.
+
+Parameter ``log2``:
+    Log2 of the number of children per axis of the node
+
+Parameter ``span_log2``:
+    Log2 of the number of voxels per axis covered by a child)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_class = R"doc()doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_init = R"doc(Allocate an empty tree)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_leaf_count = R"doc(Return the number of leaf nodes)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_lower = R"doc(Return the child tables of all lower nodes (indices of leaf nodes))doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_lower_count = R"doc(Return the number of lower internal nodes)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_m_background = R"doc()doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_m_bbox = R"doc()doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_m_channel_count = R"doc()doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_m_lower = R"doc()doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_m_max = R"doc()doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_m_max_per_channel = R"doc()doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_m_node_max = R"doc()doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_m_node_min = R"doc()doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_m_root = R"doc()doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_m_root_size = R"doc()doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_m_size = R"doc()doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_m_upper = R"doc()doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_m_values = R"doc()doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_max = R"doc(Return the maximum over the volume grid)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_max_per_channel =
+R"doc(Return the maximum over the volume grid per channel
+
+Pointer allocation/deallocation must be performed by the caller.)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_max_per_channel_2 =
+R"doc(Conservative per-channel maximum over a region of voxels
+
+The region spans the voxels from ``min`` to ``max`` (inclusive). The
+bound is computed from the per-node statistics and is tight for nodes
+that are fully contained in the region.
+
+Pointer allocation/deallocation must be performed by the caller.)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_node_max = R"doc(Return the per-channel maximum of the nodes of a given level (see node_min()))doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_node_min =
+R"doc(Return the per-channel minimum of the nodes of a given level
+
+Parameter ``level``:
+    0 for leaf nodes, 1 for lower and 2 for upper internal nodes. The
+    result holds ``channel_count()`` entries per node.)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_read = R"doc()doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_region_max = R"doc(Per-channel bound over a region within a node (see max_per_channel()))doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_root = R"doc(Return the root table (indices of upper nodes))doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_root_size = R"doc(Return the resolution of the root table)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_size = R"doc(Return the resolution of the voxel grid)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_to_string = R"doc(Return a human-readable summary of this sparse grid)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_touch_leaf = R"doc(Return the index of the leaf containing a voxel, creating it if needed)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_update_bounds = R"doc(Compute the per-node statistics)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_upper = R"doc(Return the child tables of all upper nodes (indices of lower nodes))doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_upper_count = R"doc(Return the number of upper internal nodes)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_values = R"doc(Return the voxel values of all leaf nodes)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_voxel =
+R"doc(Look up the values of a voxel
+
+Returns a pointer to ``channel_count()`` values, which refers to the
+background if the voxel isn't stored.)doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_write =
+R"doc(Write an encoded form of the sparse grid to a binary file
+
+Parameter ``path``:
+    Target file name (expected to end in ".svol"))doc";
+
+static const char *__doc_mitsuba_SparseVolumeGrid_write_2 =
+R"doc(Write an encoded form of the sparse grid to a stream
+
+Parameter ``stream``:
+    Target stream that will receive the encoded output)doc";
+
 static const char *__doc_mitsuba_Spectrum =
 R"doc(//! @{ \name Data types for spectral quantities with sampled
 wavelengths)doc";
@@ -8275,8 +9081,12 @@ static const char *__doc_mitsuba_Spiral_m_mutex = R"doc()doc";
 
 static const char *__doc_mitsuba_Spiral_m_offset = R"doc()doc";
 
+static const char *__doc_mitsuba_Spiral_m_passes = R"doc()doc";
+
 static const char *__doc_mitsuba_Spiral_m_passes_left = R"doc()doc";
 
+static const char *__doc_mitsuba_Spiral_m_scanline = R"doc()doc";
+
 static const char *__doc_mitsuba_Spiral_m_position = R"doc()doc";
 
 static const char *__doc_mitsuba_Spiral_m_size = R"doc()doc";
@@ -8296,6 +9106,15 @@ static const char *__doc_mitsuba_Spiral_reset =
 R"doc(Reset the spiral to its initial state. Does not affect the number of
 passes.)doc";
 
+static const char *__doc_mitsuba_Spiral_set_scanline_order =
+R"doc(Generate blocks in scanline order instead of along a spiral
+
+In this mode, blocks are generated row by row, and all passes of a
+block are generated consecutively before moving on to the next block.
+This ensures that image regions are completed in order, which is
+required by films that stream their output to disk. Must be called
+before the first call to next_block().)doc";
+
 static const char *__doc_mitsuba_Stream =
 R"doc(Abstract seekable stream class
 
@@ -9724,6 +10543,90 @@ static const char *__doc_mitsuba_Thread_wait_for_tasks = R"doc(Wait for previous
 
 static const char *__doc_mitsuba_Thread_yield = R"doc(Yield to another processor)doc";
 
+static const char *__doc_mitsuba_TiledEXRWriter =
+R"doc(Incrementally writes a tiled OpenEXR file
+
+This class creates a tiled OpenEXR image (single resolution level,
+random tile order) and streams individual tiles to disk as soon as they
+become available. This makes it possible to produce images that exceed
+the amount of available memory, since only the tiles that are
+currently being worked on must be stored.
+
+All tiles must share the pixel format, component format, and channel
+names of the prototype bitmap that is passed to the constructor. Tiles
+that were never written are filled with zeros by close().
+
+The write_tile() function is thread-safe.)doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_TiledEXRWriter =
+R"doc(Create a new tiled OpenEXR file
+
+Parameter ``filename``:
+    Path of the output file
+
+Parameter ``size``:
+    Resolution of the complete image
+
+Parameter ``tile_size``:
+    Size of the (square) tiles in pixels
+
+Parameter ``prototype``:
+    Bitmap that specifies the pixel format, component format, channel
+    names, and metadata of the output file. Its contents are ignored.)doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_TiledEXRWriterPrivate = R"doc()doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_class = R"doc()doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_close = R"doc(Fill in missing tiles and close the file. Further writes raise an error.)doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_closed = R"doc(Has the file been closed?)doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_d = R"doc()doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_filename = R"doc(Return the path of the output file)doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_m_filename = R"doc()doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_m_mutex = R"doc()doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_m_pixel_format = R"doc()doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_m_size = R"doc()doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_m_struct = R"doc()doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_m_tile_size = R"doc()doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_m_tiles = R"doc()doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_m_tiles_written = R"doc()doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_m_written = R"doc()doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_size = R"doc(Return the resolution of the complete image)doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_tile_count = R"doc(Return the number of tiles in the file)doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_tile_size = R"doc(Return the size of the (square) tiles in pixels)doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_tiles_written = R"doc(Return the number of tiles written so far)doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_to_string = R"doc(Return a string representation)doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_write_tile =
+R"doc(Write a tile to the file
+
+Parameter ``offset``:
+    Position of the top left corner of the tile in pixels. Must be a
+    multiple of the tile size.
+
+Parameter ``tile``:
+    Tile contents. Its size must equal the tile size, except for tiles
+    on the right and bottom boundary of the image, which are clipped.)doc";
+
+static const char *__doc_mitsuba_TiledEXRWriter_write_tile_nolock = R"doc(Write a tile without acquiring the lock)doc";
+
 static const char *__doc_mitsuba_Timer = R"doc()doc";
 
 static const char *__doc_mitsuba_Timer_Timer = R"doc()doc";
@@ -9738,6 +10641,38 @@ static const char *__doc_mitsuba_Timer_start = R"doc()doc";
 
 static const char *__doc_mitsuba_Timer_value = R"doc()doc";
 
+static const char *__doc_mitsuba_Tracer =
+R"doc(Built-in timeline recorder that exports Chrome trace JSON
+
+When recording is enabled, the coarse profiler phases (scene
+initialization, geometry and bitmap I/O, acceleration data structure
+construction, and rendering) as well as regions marked with
+ScopedTraceEvent (e.g. the instantiation of individual objects) are
+recorded with their start time, duration, and thread. Fine-grained
+phases like ProfilerPhase::BSDFEvaluate are not recorded.
+
+Every thread appends events to its own buffer without any
+synchronization. The events are written when stop() is called or at
+shutdown, using the Trace Event format that is understood by
+``chrome://tracing`` and ``ui.perfetto.dev``.
+
+Recording can also be enabled by setting the environment variable
+``MI_TRACE_FILE`` to the path of the output file.)doc";
+
+static const char *__doc_mitsuba_Tracer_enabled = R"doc(Is recording currently enabled?)doc";
+
+static const char *__doc_mitsuba_Tracer_m_enabled = R"doc()doc";
+
+static const char *__doc_mitsuba_Tracer_record = R"doc(Record an event that started at time ``start`` and ends now)doc";
+
+static const char *__doc_mitsuba_Tracer_record_2 = R"doc(Variant of record() for names that aren't known at compile time)doc";
+
+static const char *__doc_mitsuba_Tracer_start = R"doc(Start recording events that will be written to ``filename``)doc";
+
+static const char *__doc_mitsuba_Tracer_stop = R"doc(Stop recording and write the events recorded so far)doc";
+
+static const char *__doc_mitsuba_Tracer_timestamp = R"doc(Return the current time in nanoseconds)doc";
+
 static const char *__doc_mitsuba_Transform =
 R"doc(Encapsulates a 4x4 homogeneous coordinate transformation along with
 its inverse transpose
@@ -11537,6 +12472,24 @@ Parameter ``cos_theta_t``:
 Parameter ``eta_ti``:
     Relative index of refraction (transmitted / incident))doc";
 
+static const char *__doc_mitsuba_sample_pcg4d =
+R"doc(Counter-based hash function mapping four 32-bit integers to four
+uniformly distributed 32-bit integers
+
+This is the ``pcg4d`` function from "Hash Functions for GPU Rendering"
+by Mark Jarzynski and Marc Olano (JCGT 2020). In contrast to a random
+number generator, it has no state: each output only depends on the
+inputs (e.g. a pixel index, sample index, dimension, and seed), which
+makes it suitable for generating random numbers in very large
+wavefronts. It is considerably cheaper than sample_tea_32() while
+passing the same statistical tests.
+
+Parameter ``v0``:
+    Input values to be hashed
+
+Returns:
+    Four uniformly distributed 32-bit integers)doc";
+
 static const char *__doc_mitsuba_sample_rgb_spectrum =
 R"doc(Importance sample a "importance spectrum" that concentrates the
 computation on wavelengths that are relevant for rendering of RGB data
@@ -12337,6 +13290,12 @@ static const char *__doc_mitsuba_util_library_path = R"doc(Return the absolute p
 
 static const char *__doc_mitsuba_util_mem_string = R"doc(Turn a memory size into a human-readable string)doc";
 
+static const char *__doc_mitsuba_util_peak_memory_usage =
+R"doc(Determine the peak resident set size of the process (in bytes), or 0
+if unknown)doc";
+
+static const char *__doc_mitsuba_util_physical_memory = R"doc(Determine the amount of physical memory (in bytes), or 0 if unknown)doc";
+
 static const char *__doc_mitsuba_util_terminal_width = R"doc(Determine the width of the terminal window that is used to run Mitsuba)doc";
 
 static const char *__doc_mitsuba_util_time_string =
@@ -12421,6 +13380,21 @@ static const char *__doc_mitsuba_warp_interval_to_tent = R"doc(Warp a uniformly
 
 static const char *__doc_mitsuba_warp_linear_to_interval = R"doc(Inverse of interval_to_linear)doc";
 
+static const char *__doc_mitsuba_warp_spherical_rectangle_solid_angle =
+R"doc(Solid angle of a rectangle as seen from a reference point
+
+The rectangle is specified by the offset ``o`` from the reference
+point to one of its corners and by two orthogonal edge vectors ``ex``
+and ``ey``.)doc";
+
+static const char *__doc_mitsuba_warp_spherical_triangle_solid_angle =
+R"doc(Solid angle of a spherical triangle
+
+The triangle is specified by unit vectors ``a``, ``b``, and ``c`` that
+point to its vertices. Based on "The Solid Angle of a Plane Triangle"
+by A. van Oosterom and J. Strackee, which remains accurate for small
+triangles.)doc";
+
 static const char *__doc_mitsuba_warp_square_to_beckmann = R"doc(Warp a uniformly distributed square sample to a Beckmann distribution)doc";
 
 static const char *__doc_mitsuba_warp_square_to_beckmann_pdf = R"doc(Probability density of square_to_beckmann())doc";
@@ -12507,6 +13481,30 @@ normals ``n1`` and ``n2``.)doc";
 
 static const char *__doc_mitsuba_warp_square_to_uniform_spherical_lune_pdf = R"doc(Density of square_to_uniform_spherical_lune() w.r.t. solid angles)doc";
 
+static const char *__doc_mitsuba_warp_square_to_uniform_spherical_rectangle =
+R"doc(Uniformly sample the solid angle subtended by a rectangle
+
+The rectangle is specified by the offset ``o`` from the reference
+point to one of its corners and by two orthogonal edge vectors ``ex``
+and ``ey``. Unlike the other warping functions, this function returns
+the offset from the reference point to the sampled point on the
+rectangle (i.e., an unnormalized direction).
+
+Based on "An Area-Preserving Parametrization for Spherical Rectangles"
+by Carlos Ureña, Marcos Fajardo, and Alan King.)doc";
+
+static const char *__doc_mitsuba_warp_square_to_uniform_spherical_rectangle_pdf = R"doc(Density of square_to_uniform_spherical_rectangle() w.r.t. solid angles)doc";
+
+static const char *__doc_mitsuba_warp_square_to_uniform_spherical_triangle =
+R"doc(Uniformly sample a direction within a spherical triangle with respect
+to solid angles
+
+The triangle is specified by unit vectors ``a``, ``b``, and ``c`` that
+point to its vertices. Based on "Stratified Sampling of Spherical
+Triangles" by James Arvo.)doc";
+
+static const char *__doc_mitsuba_warp_square_to_uniform_spherical_triangle_pdf = R"doc(Density of square_to_uniform_spherical_triangle() w.r.t. solid angles)doc";
+
 static const char *__doc_mitsuba_warp_square_to_uniform_square_concentric =
 R"doc(Low-distortion concentric square to square mapping (meant to be used
 in conjunction with another warping method that maps to the sphere))doc";
@@ -154,6 +154,41 @@ inline py::module_ create_submodule(py::module_ &m, const char *name) {
     return module;
 }
 
+/**
+ * \brief Return a NumPy view of \c value if it holds an array in host memory
+ *
+ * NumPy arrays are returned as-is and objects implementing the DLPack protocol
+ * for CPU memory (e.g. PyTorch tensors) are wrapped without copying. Returns
+ * \c None for Dr.Jit arrays, for anything else, and when NumPy is not
+ * installed.
+ */
+inline py::object host_array_view(py::handle value) {
+    // Only plain values reach this point; don't import NumPy for them
+    if (!py::hasattr(value, "__array_interface__") &&
+        !py::hasattr(value, "__dlpack__"))
+        return py::none();
+
+    py::module_ np;
+    try {
+        np = py::module_::import("numpy");
+    } catch (const py::error_already_set &) {
+        return py::none(); // NumPy is an optional dependency
+    }
+
+    if (py::isinstance(value, np.attr("ndarray")))
+        return py::reinterpret_borrow<py::object>(value);
+
+    if (!py::hasattr(value, "__dlpack__") ||
+        py::isinstance(value, py::module_::import("drjit").attr("ArrayBase")))
+        return py::none();
+
+    try {
+        return np.attr("from_dlpack")(value);
+    } catch (const py::error_already_set &) {
+        return py::none(); // E.g. device memory or an older NumPy version
+    }
+}
+
 template <typename Array> void bind_drjit_ptr_array(py::class_<Array> &cls) {
     using Type = std::decay_t<std::remove_pointer_t<dr::value_t<Array>>>;
     using UInt32 = dr::uint32_array_t<Array>;
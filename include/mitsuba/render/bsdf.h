@@ -569,6 +569,31 @@ public:
     /// Set a string identifier
     void set_id(const std::string& id) override { m_id = id; };
 
+    /**
+     * \brief Fuse a chain of adapter BSDFs into a single BSDF
+     *
+     * Material stacks such as <tt>twosided(normalmap(bumpmap(mask(...))))</tt>
+     * normally perform one virtual function call per adapter and query. This
+     * function collapses chains of the \c twosided (with a single nested
+     * material), \c normalmap, \c bumpmap, and \c mask adapters into a single
+     * object that applies the frame perturbations of all adapters inline
+     * before dispatching to the innermost BSDF. The result is identical to
+     * that of the original chain, and the parameters exposed via \ref
+     * traverse() are unchanged.
+     *
+     * Returns \c bsdf itself when it does not contain at least two adapters.
+     */
+    static ref<BSDF> flatten(BSDF *bsdf);
+
+    /**
+     * \brief Separate the opacity texture from a \c mask BSDF
+     *
+     * When \c bsdf is an instance of the \c mask plugin, this function
+     * returns its nested BSDF and its opacity texture. Otherwise, it returns
+     * \c bsdf and \c nullptr.
+     */
+    static std::pair<ref<BSDF>, ref<Texture>> split_opacity(BSDF *bsdf);
+
     /**
      * \brief Evaluate the diffuse reflectance
      *
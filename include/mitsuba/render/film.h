@@ -137,6 +137,33 @@ public:
                                          bool normalize = false,
                                          bool border = false) = 0;
 
+    /**
+     * \brief Inform the film about the block decomposition of the next render
+     *
+     * This function is invoked by the CPU rendering code path of sampling
+     * integrators before any image blocks are submitted via \ref put_block().
+     * Films that stream finished image regions to disk use this information
+     * to determine when a region has received all of its contributions. The
+     * default implementation does nothing.
+     *
+     * \param block_size
+     *     Size of the (square) image blocks in pixels, excluding the border
+     *
+     * \param passes
+     *     Number of times that every block will be submitted
+     */
+    virtual void prepare_blocks(uint32_t block_size, uint32_t passes);
+
+    /**
+     * \brief Should image blocks be rendered in scanline order?
+     *
+     * When this function returns \c true, the integrator generates image
+     * blocks row by row (instead of following a spiral) and renders all
+     * passes of a block before moving on to the next one, so that image
+     * regions complete in order. The default implementation returns \c false.
+     */
+    virtual bool scanline_order() const;
+
     // =============================================================
     //! @{ \name Accessor functions
     // =============================================================
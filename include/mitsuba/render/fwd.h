@@ -29,6 +29,7 @@ template <typename Float, typename Spectrum> class ProjectiveCamera;
 template <typename Float, typename Spectrum> class Shape;
 template <typename Float, typename Spectrum> class ShapeGroup;
 template <typename Float, typename Spectrum> class ShapeKDTree;
+template <typename Float, typename Spectrum> class SparseVolumeGrid;
 template <typename Float, typename Spectrum> class Texture;
 template <typename Float, typename Spectrum> class Volume;
 template <typename Float, typename Spectrum> class VolumeGrid;
@@ -97,6 +98,7 @@ template <typename Float_, typename Spectrum_> struct RenderAliases {
     using Texture                = mitsuba::Texture<FloatU, SpectrumU>;
     using Volume                 = mitsuba::Volume<FloatU, SpectrumU>;
     using VolumeGrid             = mitsuba::VolumeGrid<FloatU, SpectrumU>;
+    using SparseVolumeGrid       = mitsuba::SparseVolumeGrid<FloatU, SpectrumU>;
 
     using MeshAttribute          = mitsuba::MeshAttribute<FloatU, SpectrumU>;
 
@@ -317,10 +317,46 @@ protected:
     /// Virtual destructor
     virtual ~Integrator() { }
 
+    /**
+     * \brief Estimate the amount of memory (in bytes) that each lane of a
+     * wavefront occupies while rendering in a JIT variant
+     *
+     * The estimate accounts for per-lane state that is stored in memory
+     * between kernel launches (e.g. the sampler state), and for the loop
+     * state that is written to memory when loops are not recorded (wavefront
+     * mode).
+     *
+     * \param n_channels
+     *     Number of channels written to the image block by every sample
+     */
+    virtual size_t wavefront_sample_footprint(size_t n_channels) const;
+
+    /**
+     * \brief Determine the number of samples per pixel rendered by a single
+     * wavefront (JIT variants)
+     *
+     * Returns the largest divisor of \c spp_per_pass, such that a wavefront
+     * with \c pixel_count pixels neither exceeds the limit of 2^32 lanes, nor
+     * the memory budget (see \ref m_memory_budget) given the per-lane
+     * footprint estimated by \ref wavefront_sample_footprint().
+     */
+    uint32_t wavefront_samples_per_pass(size_t pixel_count,
+                                        uint32_t spp_per_pass,
+                                        size_t n_channels) const;
+
 protected:
     /// Integrators should stop all work when this flag is set to true.
     bool m_stop;
 
+    /**
+     * \brief Memory budget for the wavefront of a JIT rendering pass (in bytes)
+     *
+     * Larger rendering tasks are split into several passes. A value of zero
+     * means that half of the physical memory is used in LLVM variants, and
+     * that no budget is enforced in CUDA variants.
+     */
+    size_t m_memory_budget;
+
     /**
      * \brief Maximum amount of time to spend rendering (excluding scene parsing).
      *
@@ -349,7 +385,8 @@ template <typename Float, typename Spectrum>
 class MI_EXPORT_LIB SamplingIntegrator : public Integrator<Float, Spectrum> {
 public:
     MI_IMPORT_BASE(Integrator, should_stop, aov_names,
-                    m_stop, m_timeout, m_render_timer, m_hide_emitters)
+                    wavefront_samples_per_pass, m_stop, m_timeout,
+                    m_render_timer, m_hide_emitters)
     MI_IMPORT_TYPES(Scene, Sensor, Film, ImageBlock, Medium, Sampler)
 
     /**
@@ -417,6 +454,15 @@ protected:
     SamplingIntegrator(const Properties &props);
     virtual ~SamplingIntegrator();
 
+    /**
+     * \brief Render a block of the image (scalar variants)
+     *
+     * This is invoked by \ref render() for every block of the spiral. The
+     * default implementation claims the pixels of the block in small chunks,
+     * which allows threads that ran out of blocks to help with the remaining
+     * pixels. Overriding implementations are still called for every block,
+     * but their blocks are never split in this way.
+     */
     virtual void render_block(const Scene *scene,
                               const Sensor *sensor,
                               Sampler *sampler,
@@ -427,6 +473,29 @@ protected:
                               uint32_t block_id,
                               uint32_t block_size) const;
 
+    /**
+     * \brief Render the pixels of a block with Morton indices in
+     * <tt>[pixel_begin, pixel_end)</tt>
+     *
+     * The samples of each pixel are seeded based on the block ID and the
+     * Morton index of the pixel, which allows several threads to render
+     * disjoint pixel ranges of the same block (into separate image blocks)
+     * with the same samples. This is used by \ref render_block() and
+     * \ref render() to split the remaining blocks at the end of a render.
+     * Contrary to \ref render_block(), the image block is not cleared.
+     */
+    virtual void render_block_pixels(const Scene *scene,
+                                     const Sensor *sensor,
+                                     Sampler *sampler,
+                                     ImageBlock *block,
+                                     Float *aovs,
+                                     uint32_t sample_count,
+                                     uint32_t seed,
+                                     uint32_t block_id,
+                                     uint32_t block_size,
+                                     uint32_t pixel_begin,
+                                     uint32_t pixel_end) const;
+
     void render_sample(const Scene *scene,
                        const Sensor *sensor,
                        Sampler *sampler,
@@ -492,7 +561,8 @@ protected:
 template <typename Float, typename Spectrum>
 class MI_EXPORT_LIB AdjointIntegrator : public Integrator<Float, Spectrum> {
 public:
-    MI_IMPORT_BASE(Integrator, should_stop, aov_names, m_stop, m_timeout,
+    MI_IMPORT_BASE(Integrator, should_stop, aov_names,
+                    wavefront_samples_per_pass, m_stop, m_timeout,
                     m_render_timer, m_hide_emitters)
     MI_IMPORT_TYPES(Scene, Sensor, Film, BSDF, BSDFPtr, ImageBlock, Sampler,
                      EmitterPtr)
@@ -53,6 +53,26 @@ enum class RayFlags : uint32_t {
     /// Derivatives of the SurfaceInteraction fields ignore shape's motion
     DetachShape = 0x100,
 
+    // =============================================================
+    //!                  Ray visibility flags
+    // =============================================================
+
+    /// Only intersect shapes that are visible to camera rays
+    CameraRay = 0x200,
+
+    /// Only intersect shapes that cast shadows
+    ShadowRay = 0x400,
+
+    /// Only intersect shapes that are visible to diffuse (non-delta) indirect rays
+    DiffuseRay = 0x800,
+
+    /// Only intersect shapes that are visible to specular (delta) indirect rays
+    SpecularRay = 0x1000,
+
+    /* \brief Combination of all ray visibility flags. When none of them are
+       set, rays intersect all shapes */
+    RayTypes = CameraRay | ShadowRay | DiffuseRay | SpecularRay,
+
     // =============================================================
     //!                 Compound compute flags
     // =============================================================
@@ -239,7 +259,7 @@ struct SurfaceInteraction : Interaction<Float_, Spectrum_> {
                                 const Wavelength &wavelengths)
         : Base(0.f, ps.time, wavelengths, ps.p, ps.n), uv(ps.uv),
           sh_frame(Frame3f(ps.n)), dp_du(0), dp_dv(0), dn_du(0), dn_dv(0),
-          duv_dx(0), duv_dy(0), wi(0), prim_index(0) {}
+          duv_dx(0), duv_dy(0), wi(0), prim_index(ps.prim_index) {}
 
     /// Initialize local shading frame using Gram-schmidt orthogonalization
     void initialize_sh_frame() {
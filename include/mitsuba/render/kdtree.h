@@ -9,6 +9,7 @@
 #include <mitsuba/core/logger.h>
 #include <mitsuba/core/math.h>
 #include <mitsuba/core/object.h>
+#include <mitsuba/core/profiler.h>
 #include <mitsuba/core/ray.h>
 #include <mitsuba/core/timer.h>
 #include <mitsuba/core/util.h>
@@ -1882,6 +1883,7 @@ protected:
             Log(m_log_level, "Creating a preliminary index list (%s)",
                 util::mem_string(prim_count * sizeof(Index)).c_str());
 
+            ScopedTraceEvent trace("kdtree", "kd-tree: build nodes");
             IndexVector indices(prim_count);
             for (size_t i = 0; i < prim_count; ++i)
                 indices[i] = (Index) i;
@@ -1897,6 +1899,7 @@ protected:
         /*     Store the node and index lists in a compact contiguous format    */
         /* ==================================================================== */
 
+        ScopedTraceEvent trace_compact("kdtree", "kd-tree: compact storage");
         m_node_count  = (Index) ctx.node_storage.size();
         m_index_count = (Index) ctx.index_storage.size();
 
@@ -2186,17 +2189,18 @@ public:
 
     template <bool ShadowRay>
     MI_INLINE PreliminaryIntersection3f ray_intersect_preliminary(const Ray3f &ray,
-                                                                   Mask active) const {
+                                                                   Mask active,
+                                                                   uint32_t ray_flags = 0) const {
         DRJIT_MARK_USED(active);
         if constexpr (!dr::is_array_v<Float>)
-            return ray_intersect_scalar<ShadowRay>(ray);
+            return ray_intersect_scalar<ShadowRay>(ray, ray_flags);
         else
             Throw("kdtree should only be used in scalar mode");
     }
 
     template <bool ShadowRay>
     MI_INLINE PreliminaryIntersection<ScalarFloat, Shape>
-    ray_intersect_scalar(ScalarRay3f ray) const {
+    ray_intersect_scalar(ScalarRay3f ray, uint32_t ray_flags = 0) const {
         /// Ray traversal stack entry
         struct KDStackEntry {
             // Ray distance associated with the node entry and exit point
@@ -2220,9 +2224,17 @@ public:
 
         ScalarVector3f d_rcp = dr::rcp(ray.d);
 
+        // Number of visited inner nodes (see \ref CostCounters)
+        uint64_t steps = 0;
+        auto count_steps = [&]() {
+            if (unlikely(CostCounters::enabled()))
+                CostCounters::local().traversal_steps += steps;
+        };
+
         const KDNode *node = m_nodes.get();
         while (mint <= maxt) {
             if (likely(!node->leaf())) { // Inner node
+                steps++;
                 const ScalarFloat split = node->split();
                 const uint32_t axis     = node->axis();
 
@@ -2265,11 +2277,13 @@ public:
                     Index prim_index = m_indices[i];
 
                     PreliminaryIntersection<ScalarFloat, Shape> prim_pi =
-                        intersect_prim<ShadowRay>(prim_index, ray);
+                        intersect_prim<ShadowRay>(prim_index, ray, ray_flags);
 
                     if (unlikely(prim_pi.is_valid())) {
-                        if constexpr (ShadowRay)
+                        if constexpr (ShadowRay) {
+                            count_steps();
                             return prim_pi;
+                        }
 
                         Assert(prim_pi.t >= 0.f && prim_pi.t <= ray.maxt);
                         pi = prim_pi;
@@ -2289,6 +2303,7 @@ public:
             }
         }
 
+        count_steps();
         return pi;
     }
 
@@ -2487,13 +2502,52 @@ protected:
      */
     template <bool ShadowRay = false>
     MI_INLINE PreliminaryIntersection<ScalarFloat, Shape>
-    intersect_prim(Index prim_index, const ScalarRay3f &ray) const {
+    intersect_prim(Index prim_index, const ScalarRay3f &ray,
+                   uint32_t ray_flags = 0) const {
         Index shape_index  = find_shape(prim_index);
         const Shape *shape = this->shape(shape_index);
         const Mesh *mesh = (const Mesh *) shape;
 
         PreliminaryIntersection<ScalarFloat, Shape> pi;
 
+        // Skip shapes that are invisible to this type of ray
+        if (unlikely(!shape->is_visible(ray_flags)))
+            return pi;
+
+        if (unlikely(ObjectProfiler::enabled()))
+            ObjectProfiler::record(shape, ProfilerPhase::ShapeIntersect, 0);
+        if (unlikely(CostCounters::enabled()))
+            CostCounters::local().prim_tests++;
+
+        if constexpr (!dr::is_jit_v<Float>) {
+            /* Alpha-tested shapes need the full intersection record. Rejected
+               hits are skipped without leaving the traversal loop. */
+            if (unlikely(shape->alpha_texture())) {
+                ScalarFloat t;
+                ScalarPoint2f prim_uv;
+                bool hit;
+                if (shape->is_mesh()) {
+                    std::tie(t, prim_uv) = mesh->ray_intersect_triangle_scalar(prim_index, ray);
+                    hit = t != dr::Infinity<ScalarFloat> &&
+                          shape->alpha_test_scalar(ray, t, prim_uv, prim_index);
+                } else {
+                    // Analytic shapes continue past rejected hits
+                    std::tie(t, prim_uv) =
+                        shape->ray_intersect_alpha_tested_scalar(ray, prim_index);
+                    hit = t != dr::Infinity<ScalarFloat>;
+                }
+
+                if (hit) {
+                    pi.t           = ShadowRay ? 0.f : t;
+                    pi.prim_uv     = prim_uv;
+                    pi.prim_index  = prim_index;
+                    pi.shape       = shape;
+                    pi.shape_index = shape_index;
+                }
+                return pi;
+            }
+        }
+
         if constexpr (ShadowRay) {
             bool hit;
             if (shape->is_mesh())
@@ -7,7 +7,9 @@
 #include <mitsuba/core/transform.h>
 #include <mitsuba/core/distr_1d.h>
 #include <mitsuba/core/properties.h>
+#include <mitsuba/core/shmem.h>
 #include <unordered_map>
+#include <atomic>
 #include <mutex>
 #include <drjit/dynamic.h>
 
@@ -19,7 +21,8 @@ public:
     MI_IMPORT_TYPES()
     MI_IMPORT_BASE(Shape, m_to_world, mark_dirty, m_emitter, m_sensor, m_bsdf,
                    m_interior_medium, m_exterior_medium, m_is_instance,
-                   m_discontinuity_types, m_shape_type, m_initialized)
+                   m_discontinuity_types, m_shape_type, m_initialized,
+                   SolidAngleSamplingMin, SolidAngleSamplingMax)
 
     // Mesh is always stored in single precision
     using InputFloat = float;
@@ -83,6 +86,24 @@ public:
     /// Const variant of \ref faces_buffer.
     const DynamicBuffer<UInt32>& faces_buffer() const { return m_faces; }
 
+    /**
+     * \brief Replace the vertex positions and faces (and optionally the
+     * texture coordinates) of the mesh
+     *
+     * The given buffers are adopted without copying them, after which all
+     * derived data (bounding box, vertex normals, sampling tables, ...) is
+     * updated as in \ref parameters_changed(). An empty texture coordinate
+     * buffer leaves the current one untouched. This is the fast path for
+     * meshes whose geometry is generated outside of Mitsuba: the Python
+     * bindings load host arrays (NumPy, PyTorch, ...) in a single copy and
+     * call this method without holding the GIL.
+     *
+     * As with \c mi.traverse(), a scene containing this mesh must be
+     * notified afterwards via \ref Scene::parameters_changed().
+     */
+    void set_buffers(FloatStorage vertex_positions, DynamicBuffer<UInt32> faces,
+                     FloatStorage vertex_texcoords = FloatStorage());
+
     /// Return the mesh attribute associated with \c name
     FloatStorage& attribute_buffer(const std::string& name) {
         auto attribute = m_mesh_attributes.find(name);
@@ -208,6 +229,27 @@ public:
 
     Float pdf_position(const PositionSample3f &ps, Mask active = true) const override;
 
+    /**
+     * \brief Sample a direction towards the mesh
+     *
+     * A triangle is chosen proportionally to its surface area, and a direction
+     * is then sampled uniformly within the solid angle that it subtends from
+     * the reference position. Triangles that are distant or tiny as seen from
+     * the reference position revert to area sampling.
+     */
+    DirectionSample3f sample_direction(const Interaction3f &it,
+                                       const Point2f &sample,
+                                       Mask active = true) const override;
+
+    /**
+     * \brief Query the probability density of \ref sample_direction()
+     *
+     * The density depends on the triangle containing the sampled position,
+     * which is given by \ref PositionSample::prim_index.
+     */
+    Float pdf_direction(const Interaction3f &it, const DirectionSample3f &ds,
+                        Mask active = true) const override;
+
     Point3f barycentric_coordinates(const SurfaceInteraction3f &si,
                                     Mask active = true) const;
 
@@ -261,6 +303,17 @@ public:
                                                      Float sample2,
                                                      Mask active = true) const override;
 
+    /**
+     * \brief Return the directed edges that lie on the silhouette of the mesh
+     * as seen from \c viewpoint
+     *
+     * This is a convenience wrapper around \ref precompute_silhouette() that
+     * drops the sampling weights. Each edge is reported once (by its smaller
+     * directed edge index) and boundary edges are always included. The
+     * returned indices can be passed to \ref sample_precomputed_silhouette().
+     */
+    DynamicBuffer<UInt32> silhouette_edges(const ScalarPoint3f &viewpoint) const;
+
     //! @}
     // =============================================================
 
@@ -374,6 +427,32 @@ protected:
     inline Mesh() {}
     virtual ~Mesh();
 
+    /**
+     * \brief Initialize the mesh buffers from the node-level shared memory
+     * cache (see \ref SharedMemoryRegion)
+     *
+     * Returns \c false when the cache contains no entry for \c key. The
+     * caller must subsequently invoke \ref initialize().
+     */
+    bool load_from_shared_cache(const std::string &key);
+
+    /**
+     * \brief Publish the mesh buffers to the node-level shared memory cache
+     *
+     * On success, the mesh subsequently references the published buffers.
+     * Meshes with custom attributes are not cached.
+     */
+    void publish_to_shared_cache(const std::string &key);
+
+    /**
+     * \brief Return a shared memory cache key for a mesh loaded from \c path
+     *
+     * Besides the file identity, the key accounts for the variant, the
+     * \c to_world transform and loader-specific parameters (\c params).
+     */
+    std::string shared_cache_key(const fs::path &path,
+                                 const std::string &params) const;
+
     /**
      * \brief Build internal tables for sampling uniformly wrt. area.
      *
@@ -382,6 +461,16 @@ protected:
      */
     void build_pmf();
 
+    /**
+     * \brief Create a position sample for the point with barycentric
+     * coordinates \c b on the face \c face_idx
+     *
+     * The \c pdf field of the returned record is left at zero.
+     */
+    PositionSample3f triangle_position_sample(Float time, const Index &face_idx,
+                                              const Point2f &b,
+                                              Mask active) const;
+
     /**
      * /brief Build directed edge data structure to efficiently access adjacent
      * edges.
@@ -403,6 +492,37 @@ protected:
      */
     void build_indirect_silhouette_distribution();
 
+    /**
+     * \brief Build (or refit) the bounding volume hierarchy over the edges of
+     * the mesh that accelerates \ref precompute_silhouette().
+     *
+     * Every node stores the bounding box of its edges along with a cone that
+     * bounds the normals of all faces adjacent to them. For a given viewpoint,
+     * this is sufficient to conservatively reject subtrees where all of these
+     * faces are either front- or back-facing, and which therefore cannot
+     * contain silhouette edges.
+     *
+     * The hierarchy is rebuilt from scratch when the topology changed and is
+     * otherwise only refitted to the current vertex positions. The directed
+     * edge data structure is created on demand.
+     */
+    void build_silhouette_bvh();
+
+    /**
+     * \brief Ensures that the silhouette edge hierarchy is ready and up to date
+     *
+     * Uses double-checked locking: \ref build_silhouette_bvh() checks the
+     * flag again while holding the mutex.
+     */
+    DRJIT_INLINE void ensure_silhouette_bvh_built() const {
+        if (unlikely(m_sil_bvh_dirty.load(std::memory_order_acquire)))
+            const_cast<Mesh *>(this)->build_silhouette_bvh();
+    }
+
+    /// Silhouette query that traverses the edge hierarchy (CPU variants only)
+    std::tuple<DynamicBuffer<UInt32>, DynamicBuffer<Float>>
+    precompute_silhouette_bvh(const ScalarPoint3f &viewpoint) const;
+
     /**
      * \brief Initialize the \c m_parameterization field for mapping UV
      * coordinates to positions
@@ -471,6 +591,24 @@ protected:
         Vertex, Face
     };
 
+    /// Node of the edge hierarchy used by \ref build_silhouette_bvh()
+    struct SilhouetteBVHNode {
+        /// Bounding box of the edge end points
+        ScalarBoundingBox3f bbox;
+        /// Axis of the cone bounding the normals of all adjacent faces
+        ScalarVector3f cone_axis;
+        /// Half-angle of the normal cone (\c Pi if it can't be bounded)
+        ScalarFloat cone_angle;
+        /**
+         * Index of the first edge in \ref m_sil_bvh_edges for leaf nodes,
+         * or index of the right child for interior nodes (the left child
+         * immediately follows its parent)
+         */
+        ScalarIndex offset;
+        /// Number of edges in a leaf node, zero for interior nodes
+        ScalarIndex edge_count;
+    };
+
     struct MeshAttribute {
         size_t size;
         MeshAttributeType type;
@@ -538,6 +676,9 @@ protected:
 
     mutable DynamicBuffer<UInt32> m_faces;
 
+    /// Shared memory region backing the buffers above (scalar variants)
+    ref<SharedMemoryRegion> m_shared_region;
+
     /// Directed edges data structures to support neighbor queries
     mutable DynamicBuffer<UInt32> m_E2E;
     bool m_E2E_outdated = true;
@@ -548,6 +689,18 @@ protected:
     /// Sampling density of silhouette (\ref build_indirect_silhouette_distribution)
     DiscreteDistribution<Float> m_sil_dedge_pmf;
 
+    /// Edge hierarchy for silhouette queries (\ref build_silhouette_bvh)
+    std::vector<SilhouetteBVHNode> m_sil_bvh_nodes;
+    std::vector<ScalarIndex> m_sil_bvh_edges;
+    /// Must the hierarchy be (re)built? Cleared once it is ready.
+    std::atomic<bool> m_sil_bvh_dirty = true;
+
+    /// Use the edge hierarchy for silhouette queries of sufficiently large meshes?
+    bool m_silhouette_bvh = true;
+
+    /// Meshes with fewer faces are always processed by a linear scan
+    constexpr static ScalarSize m_sil_bvh_min_faces = 1024;
+
 #if defined(MI_ENABLE_LLVM) && !defined(MI_ENABLE_EMBREE)
     /* Data pointer to ensure triangle intersection routine doesn't rely on
        drjit-core when called from an LLVM kernel */
@@ -59,6 +59,14 @@ struct PositionSample {
     /// Set if the sample was drawn from a degenerate (Dirac delta) distribution
     Mask delta;
 
+    /**
+     * \brief Optional: index of the primitive containing the sampled position
+     *
+     * Shapes consisting of several primitives (e.g. triangle meshes) use this
+     * to evaluate sampling densities that depend on the primitive.
+     */
+    UInt32 prim_index = 0;
+
     //! @}
     // =============================================================
 
@@ -75,7 +83,7 @@ struct PositionSample {
      */
     PositionSample(const SurfaceInteraction3f &si)
         : p(si.p), n(si.sh_frame.n), uv(si.uv), time(si.time), pdf(0.f),
-          delta(false) { }
+          delta(false), prim_index(si.prim_index) { }
 
     /// Basic field constructor
     PositionSample(const Point3f &p, const Normal3f &n, const Point2f &uv,
@@ -85,7 +93,7 @@ struct PositionSample {
     //! @}
     // =============================================================
 
-    DRJIT_STRUCT(PositionSample, p, n, uv, time, pdf, delta)
+    DRJIT_STRUCT(PositionSample, p, n, uv, time, pdf, delta, prim_index)
 };
 
 // -----------------------------------------------------------------------------
@@ -114,7 +122,7 @@ struct DirectionSample : public PositionSample<Float_, Spectrum_> {
     using Float    = Float_;
     using Spectrum = Spectrum_;
 
-    MI_IMPORT_BASE(PositionSample, p, n, uv, time, pdf, delta)
+    MI_IMPORT_BASE(PositionSample, p, n, uv, time, pdf, delta, prim_index)
     MI_IMPORT_RENDER_BASIC_TYPES()
 
     using Interaction3f        = typename RenderAliases::Interaction3f;
@@ -191,7 +199,7 @@ struct DirectionSample : public PositionSample<Float_, Spectrum_> {
     //! @}
     // =============================================================
 
-    DRJIT_STRUCT(DirectionSample, p, n, uv, time, pdf, delta, d, dist, emitter)
+    DRJIT_STRUCT(DirectionSample, p, n, uv, time, pdf, delta, prim_index, d, dist, emitter)
 };
 
 // -----------------------------------------------------------------------------
@@ -206,6 +214,7 @@ std::ostream &operator<<(std::ostream &os,
        << "  time = " << ps.time << "," << std::endl
        << "  pdf = " << ps.pdf << "," << std::endl
        << "  delta = " << ps.delta << "," << std::endl
+       << "  prim_index = " << ps.prim_index << "," << std::endl
        <<  "]";
     return os;
 }
@@ -220,6 +229,7 @@ std::ostream &operator<<(std::ostream &os,
        << "  time = " << ds.time << "," << std::endl
        << "  pdf = " << ds.pdf << "," << std::endl
        << "  delta = " << ds.delta << "," << std::endl
+       << "  prim_index = " << ds.prim_index << "," << std::endl
        << "  emitter = " << string::indent(ds.emitter) << "," << std::endl
        << "  d = " << string::indent(ds.d, 6) << "," << std::endl
        << "  dist = " << ds.dist << std::endl
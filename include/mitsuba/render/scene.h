@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mitsuba/core/distr_1d.h>
+#include <mitsuba/core/profiler.h>
 #include <mitsuba/core/spectrum.h>
 #include <mitsuba/render/emitter.h>
 #include <mitsuba/render/shapegroup.h>
@@ -115,6 +116,11 @@ public:
      * this). The default, \ref RayFlags::All, propagates derivatives through
      * all steps of the intersection computation.
      *
+     * Finally, the ray visibility flags of \ref RayFlags (\c CameraRay,
+     * \c ShadowRay, \c DiffuseRay, and \c SpecularRay) restrict the
+     * intersection to shapes that are visible to the given types of rays.
+     * Other shapes are skipped during traversal.
+     *
      * The \c coherent flag is a hint that can improve performance in the first
      * step of finding the \ref PreliminaryInteraction if the input set of rays
      * is coherent (e.g., when they are generated by \ref Sensor::sample_ray(),
@@ -145,6 +151,46 @@ public:
                                        Mask coherent,
                                        Mask active = true) const;
 
+    /**
+     * \brief Intersect a ray with the shapes comprising the scene and return a
+     * detailed data structure describing the intersection, if one is found.
+     *
+     * This overload additionally takes a per-lane \c ray_types parameter that
+     * combines the ray visibility flags of \ref RayFlags (\c CameraRay,
+     * \c ShadowRay, \c DiffuseRay, and \c SpecularRay). Unlike the visibility
+     * bits of \c ray_flags, which apply to all rays of the call, it can differ
+     * between the lanes of vectorized variants, e.g. to distinguish diffuse
+     * from specular bounces within a single wavefront. Lanes that don't
+     * specify any visibility flag intersect all shapes. The visibility bits of
+     * \c ray_flags are ignored.
+     *
+     * \param ray
+     *    A 3D ray including maximum extent (\ref Ray::maxt) and time (\ref
+     *    Ray::time) information, which matters when the shapes are in motion
+     *
+     * \param ray_flags
+     *    An integer combining flag bits from \ref RayFlags (merged using
+     *    binary or).
+     *
+     * \param ray_types
+     *    The ray visibility flags of each ray (merged using binary or).
+     *
+     * \param coherent
+     *    Setting this flag to \c true can noticeably improve performance when
+     *    \c ray contains a coherent set of rays (e.g. primary camera rays),
+     *    and when using <tt>llvm_*</tt> variants of the renderer along with
+     *    Embree. It has no effect in scalar or CUDA/OptiX variants.
+     *
+     * \return
+     *    A detailed surface interaction record. Its <tt>is_valid()</tt> method
+     *    should be queried to check if an intersection was actually found.
+     */
+    SurfaceInteraction3f ray_intersect(const Ray3f &ray,
+                                       uint32_t ray_flags,
+                                       const UInt32 &ray_types,
+                                       Mask coherent,
+                                       Mask active) const;
+
     /**
      * \brief Intersect a ray with the shapes comprising the scene and return a
      * boolean specifying whether or not an intersection was found.
@@ -205,7 +251,37 @@ public:
      *
      * \return \c true if an intersection was found
      */
-    Mask ray_test(const Ray3f &ray, Mask coherent, Mask active) const;
+    Mask ray_test(const Ray3f &ray, Mask coherent, Mask active) const {
+        return ray_test(ray, +RayFlags::Empty, coherent, active);
+    }
+
+    /**
+     * \brief Intersect a ray with the shapes comprising the scene and return a
+     * boolean specifying whether or not an intersection was found.
+     *
+     * This overload additionally takes a \c ray_flags parameter. Only its ray
+     * visibility flags (e.g. \ref RayFlags::ShadowRay) are used: when any of
+     * them are set, shapes that are not visible to the specified types of rays
+     * are skipped during traversal.
+     *
+     * \param ray
+     *    A 3D ray including maximum extent (\ref Ray::maxt) and time (\ref
+     *    Ray::time) information, which matters when the shapes are in motion
+     *
+     * \param ray_flags
+     *    An integer combining flag bits from \ref RayFlags (merged using
+     *    binary or).
+     *
+     * \param coherent
+     *    Setting this flag to \c true can noticeably improve performance when
+     *    \c ray contains a coherent set of rays (e.g. primary camera rays),
+     *    and when using <tt>llvm_*</tt> variants of the renderer along with
+     *    Embree. It has no effect in scalar or CUDA/OptiX variants.
+     *
+     * \return \c true if an intersection was found
+     */
+    Mask ray_test(const Ray3f &ray, uint32_t ray_flags, Mask coherent,
+                  Mask active) const;
 
     /**
      * \brief Intersect a ray with the shapes comprising the scene and return
@@ -258,6 +334,22 @@ public:
      */
     PreliminaryIntersection3f ray_intersect_preliminary(const Ray3f &ray,
                                                         Mask coherent = false,
+                                                        Mask active = true) const {
+        return ray_intersect_preliminary(ray, +RayFlags::Empty, coherent, active);
+    }
+
+    /**
+     * \brief Intersect a ray with the shapes comprising the scene and return
+     * preliminary information, if one is found
+     *
+     * This overload additionally takes a \c ray_flags parameter. Only its ray
+     * visibility flags (e.g. \ref RayFlags::CameraRay) are used: when any of
+     * them are set, shapes that are not visible to the specified types of rays
+     * are skipped during traversal.
+     */
+    PreliminaryIntersection3f ray_intersect_preliminary(const Ray3f &ray,
+                                                        uint32_t ray_flags,
+                                                        Mask coherent,
                                                         Mask active = true) const;
 
     /**
@@ -589,18 +681,26 @@ protected:
 
     /// Trace a ray and only return a preliminary intersection data structure
     MI_INLINE PreliminaryIntersection3f ray_intersect_preliminary_cpu(
-        const Ray3f &ray, Mask coherent, Mask active) const;
+        const Ray3f &ray, const UInt32 &ray_types, Mask coherent, Mask active) const;
     MI_INLINE PreliminaryIntersection3f ray_intersect_preliminary_gpu(
-        const Ray3f &ray, Mask active) const;
+        const Ray3f &ray, const UInt32 &ray_types, Mask active) const;
 
     /// Trace a ray
-    MI_INLINE SurfaceInteraction3f ray_intersect_cpu(const Ray3f &ray, uint32_t ray_flags, Mask coherent, Mask active) const;
-    MI_INLINE SurfaceInteraction3f ray_intersect_gpu(const Ray3f &ray, uint32_t ray_flags, Mask active) const;
+    MI_INLINE SurfaceInteraction3f ray_intersect_cpu(const Ray3f &ray, uint32_t ray_flags, const UInt32 &ray_types, Mask coherent, Mask active) const;
+    MI_INLINE SurfaceInteraction3f ray_intersect_gpu(const Ray3f &ray, uint32_t ray_flags, const UInt32 &ray_types, Mask active) const;
     MI_INLINE SurfaceInteraction3f ray_intersect_naive_cpu(const Ray3f &ray, Mask active) const;
 
     /// Trace a shadow ray
-    MI_INLINE Mask ray_test_cpu(const Ray3f &ray, Mask coherent, Mask active) const;
-    MI_INLINE Mask ray_test_gpu(const Ray3f &ray, Mask active) const;
+    MI_INLINE Mask ray_test_cpu(const Ray3f &ray, const UInt32 &ray_types, Mask coherent, Mask active) const;
+    MI_INLINE Mask ray_test_gpu(const Ray3f &ray, const UInt32 &ray_types, Mask active) const;
+
+    /// Count a ray query in scalar variants (see \ref CostCounters)
+    MI_INLINE void count_ray_query() const {
+        if constexpr (!dr::is_jit_v<Float>) {
+            if (unlikely(CostCounters::enabled()))
+                CostCounters::local().ray_queries++;
+        }
+    }
 
     using ShapeKDTree = mitsuba::ShapeKDTree<Float, Spectrum>;
 
@@ -797,6 +797,86 @@ public:
     /// Return the shape's BSDF
     BSDF *bsdf(Mask /*unused*/ = true) { return m_bsdf.get(); }
 
+    /// Replace the shape's BSDF
+    void set_bsdf(BSDF *bsdf);
+
+    /**
+     * \brief Return the ray types that can intersect this shape
+     *
+     * The result combines the ray visibility flags of \ref RayFlags (i.e.,
+     * \c CameraRay, \c ShadowRay, \c DiffuseRay, and \c SpecularRay).
+     */
+    uint32_t ray_visibility() const { return m_ray_visibility; }
+
+    /**
+     * \brief Can rays traced with the given \ref RayFlags intersect this shape?
+     *
+     * Rays that don't specify any ray visibility flag intersect all shapes.
+     */
+    bool is_visible(uint32_t ray_flags) const {
+        uint32_t ray_types = ray_flags & (uint32_t) RayFlags::RayTypes;
+        return ray_types == 0 || (m_ray_visibility & ray_types) != 0;
+    }
+
+    /// Return the opacity texture used to alpha-test intersections (if any)
+    const Texture *alpha_texture() const { return m_alpha_texture.get(); }
+
+    /**
+     * \brief Set an opacity texture that is used to alpha-test intersections
+     * during ray traversal
+     *
+     * This is only supported by the scalar variants, whose ray tracing
+     * backends (kd-tree and Embree) call \ref alpha_test_scalar() for every
+     * candidate intersection with this shape.
+     */
+    void set_alpha_texture(Texture *texture);
+
+    /**
+     * \brief Stochastically decide whether a candidate intersection is kept
+     *
+     * The opacity texture is evaluated at the intersection, and the hit is
+     * kept with a probability equal to the opacity. The decision uses a hash
+     * of the ray, distance, and primitive index, hence it is deterministic.
+     *
+     * \param ray
+     *     The ray in world space
+     *
+     * \param t
+     *     Distance to the candidate intersection along the ray
+     *
+     * \param prim_uv
+     *     Primitive-local UV coordinates of the candidate intersection
+     *
+     * \param prim_index
+     *     Index of the intersected primitive
+     */
+    bool alpha_test_scalar(const ScalarRay3f &ray, ScalarFloat t,
+                           const ScalarPoint2f &prim_uv,
+                           ScalarUInt32 prim_index) const;
+
+    /**
+     * \brief Find the nearest intersection of an analytic shape that passes
+     * the alpha test
+     *
+     * Unlike triangles, analytic shapes can be intersected several times by
+     * the same ray (e.g. the near and far side of a sphere). A rejected hit
+     * therefore doesn't end the query: the shape is intersected again past
+     * the rejected distance until a hit is accepted or none is left.
+     *
+     * \param ray
+     *     The ray in world space
+     *
+     * \param prim_index
+     *     Index of the primitive, forwarded to \ref alpha_test_scalar()
+     *
+     * \return
+     *     The distance to the accepted hit (infinity if there is none) and
+     *     its primitive-local UV coordinates
+     */
+    std::pair<ScalarFloat, ScalarPoint2f>
+    ray_intersect_alpha_tested_scalar(const ScalarRay3f &ray,
+                                      ScalarUInt32 prim_index) const;
+
     /// Is this shape also an area emitter?
     bool is_emitter() const { return (bool) m_emitter; }
 
@@ -955,8 +1035,18 @@ protected:
 
     virtual void initialize();
     std::string get_children_string() const;
+
+    /**
+     * Range of subtended solid angles (in steradians) for which shapes use
+     * solid angle sampling in \ref sample_direction(). Smaller regions
+     * (distant or tiny shapes) and regions close to a full hemisphere are
+     * numerically fragile and revert to area sampling instead.
+     */
+    static constexpr float SolidAngleSamplingMin = 3e-4f,
+                           SolidAngleSamplingMax = 6.22f;
 protected:
     ref<BSDF> m_bsdf;
+    ref<Texture> m_alpha_texture;
     ref<Emitter> m_emitter;
     ref<Sensor> m_sensor;
     ref<Medium> m_interior_medium;
@@ -968,6 +1058,9 @@ protected:
     /// Sampling weight (proportional to scene)
     float m_silhouette_sampling_weight;
 
+    /// Ray types that can intersect this shape (see \ref RayFlags)
+    uint32_t m_ray_visibility = (uint32_t) RayFlags::RayTypes;
+
     std::unordered_map<std::string, ref<Texture>> m_texture_attributes;
 
     field<Transform4f, ScalarTransform4f> m_to_world;
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <mitsuba/core/bbox.h>
+#include <mitsuba/core/properties.h>
+#include <mitsuba/core/spectrum.h>
+#include <mitsuba/core/transform.h>
+#include <mitsuba/render/fwd.h>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**
+ * \brief Sparse 3D volume grid with a pointer-free tree layout
+ *
+ * The voxels are organized in a shallow tree with the same configuration as
+ * NanoVDB: a root table references upper internal nodes that each span
+ * 4096^3 voxels, which reference lower internal nodes spanning 128^3
+ * voxels, which in turn reference leaf nodes holding blocks of 8^3 voxels.
+ * The nodes of each level are stored in flat arrays and reference their
+ * children by index, so the tree is loaded using a few bulk reads and can be
+ * uploaded to the GPU as is. Voxels that are not covered by a leaf node take
+ * the background value.
+ *
+ * Every node also stores the per-channel minimum and maximum of the voxels
+ * that it covers (including the background of missing children), which is
+ * useful to compute local majorants.
+ *
+ * Please see the documentation of the \c sparsegridvolume plugin for the
+ * file format specification.
+ */
+MI_VARIANT
+class MI_EXPORT_LIB SparseVolumeGrid : public Object {
+public:
+    MI_IMPORT_CORE_TYPES()
+
+    /// Log2 of the number of children per axis of leaf, lower and upper nodes
+    static constexpr uint32_t LeafLog2 = 3, LowerLog2 = 4, UpperLog2 = 5;
+
+    /// Log2 of the number of voxels per axis covered by a node of each level
+    static constexpr uint32_t LeafSpanLog2  = LeafLog2,
+                              LowerSpanLog2 = LeafSpanLog2 + LowerLog2,
+                              UpperSpanLog2 = LowerSpanLog2 + UpperLog2;
+
+    /// Number of voxels stored in a leaf node
+    static constexpr uint32_t LeafSize  = 1u << (3 * LeafLog2);
+
+    /// Number of children of lower and upper internal nodes
+    static constexpr uint32_t LowerSize = 1u << (3 * LowerLog2),
+                              UpperSize = 1u << (3 * UpperLog2);
+
+    /// Child index denoting a missing child (i.e. a background tile)
+    static constexpr uint32_t Empty = (uint32_t) -1;
+
+    /**
+     * \brief Load a SparseVolumeGrid from a given filename
+     *
+     * \param path
+     *    Name of the file to be loaded
+     */
+    SparseVolumeGrid(const fs::path &path);
+
+    /**
+     * \brief Load a SparseVolumeGrid from an arbitrary stream data source
+     *
+     * \param stream
+     *    Pointer to an arbitrary stream data source
+     */
+    SparseVolumeGrid(Stream *stream);
+
+    /**
+     * \brief Create a sparse grid from dense voxel data
+     *
+     * Only the blocks of 8^3 voxels that contain values different from the
+     * background are stored.
+     *
+     * \param size
+     *    Resolution of the voxel grid
+     *
+     * \param channel_count
+     *    Number of channels per voxel
+     *
+     * \param data
+     *    Voxel data ordered as <tt>data[((z*yres + y)*xres + x)*channels + chan]</tt>
+     *
+     * \param background
+     *    Background value per channel (zero if \c nullptr)
+     */
+    SparseVolumeGrid(ScalarVector3u size, uint32_t channel_count,
+                     const ScalarFloat *data,
+                     const ScalarFloat *background = nullptr);
+
+    /**
+     * \brief Create a sparse grid from a list of active voxels
+     *
+     * \param size
+     *    Resolution of the voxel grid
+     *
+     * \param channel_count
+     *    Number of channels per voxel
+     *
+     * \param coords
+     *    Integer coordinates of the active voxels (<tt>3 * count</tt> values)
+     *
+     * \param values
+     *    Values of the active voxels (<tt>channel_count * count</tt> values)
+     *
+     * \param count
+     *    Number of active voxels
+     *
+     * \param background
+     *    Background value per channel (zero if \c nullptr)
+     */
+    SparseVolumeGrid(ScalarVector3u size, uint32_t channel_count,
+                     const uint32_t *coords, const ScalarFloat *values,
+                     size_t count, const ScalarFloat *background = nullptr);
+
+    /// Return the resolution of the voxel grid
+    ScalarVector3u size() const { return m_size; }
+
+    /// Return the number of channels
+    uint32_t channel_count() const { return m_channel_count; }
+
+    /// Return the bounding box of the grid data
+    const ScalarBoundingBox3f &bbox() const { return m_bbox; }
+
+    /// Estimates the transformation from a unit axis-aligned bounding box to the given one.
+    ScalarTransform4f bbox_transform() const {
+        auto scale_transf = ScalarTransform4f::scale(dr::rcp(m_bbox.extents()));
+        auto translation  = ScalarTransform4f::translate(-m_bbox.min);
+        return scale_transf * translation;
+    }
+
+    /// Return the background value (one entry per channel)
+    const ScalarFloat *background() const { return m_background.data(); }
+
+    /// Return the resolution of the root table
+    ScalarVector3u root_size() const { return m_root_size; }
+
+    /// Return the root table (indices of upper nodes)
+    const uint32_t *root() const { return m_root.data(); }
+
+    /// Return the child tables of all upper nodes (indices of lower nodes)
+    const uint32_t *upper() const { return m_upper.data(); }
+
+    /// Return the child tables of all lower nodes (indices of leaf nodes)
+    const uint32_t *lower() const { return m_lower.data(); }
+
+    /// Return the voxel values of all leaf nodes
+    const ScalarFloat *values() const { return m_values.data(); }
+
+    /// Return the number of upper internal nodes
+    size_t upper_count() const { return m_upper.size() / UpperSize; }
+
+    /// Return the number of lower internal nodes
+    size_t lower_count() const { return m_lower.size() / LowerSize; }
+
+    /// Return the number of leaf nodes
+    size_t leaf_count() const { return m_values.size() / (LeafSize * m_channel_count); }
+
+    /**
+     * \brief Return the per-channel minimum of the nodes of a given level
+     *
+     * \param level
+     *    0 for leaf nodes, 1 for lower and 2 for upper internal nodes. The
+     *    result holds <tt>channel_count()</tt> entries per node.
+     */
+    const ScalarFloat *node_min(uint32_t level) const { return m_node_min[level].data(); }
+
+    /// Return the per-channel maximum of the nodes of a given level (see \ref node_min())
+    const ScalarFloat *node_max(uint32_t level) const { return m_node_max[level].data(); }
+
+    /// Return the maximum over the volume grid
+    ScalarFloat max() const { return m_max; }
+
+    /**
+     * \brief Return the maximum over the volume grid per channel
+     *
+     * Pointer allocation/deallocation must be performed by the caller.
+     */
+    void max_per_channel(ScalarFloat *out) const;
+
+    /**
+     * \brief Conservative per-channel maximum over a region of voxels
+     *
+     * The region spans the voxels from \c min to \c max (inclusive). The
+     * bound is computed from the per-node statistics and is tight for nodes
+     * that are fully contained in the region.
+     *
+     * Pointer allocation/deallocation must be performed by the caller.
+     */
+    void max_per_channel(const ScalarPoint3u &min, const ScalarPoint3u &max,
+                         ScalarFloat *out) const;
+
+    /**
+     * \brief Look up the values of a voxel
+     *
+     * Returns a pointer to \c channel_count() values, which refers to the
+     * background if the voxel isn't stored.
+     */
+    const ScalarFloat *voxel(const ScalarPoint3u &p) const;
+
+    /// Return the size in bytes of the node tables and voxel values
+    size_t buffer_size() const;
+
+    /**
+     * Write an encoded form of the sparse grid to a binary file
+     *
+     * \param path
+     *    Target file name (expected to end in ".svol")
+     */
+    void write(const fs::path &path) const;
+
+    /**
+     * Write an encoded form of the sparse grid to a stream
+     *
+     * \param stream
+     *    Target stream that will receive the encoded output
+     */
+    void write(Stream *stream) const;
+
+    /**
+     * \brief Index of a voxel within a leaf, or of a child within an
+     * internal node
+     *
+     * Follows the NanoVDB convention, where the \c x coordinate varies the
+     * slowest.
+     *
+     * \param log2
+     *    Log2 of the number of children per axis of the node
+     *
+     * \param span_log2
+     *    Log2 of the number of voxels per axis covered by a child
+     */
+    template <typename Point>
+    static auto child_offset(const Point &p, uint32_t log2, uint32_t span_log2) {
+        uint32_t mask = (1u << log2) - 1u;
+        return (((p.x() >> span_log2) & mask) << (2 * log2)) |
+               (((p.y() >> span_log2) & mask) << log2) |
+                ((p.z() >> span_log2) & mask);
+    }
+
+    /// Return a human-readable summary of this sparse grid
+    virtual std::string to_string() const override;
+
+    MI_DECLARE_CLASS()
+
+protected:
+    void read(Stream *stream);
+
+    /// Allocate an empty tree
+    void init(ScalarVector3u size, uint32_t channel_count,
+              const ScalarFloat *background);
+
+    /// Return the index of the leaf containing a voxel, creating it if needed
+    uint32_t touch_leaf(const ScalarPoint3u &p);
+
+    /// Compute the per-node statistics
+    void update_bounds();
+
+    /// Per-channel bound over a region within a node (see \ref max_per_channel())
+    void region_max(uint32_t level, uint32_t index, const ScalarPoint3u &origin,
+                    const ScalarPoint3u &min, const ScalarPoint3u &max,
+                    ScalarFloat *out) const;
+
+protected:
+    ScalarVector3u m_size;
+    uint32_t m_channel_count;
+    ScalarBoundingBox3f m_bbox;
+    std::vector<ScalarFloat> m_background;
+
+    ScalarVector3u m_root_size;
+    std::vector<uint32_t> m_root;
+    std::vector<uint32_t> m_upper;
+    std::vector<uint32_t> m_lower;
+    std::vector<ScalarFloat> m_values;
+
+    std::vector<ScalarFloat> m_node_min[3];
+    std::vector<ScalarFloat> m_node_max[3];
+    ScalarFloat m_max;
+    std::vector<ScalarFloat> m_max_per_channel;
+};
+
+MI_EXTERN_CLASS(SparseVolumeGrid)
+NAMESPACE_END(mitsuba)
@@ -43,6 +43,17 @@ public:
     /// Reset the spiral to its initial state. Does not affect the number of passes.
     void reset();
 
+    /**
+     * \brief Generate blocks in scanline order instead of along a spiral
+     *
+     * In this mode, blocks are generated row by row, and all passes of a
+     * block are generated consecutively before moving on to the next block.
+     * This ensures that image regions are completed in order, which is
+     * required by films that stream their output to disk. Must be called
+     * before the first call to \ref next_block().
+     */
+    void set_scanline_order(bool value) { m_scanline = value; }
+
     /**
      * \brief Return the offset, size, and unique identifier of the next block.
      *
@@ -66,6 +77,8 @@ protected:
     uint32_t m_block_size;    //< Size of the (square) blocks (in pixels)
     uint32_t m_steps_left;    //< Steps before next change of direction
     uint32_t m_spiral_size;   //< Current spiral size in blocks
+    uint32_t m_passes;        //< Total number of passes
+    bool m_scanline;          //< Generate blocks in scanline order?
 };
 
 NAMESPACE_END(mitsuba)
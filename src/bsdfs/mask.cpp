@@ -40,6 +40,15 @@ Note that the standard :ref:`path tracer <integrator-path>` does not have a good
 but the (:ref:`volumetric path tracer <integrator-volpath>`) does. It may thus be preferable when rendering
 scenes that contain the :ref:`mask <bsdf-mask>` plugin, even if there is nothing *volumetric* in the scene.
 
+In the scalar variants, the opacity can instead be evaluated while the ray
+traverses the acceleration data structure, by setting the boolean
+:monosp:`alpha_test` parameter of the scene to |true|. Candidate intersections
+with shapes whose BSDF is a mask are then kept with a probability equal to the
+opacity, and the nested BSDF is used at the remaining ones. This avoids
+restarting ray traversal at every transparent intersection, which is much
+faster for foliage and similar geometry, and it also applies to shadow rays.
+Transparent intersections no longer count towards the maximum path depth.
+
 The following XML snippet describes a material configuration for a transparent leaf:
 
 .. tabs::
@@ -114,6 +114,9 @@ Bitmap::Bitmap(Stream *stream, FileFormat format) {
 }
 
 Bitmap::Bitmap(const fs::path &filename, FileFormat format) {
+    ScopedTraceEvent trace("io", [&] {
+        return tfm::format("Reading \"%s\"", filename.filename());
+    });
     ref<FileStream> fs = new FileStream(filename);
     read(fs, format);
 }
@@ -742,6 +745,9 @@ Bitmap::FileFormat Bitmap::detect_file_format(Stream *stream) {
 }
 
 void Bitmap::write(const fs::path &path, FileFormat format, int quality) const {
+    ScopedTraceEvent trace("io", [&] {
+        return tfm::format("Writing \"%s\"", path.filename());
+    });
     ref<FileStream> fs = new FileStream(path, FileStream::ETruncReadWrite);
     write(fs, format, quality);
 }
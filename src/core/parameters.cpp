@@ -0,0 +1,210 @@
+#include <mitsuba/core/parameters.h>
+#include <mitsuba/core/logger.h>
+#include <mitsuba/core/string.h>
+#include <sstream>
+
+NAMESPACE_BEGIN(mitsuba)
+
+static bool starts_with_any(const std::string &key,
+                            const std::vector<std::string> &prefixes) {
+    if (prefixes.empty())
+        return true;
+    for (const std::string &prefix : prefixes)
+        if (key.compare(0, prefix.size(), prefix) == 0)
+            return true;
+    return false;
+}
+
+ParameterRegistry::ParameterRegistry(Object *root,
+                                     const std::vector<std::string> &prefixes)
+    : m_root(root), m_prefixes(prefixes) {
+    if (!root)
+        Throw("ParameterRegistry: the root object must not be null!");
+
+    m_nodes[root] = Node{ nullptr, 0 };
+    m_node_order.push_back(root);
+    push(root, "", 0, +ParamFlags::Differentiable);
+}
+
+ParameterRegistry::~ParameterRegistry() { }
+
+size_t ParameterRegistry::size() {
+    while (!complete())
+        step();
+    return m_index.size();
+}
+
+const ParameterRegistry::Entry *
+ParameterRegistry::find(const std::string &key) {
+    auto it = m_index.find(key);
+    while (it == m_index.end() && !complete()) {
+        size_t count = m_entries.size();
+        step();
+        if (m_entries.size() != count)
+            it = m_index.find(key);
+    }
+    return it != m_index.end() ? &m_entries[it->second] : nullptr;
+}
+
+bool ParameterRegistry::erase(const std::string &key) {
+    if (!find(key))
+        return false;
+    auto it = m_index.find(key);
+    Entry &e = m_entries[it->second];
+    e.node = nullptr;
+    e.holder.reset();
+    m_index.erase(it);
+    m_erased.insert(key);
+    return true;
+}
+
+void ParameterRegistry::keep(const std::vector<std::string> &prefixes) {
+    for (Entry &e : m_entries) {
+        if (e.node && !starts_with_any(e.key, prefixes)) {
+            m_index.erase(e.key);
+            e.node = nullptr;
+            e.holder.reset();
+        }
+    }
+    // Also applies to the entries that the traversal hasn't reached yet
+    if (!prefixes.empty())
+        m_keep.push_back(prefixes);
+}
+
+const ParameterRegistry::Node *ParameterRegistry::node(const Object *obj) {
+    auto it = m_nodes.find(obj);
+    while (it == m_nodes.end() && !complete()) {
+        size_t count = m_node_order.size();
+        step();
+        if (m_node_order.size() != count)
+            it = m_nodes.find(obj);
+    }
+    return it != m_nodes.end() ? &it->second : nullptr;
+}
+
+size_t ParameterRegistry::node_count() {
+    return nodes().size();
+}
+
+const std::vector<Object *> &ParameterRegistry::nodes() {
+    while (!complete())
+        step();
+    return m_node_order;
+}
+
+const ParameterRegistry::Entry *ParameterRegistry::entry(size_t index) {
+    while (index >= m_entries.size() && !complete())
+        step();
+    return index < m_entries.size() ? &m_entries[index] : nullptr;
+}
+
+void ParameterRegistry::push(Object *obj, std::string name, uint32_t depth,
+                             uint32_t flags) {
+    Frame frame{ obj, std::move(name), depth, flags, {}, 0 };
+    Recorder recorder(&frame.events);
+    obj->traverse(&recorder);
+    m_stack.push_back(std::move(frame));
+}
+
+void ParameterRegistry::step() {
+    Frame &frame = m_stack.back();
+    if (frame.next == frame.events.size()) {
+        m_stack.pop_back();
+        return;
+    }
+
+    Event &event = frame.events[frame.next++];
+    if (!event.obj) {
+        record(frame, event);
+        return;
+    }
+
+    // Objects that are referenced several times are only visited once
+    if (m_nodes.find(event.obj) != m_nodes.end())
+        return;
+
+    // Objects whose name was already used receive a numbered suffix
+    std::string base = frame.depth == 0 ? event.name
+                                        : frame.name + "." + event.name,
+                child_name = base;
+    for (uint32_t ctr = 1; m_names.find(child_name) != m_names.end(); ++ctr)
+        child_name = base + "_" + std::to_string(ctr);
+    m_names.insert(child_name);
+
+    m_nodes[event.obj] = Node{ frame.node, frame.depth + 1 };
+    m_node_order.push_back(event.obj);
+
+    // Visit the children before the remaining events of this object
+    push(event.obj, std::move(child_name), frame.depth + 1,
+         frame.flags | event.flags);
+}
+
+void ParameterRegistry::record(const Frame &frame, Event &event) {
+    std::string key = frame.depth == 0 ? event.name
+                                       : frame.name + "." + event.name;
+    if (!starts_with_any(key, m_prefixes) ||
+        m_erased.find(key) != m_erased.end())
+        return;
+    for (const std::vector<std::string> &prefixes : m_keep)
+        if (!starts_with_any(key, prefixes))
+            return;
+
+    uint32_t flags = event.flags | frame.flags;
+    // Non differentiable parameters shouldn't be flagged as discontinuous
+    if (flags & +ParamFlags::NonDifferentiable)
+        flags &= ~(uint32_t) ParamFlags::Discontinuous;
+
+    auto [it, inserted] = m_index.emplace(key, m_entries.size());
+    if (!inserted) {
+        // Same behavior as a dictionary: the last definition wins
+        Entry &e = m_entries[it->second];
+        e.ptr = event.ptr;
+        e.type = event.type;
+        e.node = frame.node;
+        e.flags = flags;
+        e.holder = std::move(event.holder);
+        return;
+    }
+
+    m_entries.push_back(Entry{ std::move(key), event.ptr, event.type,
+                               frame.node, flags, std::move(event.holder) });
+}
+
+std::string ParameterRegistry::to_string() const {
+    std::ostringstream oss;
+    oss << "ParameterRegistry[" << std::endl
+        << "  root = " << string::indent(m_root) << "," << std::endl
+        << "  node_count = " << m_node_order.size() << "," << std::endl
+        << "  size = " << m_index.size() << "," << std::endl
+        << "  complete = " << (complete() ? "true" : "false") << std::endl
+        << "]";
+    return oss.str();
+}
+
+// -----------------------------------------------------------------------
+
+ParameterRegistry::Recorder::Recorder(std::vector<Event> *events)
+    : m_events(events) { }
+
+void ParameterRegistry::Recorder::put_object(const std::string &name,
+                                             Object *obj, uint32_t flags) {
+    if (obj)
+        m_events->push_back(Event{ name, obj, nullptr, nullptr, flags, nullptr });
+}
+
+void ParameterRegistry::Recorder::put_opaque(const std::string &name,
+                                             std::shared_ptr<void> holder,
+                                             uint32_t flags) {
+    void *ptr = holder.get();
+    m_events->push_back(
+        Event{ name, nullptr, ptr, nullptr, flags, std::move(holder) });
+}
+
+void ParameterRegistry::Recorder::put_parameter_impl(const std::string &name,
+                                                     void *ptr, uint32_t flags,
+                                                     const std::type_info &type) {
+    m_events->push_back(Event{ name, nullptr, ptr, &type, flags, nullptr });
+}
+
+MI_IMPLEMENT_CLASS(ParameterRegistry, Object)
+NAMESPACE_END(mitsuba)
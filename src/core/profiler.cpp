@@ -1,6 +1,18 @@
 #include <mitsuba/core/profiler.h>
 #include <mitsuba/core/logger.h>
+#include <mitsuba/core/thread.h>
 #include <mitsuba/core/util.h>
+#include <mitsuba/core/string.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -16,8 +28,343 @@ void Profiler::static_initialization() {
     for (int i = 0; i < (int) ProfilerPhase::ProfilerPhaseCount; ++i)
         mitsuba_itt_phase[i] = __itt_string_handle_create(profiler_phase_id[i]);
 #endif
+
+    const char *trace_file = std::getenv("MI_TRACE_FILE");
+    if (trace_file && *trace_file && !Tracer::enabled())
+        Tracer::start(trace_file);
+
+    const char *object_profiler = std::getenv("MI_OBJECT_PROFILER");
+    if (object_profiler && *object_profiler && strcmp(object_profiler, "0") != 0)
+        ObjectProfiler::set_enabled(true);
+}
+
+void Profiler::static_shutdown() {
+    if (Tracer::enabled())
+        Tracer::stop();
+    ObjectProfiler::set_enabled(false);
+    ObjectProfiler::reset();
+}
+
+// -----------------------------------------------------------------------
+
+struct TraceEvent {
+    const char *category;
+    const char *name;
+    std::string label;
+    uint64_t start, end;
+};
+
+/**
+ * Events of a single thread. Only the owning thread appends events, while
+ * \ref Tracer::stop() may concurrently read the events that were already
+ * published. Chunks are never moved or released while the process is
+ * running, hence neither side needs a lock.
+ */
+struct TraceBuffer {
+    static constexpr size_t ChunkSize = 512;
+
+    struct Chunk {
+        TraceEvent events[ChunkSize];
+        std::atomic<size_t> size { 0 };
+        std::atomic<Chunk *> next { nullptr };
+    };
+
+    std::unique_ptr<Chunk> head;
+    Chunk *tail;
+    uint32_t tid;
+    std::string thread_name;
+
+    // Position of the first event that wasn't written yet (used by stop())
+    Chunk *read_chunk;
+    size_t read_pos = 0;
+
+    TraceBuffer(uint32_t tid, std::string thread_name)
+        : head(new Chunk()), tail(head.get()), tid(tid),
+          thread_name(std::move(thread_name)), read_chunk(head.get()) { }
+
+    ~TraceBuffer() {
+        Chunk *chunk = head.release();
+        while (chunk) {
+            Chunk *next = chunk->next.load(std::memory_order_relaxed);
+            delete chunk;
+            chunk = next;
+        }
+    }
+
+    void append(TraceEvent &&event) {
+        size_t size = tail->size.load(std::memory_order_relaxed);
+        if (size == ChunkSize) {
+            Chunk *chunk = new Chunk();
+            tail->next.store(chunk, std::memory_order_release);
+            tail = chunk;
+            size = 0;
+        }
+        tail->events[size] = std::move(event);
+        tail->size.store(size + 1, std::memory_order_release);
+    }
+};
+
+std::atomic<bool> Tracer::m_enabled { false };
+
+static std::mutex tracer_mutex;
+static std::vector<std::unique_ptr<TraceBuffer>> tracer_buffers;
+static fs::path tracer_filename;
+static uint64_t tracer_origin = 0;
+static thread_local TraceBuffer *tracer_local_buffer = nullptr;
+
+uint64_t Tracer::timestamp() {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static TraceBuffer *tracer_buffer() {
+    TraceBuffer *buffer = tracer_local_buffer;
+    if (!buffer) {
+        std::lock_guard<std::mutex> guard(tracer_mutex);
+        buffer = new TraceBuffer((uint32_t) tracer_buffers.size(),
+                                 Thread::thread()->name());
+        tracer_buffers.emplace_back(buffer);
+        tracer_local_buffer = buffer;
+    }
+    return buffer;
+}
+
+void Tracer::record(const char *category, const char *name, uint64_t start) {
+    tracer_buffer()->append(TraceEvent{ category, name, std::string(),
+                                        start, timestamp() });
+}
+
+void Tracer::record(const char *category, std::string &&name, uint64_t start) {
+    tracer_buffer()->append(TraceEvent{ category, nullptr, std::move(name),
+                                        start, timestamp() });
+}
+
+void Tracer::start(const fs::path &filename) {
+    std::lock_guard<std::mutex> guard(tracer_mutex);
+    if (m_enabled)
+        Throw("Tracer::start(): recording is already enabled!");
+
+    // Skip events recorded during previous sessions
+    for (auto &buffer : tracer_buffers) {
+        TraceBuffer::Chunk *chunk = buffer->read_chunk, *next;
+        while ((next = chunk->next.load(std::memory_order_acquire)) != nullptr)
+            chunk = next;
+        buffer->read_chunk = chunk;
+        buffer->read_pos = chunk->size.load(std::memory_order_acquire);
+    }
+
+    tracer_filename = filename;
+    tracer_origin = timestamp();
+    m_enabled = true;
+}
+
+static void write_json_string(std::ostream &os, const char *str) {
+    os << '"';
+    for (; *str; ++str) {
+        char c = *str;
+        if (c == '"' || c == '\\')
+            os << '\\' << c;
+        else if ((unsigned char) c < 0x20)
+            os << tfm::format("\\u%04x", (int) c);
+        else
+            os << c;
+    }
+    os << '"';
+}
+
+void Tracer::stop() {
+    std::lock_guard<std::mutex> guard(tracer_mutex);
+    if (!m_enabled)
+        Throw("Tracer::stop(): recording is not enabled!");
+    m_enabled = false;
+
+    std::ofstream os(tracer_filename.native());
+    if (!os.good()) {
+        Log(Warn, "Tracer::stop(): could not open \"%s\" for writing!",
+            tracer_filename);
+        return;
+    }
+
+    os << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [" << std::endl
+       << "{\"ph\": \"M\", \"pid\": 0, \"tid\": 0, \"name\": \"process_name\", "
+          "\"args\": {\"name\": \"mitsuba\"}}";
+
+    size_t event_count = 0;
+    for (auto &buffer : tracer_buffers) {
+        os << "," << std::endl
+           << "{\"ph\": \"M\", \"pid\": 0, \"tid\": " << buffer->tid
+           << ", \"name\": \"thread_name\", \"args\": {\"name\": ";
+        write_json_string(os, buffer->thread_name.c_str());
+        os << "}}";
+
+        TraceBuffer::Chunk *chunk = buffer->read_chunk;
+        size_t pos = buffer->read_pos;
+        while (true) {
+            size_t size = chunk->size.load(std::memory_order_acquire);
+            for (; pos < size; ++pos) {
+                const TraceEvent &e = chunk->events[pos];
+                uint64_t start = std::max(e.start, tracer_origin);
+                os << "," << std::endl
+                   << "{\"ph\": \"X\", \"pid\": 0, \"tid\": " << buffer->tid
+                   << ", \"cat\": \"" << e.category << "\", \"name\": ";
+                write_json_string(os, e.name ? e.name : e.label.c_str());
+                os << tfm::format(", \"ts\": %.3f, \"dur\": %.3f}",
+                                  (start - tracer_origin) / 1000.0,
+                                  (e.end - start) / 1000.0);
+                event_count++;
+            }
+
+            TraceBuffer::Chunk *next = chunk->next.load(std::memory_order_acquire);
+            if (!next || size < TraceBuffer::ChunkSize)
+                break;
+            chunk = next;
+            pos = 0;
+        }
+        buffer->read_chunk = chunk;
+        buffer->read_pos = pos;
+    }
+
+    os << std::endl << "]}" << std::endl;
+    Log(Info, "Wrote %zu timeline events to \"%s\".", event_count,
+        tracer_filename);
+}
+
+// -----------------------------------------------------------------------
+
+struct ObjectCost {
+    ref<Object> object;
+    uint64_t count[(int) ProfilerPhase::ProfilerPhaseCount] { };
+    uint64_t time[(int) ProfilerPhase::ProfilerPhaseCount] { };
+};
+
+/**
+ * Costs recorded by a single thread. The mutex is only contended while the
+ * tables of all threads are merged or reset.
+ */
+struct ObjectCostTable {
+    std::mutex mutex;
+    std::unordered_map<const Object *, ObjectCost> costs;
+};
+
+std::atomic<bool> ObjectProfiler::m_enabled { false };
+
+static std::mutex object_profiler_mutex;
+static std::vector<std::unique_ptr<ObjectCostTable>> object_profiler_tables;
+static thread_local ObjectCostTable *object_profiler_local_table = nullptr;
+
+void ObjectProfiler::set_enabled(bool enabled) {
+    m_enabled = enabled;
+}
+
+void ObjectProfiler::record(const Object *object, ProfilerPhase phase,
+                            uint64_t time) {
+    ObjectCostTable *table = object_profiler_local_table;
+    if (!table) {
+        std::lock_guard<std::mutex> guard(object_profiler_mutex);
+        table = new ObjectCostTable();
+        object_profiler_tables.emplace_back(table);
+        object_profiler_local_table = table;
+    }
+
+    std::lock_guard<std::mutex> guard(table->mutex);
+    auto [it, inserted] = table->costs.try_emplace(object);
+    if (inserted)
+        it->second.object = const_cast<Object *>(object);
+    it->second.count[(int) phase]++;
+    it->second.time[(int) phase] += time;
+}
+
+std::vector<ObjectProfiler::Record> ObjectProfiler::records() {
+    std::unordered_map<const Object *, ObjectCost> merged;
+    {
+        std::lock_guard<std::mutex> guard(object_profiler_mutex);
+        for (auto &table : object_profiler_tables) {
+            std::lock_guard<std::mutex> guard2(table->mutex);
+            for (auto &[object, cost] : table->costs) {
+                ObjectCost &m = merged[object];
+                m.object = cost.object;
+                for (int i = 0; i < (int) ProfilerPhase::ProfilerPhaseCount; ++i) {
+                    m.count[i] += cost.count[i];
+                    m.time[i] += cost.time[i];
+                }
+            }
+        }
+    }
+
+    std::vector<Record> result;
+    for (auto &[object, cost] : merged) {
+        for (int i = 0; i < (int) ProfilerPhase::ProfilerPhaseCount; ++i) {
+            if (cost.count[i] > 0)
+                result.push_back(Record{ cost.object, (ProfilerPhase) i,
+                                         cost.count[i], cost.time[i] });
+        }
+    }
+
+    std::sort(result.begin(), result.end(),
+              [](const Record &a, const Record &b) {
+                  return std::make_pair(a.time, a.count) >
+                         std::make_pair(b.time, b.count);
+              });
+    return result;
+}
+
+std::string ObjectProfiler::report(size_t limit) {
+    std::vector<Record> records = ObjectProfiler::records();
+
+    std::ostringstream oss;
+    oss << "Per-object rendering costs (inclusive times):" << std::endl;
+    if (records.empty()) {
+        oss << "  (nothing was recorded)";
+        return oss.str();
+    }
+
+    oss << tfm::format("  %-40s %-36s %12s %10s %10s", "Object", "Method",
+                       "Calls", "Time", "Per call");
+    for (size_t i = 0; i < std::min(limit, records.size()); ++i) {
+        const Record &r = records[i];
+        std::string id = r.object->id();
+        std::string name = tfm::format("%s [%s]", id.empty() ? "<unnamed>" : id,
+                                       r.object->class_()->name());
+        oss << std::endl << tfm::format("  %-40s %-36s %12llu", name,
+                                        profiler_phase_id[(int) r.phase],
+                                        (unsigned long long) r.count);
+        if (r.time > 0)
+            oss << tfm::format(" %10s %8.1fns",
+                               util::time_string(r.time / 1e6f, true),
+                               r.time / (double) r.count);
+    }
+    if (records.size() > limit)
+        oss << std::endl << tfm::format("  .. and %zu more", records.size() - limit);
+    return oss.str();
+}
+
+void ObjectProfiler::reset() {
+    std::lock_guard<std::mutex> guard(object_profiler_mutex);
+    for (auto &table : object_profiler_tables) {
+        std::lock_guard<std::mutex> guard2(table->mutex);
+        table->costs.clear();
+    }
+}
+
+// -----------------------------------------------------------------------
+
+std::atomic<uint32_t> CostCounters::m_users { 0 };
+
+void CostCounters::acquire() {
+    m_users++;
+}
+
+void CostCounters::release() {
+    uint32_t users = m_users.load();
+    do {
+        if (users == 0)
+            Throw("CostCounters::release(): unbalanced call!");
+    } while (!m_users.compare_exchange_weak(users, users - 1));
 }
 
-void Profiler::static_shutdown() { }
+CostCounters::Counters &CostCounters::local() {
+    static thread_local Counters counters;
+    return counters;
+}
 
 NAMESPACE_END(mitsuba)
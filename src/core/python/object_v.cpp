@@ -1,5 +1,6 @@
 #include <mitsuba/core/transform.h>
 #include <mitsuba/core/frame.h>
+#include <mitsuba/core/parameters.h>
 #include <mitsuba/python/python.h>
 #include <drjit/dynamic.h>
 #include <drjit/tensor.h>
@@ -118,6 +119,18 @@ MI_PY_EXPORT(Object) {
             .def(py::init<>())
             .def("put_parameter",
                  [] (TraversalCallback &self_, const std::string &name, py::object &value, uint32_t flags) {
+                    /* The registry keeps a reference to the Python object,
+                       since the copies made below are temporaries */
+                    if (auto *recorder = dynamic_cast<ParameterRegistry::Recorder *>(&self_)) {
+                        std::shared_ptr<void> holder(
+                            new py::object(value), [](void *ptr) {
+                                py::gil_scoped_acquire gil;
+                                delete (py::object *) ptr;
+                            });
+                        recorder->put_opaque(name, std::move(holder), flags);
+                        return;
+                    }
+
                     PublicistTraversalCallback *self = (PublicistTraversalCallback *) &self_;
                     APPLY_FOR_EACH(PUT_PARAMETER_IMPL_T);
                  },
@@ -0,0 +1,99 @@
+#include <mitsuba/core/parameters.h>
+#include <mitsuba/python/python.h>
+
+extern py::object cast_object(Object *o);
+
+using Entry = ParameterRegistry::Entry;
+
+/**
+ * Iterates over the names of the parameters that haven't been removed. The
+ * traversal of the registry only advances as far as the iteration requires.
+ */
+struct ParameterKeyIterator {
+    ParameterRegistry *registry;
+    size_t index;
+
+    /// Create an iterator pointing to the first parameter (or the end sentinel)
+    ParameterKeyIterator(ParameterRegistry *registry)
+        : registry(registry), index(0) { skip(); }
+
+    void skip() {
+        if (!registry)
+            return;
+        const Entry *e;
+        while ((e = registry->entry(index)) && !e->node)
+            ++index;
+    }
+
+    bool at_end() const { return !registry || !registry->entry(index); }
+
+    const std::string &operator*() const { return registry->entry(index)->key; }
+    ParameterKeyIterator &operator++() { ++index; skip(); return *this; }
+    bool operator==(const ParameterKeyIterator &it) const {
+        if (at_end() || it.at_end())
+            return at_end() == it.at_end();
+        return index == it.index;
+    }
+    bool operator!=(const ParameterKeyIterator &it) const { return !operator==(it); }
+};
+
+/// Convert an entry into the (value, type, node, flags) tuple used by mitsuba.SceneParameters
+static py::tuple entry_to_tuple(const Entry &e) {
+    py::object value, type = py::none();
+    if (e.type) {
+        value = py::cast(e.ptr);
+        type = py::cast((void *) e.type);
+    } else {
+        value = *(py::object *) e.ptr;
+    }
+    return py::make_tuple(value, type, cast_object(e.node), e.flags);
+}
+
+MI_PY_EXPORT(ParameterRegistry) {
+    MI_PY_CLASS(ParameterRegistry, Object)
+        .def(py::init<Object *, const std::vector<std::string> &>(),
+             "root"_a, "prefixes"_a = std::vector<std::string>(),
+             D(ParameterRegistry, ParameterRegistry))
+        .def("__len__", &ParameterRegistry::size, D(ParameterRegistry, size))
+        .def("__contains__",
+             [](ParameterRegistry &r, const std::string &key) {
+                 return r.find(key) != nullptr;
+             })
+        .def("__getitem__",
+             [](ParameterRegistry &r, const std::string &key) {
+                 const Entry *e = r.find(key);
+                 if (!e)
+                     throw py::key_error(key);
+                 return entry_to_tuple(*e);
+             }, D(ParameterRegistry, find))
+        .def("__delitem__",
+             [](ParameterRegistry &r, const std::string &key) {
+                 if (!r.erase(key))
+                     throw py::key_error(key);
+             }, D(ParameterRegistry, erase))
+        .def("__iter__",
+             [](ParameterRegistry &r) {
+                 return py::make_iterator(ParameterKeyIterator(&r),
+                                          ParameterKeyIterator(nullptr));
+             }, py::keep_alive<0, 1>())
+        .def("node",
+             [](ParameterRegistry &r, Object *obj) {
+                 const ParameterRegistry::Node *n = r.node(obj);
+                 if (!n)
+                     throw py::key_error("node");
+                 py::object parent = n->parent ? cast_object(n->parent) : py::none();
+                 return py::make_tuple(parent, n->depth);
+             }, "obj"_a, D(ParameterRegistry, node))
+        .def("nodes",
+             [](ParameterRegistry &r) {
+                 py::list result;
+                 for (Object *obj : r.nodes())
+                     result.append(cast_object(obj));
+                 return result;
+             }, D(ParameterRegistry, nodes))
+        .def_method(ParameterRegistry, node_count)
+        .def_method(ParameterRegistry, complete)
+        .def_method(ParameterRegistry, keep, "prefixes"_a)
+        .def("root", [](const ParameterRegistry &r) { return cast_object(r.root()); },
+             D(ParameterRegistry, root));
+}
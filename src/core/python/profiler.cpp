@@ -0,0 +1,27 @@
+#include <mitsuba/core/profiler.h>
+#include <mitsuba/python/python.h>
+
+extern py::object cast_object(Object *o);
+
+MI_PY_EXPORT(Tracer) {
+    py::class_<Tracer>(m, "Tracer", D(Tracer))
+        .def_static_method(Tracer, start, "filename"_a)
+        .def_static_method(Tracer, stop)
+        .def_static_method(Tracer, enabled);
+}
+
+MI_PY_EXPORT(ObjectProfiler) {
+    py::class_<ObjectProfiler>(m, "ObjectProfiler", D(ObjectProfiler))
+        .def_static_method(ObjectProfiler, set_enabled, "enabled"_a)
+        .def_static_method(ObjectProfiler, enabled)
+        .def_static("records", []() {
+            py::list result;
+            for (const ObjectProfiler::Record &r : ObjectProfiler::records())
+                result.append(py::make_tuple(cast_object(r.object.get()),
+                                             profiler_phase_id[(int) r.phase],
+                                             r.count, r.time * 1e-9));
+            return result;
+        }, D(ObjectProfiler, records))
+        .def_static_method(ObjectProfiler, report, "limit"_a = 25)
+        .def_static_method(ObjectProfiler, reset);
+}
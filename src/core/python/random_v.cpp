@@ -18,6 +18,9 @@ MI_PY_EXPORT(sample_tea) {
         m.def("sample_tea_float64",
               sample_tea_float64<uint32_t>,
               "v0"_a, "v1"_a, "rounds"_a = 4, D(sample_tea_float64));
+
+        m.def("sample_pcg4d", sample_pcg4d<uint32_t>,
+              "v0"_a, "v1"_a, "v2"_a, "v3"_a, D(sample_pcg4d));
     }
 
     m.def("sample_tea_32", sample_tea_32<UInt32>,
@@ -34,6 +37,9 @@ MI_PY_EXPORT(sample_tea) {
           sample_tea_float64<UInt32>,
           "v0"_a, "v1"_a, "rounds"_a = 4, D(sample_tea_float64));
 
+    m.def("sample_pcg4d", sample_pcg4d<UInt32>,
+          "v0"_a, "v1"_a, "v2"_a, "v3"_a, D(sample_pcg4d));
+
     m.attr("sample_tea_float") = m.attr(
         sizeof(Float) != sizeof(Float64) ? "sample_tea_float32" : "sample_tea_float64");
 
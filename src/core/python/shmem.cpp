@@ -0,0 +1,30 @@
+#include <mitsuba/core/shmem.h>
+#include <mitsuba/python/python.h>
+
+MI_PY_EXPORT(SharedMemoryRegion) {
+    MI_PY_CLASS(SharedMemoryRegion, Object, py::buffer_protocol())
+        .def_static("open", &SharedMemoryRegion::open, D(SharedMemoryRegion, open), "key"_a)
+        .def_static("create", &SharedMemoryRegion::create, D(SharedMemoryRegion, create),
+                    "key"_a, "size"_a)
+        .def_static("remove", &SharedMemoryRegion::remove, D(SharedMemoryRegion, remove), "key"_a)
+        .def_static("enabled", &SharedMemoryRegion::enabled, D(SharedMemoryRegion, enabled))
+        .def_static("set_enabled", &SharedMemoryRegion::set_enabled,
+                    D(SharedMemoryRegion, set_enabled), "value"_a)
+        .def_static("make_key", &SharedMemoryRegion::make_key,
+                    D(SharedMemoryRegion, make_key), "descr"_a)
+        .def_static("file_descriptor", &SharedMemoryRegion::file_descriptor,
+                    D(SharedMemoryRegion, file_descriptor), "path"_a)
+        .def("publish", &SharedMemoryRegion::publish, D(SharedMemoryRegion, publish))
+        .def("size", &SharedMemoryRegion::size, D(SharedMemoryRegion, size))
+        .def("key", &SharedMemoryRegion::key, D(SharedMemoryRegion, key))
+        .def_buffer([](SharedMemoryRegion &m) -> py::buffer_info {
+            return py::buffer_info(
+                m.data(),
+                sizeof(uint8_t),
+                py::format_descriptor<uint8_t>::format(),
+                1,
+                { (size_t) m.size() },
+                { sizeof(uint8_t) }
+            );
+        });
+}
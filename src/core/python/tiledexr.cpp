@@ -0,0 +1,20 @@
+#include <mitsuba/core/tiledexr.h>
+#include <mitsuba/python/python.h>
+
+MI_PY_EXPORT(TiledEXRWriter) {
+    using Vector2u = typename TiledEXRWriter::Vector2u;
+    MI_PY_CLASS(TiledEXRWriter, Object)
+        .def(py::init<const fs::path &, const Vector2u &, uint32_t, const Bitmap *>(),
+             "filename"_a, "size"_a, "tile_size"_a, "prototype"_a,
+             D(TiledEXRWriter, TiledEXRWriter))
+        .def("write_tile", &TiledEXRWriter::write_tile,
+             "offset"_a, "tile"_a, D(TiledEXRWriter, write_tile),
+             py::call_guard<py::gil_scoped_release>())
+        .def_method(TiledEXRWriter, close)
+        .def_method(TiledEXRWriter, closed)
+        .def_method(TiledEXRWriter, size)
+        .def_method(TiledEXRWriter, tile_size)
+        .def_method(TiledEXRWriter, tile_count)
+        .def_method(TiledEXRWriter, tiles_written)
+        .def_method(TiledEXRWriter, filename);
+}
@@ -94,6 +94,34 @@ MI_PY_EXPORT(warp) {
           "d"_a, "n1"_a, "n2"_a,
           D(warp, square_to_uniform_spherical_lune_pdf));
 
+    m.def("spherical_triangle_solid_angle",
+          warp::spherical_triangle_solid_angle<Float>,
+          "a"_a, "b"_a, "c"_a, D(warp, spherical_triangle_solid_angle));
+
+    m.def("square_to_uniform_spherical_triangle",
+          warp::square_to_uniform_spherical_triangle<Float>,
+          "sample"_a, "a"_a, "b"_a, "c"_a,
+          D(warp, square_to_uniform_spherical_triangle));
+
+    m.def("square_to_uniform_spherical_triangle_pdf",
+          warp::square_to_uniform_spherical_triangle_pdf<Float>,
+          "d"_a, "a"_a, "b"_a, "c"_a,
+          D(warp, square_to_uniform_spherical_triangle_pdf));
+
+    m.def("spherical_rectangle_solid_angle",
+          warp::spherical_rectangle_solid_angle<Float>,
+          "o"_a, "ex"_a, "ey"_a, D(warp, spherical_rectangle_solid_angle));
+
+    m.def("square_to_uniform_spherical_rectangle",
+          warp::square_to_uniform_spherical_rectangle<Float>,
+          "sample"_a, "o"_a, "ex"_a, "ey"_a,
+          D(warp, square_to_uniform_spherical_rectangle));
+
+    m.def("square_to_uniform_spherical_rectangle_pdf",
+          warp::square_to_uniform_spherical_rectangle_pdf<Float>,
+          "d"_a, "o"_a, "ex"_a, "ey"_a,
+          D(warp, square_to_uniform_spherical_rectangle_pdf));
+
     m.def("square_to_uniform_hemisphere",
           warp::square_to_uniform_hemisphere<Float>,
           "sample"_a, D(warp, square_to_uniform_hemisphere));
@@ -8,6 +8,7 @@
 #include <mitsuba/core/transform.h>
 #include <mitsuba/python/python.h>
 #include <nanothread/nanothread.h>
+#include <pybind11/numpy.h>
 #include <map>
 
 using Caster = py::object(*)(mitsuba::Object *);
@@ -364,7 +365,35 @@ void parse_dictionary(DictParseContext &ctx,
             continue;
         }
 
-        // Try to cast to Array3f (list, tuple, numpy.array, ...)
+        /* Host arrays (NumPy, PyTorch, ...) are loaded into a tensor in a
+           single copy, without holding the GIL. Arrays with three entries are
+           still interpreted as Array3f below. */
+        using HostArray =
+            py::array_t<ScalarFloat, py::array::c_style | py::array::forcecast>;
+        py::object view = host_array_view(value);
+        HostArray host;
+        if (!view.is_none())
+            host = HostArray::ensure(view);
+        if (!view.is_none() && host && host.ndim() > 0 &&
+            !(host.ndim() == 1 && host.size() == 3)) {
+            std::vector<size_t> shape(host.shape(), host.shape() + host.ndim());
+            const ScalarFloat *data = host.data();
+            size_t size = (size_t) host.size();
+
+            std::shared_ptr<TensorXf> tensor;
+            {
+                py::gil_scoped_release release;
+                tensor = std::make_shared<TensorXf>(
+                    dr::load<DynamicBuffer<Float>>(data, size), shape.size(),
+                    shape.data());
+                // See below: tensors must be evaluated to support parallel loading
+                dr::eval(*tensor);
+            }
+            props.set_tensor_handle(key, tensor);
+            continue;
+        }
+
+        // Try to cast to Array3f (list, tuple, ...)
         try {
             props.set_array3f(key, value.template cast<Properties::Array3f>());
             continue;
@@ -0,0 +1,281 @@
+#include <mitsuba/core/shmem.h>
+#include <mitsuba/core/logger.h>
+#include <mitsuba/core/util.h>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__linux__) || defined(__APPLE__)
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
+NAMESPACE_BEGIN(mitsuba)
+
+/// Header stored at the beginning of every region
+struct SharedMemoryHeader {
+    uint64_t magic;
+    uint64_t size;
+    std::atomic<uint32_t> ready;
+};
+
+static_assert(sizeof(SharedMemoryHeader) <= SharedMemoryRegion::Alignment);
+
+static constexpr uint64_t SharedMemoryMagic = 0x4d49534853484d31ull; // "MISHSHM1"
+
+/// -1: not yet initialized from the environment, 0: disabled, 1: enabled
+static std::atomic<int> shmem_enabled { -1 };
+
+struct SharedMemoryRegion::SharedMemoryRegionPrivate {
+    std::string key;
+    uint8_t *base = nullptr;
+    size_t size = 0;
+    int fd = -1;
+
+    SharedMemoryHeader *header() { return (SharedMemoryHeader *) base; }
+
+    /// Map the region privately (copy-on-write)
+    bool map_private(int fd_) {
+    #if defined(__linux__) || defined(__APPLE__)
+        struct stat st;
+        if (fstat(fd_, &st) != 0 || (size_t) st.st_size < Alignment)
+            return false;
+
+        void *ptr = mmap(nullptr, (size_t) st.st_size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE, fd_, 0);
+        if (ptr == MAP_FAILED)
+            return false;
+
+        base = (uint8_t *) ptr;
+        size = (size_t) st.st_size - Alignment;
+        return true;
+    #else
+        (void) fd_;
+        return false;
+    #endif
+    }
+
+    void unmap() {
+    #if defined(__linux__) || defined(__APPLE__)
+        if (base)
+            munmap(base, size + Alignment);
+        if (fd != -1)
+            close(fd);
+    #endif
+        base = nullptr;
+        fd = -1;
+    }
+};
+
+SharedMemoryRegion::SharedMemoryRegion(const std::string &key)
+    : d(new SharedMemoryRegionPrivate()) {
+    d->key = key;
+}
+
+SharedMemoryRegion::~SharedMemoryRegion() {
+    d->unmap();
+}
+
+ref<SharedMemoryRegion> SharedMemoryRegion::open(const std::string &key) {
+#if defined(__linux__) || defined(__APPLE__)
+    int fd = shm_open(key.c_str(), O_RDONLY, 0);
+    if (fd == -1)
+        return nullptr;
+
+    /* Only trust regions published by the current user: another local user
+       could otherwise plant a region under a predictable key */
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_uid != geteuid() ||
+        (st.st_mode & (S_IWGRP | S_IWOTH)) != 0) {
+        Log(Warn, "SharedMemoryRegion::open(): ignoring region \"%s\", which "
+            "is not exclusively owned by the current user.", key);
+        close(fd);
+        return nullptr;
+    }
+
+    ref<SharedMemoryRegion> region = new SharedMemoryRegion(key);
+    bool success = region->d->map_private(fd);
+    close(fd);
+    if (!success)
+        return nullptr;
+
+    SharedMemoryHeader *header = region->d->header();
+    if (header->magic != SharedMemoryMagic ||
+        header->ready.load(std::memory_order_acquire) == 0 ||
+        header->size != region->d->size) {
+        // Still being published (or left incomplete by a crashed process)
+        return nullptr;
+    }
+
+    Log(Debug, "Mapped shared memory region \"%s\" (%s)", key,
+        util::mem_string(region->d->size));
+    return region;
+#else
+    return nullptr;
+#endif
+}
+
+ref<SharedMemoryRegion> SharedMemoryRegion::create(const std::string &key, size_t size) {
+#if defined(__linux__) || defined(__APPLE__)
+    int fd = shm_open(key.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd == -1)
+        return nullptr; // Exists already, or shared memory is unavailable
+
+    size_t total = size + Alignment;
+    bool success = ftruncate(fd, (off_t) total) == 0;
+# if defined(__linux__)
+    /* Reserve the memory up front: writing to a sparse region that exceeds
+       the capacity of /dev/shm would otherwise raise SIGBUS */
+    success = success && posix_fallocate(fd, 0, (off_t) total) == 0;
+# endif
+
+    void *ptr = MAP_FAILED;
+    if (success)
+        ptr = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (ptr == MAP_FAILED) {
+        Log(Warn, "SharedMemoryRegion::create(): could not allocate %s of "
+            "shared memory, the node-level cache will not be used.",
+            util::mem_string(total));
+        close(fd);
+        shm_unlink(key.c_str());
+        return nullptr;
+    }
+
+    ref<SharedMemoryRegion> region = new SharedMemoryRegion(key);
+    region->d->base = (uint8_t *) ptr;
+    region->d->size = size;
+    region->d->fd = fd;
+
+    SharedMemoryHeader *header = region->d->header();
+    header->magic = SharedMemoryMagic;
+    header->size = size;
+    header->ready.store(0, std::memory_order_relaxed);
+    return region;
+#else
+    (void) key; (void) size;
+    return nullptr;
+#endif
+}
+
+void SharedMemoryRegion::publish() {
+    if (d->fd == -1)
+        Throw("SharedMemoryRegion::publish(): region \"%s\" was already published!", d->key);
+
+#if defined(__linux__) || defined(__APPLE__)
+    d->header()->ready.store(1, std::memory_order_release);
+
+    // Switch to a private mapping, so that later changes remain local
+    int fd = d->fd;
+    d->fd = -1;
+    munmap(d->base, d->size + Alignment);
+    d->base = nullptr;
+    bool success = d->map_private(fd);
+    close(fd);
+    if (!success)
+        Throw("SharedMemoryRegion::publish(): could not remap region \"%s\"!", d->key);
+
+    Log(Debug, "Published shared memory region \"%s\" (%s)", d->key,
+        util::mem_string(d->size));
+#endif
+}
+
+bool SharedMemoryRegion::remove(const std::string &key) {
+#if defined(__linux__) || defined(__APPLE__)
+    return shm_unlink(key.c_str()) == 0;
+#else
+    (void) key;
+    return false;
+#endif
+}
+
+bool SharedMemoryRegion::enabled() {
+#if defined(__linux__) || defined(__APPLE__)
+    int value = shmem_enabled.load(std::memory_order_relaxed);
+    if (value == -1) {
+        const char *env = getenv("MI_SHM_CACHE");
+        value = (env && (strcmp(env, "1") == 0 || strcmp(env, "true") == 0)) ? 1 : 0;
+        shmem_enabled.store(value, std::memory_order_relaxed);
+    }
+    return value == 1;
+#else
+    return false;
+#endif
+}
+
+void SharedMemoryRegion::set_enabled(bool value) {
+    shmem_enabled.store(value ? 1 : 0, std::memory_order_relaxed);
+}
+
+std::string SharedMemoryRegion::make_key(const std::string &descr) {
+    // Two FNV-1a hashes with different offsets (96 bits in total)
+    uint64_t h1 = 0xcbf29ce484222325ull, h2 = 0x84222325cbf29ce4ull;
+
+    // Regions are private to a user, keep their keys apart
+    std::string descr_user = descr;
+#if defined(__linux__) || defined(__APPLE__)
+    descr_user += tfm::format("|uid=%u", (unsigned) geteuid());
+#endif
+
+    for (char c : descr_user) {
+        h1 = (h1 ^ (uint8_t) c) * 0x100000001b3ull;
+        h2 = (h2 ^ (uint8_t) c) * 0x100000001b3ull;
+    }
+
+    /* macOS limits shared memory object names to 31 characters */
+    return tfm::format("/mi-%016llx%08x", (unsigned long long) h1,
+                       (uint32_t) (h2 ^ (h2 >> 32)));
+}
+
+std::string SharedMemoryRegion::file_descriptor(const fs::path &path) {
+    /* Hashing the entire contents of a multi-GB file would defeat the purpose
+       of the cache, hence the path, size and modification time are used */
+    fs::path abs_path = fs::absolute(path);
+#if defined(__linux__) || defined(__APPLE__)
+    struct stat st;
+    if (stat(abs_path.string().c_str(), &st) != 0)
+        Throw("SharedMemoryRegion::file_descriptor(): could not access \"%s\"!",
+              abs_path.string());
+# if defined(__APPLE__)
+    int64_t mtime_ns = (int64_t) st.st_mtimespec.tv_sec * 1000000000 + st.st_mtimespec.tv_nsec;
+# else
+    int64_t mtime_ns = (int64_t) st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+# endif
+    return tfm::format("%s|%llu|%lld", abs_path.string(),
+                       (unsigned long long) st.st_size, (long long) mtime_ns);
+#else
+    return tfm::format("%s|%zu", abs_path.string(), fs::file_size(abs_path));
+#endif
+}
+
+void *SharedMemoryRegion::data() {
+    return d->base + Alignment;
+}
+
+const void *SharedMemoryRegion::data() const {
+    return d->base + Alignment;
+}
+
+size_t SharedMemoryRegion::size() const {
+    return d->size;
+}
+
+const std::string &SharedMemoryRegion::key() const {
+    return d->key;
+}
+
+std::string SharedMemoryRegion::to_string() const {
+    std::ostringstream oss;
+    oss << "SharedMemoryRegion[" << std::endl
+        << "  key = \"" << d->key << "\"," << std::endl
+        << "  size = " << util::mem_string(d->size) << "," << std::endl
+        << "  published = " << (d->fd == -1 ? "true" : "false") << std::endl
+        << "]";
+    return oss.str();
+}
+
+MI_IMPLEMENT_CLASS(SharedMemoryRegion, Object)
+
+NAMESPACE_END(mitsuba)
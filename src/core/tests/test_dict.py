@@ -504,3 +504,18 @@ def test12_dict_spectrum(variant_scalar_spectral):
     """)
 
     assert str(s1) == str(s2)
+
+
+def test13_dict_tensor_from_numpy(variants_all_rgb):
+    import numpy as np
+
+    data = np.random.default_rng(0).random((4, 5, 3)).astype(np.float64)
+    texture = mi.load_dict({
+        "type" : "bitmap",
+        "data" : data,
+        "raw" : True
+    })
+
+    params = mi.traverse(texture)
+    assert params['data'].shape == (4, 5, 3)
+    assert np.allclose(np.array(params['data']), data)
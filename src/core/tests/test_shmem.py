@@ -0,0 +1,55 @@
+import os
+import pytest
+import numpy as np
+import mitsuba as mi
+
+
+@pytest.fixture
+def region_key():
+    if not os.path.isdir('/dev/shm'):
+        pytest.skip('POSIX shared memory is not available')
+    key = mi.SharedMemoryRegion.make_key('test_shmem|%i' % os.getpid())
+    mi.SharedMemoryRegion.remove(key)
+    yield key
+    mi.SharedMemoryRegion.remove(key)
+
+
+def test01_make_key(variant_scalar_rgb):
+    key = mi.SharedMemoryRegion.make_key('foo')
+    assert key.startswith('/') and len(key) <= 31
+    assert key == mi.SharedMemoryRegion.make_key('foo')
+    assert key != mi.SharedMemoryRegion.make_key('bar')
+
+
+def test02_publish_and_open(variant_scalar_rgb, region_key):
+    assert mi.SharedMemoryRegion.open(region_key) is None
+
+    region = mi.SharedMemoryRegion.create(region_key, 1024)
+    assert region is not None and region.size() == 1024
+
+    # Unpublished regions are invisible, and can't be created twice
+    assert mi.SharedMemoryRegion.open(region_key) is None
+    assert mi.SharedMemoryRegion.create(region_key, 1024) is None
+
+    np.array(region, copy=False).view(np.uint32)[:] = np.arange(256, dtype=np.uint32)
+    region.publish()
+
+    other = mi.SharedMemoryRegion.open(region_key)
+    assert other is not None and other.size() == 1024
+    assert np.all(np.array(other, copy=False).view(np.uint32) == np.arange(256))
+
+    # Mappings are private and copy-on-write
+    np.array(other, copy=False)[0] = 123
+    assert np.array(region, copy=False)[0] == 0
+    assert np.array(mi.SharedMemoryRegion.open(region_key), copy=False)[0] == 0
+
+
+def test03_file_descriptor(variant_scalar_rgb, tmpdir):
+    fname = os.path.join(str(tmpdir), 'shmem_test')
+    with open(fname, 'w') as f:
+        f.write('hello')
+    d1 = mi.SharedMemoryRegion.file_descriptor(fname)
+    with open(fname, 'w') as f:
+        f.write('hello world')
+    d2 = mi.SharedMemoryRegion.file_descriptor(fname)
+    assert d1 != d2
@@ -213,3 +213,69 @@ def test_square_to_uniform_lune(variants_vec_rgb):
     inv = lambda v: mi.warp.uniform_spherical_lune_to_square(v, n1, n2)
 
     check_inverse(fwd, inv, atol=1e-4)
+
+
+def test_square_to_uniform_spherical_triangle(variant_scalar_rgb):
+    p = mi.ScalarPoint3f(0.3, -0.2, 0.5)
+    v = [mi.ScalarPoint3f(-1, -1, 2), mi.ScalarPoint3f(2, -0.5, 1.5),
+         mi.ScalarPoint3f(0.5, 2, 2.5)]
+    a, b, c = [dr.normalize(x - p) for x in v]
+
+    # Compare against Girard's theorem (sum of the interior angles - pi)
+    def angle(x, y, z):
+        return dr.acos(dr.dot(dr.normalize(dr.cross(x, y)),
+                              dr.normalize(dr.cross(x, z))))
+    solid_angle = mi.warp.spherical_triangle_solid_angle(a, b, c)
+    assert dr.allclose(solid_angle, angle(a, b, c) + angle(b, c, a) +
+                       angle(c, a, b) - dr.pi, rtol=1e-4)
+    assert dr.allclose(mi.warp.square_to_uniform_spherical_triangle_pdf(a, a, b, c),
+                       1 / solid_angle)
+
+    n = dr.cross(v[1] - v[0], v[2] - v[0])
+    for x in dr.linspace(Float, 1e-3, 1 - 1e-3, 10):
+        # The first sample dimension selects a sub-triangle of proportional area
+        d = mi.warp.square_to_uniform_spherical_triangle([x, 1], a, b, c)
+        assert dr.allclose(mi.warp.spherical_triangle_solid_angle(a, b, d),
+                           x * solid_angle, rtol=1e-3, atol=1e-5)
+
+        for y in dr.linspace(Float, 1e-3, 1 - 1e-3, 10):
+            d = mi.warp.square_to_uniform_spherical_triangle([x, y], a, b, c)
+            assert dr.allclose(dr.norm(d), 1)
+
+            # Sampled directions must hit the triangle
+            q = p + d * (dr.dot(v[0] - p, n) / dr.dot(d, n))
+            for i in range(3):
+                e = dr.cross(v[(i + 1) % 3] - v[i], q - v[i])
+                assert dr.dot(e, n) > -1e-4
+
+
+def test_square_to_uniform_spherical_rectangle(variant_scalar_rgb):
+    p  = mi.ScalarPoint3f(0.3, -0.2, 1.5)
+    s  = mi.ScalarPoint3f(-1, -0.5, 0)
+    ex = mi.ScalarVector3f(2, 0, 0)
+    ey = mi.ScalarVector3f(0, 1.5, 0)
+    o = s - p
+
+    # Split into two triangles to obtain a reference solid angle
+    def tri(x, y, z):
+        return mi.warp.spherical_triangle_solid_angle(
+            dr.normalize(x), dr.normalize(y), dr.normalize(z))
+    solid_angle = mi.warp.spherical_rectangle_solid_angle(o, ex, ey)
+    assert dr.allclose(solid_angle, tri(o, o + ex, o + ex + ey) +
+                       tri(o, o + ex + ey, o + ey), rtol=1e-4)
+
+    for x in dr.linspace(Float, 1e-3, 1 - 1e-3, 10):
+        for y in dr.linspace(Float, 1e-3, 1 - 1e-3, 10):
+            rel = mi.warp.square_to_uniform_spherical_rectangle([x, y], o, ex, ey)
+
+            # Sampled points lie on the rectangle
+            local = rel - o
+            u = dr.dot(local, ex) / dr.squared_norm(ex)
+            v = dr.dot(local, ey) / dr.squared_norm(ey)
+            assert dr.allclose(dr.dot(local, dr.cross(ex, ey)), 0, atol=1e-5)
+            assert u >= -1e-5 and u <= 1 + 1e-5
+            assert v >= -1e-5 and v <= 1 + 1e-5
+
+            # The first sample dimension selects a sub-rectangle of proportional area
+            assert dr.allclose(mi.warp.spherical_rectangle_solid_angle(o, ex * u, ey),
+                               x * solid_angle, rtol=1e-3, atol=1e-5)
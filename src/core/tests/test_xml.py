@@ -425,3 +425,33 @@ def test31_python_plugins_parallel(variants_vec_backends_once_rgb):
         <bsdf type='dummy'/>
     </scene>
     """, parallel=True)
+
+
+def test32_timeline_trace(variant_scalar_rgb, tmp_path):
+    import json
+
+    filename = str(tmp_path / 'trace.json')
+    mi.Tracer.start(filename)
+    assert mi.Tracer.enabled()
+
+    mi.load_string("""
+    <scene version='3.0.0'>
+        <bsdf type='diffuse' id='my_bsdf'/>
+        <shape type='sphere'>
+            <ref id='my_bsdf'/>
+        </shape>
+    </scene>
+    """)
+
+    mi.Tracer.stop()
+    assert not mi.Tracer.enabled()
+
+    with open(filename) as f:
+        trace = json.load(f)
+
+    events = [e for e in trace['traceEvents'] if e['ph'] == 'X']
+    names = [e['name'] for e in events]
+    assert 'diffuse "my_bsdf"' in names
+    assert any(n.startswith('sphere') for n in names)
+    assert 'Scene initialization' in names
+    assert all(e['dur'] >= 0 for e in events)
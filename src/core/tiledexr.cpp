@@ -0,0 +1,217 @@
+#include <mitsuba/core/tiledexr.h>
+#include <mitsuba/core/logger.h>
+#include <mitsuba/core/profiler.h>
+#include <mitsuba/core/util.h>
+
+/* OpenEXR */
+#if defined(__clang__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wdeprecated-register"
+#  pragma clang diagnostic ignored "-Wunused-parameter"
+#elif defined(__GNUG__)
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wdeprecated"
+#endif
+
+#include <ImfTiledOutputFile.h>
+#include <ImfTileDescription.h>
+#include <ImfStandardAttributes.h>
+#include <ImfChannelList.h>
+#include <ImfFrameBuffer.h>
+#include <ImfStringAttribute.h>
+
+#if defined(__clang__)
+#  pragma clang diagnostic pop
+#elif defined(__GNUG__)
+#  pragma GCC diagnostic pop
+#endif
+
+NAMESPACE_BEGIN(mitsuba)
+
+struct TiledEXRWriter::TiledEXRWriterPrivate {
+    std::unique_ptr<Imf::TiledOutputFile> file;
+};
+
+TiledEXRWriter::TiledEXRWriter(const fs::path &filename, const Vector2u &size,
+                               uint32_t tile_size, const Bitmap *prototype)
+    : d(new TiledEXRWriterPrivate()), m_filename(filename), m_size(size),
+      m_tile_size(tile_size), m_tiles_written(0) {
+    if (dr::any(size == 0u) || tile_size == 0)
+        Throw("TiledEXRWriter: image and tile size must be nonzero!");
+
+    m_tiles = (size + (tile_size - 1)) / tile_size;
+    m_written.resize(dr::prod(m_tiles), false);
+    m_struct = new Struct(*prototype->struct_());
+    m_pixel_format = prototype->pixel_format();
+
+    Imf::Header header(
+        (int) size.x(),    // width
+        (int) size.y(),    // height,
+        1.f,               // pixelAspectRatio
+        Imath::V2f(0, 0),  // screenWindowCenter,
+        1.f,               // screenWindowWidth
+        Imf::RANDOM_Y,     // lineOrder: tiles are written as they complete
+        Imf::PIZ_COMPRESSION
+    );
+
+    header.setTileDescription(
+        Imf::TileDescription(tile_size, tile_size, Imf::ONE_LEVEL));
+
+    const Properties &metadata = prototype->metadata();
+    for (const std::string &key : metadata.property_names()) {
+        if (metadata.type(key) == Properties::Type::String)
+            header.insert(key.c_str(), Imf::StringAttribute(metadata.string(key)));
+    }
+    if (!metadata.has_property("generatedBy"))
+        header.insert("generatedBy",
+                      Imf::StringAttribute("Mitsuba version " MI_VERSION));
+
+    if (m_pixel_format == Bitmap::PixelFormat::XYZ ||
+        m_pixel_format == Bitmap::PixelFormat::XYZA) {
+        Imf::addChromaticities(header, Imf::Chromaticities(
+            Imath::V2f(1.f, 0.f),
+            Imath::V2f(0.f, 1.f),
+            Imath::V2f(0.f, 0.f),
+            Imath::V2f(1.f / 3.f, 1.f / 3.f)));
+    }
+
+    Imf::ChannelList &channels = header.channels();
+    for (auto field : *m_struct) {
+        Imf::PixelType comp_type;
+        switch (field.type) {
+            case Struct::Type::Float32: comp_type = Imf::FLOAT; break;
+            case Struct::Type::Float16: comp_type = Imf::HALF; break;
+            case Struct::Type::UInt32: comp_type = Imf::UINT; break;
+            default: Throw("TiledEXRWriter: unexpected field type!");
+        }
+        channels.insert(field.name, Imf::Channel(comp_type));
+    }
+
+    d->file = std::make_unique<Imf::TiledOutputFile>(
+        filename.string().c_str(), header);
+
+    Log(Debug, "Streaming %ux%u image to \"%s\" (%u tiles of %ux%u pixels)",
+        size.x(), size.y(), filename.string(), tile_count(), tile_size,
+        tile_size);
+}
+
+TiledEXRWriter::~TiledEXRWriter() {
+    if (d->file && m_tiles_written != tile_count())
+        Log(Debug, "TiledEXRWriter: \"%s\" was not closed, %u tiles are missing.",
+            m_filename.string(), tile_count() - m_tiles_written);
+}
+
+void TiledEXRWriter::write_tile(const Point2u &offset, const Bitmap *tile) {
+    if (dr::any(offset % m_tile_size != 0u) || dr::any(offset >= m_size))
+        Throw("TiledEXRWriter::write_tile(): invalid tile offset %s!", offset);
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!d->file)
+        Throw("TiledEXRWriter::write_tile(): the file was already closed!");
+
+    write_tile_nolock(offset / m_tile_size, tile);
+}
+
+void TiledEXRWriter::write_tile_nolock(const Vector2u &index, const Bitmap *tile) {
+    ScopedPhase phase(ProfilerPhase::BitmapWrite);
+
+    Vector2u offset = index * m_tile_size,
+             size   = dr::minimum(m_tile_size, m_size - offset);
+
+    if (tile->size() != size)
+        Throw("TiledEXRWriter::write_tile(): expected a tile of size %s, got %s!",
+              size, tile->size());
+    const Struct *tile_struct = tile->struct_();
+    bool compatible = tile_struct->size() == m_struct->size() &&
+                      tile_struct->field_count() == m_struct->field_count();
+    for (size_t i = 0; compatible && i < m_struct->field_count(); ++i) {
+        const Struct::Field &f1 = (*tile_struct)[i], &f2 = (*m_struct)[i];
+        compatible = f1.name == f2.name && f1.type == f2.type &&
+                     f1.offset == f2.offset;
+    }
+    if (!compatible)
+        Throw("TiledEXRWriter::write_tile(): tile format does not match the "
+              "file format!");
+
+    uint32_t tile_index = index.x() + index.y() * m_tiles.x();
+    if (m_written[tile_index])
+        Throw("TiledEXRWriter::write_tile(): tile %s was already written!", index);
+
+    /* OpenEXR addresses pixels relative to the data window. Shift the base
+       pointer so that the tile's top left pixel lands at 'offset' */
+    size_t pixel_stride = m_struct->size(),
+           row_stride   = pixel_stride * size.x();
+    const char *base = (const char *) tile->uint8_data() -
+                       offset.x() * pixel_stride - offset.y() * row_stride;
+
+    Imf::FrameBuffer framebuffer;
+    for (auto field : *m_struct) {
+        const Imf::Channel &channel = d->file->header().channels()[field.name];
+        framebuffer.insert(field.name,
+                           Imf::Slice(channel.type, (char *) base + field.offset,
+                                      pixel_stride, row_stride));
+    }
+
+    d->file->setFrameBuffer(framebuffer);
+    d->file->writeTile((int) index.x(), (int) index.y());
+
+    m_written[tile_index] = true;
+    m_tiles_written++;
+}
+
+void TiledEXRWriter::close() {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!d->file)
+        return;
+
+    if (m_tiles_written != tile_count()) {
+        Log(Debug, "TiledEXRWriter: filling %u missing tiles with zeros",
+            tile_count() - m_tiles_written);
+
+        std::vector<std::string> channel_names;
+        for (auto field : *m_struct)
+            channel_names.push_back(field.name);
+
+        for (uint32_t y = 0; y < m_tiles.y(); ++y) {
+            for (uint32_t x = 0; x < m_tiles.x(); ++x) {
+                if (m_written[x + y * m_tiles.x()])
+                    continue;
+                Vector2u index(x, y),
+                         size = dr::minimum(m_tile_size, m_size - index * m_tile_size);
+                ref<Bitmap> zero = new Bitmap(
+                    m_pixel_format, m_struct->operator[](0).type, size,
+                    m_struct->field_count(), channel_names);
+                zero->clear();
+                write_tile_nolock(index, zero);
+            }
+        }
+    }
+
+    d->file.reset();
+}
+
+bool TiledEXRWriter::closed() const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return !d->file;
+}
+
+uint32_t TiledEXRWriter::tiles_written() const {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_tiles_written;
+}
+
+std::string TiledEXRWriter::to_string() const {
+    std::ostringstream oss;
+    oss << "TiledEXRWriter[" << std::endl
+        << "  filename = \"" << m_filename.string() << "\"," << std::endl
+        << "  size = " << m_size << "," << std::endl
+        << "  tile_size = " << m_tile_size << "," << std::endl
+        << "  tiles_written = " << tiles_written() << " / " << tile_count() << "," << std::endl
+        << "  closed = " << (closed() ? "true" : "false") << std::endl
+        << "]";
+    return oss.str();
+}
+
+MI_IMPLEMENT_CLASS(TiledEXRWriter, Object)
+
+NAMESPACE_END(mitsuba)
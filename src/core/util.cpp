@@ -14,13 +14,16 @@
 #  include <unistd.h>
 #  include <limits.h>
 #  include <sys/ioctl.h>
+#  include <sys/resource.h>
 #elif defined(__APPLE__)
 #  include <sys/sysctl.h>
 #  include <mach-o/dyld.h>
 #  include <unistd.h>
 #  include <sys/ioctl.h>
+#  include <sys/resource.h>
 #elif defined(_WIN32)
 #  include <windows.h>
+#  include <psapi.h>
 #endif
 
 NAMESPACE_BEGIN(mitsuba)
@@ -199,6 +202,46 @@ std::string mem_string(size_t size, bool precise) {
     return tfm::format(precise ? "%.5g %s" : "%.3g %s", value, orders[i]);
 }
 
+size_t physical_memory() {
+#if defined(_WIN32)
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (!GlobalMemoryStatusEx(&status))
+        return 0;
+    return (size_t) status.ullTotalPhys;
+#elif defined(__APPLE__)
+    uint64_t size = 0;
+    size_t size_len = sizeof(size);
+    if (sysctlbyname("hw.memsize", &size, &size_len, NULL, 0))
+        return 0;
+    return (size_t) size;
+#else
+    long pages = sysconf(_SC_PHYS_PAGES),
+         page_size = sysconf(_SC_PAGESIZE);
+    if (pages <= 0 || page_size <= 0)
+        return 0;
+    return (size_t) pages * (size_t) page_size;
+#endif
+}
+
+size_t peak_memory_usage() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return (size_t) counters.PeakWorkingSetSize;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#  if defined(__APPLE__)
+    return (size_t) usage.ru_maxrss; // bytes
+#  else
+    return (size_t) usage.ru_maxrss * 1024; // kilobytes
+#  endif
+#endif
+}
+
 #if defined(_WIN32) || defined(__linux__)
     void MI_EXPORT __dummySymbol() { }
 #endif
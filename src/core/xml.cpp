@@ -1074,6 +1074,9 @@ static Task *instantiate_node(XMLParseContext &ctx,
         }
 
         try {
+            ScopedTraceEvent trace("instantiate", [&] {
+                return tfm::format("%s \"%s\"", props.plugin_name(), id);
+            });
             inst.object = PluginManager::instance()->create_object(props, inst.class_);
         } catch (const std::exception &e) {
             Throw("Error while loading \"%s\" (near %s): could not instantiate "
@@ -1110,6 +1113,7 @@ static Task *instantiate_node(XMLParseContext &ctx,
         std::exception_ptr eptr;
         for (auto& task : deps) {
             try {
+                ScopedTraceEvent trace("wait", "Waiting for child objects");
                 task_wait(task);
             } catch (...) {
                 if (!eptr)
@@ -1387,7 +1391,13 @@ std::vector<ref<Object>> load_file(const fs::path &filename,
 
     try {
         detail::XMLParseContext ctx(variant, parallel);
-        auto scene_id = detail::init_xml_parse_context_from_file(ctx, filename, param, write_update);
+        std::string scene_id;
+        {
+            ScopedTraceEvent trace("io", [&] {
+                return tfm::format("Parsing \"%s\"", filename.filename());
+            });
+            scene_id = detail::init_xml_parse_context_from_file(ctx, filename, param, write_update);
+        }
 
         ref<Object> top_node = detail::instantiate_top_node(ctx, scene_id);
         std::vector<ref<Object>> objects = detail::expand_node(top_node);
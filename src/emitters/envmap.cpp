@@ -33,6 +33,11 @@ Environment emitter (:monosp:`envmap`)
      an existing Bitmap image instance can be passed directly rather than
      loading it from the filesystem with :paramtype:`filename`.
 
+ * - (Nested plugin)
+   - |shape|
+   - Optional :ref:`rectangle <shape-rectangle>` shapes marking openings through which the
+     environment illuminates an interior scene. See the section on light portals below.
+
  * - scale
    - |Float|
    - A scale factor that is applied to the radiance values stored in the input image. (Default: 1.0)
@@ -92,6 +97,48 @@ High quality free light probes are available on
         'type': 'envmap',
         'filename': 'textures/museum.exr'
 
+.. rubric:: Light portals
+
+In interior scenes that only receive light from the environment through a few
+openings (e.g. windows), most directions drawn from the environment map are
+blocked by walls. Such openings can be tagged as *portals* by nesting
+:ref:`rectangle <shape-rectangle>` shapes within the emitter. Directions are
+then sampled through the portals that are visible from the shading point,
+proportionally to the environment map radiance that they reveal (following
+Bitterli et al. :cite:`Bitterli2015Portal`). The portal shapes are not part of
+the scene geometry.
+
+The normal of each portal must face the interior of the scene, and all light
+from the environment that reaches the interior is assumed to pass through a
+portal: directions that don't are only found by BSDF sampling. Points on the
+exterior side of all portals sample the entire environment map instead.
+
+.. tabs::
+    .. code-tab:: xml
+        :name: envmap-portal
+
+        <emitter type="envmap">
+            <string name="filename" value="textures/museum.exr"/>
+            <shape type="rectangle" name="window">
+                <transform name="to_world">
+                    <scale x="0.8" y="0.6"/>
+                    <rotate y="1" angle="90"/>
+                    <translate x="-2" y="1"/>
+                </transform>
+            </shape>
+        </emitter>
+
+    .. code-tab:: python
+
+        'type': 'envmap',
+        'filename': 'textures/museum.exr',
+        'window': {
+            'type': 'rectangle',
+            'to_world': mi.ScalarTransform4f.translate([-2, 1, 0]) @
+                        mi.ScalarTransform4f.rotate([0, 1, 0], 90) @
+                        mi.ScalarTransform4f.scale([0.8, 0.6, 1])
+        }
+
  */
 
 template <typename Float, typename Spectrum>
@@ -101,6 +148,7 @@ public:
     MI_IMPORT_TYPES(Scene, Shape, Texture)
 
     using Warp = Hierarchical2D<Float, 0>;
+    using FloatStorage = DynamicBuffer<Float>;
 
     /* In RGB variants: 3-channel array for R, G, and B components
        In spectral variants: 4-channel array for polynomial coefficients & scale */
@@ -112,6 +160,16 @@ public:
            about the scene and default to the unit bounding sphere. */
         m_bsphere = BoundingSphere3f(ScalarPoint3f(0.f), 1.f);
 
+        for (auto &[name, obj] : props.objects()) {
+            Shape *shape = dynamic_cast<Shape *>(obj.get());
+            if (!shape)
+                continue;
+            if (shape->shape_type() != +ShapeType::Rectangle)
+                Throw("Portal \"%s\": only rectangle shapes can be used as "
+                      "light portals!", name);
+            add_portal(name, shape);
+        }
+
         ref<Bitmap> bitmap;
 
         if (props.has_property("bitmap")) {
@@ -210,6 +268,9 @@ public:
                                        dr::Array<ScalarFloat, 1>(scale));
                 }
 
+                if (!m_portals.empty())
+                    m_portal_lum.push_back(lum);
+
                 lum = dr::maximum(lum - luminance_offset, 0.f);
 
                 *lum_ptr++ = lum * sin_theta;
@@ -221,6 +282,9 @@ public:
             // Last column of pixels mirrors first
             ScalarFloat temp = *(lum_ptr - bitmap->size().x());
             *lum_ptr++ = temp;
+            if (!m_portals.empty())
+                m_portal_lum.push_back(
+                    m_portal_lum[m_portal_lum.size() - bitmap->size().x()]);
             dr::store(out_ptr, dr::load<ScalarPixelData>(
                                    out_ptr - bitmap->size().x() * pixel_width));
             out_ptr += pixel_width;
@@ -231,6 +295,8 @@ public:
 
         m_scale = props.get<ScalarFloat>("scale", 1.f);
         m_warp = Warp(luminance.get(), res);
+        if (!m_portals.empty())
+            build_portals();
         m_d65 = Texture::D65(1.f);
         m_flags = EmitterFlags::Infinite | EmitterFlags::SpatiallyVarying;
         dr::set_attr(this, "flags", m_flags);
@@ -244,6 +310,16 @@ public:
     }
 
     void parameters_changed(const std::vector<std::string> &keys = {}) override {
+        bool rebuild_portals = !m_portals.empty() &&
+                               (keys.empty() || string::contains(keys, "to_world"));
+
+        if (rebuild_portals) {
+            if constexpr (dr::is_jit_v<Float>)
+                dr::sync_thread();
+            // Update the scalar value of the matrix
+            m_to_world = m_to_world.value();
+        }
+
         if (keys.empty() || string::contains(keys, "data")) {
 
             ScalarVector2u res = { m_data.shape(1), m_data.shape(0) };
@@ -269,6 +345,10 @@ public:
             ScalarFloat *ptr     = (ScalarFloat *) data.data(),
                         *lum_ptr = (ScalarFloat *) luminance.get();
 
+            // The resolution may have changed
+            if (!m_portals.empty())
+                m_portal_lum.resize(dr::prod(res));
+
             size_t pixel_width = is_spectral_v<Spectrum> ? 4 : 3;
             constexpr bool is_aligned = ScalarPixelData::Size == 4;
 
@@ -315,13 +395,21 @@ public:
                         lum = srgb_model_mean(dr::head<3>(coeff)) * coeff.w();
                     }
 
+                    if (!m_portals.empty())
+                        m_portal_lum[y * res.x() + x] = lum;
+
                     *lum_ptr++ = lum * sin_theta;
                     ptr += pixel_width;
                 }
             }
 
             m_warp = Warp(luminance.get(), res);
+            rebuild_portals = !m_portals.empty();
         }
+
+        if (rebuild_portals)
+            build_portals();
+
         Base::parameters_changed(keys);
     }
 
@@ -407,51 +495,80 @@ public:
                      Mask active) const override {
         MI_MASKED_FUNCTION(ProfilerPhase::EndpointSampleDirection, active);
 
-        auto [uv, pdf] = m_warp.sample(sample, nullptr, active);
-        uv.x() += .5f / (m_data.shape(1) - 1);
-        active &= pdf > 0.f;
-
-        Float theta = uv.y() * dr::Pi<Float>,
-              phi   = uv.x() * dr::TwoPi<Float>;
-
-        Vector3f d = dr::sphdir(theta, phi);
-        d = Vector3f(d.y(), d.z(), -d.x());
-
         // Needed when the reference point is on the sensor, which is not part of the bbox
         Float radius = dr::maximum(m_bsphere.radius, dr::norm(it.p - m_bsphere.center));
         Float dist = 2.f * radius;
 
-        Float inv_sin_theta = dr::safe_rsqrt(dr::maximum(
-            dr::sqr(d.x()) + dr::sqr(d.z()), dr::sqr(dr::Epsilon<Float>)));
-
-        d = m_to_world.value().transform_affine(d);
-
-        DirectionSample3f ds;
-        ds.p       = it.p + d * dist;
-        ds.n       = -d;
-        ds.uv      = uv;
+        DirectionSample3f ds = dr::zeros<DirectionSample3f>();
         ds.time    = it.time;
-        ds.pdf     = dr::select(
-            active,
-            pdf * inv_sin_theta * (1.f / (2.f * dr::sqr(dr::Pi<Float>))),
-            0.f
-        );
         ds.delta   = false;
         ds.emitter = this;
-        ds.d       = d;
         ds.dist    = dist;
 
+        // Sample through the portals that are visible from the reference point
+        Mask portal_mask = false;
+        if (!m_portals.empty()) {
+            auto [d, mass] = sample_portals(it.p, sample, active);
+            portal_mask = active && mass > 0.f;
+
+            if (dr::any_or<true>(portal_mask)) {
+                Vector3f v = m_to_world.value().inverse().transform_affine(d);
+                dr::masked(ds.uv, portal_mask) =
+                    Point2f(dr::atan2(v.x(), -v.z()) * dr::InvTwoPi<Float>,
+                            dr::safe_acos(v.y()) * dr::InvPi<Float>);
+                dr::masked(ds.d, portal_mask) = d;
+                dr::masked(ds.pdf, portal_mask) =
+                    pdf_portals(it.p, d, portal_mask).first;
+            }
+        }
+
+        // Otherwise, sample the entire environment map
+        Mask envmap_mask = dr::andnot(active, portal_mask);
+        if (dr::any_or<true>(envmap_mask)) {
+            auto [uv, pdf] = m_warp.sample(sample, nullptr, envmap_mask);
+            uv.x() += .5f / (m_data.shape(1) - 1);
+
+            Float theta = uv.y() * dr::Pi<Float>,
+                  phi   = uv.x() * dr::TwoPi<Float>;
+
+            Vector3f d = dr::sphdir(theta, phi);
+            d = Vector3f(d.y(), d.z(), -d.x());
+
+            Float inv_sin_theta = dr::safe_rsqrt(dr::maximum(
+                dr::sqr(d.x()) + dr::sqr(d.z()), dr::sqr(dr::Epsilon<Float>)));
+
+            dr::masked(ds.uv, envmap_mask) = uv;
+            dr::masked(ds.d, envmap_mask) = m_to_world.value().transform_affine(d);
+            dr::masked(ds.pdf, envmap_mask) =
+                pdf * inv_sin_theta * (1.f / (2.f * dr::sqr(dr::Pi<Float>)));
+        }
+
+        active &= ds.pdf > 0.f;
+        ds.pdf = dr::select(active, ds.pdf, 0.f);
+        ds.p   = it.p + ds.d * dist;
+        ds.n   = -ds.d;
+
         auto weight =
-            depolarizer<Spectrum>(eval_spectrum(uv, it.wavelengths, active)) /
+            depolarizer<Spectrum>(eval_spectrum(ds.uv, it.wavelengths, active)) /
             ds.pdf;
 
         return { ds, weight & active };
     }
 
-    Float pdf_direction(const Interaction3f & /*it*/, const DirectionSample3f &ds,
+    Float pdf_direction(const Interaction3f &it, const DirectionSample3f &ds,
                         Mask active) const override {
         MI_MASKED_FUNCTION(ProfilerPhase::EndpointEvaluate, active);
 
+        /* Reference points with visible portals only sample directions
+           through them, others sample the entire environment map */
+        Float portal_pdf = 0.f;
+        Mask portal_mask = false;
+        if (!m_portals.empty()) {
+            auto [pdf, mass] = pdf_portals(it.p, ds.d, active);
+            portal_pdf  = pdf;
+            portal_mask = mass > 0.f;
+        }
+
         Vector3f d = m_to_world.value().inverse().transform_affine(ds.d);
 
         // Convert to latitude-longitude texture coordinates
@@ -463,7 +580,10 @@ public:
         Float inv_sin_theta = dr::safe_rsqrt(dr::maximum(
             dr::sqr(d.x()) + dr::sqr(d.z()), dr::sqr(dr::Epsilon<Float>)));
 
-        return m_warp.eval(uv) * inv_sin_theta * (1.f / (2.f * dr::sqr(dr::Pi<Float>)));
+        Float pdf = m_warp.eval(uv) * inv_sin_theta *
+                    (1.f / (2.f * dr::sqr(dr::Pi<Float>)));
+
+        return dr::select(portal_mask, portal_pdf, pdf);
     }
 
     Spectrum eval_direction(const Interaction3f &it,
@@ -509,8 +629,10 @@ public:
         oss << "EnvironmentMapEmitter[" << std::endl;
         if (!m_filename.empty())
             oss << "  filename = \"" << m_filename << "\"," << std::endl;
-        oss << "  res = \"" << res << "\"," << std::endl
-            << "  bsphere = " << string::indent(m_bsphere) << std::endl
+        oss << "  res = \"" << res << "\"," << std::endl;
+        if (!m_portals.empty())
+            oss << "  portals = " << m_portals.size() << "," << std::endl;
+        oss << "  bsphere = " << string::indent(m_bsphere) << std::endl
             << "]";
         return oss.str();
     }
@@ -576,6 +698,312 @@ protected:
         }
     }
 
+    // =============================================================
+    //! @{ \name Light portals
+    // =============================================================
+
+    /* Directions through a portal are parameterized by the angles (alpha,
+       beta) that they form with the portal's normal along its two edges,
+       which map the visible region of any reference point to an
+       axis-aligned rectangle. Each portal stores a summed-area table of the
+       environment map luminance in this rectified space, which provides the
+       mass of that rectangle in constant time. */
+
+    /// Resolution of the rectified environment map of each portal
+    static constexpr uint32_t PortalResolution = 128;
+
+    /// Number of entries in the summed-area table of each portal
+    static constexpr uint32_t PortalSize =
+        (PortalResolution + 1) * (PortalResolution + 1);
+
+    struct Portal {
+        /// Center of the rectangle
+        ScalarPoint3f center;
+        /// Edge directions and outward-facing normal
+        ScalarVector3f u, v, w;
+        /// Half extents along \c u and \c v
+        ScalarFloat hx, hy;
+    };
+
+    void add_portal(const std::string &name, const Shape *shape) {
+        auto position = [&](ScalarFloat x, ScalarFloat y) {
+            PositionSample3f ps = shape->sample_position(0.f, Point2f(x, y));
+            return std::make_pair(ScalarPoint3f(dr::slice(ps.p)),
+                                  ScalarVector3f(dr::slice(ps.n)));
+        };
+
+        auto [center, n] = position(.5f, .5f);
+        ScalarVector3f u = position(1.f, .5f).first - center,
+                       v = position(.5f, 1.f).first - center;
+
+        Portal portal;
+        portal.center = center;
+        portal.hx     = dr::norm(u);
+        portal.hy     = dr::norm(v);
+        portal.u      = u / portal.hx;
+        portal.v      = v / portal.hy;
+        portal.w      = -dr::normalize(n);
+
+        if (dr::abs(dr::dot(portal.u, portal.v)) > 1e-4f)
+            Throw("Portal \"%s\": the rectangle must not be sheared!", name);
+
+        m_portals.push_back(portal);
+    }
+
+    /// Luminance of the environment map (nearest pixel) in a world-space direction
+    ScalarFloat portal_luminance(const ScalarTransform4f &to_local,
+                                 const ScalarVector3f &d) const {
+        ScalarVector2u res = { (uint32_t) m_data.shape(1), (uint32_t) m_data.shape(0) };
+        ScalarVector3f v = to_local.transform_affine(d);
+
+        ScalarFloat x = dr::atan2(v.x(), -v.z()) * dr::InvTwoPi<ScalarFloat>,
+                    y = dr::safe_acos(v.y()) * dr::InvPi<ScalarFloat>;
+
+        x = x * (res.x() - 1) - .5f;
+        x -= dr::floor(x / (res.x() - 1)) * (res.x() - 1);
+
+        uint32_t col = (uint32_t) (x + .5f) % (res.x() - 1),
+                 row = dr::minimum((uint32_t) (y * (res.y() - 1) + .5f), res.y() - 1);
+
+        return m_portal_lum[row * res.x() + col];
+    }
+
+    /// Tabulate the environment map in the rectified space of each portal
+    void build_portals() {
+        const uint32_t res = PortalResolution, stride = res + 1;
+        const ScalarFloat cell = dr::Pi<ScalarFloat> / res;
+        ScalarTransform4f to_local = m_to_world.scalar().inverse();
+
+        /* Add a small fraction of the average radiance so that all directions
+           through a portal can be sampled, even if the tabulated luminance
+           misses them */
+        double lum_avg = 0.0;
+        for (ScalarFloat lum : m_portal_lum)
+            lum_avg += lum;
+        ScalarFloat lum_min =
+            ScalarFloat(1e-3 * lum_avg / std::max(m_portal_lum.size(), (size_t) 1));
+
+        std::vector<ScalarFloat> sat(m_portals.size() * PortalSize);
+        std::vector<double> row_sum(stride);
+
+        for (size_t i = 0; i < m_portals.size(); ++i) {
+            const Portal &portal = m_portals[i];
+            ScalarFloat *out = sat.data() + i * PortalSize;
+            std::fill(row_sum.begin(), row_sum.end(), 0.0);
+            std::fill(out, out + stride, 0.f);
+
+            for (uint32_t y = 0; y < res; ++y) {
+                ScalarFloat tb = dr::tan((y + .5f) * cell - .5f * dr::Pi<ScalarFloat>);
+                double accum = 0.0;
+                out[(y + 1) * stride] = 0.f;
+
+                for (uint32_t x = 0; x < res; ++x) {
+                    ScalarFloat ta = dr::tan((x + .5f) * cell - .5f * dr::Pi<ScalarFloat>);
+                    ScalarVector3f d = portal.u * ta + portal.v * tb + portal.w;
+                    ScalarFloat inv_norm = dr::rsqrt(dr::squared_norm(d));
+
+                    // Solid angle of the cell
+                    ScalarFloat jacobian = (1.f + dr::sqr(ta)) * (1.f + dr::sqr(tb)) *
+                                           inv_norm * inv_norm * inv_norm;
+
+                    ScalarFloat lum = portal_luminance(to_local, d * inv_norm);
+                    accum += (double) ((lum + lum_min) * jacobian * dr::sqr(cell));
+                    row_sum[x + 1] += accum;
+                    out[(y + 1) * stride + x + 1] = (ScalarFloat) row_sum[x + 1];
+                }
+            }
+        }
+
+        m_portal_sat = dr::load<FloatStorage>(sat.data(), sat.size());
+    }
+
+    /// Evaluate the summed-area table at continuous cell coordinates
+    Float portal_sat(const UInt32 &offset, const Float &x, const Float &y,
+                     Mask active) const {
+        const uint32_t res = PortalResolution;
+        UInt32 xi = dr::minimum(UInt32(x), res - 1),
+               yi = dr::minimum(UInt32(y), res - 1);
+        Float fx = x - Float(xi), fy = y - Float(yi);
+
+        UInt32 index = offset + dr::fmadd(yi, res + 1, xi);
+        Float v00 = dr::gather<Float>(m_portal_sat, index, active),
+              v10 = dr::gather<Float>(m_portal_sat, index + 1, active),
+              v01 = dr::gather<Float>(m_portal_sat, index + res + 1, active),
+              v11 = dr::gather<Float>(m_portal_sat, index + res + 2, active);
+
+        // Bilinear interpolation is exact for a piecewise constant density
+        return dr::lerp(dr::lerp(v00, v10, fx), dr::lerp(v01, v11, fx), fy);
+    }
+
+    /**
+     * \brief Rectified region of the directions from \c p through portal
+     * \c i (x0, x1, y0, y1) and its luminance mass
+     */
+    std::pair<Vector4f, Float> portal_region(uint32_t i, const Point3f &p,
+                                             Mask active) const {
+        const Portal &portal = m_portals[i];
+        Vector3f rel = p - Point3f(portal.center);
+        Float h     = -dr::dot(rel, Vector3f(portal.w)),
+              inv_h = dr::rcp(h),
+              pu    = dr::dot(rel, Vector3f(portal.u)),
+              pv    = dr::dot(rel, Vector3f(portal.v));
+
+        // The portal is only visible from its interior side
+        active &= h > 0.f;
+
+        ScalarFloat scale   = PortalResolution * dr::InvPi<ScalarFloat>,
+                    half_pi = .5f * dr::Pi<ScalarFloat>;
+        Vector4f region(dr::atan((-portal.hx - pu) * inv_h),
+                        dr::atan(( portal.hx - pu) * inv_h),
+                        dr::atan((-portal.hy - pv) * inv_h),
+                        dr::atan(( portal.hy - pv) * inv_h));
+        region = dr::clamp((region + half_pi) * scale, 0.f, (ScalarFloat) PortalResolution);
+
+        UInt32 offset = i * PortalSize;
+        Float mass = portal_sat(offset, region.y(), region.w(), active) -
+                     portal_sat(offset, region.x(), region.w(), active) -
+                     portal_sat(offset, region.y(), region.z(), active) +
+                     portal_sat(offset, region.x(), region.z(), active);
+
+        return { region, dr::select(active, dr::maximum(mass, 0.f), 0.f) };
+    }
+
+    /**
+     * \brief Sample a direction through the portals visible from \c p
+     *
+     * Returns the direction and the total luminance mass of the visible
+     * portals. The direction is invalid when the mass is zero.
+     */
+    std::pair<Vector3f, Float> sample_portals(const Point3f &p, Point2f sample,
+                                              Mask active) const {
+        const uint32_t res = PortalResolution;
+        uint32_t count = (uint32_t) m_portals.size();
+
+        std::vector<Vector4f> regions(count);
+        std::vector<Float> masses(count);
+        Float mass_total = 0.f;
+        for (uint32_t i = 0; i < count; ++i) {
+            std::tie(regions[i], masses[i]) = portal_region(i, p, active);
+            mass_total += masses[i];
+        }
+
+        // Select a portal proportionally to its mass and reuse the sample
+        Float t = sample.x() * mass_total, cdf = 0.f, cdf_sel = 0.f, mass = 0.f;
+        Vector4f region = 0.f;
+        UInt32 offset = 0;
+        Vector3f u = 0.f, v = 0.f, w = 0.f;
+        for (uint32_t i = 0; i < count; ++i) {
+            Mask pick = masses[i] > 0.f && t >= cdf;
+            dr::masked(region, pick)  = regions[i];
+            dr::masked(mass, pick)    = masses[i];
+            dr::masked(cdf_sel, pick) = cdf;
+            dr::masked(offset, pick)  = i * PortalSize;
+            dr::masked(u, pick) = Vector3f(m_portals[i].u);
+            dr::masked(v, pick) = Vector3f(m_portals[i].v);
+            dr::masked(w, pick) = Vector3f(m_portals[i].w);
+            cdf += masses[i];
+        }
+        active &= mass > 0.f;
+        sample.x() = dr::select(
+            active, dr::minimum((t - cdf_sel) / mass, dr::OneMinusEpsilon<Float>), 0.f);
+
+        Float x0 = region.x(), x1 = region.y(),
+              y0 = region.z(), y1 = region.w();
+
+        // Sample a column from the marginal distribution of the region
+        auto marginal = [&](const Float &x) DRJIT_INLINE_LAMBDA {
+            return portal_sat(offset, x, y1, active) - portal_sat(offset, x, y0, active);
+        };
+
+        Float m0 = marginal(x0);
+        t = sample.x() * mass;
+        UInt32 col = dr::binary_search<UInt32>(
+            0, res - 1, [&](UInt32 k) DRJIT_INLINE_LAMBDA {
+                return marginal(dr::clamp(Float(k + 1), x0, x1)) - m0 < t;
+            });
+
+        Float xa = dr::clamp(Float(col), x0, x1),
+              xb = dr::clamp(Float(col + 1), x0, x1),
+              ga = marginal(xa) - m0,
+              gb = marginal(xb) - m0;
+        Float x = dr::fmadd(xb - xa, dr::select(gb > ga, (t - ga) / (gb - ga), 0.f), xa);
+
+        // Sample a row from the conditional distribution within that column
+        Float c0 = Float(col), c1 = c0 + 1.f;
+        auto conditional = [&](const Float &y) DRJIT_INLINE_LAMBDA {
+            return portal_sat(offset, c1, y, active) - portal_sat(offset, c0, y, active);
+        };
+
+        Float h0 = conditional(y0);
+        t = sample.y() * (conditional(y1) - h0);
+        UInt32 row = dr::binary_search<UInt32>(
+            0, res - 1, [&](UInt32 k) DRJIT_INLINE_LAMBDA {
+                return conditional(dr::clamp(Float(k + 1), y0, y1)) - h0 < t;
+            });
+
+        Float ya = dr::clamp(Float(row), y0, y1),
+              yb = dr::clamp(Float(row + 1), y0, y1),
+              ha = conditional(ya) - h0,
+              hb = conditional(yb) - h0;
+        Float y = dr::fmadd(yb - ya, dr::select(hb > ha, (t - ha) / (hb - ha), 0.f), ya);
+
+        // Map the rectified coordinates back to a direction
+        ScalarFloat scale = dr::Pi<ScalarFloat> / res, half_pi = .5f * dr::Pi<ScalarFloat>;
+        Float ta = dr::tan(dr::fmsub(x, scale, half_pi)),
+              tb = dr::tan(dr::fmsub(y, scale, half_pi));
+
+        Vector3f d = dr::normalize(dr::fmadd(u, ta, dr::fmadd(v, tb, w)));
+
+        return { d, mass_total };
+    }
+
+    /**
+     * \brief Density of \ref sample_portals() per unit solid angle
+     *
+     * Returns the density and the total luminance mass of the portals visible
+     * from \c p. Overlapping portals each contribute to the density.
+     */
+    std::pair<Float, Float> pdf_portals(const Point3f &p, const Vector3f &d,
+                                        Mask active) const {
+        const uint32_t res = PortalResolution;
+        ScalarFloat scale = res * dr::InvPi<ScalarFloat>, half_pi = .5f * dr::Pi<ScalarFloat>;
+
+        Float mass_total = 0.f, value = 0.f;
+        for (uint32_t i = 0; i < (uint32_t) m_portals.size(); ++i) {
+            const Portal &portal = m_portals[i];
+            auto [region, mass] = portal_region(i, p, active);
+            mass_total += mass;
+
+            Float dz = dr::dot(d, Vector3f(portal.w)), inv_dz = dr::rcp(dz),
+                  ta = dr::dot(d, Vector3f(portal.u)) * inv_dz,
+                  tb = dr::dot(d, Vector3f(portal.v)) * inv_dz,
+                  x  = (dr::atan(ta) + half_pi) * scale,
+                  y  = (dr::atan(tb) + half_pi) * scale;
+
+            Mask inside = active && mass > 0.f && dz > 0.f &&
+                          x >= region.x() && x <= region.y() &&
+                          y >= region.z() && y <= region.w();
+
+            // Luminance mass of the cell containing the direction
+            UInt32 col = dr::minimum(UInt32(x), res - 1),
+                   row = dr::minimum(UInt32(y), res - 1),
+                   index = i * PortalSize + dr::fmadd(row, res + 1, col);
+            Float f = dr::gather<Float>(m_portal_sat, index + res + 2, inside) -
+                      dr::gather<Float>(m_portal_sat, index + res + 1, inside) -
+                      dr::gather<Float>(m_portal_sat, index + 1, inside) +
+                      dr::gather<Float>(m_portal_sat, index, inside);
+
+            Float jacobian = (1.f + dr::sqr(ta)) * (1.f + dr::sqr(tb)) * dr::sqr(dz) * dz;
+            value += dr::select(inside, dr::maximum(f, 0.f) / jacobian, 0.f);
+        }
+
+        Float pdf = value * dr::sqr(scale) / mass_total;
+        return { dr::select(mass_total > 0.f, pdf, 0.f), mass_total };
+    }
+
+    //! @}
+    // =============================================================
+
     MI_DECLARE_CLASS()
 protected:
     std::string m_filename;
@@ -584,6 +1012,11 @@ protected:
     Warp m_warp;
     ref<Texture> m_d65;
     Float m_scale;
+
+    std::vector<Portal> m_portals;
+    /// Luminance of the environment map (without the sine weighting)
+    std::vector<ScalarFloat> m_portal_lum;
+    FloatStorage m_portal_sat;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(EnvironmentMapEmitter, Emitter)
@@ -135,3 +135,128 @@ def test04_parameters_changed(variants_all):
 
     params = mi.traverse(emitter)
     assert dr.allclose(params['data'], 1)
+
+
+def make_portal_envmap(fname):
+    import numpy as np
+    rng = np.random.default_rng(seed=0)
+    img = rng.uniform(0.1, 1.0, (20, 40)).astype(np.float32)
+    img[5:8, 10:15] = 20
+    mi.Bitmap(img).write(fname)
+
+
+def test05_portal_chi2(variants_vec_backends_once_rgb):
+    tempdir = tempfile.TemporaryDirectory()
+    fname = os.path.join(tempdir.name, 'out.exr')
+    make_portal_envmap(fname)
+
+    # Window above the reference point (origin), with its normal facing it
+    xml = f'<string name="filename" value="{fname}"/>' \
+           '<shape type="rectangle">' \
+           '    <boolean name="flip_normals" value="true"/>' \
+           '    <transform name="to_world">' \
+           '        <scale x="1.5" y="0.8"/>' \
+           '        <translate x="0.3" z="1"/>' \
+           '    </transform>' \
+           '</shape>'
+    sample_func, pdf_func = mi.chi2.EmitterAdapter("envmap", xml)
+
+    chi2 = mi.chi2.ChiSquareTest(
+        domain=mi.chi2.SphericalDomain(),
+        sample_func=sample_func,
+        pdf_func=pdf_func,
+        sample_dim=2,
+        ires=32
+    )
+
+    assert chi2.run()
+
+
+def test06_portal_sampling(variants_vec_backends_once_rgb):
+    tempdir = tempfile.TemporaryDirectory()
+    fname = os.path.join(tempdir.name, 'out.exr')
+    make_portal_envmap(fname)
+
+    emitter = mi.load_dict({
+        'type': 'envmap',
+        'filename': fname,
+        'window': {
+            'type': 'rectangle',
+            'flip_normals': True,
+            'to_world': mi.ScalarTransform4f.translate([0.3, 0, 1]) @
+                        mi.ScalarTransform4f.scale([1.5, 0.8, 1])
+        }
+    })
+    reference = mi.load_dict({
+        'type': 'envmap',
+        'filename': fname
+    })
+
+    rng = mi.PCG32(size=10000)
+    sample = mi.Point2f(rng.next_float32(), rng.next_float32())
+
+    # All directions from an interior point pass through the portal
+    si = dr.zeros(mi.SurfaceInteraction3f)
+    ds, w = emitter.sample_direction(si, sample)
+    p = ds.d / ds.d.z
+    assert dr.all(ds.d.z > 0)
+    assert dr.all((dr.abs(p.x - 0.3) <= 1.5 + 1e-4) & (dr.abs(p.y) <= 0.8 + 1e-4))
+
+    si.wi = -ds.d
+    assert dr.allclose(emitter.pdf_direction(si, ds), ds.pdf, rtol=1e-3)
+    assert dr.allclose(w, emitter.eval(si) / ds.pdf, rtol=1e-3)
+
+    # Directions that miss the portal have a zero density
+    ds.d = mi.Vector3f(0, 0, -1)
+    assert dr.all(emitter.pdf_direction(si, ds) == 0)
+
+    # Points on the exterior side sample the entire environment map
+    si.p = mi.Point3f(0, 0, 2)
+    ds, w = emitter.sample_direction(si, sample)
+    ds_ref, w_ref = reference.sample_direction(si, sample)
+    assert dr.allclose(ds.d, ds_ref.d)
+    assert dr.allclose(emitter.pdf_direction(si, ds), reference.pdf_direction(si, ds))
+
+
+def test07_portal_resize(variants_vec_backends_once_rgb):
+    import numpy as np
+    tempdir = tempfile.TemporaryDirectory()
+    fname = os.path.join(tempdir.name, 'out.exr')
+    make_portal_envmap(fname)
+
+    window = {
+        'type': 'rectangle',
+        'flip_normals': True,
+        'to_world': mi.ScalarTransform4f.translate([0.3, 0, 1]) @
+                    mi.ScalarTransform4f.scale([1.5, 0.8, 1])
+    }
+    emitter = mi.load_dict({
+        'type': 'envmap',
+        'filename': fname,
+        'window': window
+    })
+
+    # Larger environment map loaded with the same portal
+    rng = np.random.default_rng(seed=1)
+    img = rng.uniform(0.1, 1.0, (60, 120, 3)).astype(np.float32)
+    img[30:35, 70:80] = 20
+    reference = mi.load_dict({
+        'type': 'envmap',
+        'bitmap': mi.Bitmap(img),
+        'window': window
+    })
+
+    params = mi.traverse(emitter)
+    params['data'] = mi.TensorXf(mi.traverse(reference)['data'])
+    params.update()
+    assert dr.shape(params['data']) == dr.shape(mi.traverse(reference)['data'])
+
+    # Portal sampling uses the luminance of the new data
+    rng = mi.PCG32(size=1000)
+    sample = mi.Point2f(rng.next_float32(), rng.next_float32())
+    si = dr.zeros(mi.SurfaceInteraction3f)
+    ds, w = emitter.sample_direction(si, sample)
+    ds_ref, w_ref = reference.sample_direction(si, sample)
+    assert dr.allclose(ds.d, ds_ref.d, atol=1e-4)
+    assert dr.allclose(ds.pdf, ds_ref.pdf, rtol=1e-3)
+    assert dr.allclose(w, w_ref, rtol=1e-3)
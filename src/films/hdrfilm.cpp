@@ -3,11 +3,13 @@
 #include <mitsuba/core/fstream.h>
 #include <mitsuba/core/spectrum.h>
 #include <mitsuba/core/string.h>
+#include <mitsuba/core/tiledexr.h>
 #include <mitsuba/render/film.h>
 #include <mitsuba/render/fwd.h>
 #include <mitsuba/render/imageblock.h>
 
 #include <mutex>
+#include <unordered_map>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -19,7 +21,7 @@ High dynamic range film (:monosp:`hdrfilm`)
 -------------------------------------------
 
 .. pluginparameters::
- :extra-rows: 7
+ :extra-rows: 8
 
  * - width, height
    - |int|
@@ -64,6 +66,12 @@ High dynamic range film (:monosp:`hdrfilm`)
      in JIT variants and can make sample accumulation quite a bit more expensive.
      (Default: |false|, i.e. disabled)
 
+ * - stream_file
+   - |string|
+   - Enables the out-of-core mode (see below) and specifies the tiled OpenEXR file
+     that finished image regions are streamed to while rendering. This feature is
+     currently only supported in scalar variants. (Default: disabled)
+
  * - (Nested plugin)
    - :paramtype:`rfilter`
    - Reconstruction filter that should be used by the film. (Default: :monosp:`gaussian`, a windowed
@@ -107,6 +115,21 @@ data. PFM output is restricted to :monosp:`float32`-valued images using the :mon
 :monosp:`luminance` pixel formats. Due to the superior accuracy and adoption of OpenEXR, the use of
 these two alternative formats is discouraged however.
 
+Gigapixel renders with many AOVs can exceed the available memory, since the film
+normally stores the entire crop window, and developing and writing the image
+creates further copies. In this case, the out-of-core mode can be enabled by
+specifying the :monosp:`stream_file` parameter. The film then only keeps the
+image regions (tiles) that are currently being rendered in memory. The
+integrator renders blocks in scanline order, and as soon as a tile has received
+all of its contributions (including those of neighboring blocks that overlap it
+due to the reconstruction filter), it is developed and written to a tiled
+OpenEXR file. When the film is written to disk, the streamed file is finalized
+and moved to the requested location. Developing the film in this mode
+(e.g. via ``mi.render()``) reads the finished file back into memory, hence
+``develop=False`` should be specified for very large images. Writing the film
+while rendering is still in progress (e.g. upon receiving ``SIGHUP``) finalizes
+the streamed file early, and contributions received afterwards are discarded.
+
 When RGB(A) output is selected, the measured spectral power distributions are
 converted to linear RGB based on the CIE 1931 XYZ color matching curves and
 the ITU-R Rec. BT.709-3 primaries with a D65 white point.
@@ -226,6 +249,19 @@ public:
 
         m_compensate = props.get<bool>("compensate", false);
 
+        if (props.has_property("stream_file")) {
+            if constexpr (dr::is_jit_v<Float>)
+                Throw("HDRFilm: the out-of-core mode (\"stream_file\") is "
+                      "only supported in scalar variants!");
+            if (m_file_format != Bitmap::FileFormat::OpenEXR)
+                Throw("HDRFilm: the out-of-core mode (\"stream_file\") "
+                      "requires file_format=\"openexr\"!");
+            m_stream_path = props.string("stream_file");
+            if (string::to_lower(m_stream_path.extension().string()) != ".exr")
+                m_stream_path.replace_extension(".exr");
+            m_stream_location = m_stream_path;
+        }
+
         props.mark_queried("banner"); // no banner in Mitsuba 3
     }
 
@@ -259,8 +295,16 @@ public:
 
         /* locked */ {
             std::lock_guard<std::mutex> lock(m_mutex);
-            m_storage = new ImageBlock(m_crop_size, m_crop_offset,
-                                       (uint32_t) channels.size());
+            if (m_stream_path.empty()) {
+                m_storage = new ImageBlock(m_crop_size, m_crop_offset,
+                                           (uint32_t) channels.size());
+            } else {
+                // Out-of-core mode: storage is allocated per tile on demand
+                m_storage = nullptr;
+                m_tile_size = 0;
+                m_tiles.clear();
+                m_writer = nullptr;
+            }
             m_channels = channels;
         }
 
@@ -290,7 +334,24 @@ public:
                               warn /* warn_invalid */);
     }
 
+    void prepare_blocks(uint32_t block_size, uint32_t passes) override {
+        if (m_stream_path.empty())
+            return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_block_size = block_size;
+        m_passes = passes;
+        reset_tiles();
+    }
+
+    bool scanline_order() const override { return !m_stream_path.empty(); }
+
     void put_block(const ImageBlock *block) override {
+        if (!m_stream_path.empty()) {
+            put_block_streaming(block);
+            return;
+        }
+
         Assert(m_storage != nullptr);
         std::lock_guard<std::mutex> lock(m_mutex);
         m_storage->put_block(block);
@@ -299,11 +360,23 @@ public:
     void clear() override {
         if (m_storage)
             m_storage->clear();
+
+        if (!m_stream_path.empty()) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_tile_size != 0)
+                reset_tiles();
+        }
     }
 
     TensorXf develop(bool raw = false) const override {
-        if (!m_storage)
+        if (!m_stream_path.empty()) {
+            // Out-of-core mode (scalar variants): handled by bitmap() below
+            if (raw)
+                Throw("HDRFilm::develop(): raw film contents are not available "
+                      "in out-of-core mode!");
+        } else if (!m_storage) {
             Throw("No storage allocated, was prepare() called first?");
+        }
 
         if (raw) {
             std::lock_guard<std::mutex> lock(m_mutex);
@@ -418,11 +491,86 @@ public:
     }
 
     ref<Bitmap> bitmap(bool raw = false) const override {
+        if (!m_stream_path.empty()) {
+            if (raw)
+                Throw("HDRFilm::bitmap(): raw film contents are not available "
+                      "in out-of-core mode!");
+            Log(Warn, "HDRFilm::bitmap(): loading the complete image streamed "
+                      "to \"%s\" into memory.", m_stream_location.string());
+            finalize_stream();
+            ref<Bitmap> result = new Bitmap(m_stream_location);
+            if (result->component_format() != struct_type_v<ScalarFloat>)
+                result = result->convert(result->pixel_format(),
+                                         struct_type_v<ScalarFloat>, false);
+            return result;
+        }
+
         if (!m_storage)
             Throw("No storage allocated, was prepare() called first?");
 
         std::lock_guard<std::mutex> lock(m_mutex);
-        auto &&storage = dr::migrate(m_storage->tensor().array(), AllocType::Host);
+        return develop_bitmap(m_storage, raw);
+    }
+
+    void write(const fs::path &path) const override {
+        fs::path filename = path;
+        std::string proper_extension;
+        if (m_file_format == Bitmap::FileFormat::OpenEXR)
+            proper_extension = ".exr";
+        else if (m_file_format == Bitmap::FileFormat::RGBE)
+            proper_extension = ".rgbe";
+        else
+            proper_extension = ".pfm";
+
+        std::string extension = string::to_lower(filename.extension().string());
+        if (extension != proper_extension)
+            filename.replace_extension(proper_extension);
+
+        #if !defined(_WIN32)
+            Log(Info, "\U00002714  Developing \"%s\" ..", filename.string());
+        #else
+            Log(Info, "Developing \"%s\" ..", filename.string());
+        #endif
+
+        if (!m_stream_path.empty()) {
+            write_streaming(filename);
+            return;
+        }
+
+        ref<Bitmap> source = bitmap();
+        if (m_component_format != struct_type_v<ScalarFloat>)
+            source = convert_component_format(source);
+        source->write(filename, m_file_format);
+    }
+
+    void schedule_storage() override {
+        if (m_storage)
+            dr::schedule(m_storage->tensor());
+    };
+
+    std::string to_string() const override {
+        std::ostringstream oss;
+        oss << "HDRFilm[" << std::endl
+            << "  size = " << m_size << "," << std::endl
+            << "  crop_size = " << m_crop_size << "," << std::endl
+            << "  crop_offset = " << m_crop_offset << "," << std::endl
+            << "  sample_border = " << m_sample_border << "," << std::endl
+            << "  compensate = " << m_compensate << "," << std::endl
+            << "  filter = " << m_filter << "," << std::endl
+            << "  file_format = " << m_file_format << "," << std::endl
+            << "  pixel_format = " << m_pixel_format << "," << std::endl
+            << "  component_format = " << m_component_format << "," << std::endl;
+        if (!m_stream_path.empty())
+            oss << "  stream_file = \"" << m_stream_path.string() << "\"," << std::endl;
+        oss << "]";
+        return oss.str();
+    }
+
+    MI_DECLARE_CLASS()
+protected:
+    /// Develop the contents of an image block (the film or a single tile)
+    ref<Bitmap> develop_bitmap(const ImageBlock *storage_block, bool raw) const {
+        auto &&storage = dr::migrate(storage_block->tensor().array(), AllocType::Host);
 
         if constexpr (dr::is_jit_v<Float>)
             dr::sync_thread();
@@ -437,8 +585,8 @@ public:
                                      : Bitmap::PixelFormat::MultiChannel;
 
         ref<Bitmap> source = new Bitmap(
-            source_fmt, struct_type_v<ScalarFloat>, m_storage->size(),
-            m_storage->channel_count(), m_channels, (uint8_t *) storage.data());
+            source_fmt, struct_type_v<ScalarFloat>, storage_block->size(),
+            storage_block->channel_count(), m_channels, (uint8_t *) storage.data());
 
         if (raw)
             return source;
@@ -453,11 +601,11 @@ public:
         uint32_t img_ch = to_y ? 1 : 3;
         uint32_t aovs_channel = has_aovs ? (img_ch + (uint32_t) alpha) : 0;
         uint32_t target_ch =
-            (uint32_t) m_storage->channel_count() - base_ch + aovs_channel;
+            (uint32_t) storage_block->channel_count() - base_ch + aovs_channel;
 
         ref<Bitmap> target = new Bitmap(
             has_aovs ? Bitmap::PixelFormat::MultiChannel : m_pixel_format,
-            struct_type_v<ScalarFloat>, m_storage->size(),
+            struct_type_v<ScalarFloat>, storage_block->size(),
             has_aovs ? target_ch : 0);
 
         if (has_aovs) {
@@ -543,69 +691,233 @@ public:
         return target;
     }
 
-    void write(const fs::path &path) const override {
-        fs::path filename = path;
-        std::string proper_extension;
-        if (m_file_format == Bitmap::FileFormat::OpenEXR)
-            proper_extension = ".exr";
-        else if (m_file_format == Bitmap::FileFormat::RGBE)
-            proper_extension = ".rgbe";
-        else
-            proper_extension = ".pfm";
+    /// Convert a developed bitmap to the component format of the output file
+    ref<Bitmap> convert_component_format(const Bitmap *source) const {
+        // Mismatch between the current format and the one expected by the film
+        // Conversion is necessary before saving to disk
+        std::vector<std::string> channel_names;
+        for (size_t i = 0; i < source->channel_count(); i++)
+            channel_names.push_back(source->struct_()->operator[](i).name);
+        ref<Bitmap> target = new Bitmap(
+            source->pixel_format(),
+            m_component_format,
+            source->size(),
+            source->channel_count(),
+            channel_names);
+        source->convert(target);
+        return target;
+    }
 
-        std::string extension = string::to_lower(filename.extension().string());
-        if (extension != proper_extension)
-            filename.replace_extension(proper_extension);
+    // =============================================================
+    //! @{ \name Out-of-core mode
+    // =============================================================
+
+    /**
+     * \brief Recompute the number of block submissions that each tile
+     * expects, and start a new streamed file
+     *
+     * The tiles of the streamed file coincide with the blocks generated by
+     * the integrator when \c sample_border is disabled. Blocks additionally
+     * contribute to the tiles of their neighbors due to the border of the
+     * reconstruction filter, and each block is submitted once per pass.
+     * This function replicates the integrator's block decomposition to
+     * determine when a tile is complete. Must be called with the lock held.
+     */
+    void reset_tiles() {
+        if (m_block_size == 0)
+            Throw("HDRFilm: invalid block size!");
+
+        m_tile_size = m_block_size;
+        m_tile_count = (m_crop_size + (m_tile_size - 1)) / m_tile_size;
+        m_tile_pending.assign(dr::prod(m_tile_count), 0u);
+        m_tiles.clear();
+        m_stream_discarded = false;
+
+        int filter_border = (int) m_filter->border_size(),
+            sample_border = m_sample_border ? filter_border : 0;
+
+        ScalarVector2u render_size = m_crop_size + 2u * (uint32_t) sample_border,
+                       blocks = (render_size + (m_block_size - 1)) / m_block_size;
+
+        for (uint32_t y = 0; y < blocks.y(); ++y) {
+            for (uint32_t x = 0; x < blocks.x(); ++x) {
+                ScalarPoint2i offset = ScalarPoint2i(ScalarVector2u(x, y) * m_block_size);
+                ScalarVector2i size = ScalarVector2i(
+                    dr::minimum(m_block_size, render_size - ScalarVector2u(offset)));
+                offset -= sample_border;
+
+                auto [t0, t1] = tile_range(offset - filter_border,
+                                           offset + size + filter_border);
+                for (uint32_t ty = t0.y(); ty < t1.y(); ++ty)
+                    for (uint32_t tx = t0.x(); tx < t1.x(); ++tx)
+                        m_tile_pending[tx + ty * m_tile_count.x()] += m_passes;
+            }
+        }
 
-        #if !defined(_WIN32)
-            Log(Info, "\U00002714  Developing \"%s\" ..", filename.string());
-        #else
-            Log(Info, "Developing \"%s\" ..", filename.string());
-        #endif
+        // Create the output file using a prototype of the developed tiles
+        ref<ImageBlock> prototype_block =
+            new ImageBlock(ScalarVector2u(1), m_crop_offset,
+                           (uint32_t) m_channels.size());
+        ref<Bitmap> prototype = develop_bitmap(prototype_block, false);
+        if (m_component_format != struct_type_v<ScalarFloat>)
+            prototype = convert_component_format(prototype);
+
+        fs::path parent = m_stream_path.parent_path();
+        if (!parent.empty() && !fs::exists(parent))
+            fs::create_directory(parent);
+
+        m_writer = new TiledEXRWriter(m_stream_path, m_crop_size, m_tile_size,
+                                      prototype);
+        m_stream_location = m_stream_path;
+    }
 
-        ref<Bitmap> source = bitmap();
-        if (m_component_format != struct_type_v<ScalarFloat>) {
-            // Mismatch between the current format and the one expected by the film
-            // Conversion is necessary before saving to disk
-            std::vector<std::string> channel_names;
-            for (size_t i = 0; i < source->channel_count(); i++)
-                channel_names.push_back(source->struct_()->operator[](i).name);
-            ref<Bitmap> target = new Bitmap(
-                source->pixel_format(),
-                m_component_format,
-                source->size(),
-                source->channel_count(),
-                channel_names);
-            source->convert(target);
-
-            target->write(filename, m_file_format);
-        } else {
-            source->write(filename, m_file_format);
+    /**
+     * \brief Return the range of tile indices overlapped by the given pixel
+     * rectangle (relative to the crop window, upper bound exclusive)
+     */
+    std::pair<ScalarVector2u, ScalarVector2u>
+    tile_range(const ScalarPoint2i &min, const ScalarPoint2i &max) const {
+        ScalarVector2i lo(dr::maximum(min, 0)),
+                       hi(dr::minimum(max, ScalarPoint2i(m_crop_size)));
+        if (dr::any(hi <= lo))
+            return { ScalarVector2u(0), ScalarVector2u(0) };
+        return { ScalarVector2u(lo) / m_tile_size,
+                 (ScalarVector2u(hi) + (m_tile_size - 1)) / m_tile_size };
+    }
+
+    /// Accumulate a block into the affected tiles and stream completed ones
+    void put_block_streaming(const ImageBlock *block) {
+        std::vector<std::pair<uint32_t, ref<ImageBlock>>> completed;
+
+        /* locked */ {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_tile_size == 0)
+                Throw("HDRFilm::put_block(): the out-of-core mode requires the "
+                      "block decomposition to be specified via prepare_blocks()."
+                      " This is only done by the CPU rendering code path of "
+                      "sampling-based integrators.");
+
+            if (m_writer->closed()) {
+                if (!m_stream_discarded)
+                    Log(Warn, "HDRFilm::put_block(): the streamed image was "
+                              "already finalized, discarding further "
+                              "contributions.");
+                m_stream_discarded = true;
+                return;
+            }
+
+            ScalarPoint2i min = block->offset() - (int) block->border_size() -
+                                ScalarVector2i(m_crop_offset);
+            ScalarVector2i size = ScalarVector2i(block->size()) +
+                                  2 * (int) block->border_size();
+
+            auto [t0, t1] = tile_range(min, min + size);
+            for (uint32_t ty = t0.y(); ty < t1.y(); ++ty) {
+                for (uint32_t tx = t0.x(); tx < t1.x(); ++tx) {
+                    uint32_t index = tx + ty * m_tile_count.x();
+                    if (m_tile_pending[index] == 0)
+                        Throw("HDRFilm::put_block(): received a contribution "
+                              "to tile (%u, %u), which was already streamed to "
+                              "disk. Blocks must follow the decomposition "
+                              "specified via prepare_blocks().", tx, ty);
+
+                    ref<ImageBlock> &tile = m_tiles[index];
+                    if (!tile) {
+                        ScalarVector2u offset(tx * m_tile_size, ty * m_tile_size);
+                        tile = new ImageBlock(
+                            dr::minimum(m_tile_size, m_crop_size - offset),
+                            m_crop_offset + offset, (uint32_t) m_channels.size());
+                    }
+
+                    tile->put_block(block);
+
+                    if (--m_tile_pending[index] == 0) {
+                        completed.emplace_back(index, tile);
+                        m_tiles.erase(index);
+                    }
+                }
+            }
         }
+
+        // Develop and compress completed tiles outside of the critical section
+        for (auto &[index, tile] : completed)
+            write_tile(index, tile);
     }
 
-    void schedule_storage() override {
-        dr::schedule(m_storage->tensor());
-    };
+    /// Develop a tile and write it to the streamed file
+    void write_tile(uint32_t index, const ImageBlock *tile) const {
+        ref<Bitmap> bitmap = develop_bitmap(tile, false);
+        if (m_component_format != struct_type_v<ScalarFloat>)
+            bitmap = convert_component_format(bitmap);
 
-    std::string to_string() const override {
-        std::ostringstream oss;
-        oss << "HDRFilm[" << std::endl
-            << "  size = " << m_size << "," << std::endl
-            << "  crop_size = " << m_crop_size << "," << std::endl
-            << "  crop_offset = " << m_crop_offset << "," << std::endl
-            << "  sample_border = " << m_sample_border << "," << std::endl
-            << "  compensate = " << m_compensate << "," << std::endl
-            << "  filter = " << m_filter << "," << std::endl
-            << "  file_format = " << m_file_format << "," << std::endl
-            << "  pixel_format = " << m_pixel_format << "," << std::endl
-            << "  component_format = " << m_component_format << "," << std::endl
-            << "]";
-        return oss.str();
+        ScalarPoint2u offset(index % m_tile_count.x(), index / m_tile_count.x());
+        m_writer->write_tile(offset * m_tile_size, bitmap);
     }
 
-    MI_DECLARE_CLASS()
-protected:
+    /**
+     * \brief Write all partially complete tiles and close the streamed file
+     *
+     * Tiles that never received any contributions are filled with zeros.
+     */
+    void finalize_stream() const {
+        std::vector<std::pair<uint32_t, ref<ImageBlock>>> remaining;
+
+        /* locked */ {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_writer)
+                Throw("HDRFilm: nothing was rendered in out-of-core mode yet!");
+            if (m_writer->closed())
+                return;
+            for (auto &[index, tile] : m_tiles)
+                remaining.emplace_back(index, tile);
+            m_tiles.clear();
+            std::fill(m_tile_pending.begin(), m_tile_pending.end(), 0u);
+        }
+
+        if (!remaining.empty())
+            Log(Warn, "HDRFilm: finalizing %zu partially rendered tile%s.",
+                remaining.size(), remaining.size() == 1 ? "" : "s");
+
+        for (auto &[index, tile] : remaining)
+            write_tile(index, tile);
+
+        m_writer->close();
+    }
+
+    /// Finalize the streamed file and move it to the requested location
+    void write_streaming(const fs::path &filename) const {
+        finalize_stream();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (fs::exists(filename)) {
+            if (fs::equivalent(m_stream_location, filename))
+                return;
+            fs::remove(filename);
+        }
+
+        if (!fs::rename(m_stream_location, filename)) {
+            // E.g. when moving across file systems: copy in chunks
+            ref<FileStream> src = new FileStream(m_stream_location, FileStream::ERead),
+                            dst = new FileStream(filename, FileStream::ETruncReadWrite);
+            std::unique_ptr<uint8_t[]> buffer(new uint8_t[1 << 20]);
+            size_t remaining = src->size();
+            while (remaining > 0) {
+                size_t chunk = std::min(remaining, (size_t) 1 << 20);
+                src->read(buffer.get(), chunk);
+                dst->write(buffer.get(), chunk);
+                remaining -= chunk;
+            }
+            src->close();
+            dst->close();
+            fs::remove(m_stream_location);
+        }
+
+        m_stream_location = filename;
+    }
+
+    //! @}
+    // =============================================================
+
     Bitmap::FileFormat m_file_format;
     Bitmap::PixelFormat m_pixel_format;
     Struct::Type m_component_format;
@@ -613,6 +925,20 @@ protected:
     ref<ImageBlock> m_storage;
     mutable std::mutex m_mutex;
     std::vector<std::string> m_channels;
+
+    // Out-of-core mode (only used when 'stream_file' is specified)
+    fs::path m_stream_path;
+    mutable fs::path m_stream_location;
+    ref<TiledEXRWriter> m_writer;
+    uint32_t m_block_size = 0;
+    uint32_t m_passes = 1;
+    uint32_t m_tile_size = 0;
+    ScalarVector2u m_tile_count;
+    /// Number of block submissions that each tile is still waiting for
+    mutable std::vector<uint32_t> m_tile_pending;
+    /// Tiles that have received some, but not all of their contributions
+    mutable std::unordered_map<uint32_t, ref<ImageBlock>> m_tiles;
+    bool m_stream_discarded = false;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(HDRFilm, Film)
@@ -237,3 +237,95 @@ def test07_luminance_alpha_mono(variants_all):
     image = mi.TensorXf(film.bitmap())
 
     assert image.shape[2] == 2
+
+
+@pytest.mark.parametrize('sample_border', [False, True])
+def test08_out_of_core(variant_scalar_rgb, sample_border, tmpdir):
+    import numpy as np
+    import os
+
+    stream_file = str(tmpdir.join('stream.exr'))
+    props = {
+        'type': 'hdrfilm',
+        'width': 43,
+        'height': 29,
+        'crop_offset_x': 2,
+        'crop_offset_y': 1,
+        'crop_width': 39,
+        'crop_height': 26,
+        'pixel_format': 'rgba',
+        'component_format': 'float32',
+        'sample_border': sample_border,
+        'filter': {'type': 'gaussian'}
+    }
+    film_ref = mi.load_dict(props)
+    film = mi.load_dict(dict(props, stream_file=stream_file))
+    assert film.scanline_order() and not film_ref.scanline_order()
+
+    block_size, passes = 8, 2
+    border = film.rfilter().border_size() if sample_border else 0
+    render_size = film.crop_size() + 2 * border
+
+    film_ref.prepare([])
+    film.prepare([])
+    film.prepare_blocks(block_size, passes)
+
+    # Replicate the block decomposition of SamplingIntegrator::render()
+    spiral = mi.Spiral(render_size, film.crop_offset(), block_size, passes)
+    spiral.set_scanline_order(True)
+    rng = np.random.default_rng(seed=0)
+    block = film.create_block(mi.ScalarVector2u(block_size), False, True)
+
+    while True:
+        offset, size, block_id = spiral.next_block()
+        if size[0] == 0:
+            break
+        block.set_size(size)
+        block.set_offset(mi.ScalarPoint2i(offset) - border)
+        block.clear()
+        for _ in range(20):
+            pos = [block.offset()[i] + rng.uniform() * block.size()[i]
+                   for i in range(2)]
+            block.put(pos, list(rng.uniform(size=3)) + [1.0, 1.0])
+        film_ref.put_block(block)
+        film.put_block(block)
+
+    # The finalized file is moved to the requested location
+    output = str(tmpdir.join('output.exr'))
+    film.write(output)
+    assert os.path.exists(output) and not os.path.exists(stream_file)
+
+    image_ref = film_ref.develop()
+    image = film.develop()
+    assert dr.allclose(image, image_ref, atol=1e-5)
+
+    # Blocks must follow the announced decomposition
+    film.prepare([])
+    with pytest.raises(RuntimeError, match='prepare_blocks'):
+        film.put_block(block)
+
+
+def test09_out_of_core_render(variant_scalar_rgb, tmpdir):
+    stream_file = str(tmpdir.join('stream.exr'))
+    scene = mi.load_dict({
+        'type': 'scene',
+        'integrator': {'type': 'path', 'block_size': 8},
+        'sensor': {
+            'type': 'perspective',
+            'film': {
+                'type': 'hdrfilm',
+                'width': 37,
+                'height': 21,
+                'stream_file': stream_file,
+            },
+            'sampler': {'type': 'independent', 'sample_count': 4}
+        },
+        'emitter': {'type': 'constant'}
+    })
+
+    image = mi.render(scene)
+    assert image.shape == (21, 37, 3)
+    assert dr.allclose(image, 1.0, atol=1e-3)
+
+    bitmap = mi.Bitmap(stream_file)
+    assert bitmap.size() == [37, 21]
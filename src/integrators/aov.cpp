@@ -1,3 +1,4 @@
+#include <mitsuba/core/profiler.h>
 #include <mitsuba/render/bsdf.h>
 #include <mitsuba/render/integrator.h>
 #include <mitsuba/render/records.h>
@@ -74,6 +75,10 @@ Currently, the following AOVs types are available:
     - :monosp:`duv_dx`, :monosp:`duv_dy`: UV partials wrt. changes in screen-space.
     - :monosp:`prim_index`: Primitive index (e.g. triangle index in the mesh).
     - :monosp:`shape_index`: Shape index.
+    - :monosp:`time`: Wall-clock time spent on the sample (in microseconds).
+    - :monosp:`ray_count`: Number of ray intersection and visibility queries.
+    - :monosp:`traversal_steps`: Number of visited inner kd-tree nodes.
+    - :monosp:`prim_tests`: Number of primitive intersection tests.
 
 Note that integer-valued AOVs (e.g. :monosp:`prim_index`, :monosp:`shape_index`)
 are meaningless whenever there is only partial pixel coverage or when using a
@@ -82,6 +87,31 @@ wide pixel reconstruction filter as it will result in fractional values.
 The :monosp:`albedo` AOV will evaluate the diffuse reflectance
 (\ref BSDF::eval_diffuse_reflectance) of the material. Note that depending on
 the material, this value might only be an approximation.
+
+The cost AOVs (:monosp:`time`, :monosp:`ray_count`, :monosp:`traversal_steps`
+and :monosp:`prim_tests`) measure the work performed by the nested integrators
+to compute each sample. They are written next to the rendered image and reveal
+which regions of the image (e.g. hair, glass or dense foliage) dominate the
+rendering time. With a :monosp:`box` reconstruction filter, each pixel holds
+the average cost of its samples. The kd-tree statistics are only available when
+the scene uses Mitsuba's built-in kd-tree (i.e. when Embree is disabled).
+These AOVs are only supported in scalar variants.
+
+.. tabs::
+    .. code-tab:: xml
+
+        <integrator type="aov">
+            <string name="aovs" value="cost:time,rays:ray_count"/>
+            <integrator type="path" name="image"/>
+        </integrator>
+
+    .. code-tab:: python
+
+        'type': 'aov',
+        'aovs': 'cost:time,rays:ray_count',
+        'image': {
+            'type': 'path',
+        }
  */
 
 template <typename Float, typename Spectrum>
@@ -103,6 +133,10 @@ public:
         dUVdy,
         PrimIndex,
         ShapeIndex,
+        Time,
+        RayCount,
+        TraversalSteps,
+        PrimTests,
         IntegratorRGBA
     };
 
@@ -188,6 +222,20 @@ public:
             } else if (item[1] == "shape_index") {
                 m_aov_types.push_back(Type::ShapeIndex);
                 m_aov_names.push_back(item[0] + ".I");
+            } else if (item[1] == "time" || item[1] == "ray_count" ||
+                       item[1] == "traversal_steps" || item[1] == "prim_tests") {
+                if constexpr (dr::is_jit_v<Float>)
+                    Throw("The \"%s\" AOV is only supported in scalar variants!", item[1]);
+                if (item[1] == "time") {
+                    m_aov_types.push_back(Type::Time);
+                    m_aov_names.push_back(item[0] + ".T");
+                } else {
+                    m_aov_types.push_back(item[1] == "ray_count" ? Type::RayCount
+                                        : item[1] == "traversal_steps" ? Type::TraversalSteps
+                                                                       : Type::PrimTests);
+                    m_aov_names.push_back(item[0] + ".I");
+                    m_cost_counters = true;
+                }
             } else {
                 Throw("Invalid AOV type \"%s\"!", item[1]);
             }
@@ -195,6 +243,17 @@ public:
 
         if (m_aov_names.empty())
             Log(Warn, "No AOVs were specified!");
+
+        /* Only request the cost counters once parsing can no longer throw,
+           since the destructor (and thus the matching release()) would not
+           run for a partially constructed integrator */
+        if (m_cost_counters)
+            CostCounters::acquire();
+    }
+
+    ~AOVIntegrator() {
+        if (m_cost_counters)
+            CostCounters::release();
     }
 
     std::pair<Spectrum, Mask> sample(const Scene *scene,
@@ -239,6 +298,16 @@ public:
         Float* aovs_rgba_integrator = _aovs;
         Float* aovs = _aovs + m_integrator_aovs_count;
 
+        /* Measure the cost of the sample in scalar variants. This mostly
+           covers the nested integrators, which are evaluated first. */
+        uint64_t start_time = 0;
+        CostCounters::Counters start_counters;
+        if constexpr (!dr::is_jit_v<Float>) {
+            start_time = Tracer::timestamp();
+            if (m_cost_counters)
+                start_counters = CostCounters::local();
+        }
+
         size_t inner_idx = 0;
         for (size_t i = 0; i < m_aov_types.size(); ++i) {
             switch (m_aov_types[i]) {
@@ -330,6 +399,25 @@ public:
                     }
                     break;
 
+                case Type::Time:
+                    *aovs++ = Float((Tracer::timestamp() - start_time) * 1e-3);
+                    break;
+
+                case Type::RayCount:
+                    *aovs++ = Float(CostCounters::local().ray_queries -
+                                    start_counters.ray_queries);
+                    break;
+
+                case Type::TraversalSteps:
+                    *aovs++ = Float(CostCounters::local().traversal_steps -
+                                    start_counters.traversal_steps);
+                    break;
+
+                case Type::PrimTests:
+                    *aovs++ = Float(CostCounters::local().prim_tests -
+                                    start_counters.prim_tests);
+                    break;
+
                 case Type::IntegratorRGBA: {
                     auto [inner_spec, inner_mask] 
                         = m_integrators[inner_idx]->sample(scene, sampler, ray, medium, aovs, active);
@@ -556,6 +644,7 @@ protected:
 
 private:
     size_t m_integrator_aovs_count;
+    bool m_cost_counters = false;
     std::vector<Type> m_aov_types;
     std::vector<std::string> m_aov_names;
     std::vector<ref<Base>> m_integrators;
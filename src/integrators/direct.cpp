@@ -120,7 +120,8 @@ public:
         MI_MASKED_FUNCTION(ProfilerPhase::SamplingIntegratorSample, active);
 
         SurfaceInteraction3f si = scene->ray_intersect(
-            ray, +RayFlags::All, /* coherent = */ true, active);
+            ray, +RayFlags::All | +RayFlags::CameraRay, /* coherent = */ true,
+            active);
         Mask valid_ray = active && si.is_valid();
 
         Spectrum result(0.f);
@@ -179,8 +180,13 @@ public:
             Mask active_b = active && dr::any(dr::neq(unpolarized_spectrum(bsdf_val), 0.f));
 
             // Trace the ray in the sampled direction and intersect against the scene
+            UInt32 ray_types = dr::select(
+                has_flag(bs.sampled_type, BSDFFlags::Delta),
+                UInt32(+RayFlags::SpecularRay), UInt32(+RayFlags::DiffuseRay));
             SurfaceInteraction3f si_bsdf =
-                scene->ray_intersect(si.spawn_ray(si.to_world(bs.wo)), active_b);
+                scene->ray_intersect(si.spawn_ray(si.to_world(bs.wo)),
+                                     +RayFlags::All, ray_types,
+                                     /* coherent = */ false, active_b);
 
             // Retain only rays that hit an emitter
             EmitterPtr emitter = si_bsdf.emitter(scene, active_b);
@@ -0,0 +1,711 @@
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <mitsuba/core/ray.h>
+#include <mitsuba/core/properties.h>
+#include <mitsuba/core/frame.h>
+#include <mitsuba/core/timer.h>
+#include <mitsuba/core/util.h>
+#include <mitsuba/render/bsdf.h>
+#include <mitsuba/render/emitter.h>
+#include <mitsuba/render/integrator.h>
+#include <mitsuba/render/records.h>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**!
+
+.. _integrator-irrcache:
+
+Irradiance caching (:monosp:`irrcache`)
+---------------------------------------
+
+.. pluginparameters::
+
+ * - max_depth
+   - |int|
+   - Specifies the longest path depth in the generated output image (where -1
+     corresponds to :math:`\infty`). Path depths of the final gather rays are
+     counted from the diffuse vertex that created the cache record.
+     (Default: -1)
+
+ * - rr_depth
+   - |int|
+   - Specifies the path depth, at which the implementation will begin to use
+     the *russian roulette* path termination criterion. (Default: 5)
+
+ * - hide_emitters
+   - |bool|
+   - Hide directly visible emitters. (Default: no, i.e. |false|)
+
+ * - error
+   - |float|
+   - Maximum allowed interpolation error :math:`a` of Ward's error metric.
+     Smaller values create more cache records. (Default: 0.2)
+
+ * - gather_samples
+   - |int|
+   - Number of stratified final gather rays traced to create a new cache
+     record. (Default: 512)
+
+ * - min_radius, max_radius
+   - |float|
+   - Lower and upper bound on the radius of a cache record, specified as a
+     fraction of the scene's bounding box diagonal. (Default: 0.001 and 0.05)
+
+This integrator implements *irradiance caching* [Ward et al. 1988], which
+exploits the smoothness of indirect illumination on diffuse surfaces. It is
+well suited for diffuse-dominated interiors, where a regular path tracer needs
+many samples per pixel to converge the indirect component.
+
+Whenever a camera path reaches a purely diffuse surface, direct illumination
+is computed via emitter sampling, and the indirect irradiance is interpolated
+from nearby *cache records*. When no record is close enough, a new one is
+created on demand using a stratified *final gather*: every gather ray estimates
+the incident indirect radiance using the same path tracing machinery as the
+:ref:`path <integrator-path>` plugin. Every record additionally stores the
+rotational and translational irradiance gradients of [Ward and Heckbert 1992],
+which noticeably improve the interpolation quality. Glossy, specular and
+transmissive surfaces are handled by regular path tracing, so that caustics and
+reflections of diffuse surfaces are rendered correctly.
+
+Records are stored in an octree that supports concurrent lookups and
+insertions without locks. The cache is created at the beginning of every
+``render()`` call and populated lazily by the rendering threads.
+
+.. note:: This integrator is only available in scalar RGB and monochrome
+   variants, and it does not handle participating media. Since records are
+   created in the order in which rendering threads encounter them, renderings
+   are not bit-wise reproducible across runs.
+
+.. tabs::
+    .. code-tab::  xml
+        :name: irrcache-integrator
+
+        <integrator type="irrcache">
+            <float name="error" value="0.2"/>
+            <integer name="gather_samples" value="512"/>
+        </integrator>
+
+    .. code-tab:: python
+
+        'type': 'irrcache',
+        'error': 0.2,
+        'gather_samples': 512
+
+ */
+
+template <typename Float, typename Spectrum>
+class IrradianceCacheIntegrator : public MonteCarloIntegrator<Float, Spectrum> {
+public:
+    MI_IMPORT_BASE(MonteCarloIntegrator, m_max_depth, m_rr_depth, m_hide_emitters)
+    MI_IMPORT_TYPES(Scene, Sensor, Sampler, Medium, Emitter, EmitterPtr, BSDF, BSDFPtr)
+
+    /// Irradiance caching relies on per-sample control flow and RGB/mono records
+    static constexpr bool Supported = !dr::is_array_v<Float> &&
+                                      !is_spectral_v<Spectrum> &&
+                                      !is_polarized_v<Spectrum>;
+
+    using ScalarSpectrum = dr::replace_scalar_t<UnpolarizedSpectrum, ScalarFloat>;
+
+    /// A single irradiance cache record
+    struct Record {
+        ScalarPoint3f p;
+        ScalarNormal3f n;
+        /// Harmonic mean distance to the surrounding geometry (clamped)
+        ScalarFloat radius;
+        ScalarSpectrum irradiance;
+        /// Rotational and translational gradients (one spectrum per axis)
+        ScalarSpectrum grad_r[3], grad_t[3];
+    };
+
+    struct RecordNode {
+        Record record;
+        RecordNode *next;
+    };
+
+    /// Octree node supporting concurrent, lock-free insertion
+    struct OctreeNode {
+        std::atomic<RecordNode *> records;
+        std::atomic<OctreeNode *> children[8];
+
+        OctreeNode() {
+            records.store(nullptr, std::memory_order_relaxed);
+            for (auto &c : children)
+                c.store(nullptr, std::memory_order_relaxed);
+        }
+
+        ~OctreeNode() {
+            RecordNode *r = records.load(std::memory_order_relaxed);
+            while (r) {
+                RecordNode *next = r->next;
+                delete r;
+                r = next;
+            }
+            for (auto &c : children)
+                delete c.load(std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * \brief Octree storing irradiance cache records
+     *
+     * Every record is stored in the deepest node that is at least twice as
+     * large as the record's region of influence. Lookups consequently only
+     * need to visit nodes whose bounds, enlarged by half their size in every
+     * direction, contain the query point.
+     */
+    class IrradianceCache {
+    public:
+        IrradianceCache(const ScalarBoundingBox3f &bbox) {
+            ScalarVector3f extents = bbox.valid() ? bbox.extents() : ScalarVector3f(1.f);
+            m_center = bbox.valid() ? bbox.center() : ScalarPoint3f(0.f);
+            m_half_size = .5f * dr::max(extents) * (1.f + math::RayEpsilon<ScalarFloat>) +
+                          math::RayEpsilon<ScalarFloat>;
+            m_diagonal = dr::norm(extents);
+        }
+
+        /// Insert a record with the given region of influence
+        void insert(const Record &record, ScalarFloat influence) {
+            OctreeNode *node = &m_root;
+            ScalarPoint3f center = m_center;
+            ScalarFloat half_size = m_half_size;
+
+            if (dr::all(dr::abs(record.p - center) <= half_size)) {
+                for (int depth = 0; depth < MaxDepth && influence <= .5f * half_size; ++depth) {
+                    uint32_t index = 0;
+                    for (int i = 0; i < 3; ++i) {
+                        if (record.p[i] > center[i])
+                            index |= 1u << i;
+                    }
+
+                    OctreeNode *child = node->children[index].load(std::memory_order_acquire);
+                    if (!child) {
+                        OctreeNode *new_child = new OctreeNode();
+                        if (node->children[index].compare_exchange_strong(
+                                child, new_child, std::memory_order_acq_rel))
+                            child = new_child;
+                        else
+                            delete new_child; // Another thread was faster
+                    }
+
+                    half_size *= .5f;
+                    for (int i = 0; i < 3; ++i)
+                        center[i] += (index & (1u << i)) ? half_size : -half_size;
+                    node = child;
+                }
+            }
+
+            RecordNode *entry = new RecordNode{ record, nullptr };
+            entry->next = node->records.load(std::memory_order_relaxed);
+            while (!node->records.compare_exchange_weak(entry->next, entry,
+                                                        std::memory_order_release,
+                                                        std::memory_order_relaxed))
+                ;
+            m_size.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// Invoke \c func for every record that may influence the point \c p
+        template <typename Func> void lookup(const ScalarPoint3f &p, Func &&func) const {
+            visit(&m_root, m_center, m_half_size, p, func, true);
+        }
+
+        size_t size() const { return m_size.load(std::memory_order_relaxed); }
+        ScalarFloat diagonal() const { return m_diagonal; }
+
+    private:
+        template <typename Func>
+        static void visit(const OctreeNode *node, const ScalarPoint3f &center,
+                          ScalarFloat half_size, const ScalarPoint3f &p,
+                          Func &func, bool root = false) {
+            if (!root && dr::any(dr::abs(p - center) > 2.f * half_size))
+                return;
+
+            for (const RecordNode *r = node->records.load(std::memory_order_acquire);
+                 r; r = r->next)
+                func(r->record);
+
+            ScalarFloat child_half_size = .5f * half_size;
+            for (uint32_t index = 0; index < 8; ++index) {
+                const OctreeNode *child = node->children[index].load(std::memory_order_acquire);
+                if (!child)
+                    continue;
+                ScalarPoint3f child_center = center;
+                for (int i = 0; i < 3; ++i)
+                    child_center[i] += (index & (1u << i)) ? child_half_size : -child_half_size;
+                visit(child, child_center, child_half_size, p, func);
+            }
+        }
+
+    private:
+        static constexpr int MaxDepth = 32;
+        OctreeNode m_root;
+        ScalarPoint3f m_center;
+        ScalarFloat m_half_size;
+        ScalarFloat m_diagonal;
+        std::atomic<size_t> m_size { 0 };
+    };
+
+    IrradianceCacheIntegrator(const Properties &props) : Base(props) {
+        if constexpr (!Supported)
+            Throw("The irradiance caching integrator is only available in "
+                  "scalar RGB and monochrome variants!");
+
+        m_error = props.get<ScalarFloat>("error", 0.2f);
+        if (m_error <= 0.f)
+            Throw("\"error\" must be positive!");
+
+        int gather_samples = props.get<int>("gather_samples", 512);
+        if (gather_samples < 6)
+            Throw("\"gather_samples\" must be at least 6!");
+
+        // Stratify the hemisphere into M x N cells with N ~= pi * M
+        m_gather_theta = std::max(2u, (uint32_t) std::lround(
+            dr::sqrt(gather_samples * dr::InvPi<ScalarFloat>)));
+        m_gather_phi = std::max(3u, (uint32_t) std::lround(
+            (ScalarFloat) gather_samples / m_gather_theta));
+
+        m_min_radius = props.get<ScalarFloat>("min_radius", 1e-3f);
+        m_max_radius = props.get<ScalarFloat>("max_radius", 5e-2f);
+        if (m_min_radius <= 0.f || m_max_radius < m_min_radius)
+            Throw("Invalid record radius bounds: expected 0 < min_radius <= max_radius!");
+    }
+
+    ~IrradianceCacheIntegrator() {
+        delete m_cache.load();
+    }
+
+    using Base::render;
+
+    TensorXf render(Scene *scene,
+                    Sensor *sensor,
+                    uint32_t seed = 0,
+                    uint32_t spp = 0,
+                    bool develop = true,
+                    bool evaluate = true) override {
+        m_cache_scene = scene;
+        delete m_cache.exchange(new IrradianceCache(scene->bbox()));
+
+        Timer timer;
+        TensorXf result = Base::render(scene, sensor, seed, spp, develop, evaluate);
+        Log(Info, "Irradiance cache contains %zu records (%s).",
+            m_cache.load()->size(), util::time_string((float) timer.value()));
+
+        return result;
+    }
+
+    std::pair<Spectrum, Bool> sample(const Scene *scene,
+                                     Sampler *sampler,
+                                     const RayDifferential3f &ray,
+                                     const Medium * /* medium */,
+                                     Float * /* aovs */,
+                                     Bool active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::SamplingIntegratorSample, active);
+
+        if constexpr (!Supported) {
+            DRJIT_MARK_USED(scene);
+            DRJIT_MARK_USED(sampler);
+            DRJIT_MARK_USED(ray);
+            Throw("IrradianceCacheIntegrator::sample(): unsupported variant!");
+        } else {
+            if (unlikely(m_max_depth == 0 || !active))
+                return { 0.f, false };
+
+            Bool valid;
+            Spectrum result = trace(scene, sampler, Ray3f(ray), 0, false, valid);
+            return { dr::select(valid, result, 0.f), valid };
+        }
+    }
+
+    //! @}
+    // =============================================================
+
+    std::string to_string() const override {
+        return tfm::format("IrradianceCacheIntegrator[\n"
+            "  max_depth = %u,\n"
+            "  rr_depth = %u,\n"
+            "  error = %f,\n"
+            "  gather_samples = %u x %u,\n"
+            "  radius = [%f, %f]\n"
+            "]", m_max_depth, m_rr_depth, m_error, m_gather_theta,
+            m_gather_phi, m_min_radius, m_max_radius);
+    }
+
+protected:
+    /**
+     * \brief Trace a path starting with \c ray
+     *
+     * When \c gather is \c false, the path terminates at the first purely
+     * diffuse vertex, whose indirect illumination is obtained from the
+     * irradiance cache. Otherwise, this function estimates the indirect
+     * radiance arriving along a final gather ray: emission at the first
+     * vertex is skipped (it is accounted for by emitter sampling at the
+     * record position), and the cache is not used. The distance to the first
+     * intersection is then returned via \c hit_t.
+     */
+    Spectrum trace(const Scene *scene, Sampler *sampler, Ray3f ray,
+                   uint32_t depth, bool gather, Bool &valid,
+                   Float *hit_t = nullptr) const {
+        if constexpr (!Supported) {
+            DRJIT_MARK_USED(scene); DRJIT_MARK_USED(sampler);
+            DRJIT_MARK_USED(ray); DRJIT_MARK_USED(depth);
+            DRJIT_MARK_USED(gather); DRJIT_MARK_USED(valid);
+            DRJIT_MARK_USED(hit_t);
+            Throw("IrradianceCacheIntegrator::trace(): unsupported variant!");
+        } else {
+            BSDFContext bsdf_ctx;
+            Spectrum throughput = 1.f, result = 0.f;
+            Float eta = 1.f;
+            bool first_vertex = true;
+
+            // If m_hide_emitters == false, the environment emitter will be visible
+            valid = !m_hide_emitters && scene->environment() != nullptr;
+
+            // Variables caching information from the previous bounce
+            Interaction3f prev_si = dr::zeros<Interaction3f>();
+            Float prev_bsdf_pdf   = 1.f;
+            bool prev_bsdf_delta  = true;
+
+            while (true) {
+                SurfaceInteraction3f si =
+                    scene->ray_intersect(ray, +RayFlags::All,
+                                         /* coherent = */ depth == 0 && !gather);
+
+                if (first_vertex && hit_t)
+                    *hit_t = si.t;
+
+                // ---------------------- Direct emission ----------------------
+
+                if (!(gather && first_vertex) && si.emitter(scene) != nullptr) {
+                    DirectionSample3f ds(scene, si, prev_si);
+                    Float em_pdf = 0.f;
+                    if (!prev_bsdf_delta)
+                        em_pdf = scene->pdf_emitter_direction(prev_si, ds);
+
+                    result += throughput * ds.emitter->eval(si, prev_bsdf_pdf > 0.f) *
+                              mis_weight(prev_bsdf_pdf, em_pdf);
+                }
+                first_vertex = false;
+
+                // Continue tracing the path at this point?
+                if (depth + 1 >= m_max_depth || !si.is_valid())
+                    break;
+
+                BSDFPtr bsdf = si.bsdf(ray);
+
+                // ------------------- Irradiance cache lookup -------------------
+
+                if (!gather && depth + 2 < m_max_depth && is_cacheable(bsdf, si)) {
+                    Normal3f n = si.sh_frame.n;
+                    if (Frame3f::cos_theta(si.wi) < 0.f)
+                        n = -n;
+
+                    Spectrum direct = 0.f;
+                    auto [ds, em_weight] = scene->sample_emitter_direction(
+                        si, sampler->next_2d(), true);
+                    if (ds.pdf != 0.f)
+                        direct = bsdf->eval(bsdf_ctx, si, si.to_local(ds.d)) * em_weight;
+
+                    Spectrum albedo = bsdf->eval_diffuse_reflectance(si);
+                    Spectrum irradiance = 0.f;
+                    if (dr::any(dr::neq(albedo, 0.f)))
+                        irradiance = cached_irradiance(scene, sampler, si, n);
+
+                    result += throughput * (direct + albedo * irradiance * dr::InvPi<Float>);
+                    valid = true;
+                    break;
+                }
+
+                // ---------------------- Emitter sampling ----------------------
+
+                DirectionSample3f ds = dr::zeros<DirectionSample3f>();
+                Spectrum em_weight = 0.f;
+                Vector3f wo = dr::zeros<Vector3f>();
+                bool active_em = has_flag(bsdf->flags(), BSDFFlags::Smooth);
+
+                if (active_em) {
+                    std::tie(ds, em_weight) = scene->sample_emitter_direction(
+                        si, sampler->next_2d(), true);
+                    active_em = ds.pdf != 0.f;
+                    wo = si.to_local(ds.d);
+                }
+
+                // ------ Evaluate BSDF * cos(theta) and sample direction -------
+
+                Float sample_1 = sampler->next_1d();
+                Point2f sample_2 = sampler->next_2d();
+
+                auto [bsdf_val, bsdf_pdf, bsdf_sample, bsdf_weight] =
+                    bsdf->eval_pdf_sample(bsdf_ctx, si, wo, sample_1, sample_2);
+
+                if (active_em) {
+                    Float mis_em = ds.delta ? 1.f : mis_weight(ds.pdf, bsdf_pdf);
+                    result += throughput * bsdf_val * em_weight * mis_em;
+                }
+
+                // ---------------------- BSDF sampling ----------------------
+
+                ray = si.spawn_ray(si.to_world(bsdf_sample.wo));
+
+                throughput *= bsdf_weight;
+                eta *= bsdf_sample.eta;
+                valid |= !has_flag(bsdf_sample.sampled_type, BSDFFlags::Null);
+
+                prev_si = si;
+                prev_bsdf_pdf = bsdf_sample.pdf;
+                prev_bsdf_delta = has_flag(bsdf_sample.sampled_type, BSDFFlags::Delta);
+
+                // -------------------- Stopping criterion ---------------------
+
+                depth++;
+
+                Float throughput_max = dr::max(throughput);
+                if (throughput_max == 0.f)
+                    break;
+
+                if (depth >= m_rr_depth) {
+                    Float rr_prob = dr::minimum(throughput_max * dr::sqr(eta), .95f);
+                    if (sampler->next_1d() >= rr_prob)
+                        break;
+                    throughput *= dr::rcp(rr_prob);
+                }
+            }
+
+            return result;
+        }
+    }
+
+    /// Can the indirect illumination at this vertex be interpolated?
+    bool is_cacheable(const BSDF *bsdf, const SurfaceInteraction3f &si) const {
+        if constexpr (!Supported) {
+            DRJIT_MARK_USED(bsdf);
+            DRJIT_MARK_USED(si);
+            return false;
+        } else {
+            uint32_t flags = bsdf->flags();
+            if (!has_flag(flags, BSDFFlags::DiffuseReflection) ||
+                has_flag(flags, BSDFFlags::Glossy) ||
+                has_flag(flags, BSDFFlags::Delta) ||
+                has_flag(flags, BSDFFlags::Transmission) ||
+                has_flag(flags, BSDFFlags::Anisotropic))
+                return false;
+
+            // One-sided BSDFs don't reflect light arriving from the back
+            return Frame3f::cos_theta(si.wi) > 0.f ||
+                   has_flag(flags, BSDFFlags::BackSide);
+        }
+    }
+
+    /// Interpolate the irradiance from the cache, creating a new record if needed
+    Spectrum cached_irradiance(const Scene *scene, Sampler *sampler,
+                               const SurfaceInteraction3f &si,
+                               const Normal3f &n) const {
+        if constexpr (!Supported) {
+            DRJIT_MARK_USED(scene); DRJIT_MARK_USED(sampler);
+            DRJIT_MARK_USED(si); DRJIT_MARK_USED(n);
+            return 0.f;
+        } else {
+            IrradianceCache *cache = cache_for(scene);
+
+            ScalarSpectrum value = 0.f;
+            ScalarFloat weight = 0.f;
+            ScalarFloat max_weight = dr::rcp(m_error);
+
+            cache->lookup(si.p, [&](const Record &r) {
+                Vector3f d = si.p - r.p;
+                Float cos_n = dr::dot(n, r.n);
+
+                // Reject records "in front" of the query point
+                if (dr::dot(d, n + r.n) * .5f < -.01f * r.radius)
+                    return;
+
+                Float denom = dr::norm(d) / r.radius +
+                              dr::safe_sqrt(1.f - cos_n);
+                Float w = denom > 0.f ? dr::rcp(denom) : dr::Infinity<Float>;
+                if (w <= max_weight)
+                    return;
+                w = dr::minimum(w, 1e6f);
+
+                Vector3f rot = dr::cross(r.n, n);
+                ScalarSpectrum e = r.irradiance;
+                for (int i = 0; i < 3; ++i)
+                    e += r.grad_r[i] * rot[i] + r.grad_t[i] * d[i];
+
+                value += w * dr::maximum(e, 0.f);
+                weight += w;
+            });
+
+            if (weight > 0.f)
+                return value / weight;
+
+            Record record = compute_record(scene, sampler, si, n, cache->diagonal());
+            cache->insert(record, m_error * record.radius);
+            return record.irradiance;
+        }
+    }
+
+    /**
+     * \brief Create a new cache record via a stratified final gather
+     *
+     * Besides the irradiance, this function computes the rotational and
+     * translational gradients following Ward and Heckbert's "Irradiance
+     * Gradients" (1992).
+     */
+    Record compute_record(const Scene *scene, Sampler *sampler,
+                          const SurfaceInteraction3f &si, const Normal3f &n,
+                          ScalarFloat diagonal) const {
+        Record record;
+        if constexpr (!Supported) {
+            DRJIT_MARK_USED(scene); DRJIT_MARK_USED(sampler);
+            DRJIT_MARK_USED(si); DRJIT_MARK_USED(n);
+            DRJIT_MARK_USED(diagonal);
+        } else {
+            const uint32_t M = m_gather_theta, N = m_gather_phi;
+            std::vector<Spectrum> radiance(M * N);
+            std::vector<Float> dist(M * N);
+
+            Frame3f frame(n);
+            Spectrum sum = 0.f;
+            Float inv_dist_sum = 0.f;
+
+            for (uint32_t j = 0; j < M; ++j) {
+                for (uint32_t k = 0; k < N; ++k) {
+                    Float sin2_theta = (j + sampler->next_1d()) / M,
+                          phi = dr::TwoPi<Float> * (k + sampler->next_1d()) / N;
+                    Float sin_theta = dr::sqrt(sin2_theta),
+                          cos_theta = dr::safe_sqrt(1.f - sin2_theta);
+                    auto [sin_phi, cos_phi] = dr::sincos(phi);
+
+                    Vector3f d = frame.to_world(Vector3f(
+                        sin_theta * cos_phi, sin_theta * sin_phi, cos_theta));
+
+                    Bool valid;
+                    Float t = dr::Infinity<Float>;
+                    Spectrum L = trace(scene, sampler, si.spawn_ray(d), 1,
+                                       true, valid, &t);
+
+                    radiance[j * N + k] = L;
+                    dist[j * N + k] = t;
+                    sum += L;
+                    if (dr::isfinite(t) && t > 0.f)
+                        inv_dist_sum += dr::rcp(t);
+                }
+            }
+
+            record.p = si.p;
+            record.n = n;
+            record.irradiance = sum * (dr::Pi<Float> / (M * N));
+
+            // Gradients, expressed in the local frame (s, t, n)
+            Spectrum grad_r[2] = { 0.f, 0.f }, grad_t[2] = { 0.f, 0.f };
+            for (uint32_t k = 0; k < N; ++k) {
+                Float phi_c = dr::TwoPi<Float> * (k + .5f) / N,
+                      phi_m = dr::TwoPi<Float> * k / N;
+                auto [sin_phi_c, cos_phi_c] = dr::sincos(phi_c);
+                auto [sin_phi_m, cos_phi_m] = dr::sincos(phi_m);
+
+                // u_k points along phi_k, v_k along phi_k + pi/2
+                Vector2f u_k(cos_phi_c, sin_phi_c),
+                         v_k(-sin_phi_c, cos_phi_c),
+                         v_km(-sin_phi_m, cos_phi_m);
+
+                Spectrum rot_sum = 0.f, trans_theta = 0.f, trans_phi = 0.f;
+                uint32_t k_prev = (k + N - 1) % N;
+
+                for (uint32_t j = 0; j < M; ++j) {
+                    Float sin2_c = (j + .5f) / M;
+                    Float tan_theta = dr::sqrt(sin2_c / (1.f - sin2_c));
+                    const Spectrum &L = radiance[j * N + k];
+                    rot_sum -= tan_theta * L;
+
+                    Float sin_m = dr::sqrt((Float) j / M),
+                          cos_m = dr::safe_sqrt(1.f - (Float) j / M),
+                          cos_p = dr::safe_sqrt(1.f - (Float) (j + 1) / M);
+
+                    if (j > 0) {
+                        Float r = dr::minimum(dist[j * N + k], dist[(j - 1) * N + k]);
+                        trans_theta += (sin_m * dr::sqr(cos_m) / r) *
+                                       (L - radiance[(j - 1) * N + k]);
+                    }
+
+                    Float r = dr::minimum(dist[j * N + k], dist[j * N + k_prev]);
+                    trans_phi += ((cos_m - cos_p) / (dr::sqrt(sin2_c) * r)) *
+                                 (L - radiance[j * N + k_prev]);
+                }
+
+                for (int i = 0; i < 2; ++i) {
+                    grad_r[i] += v_k[i] * rot_sum;
+                    grad_t[i] += u_k[i] * trans_theta * (dr::TwoPi<Float> / N) +
+                                 v_km[i] * trans_phi;
+                }
+            }
+
+            for (int i = 0; i < 2; ++i)
+                grad_r[i] *= dr::Pi<Float> / (M * N);
+
+            // Convert to world space
+            for (int i = 0; i < 3; ++i) {
+                record.grad_r[i] = grad_r[0] * frame.s[i] + grad_r[1] * frame.t[i];
+                record.grad_t[i] = grad_t[0] * frame.s[i] + grad_t[1] * frame.t[i];
+            }
+
+            // Harmonic mean distance, limited by the translational gradient
+            Float radius = inv_dist_sum > 0.f ? (M * N) / inv_dist_sum
+                                              : dr::Infinity<Float>;
+            Float grad_norm = dr::norm(Vector3f(dr::mean(record.grad_t[0]),
+                                                dr::mean(record.grad_t[1]),
+                                                dr::mean(record.grad_t[2])));
+            if (grad_norm > 0.f)
+                radius = dr::minimum(radius, dr::mean(record.irradiance) / grad_norm);
+
+            record.radius = dr::clamp(radius, m_min_radius * diagonal,
+                                      m_max_radius * diagonal);
+        }
+        return record;
+    }
+
+    /// Return the irradiance cache, creating it when sample() is used directly
+    IrradianceCache *cache_for(const Scene *scene) const {
+        IrradianceCache *cache = m_cache.load(std::memory_order_acquire);
+        if (likely(cache && m_cache_scene == scene))
+            return cache;
+
+        std::lock_guard<std::mutex> guard(m_cache_mutex);
+        cache = m_cache.load(std::memory_order_acquire);
+        if (!cache || m_cache_scene != scene) {
+            cache = new IrradianceCache(scene->bbox());
+            /* Records of the previous cache may still be in use by concurrent
+               callers rendering a different scene, hence it is retired only
+               once the integrator is destroyed. */
+            m_retired.emplace_back(m_cache.exchange(cache, std::memory_order_acq_rel));
+            m_cache_scene = scene;
+        }
+        return cache;
+    }
+
+    /// Compute a multiple importance sampling weight using the power heuristic
+    Float mis_weight(Float pdf_a, Float pdf_b) const {
+        pdf_a *= pdf_a;
+        pdf_b *= pdf_b;
+        Float w = pdf_a / (pdf_a + pdf_b);
+        return dr::detach<true>(dr::select(dr::isfinite(w), w, 0.f));
+    }
+
+    MI_DECLARE_CLASS()
+protected:
+    ScalarFloat m_error;
+    uint32_t m_gather_theta;
+    uint32_t m_gather_phi;
+    ScalarFloat m_min_radius;
+    ScalarFloat m_max_radius;
+
+    mutable std::atomic<IrradianceCache *> m_cache { nullptr };
+    mutable std::atomic<const Scene *> m_cache_scene { nullptr };
+    mutable std::mutex m_cache_mutex;
+    mutable std::vector<std::unique_ptr<IrradianceCache>> m_retired;
+};
+
+MI_IMPLEMENT_CLASS_VARIANT(IrradianceCacheIntegrator, MonteCarloIntegrator)
+MI_EXPORT_PLUGIN(IrradianceCacheIntegrator, "Irradiance caching integrator");
+NAMESPACE_END(mitsuba)
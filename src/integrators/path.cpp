@@ -143,10 +143,16 @@ public:
             /* dr::Loop implicitly masks all code in the loop using the 'active'
                flag, so there is no need to pass it to every function */
 
+            // Classify the ray for per-shape visibility (see \ref RayFlags)
+            UInt32 ray_types = dr::select(
+                dr::eq(depth, 0u), UInt32(+RayFlags::CameraRay),
+                dr::select(prev_bsdf_delta, UInt32(+RayFlags::SpecularRay),
+                           UInt32(+RayFlags::DiffuseRay)));
+
             SurfaceInteraction3f si =
-                scene->ray_intersect(ray,
-                                     /* ray_flags = */ +RayFlags::All,
-                                     /* coherent = */ dr::eq(depth, 0u));
+                scene->ray_intersect(ray, +RayFlags::All, ray_types,
+                                     /* coherent = */ dr::eq(depth, 0u),
+                                     active);
 
             // ---------------------- Direct emission ----------------------
 
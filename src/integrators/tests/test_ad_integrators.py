@@ -953,6 +953,56 @@ def test04_render_custom_op(variants_all_ad_rgb):
         mi.util.write_bitmap(filename, error)
         assert False
 
+
+@pytest.mark.skipif(os.name == 'nt', reason='Skip those memory heavy tests on Windows')
+@pytest.mark.parametrize('integrator_name', ['prb', 'prbvolpath'])
+def test05_rendering_max_spp_per_pass(variants_all_ad_rgb, integrator_name):
+    config = DiffuseAlbedoConfig()
+    config.res = 32
+    config.initialize()
+
+    import mitsuba
+    importlib.reload(mitsuba.ad.integrators)
+
+    def render_backward(max_spp_per_pass, spp):
+        integrator = mi.load_dict({
+            'type': integrator_name,
+            'max_depth': config.integrator_dict['max_depth'],
+            'max_spp_per_pass': max_spp_per_pass
+        })
+        theta = mi.Float(0.0)
+        dr.enable_grad(theta)
+        config.update(theta)
+        image_adj = mi.TensorXf(1.0, (config.res, config.res, 3))
+        integrator.render_backward(
+            config.scene, grad_in=image_adj, seed=0, spp=spp, params=theta)
+        return dr.grad(theta)[0]
+
+    # A single pass renders exactly the same samples
+    grad = render_backward(0, 64)
+    assert dr.allclose(render_backward(64, 64), grad)
+
+    # Gradients of several passes are accumulated with the right weights
+    grad_split = render_backward(16, 64)
+    assert dr.abs(grad_split - grad) / dr.abs(grad) < 0.02
+
+    # The forward pass is split in the same way
+    integrator = mi.load_dict({
+        'type': integrator_name,
+        'max_depth': config.integrator_dict['max_depth'],
+        'max_spp_per_pass': 16
+    })
+    theta = mi.Float(0.0)
+    dr.enable_grad(theta)
+    config.update(theta)
+    dr.forward(theta, dr.ADFlag.ClearEdges)
+    image_fwd = integrator.render_forward(config.scene, seed=0, spp=64, params=theta)
+    assert dr.allclose(dr.mean(image_fwd)[0] * dr.width(image_fwd),
+                       grad_split, rtol=0.02)
+
+    with pytest.raises(Exception):
+        mi.load_dict({'type': integrator_name, 'max_spp_per_pass': -1})
+
 # -------------------------------------------------------------------
 #                      Generate reference images
 # -------------------------------------------------------------------
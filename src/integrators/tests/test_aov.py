@@ -175,4 +175,34 @@ def test05_check_aov_film(variants_all_rgb):
     bitmap_aov = film.bitmap(raw=False)
 
     # Make sure radiance is consistent
-    assert(np.allclose(bitmap_aov.split()[0][1],bitmap_path.split()[0][1]))
\ No newline at end of file
+    assert(np.allclose(bitmap_aov.split()[0][1],bitmap_path.split()[0][1]))
+
+def test06_cost_aovs(variant_scalar_rgb):
+    scene = mi.load_file(find_resource('resources/data/scenes/cbox/cbox.xml'))
+
+    aov_integrator = mi.load_dict({
+        'type': 'aov',
+        'aovs': 'tt:time,rc:ray_count',
+        'my_image': {
+            'type': 'path',
+            'max_depth': 3
+        }
+    })
+
+    image = aov_integrator.render(scene, seed=0, spp=4)
+    time, rays = image[:, :, -2], image[:, :, -1]
+
+    assert dr.all(time >= 0, axis=None)
+    # Every sample traces its camera ray, plus at most one shadow ray and
+    # one continuation ray per path vertex
+    assert dr.all(rays >= 1, axis=None)
+    assert dr.all(rays <= 6, axis=None)
+
+
+def test07_cost_aovs_unsupported(variants_vec_rgb):
+    with pytest.raises(RuntimeError, match='only supported in scalar variants'):
+        mi.load_dict({
+            'type': 'aov',
+            'aovs': 'tt:time',
+            'my_image': {'type': 'path'}
+        })
@@ -0,0 +1,66 @@
+import pytest
+import drjit as dr
+import mitsuba as mi
+
+
+def create_furnace_scene(integrator, reflectance=0.5, radiance=1.0):
+    """Camera inside an emitting, diffuse sphere: L = Le / (1 - rho)"""
+    return mi.load_dict({
+        'type': 'scene',
+        'integrator': integrator,
+        'sensor': {
+            'type': 'perspective',
+            'to_world': mi.ScalarTransform4f.look_at(origin=(0, 0, 0),
+                                                     target=(0, 0, 1),
+                                                     up=(0, 1, 0)),
+            'sampler': { 'type': 'independent', 'sample_count': 4 },
+            'film': {
+                'type': 'hdrfilm',
+                'width': 4, 'height': 4,
+                'rfilter': { 'type': 'box' }
+            },
+        },
+        'sphere': {
+            'type': 'sphere',
+            'flip_normals': True,
+            'bsdf': {
+                'type': 'diffuse',
+                'reflectance': { 'type': 'rgb', 'value': reflectance }
+            },
+            'emitter': {
+                'type': 'area',
+                'radiance': { 'type': 'rgb', 'value': radiance }
+            }
+        }
+    })
+
+
+def test01_create(variant_scalar_rgb):
+    integrator = mi.load_dict({
+        'type': 'irrcache',
+        'error': 0.1,
+        'gather_samples': 64
+    })
+    assert integrator is not None
+
+    with pytest.raises(RuntimeError):
+        mi.load_dict({ 'type': 'irrcache', 'error': 0.0 })
+
+
+def test02_unsupported_variant(variants_vec_backends_once_rgb):
+    with pytest.raises(RuntimeError, match='irradiance caching'):
+        mi.load_dict({ 'type': 'irrcache' })
+
+
+@pytest.mark.parametrize('reflectance', [0.0, 0.5])
+def test03_furnace(variant_scalar_rgb, reflectance):
+    scene = create_furnace_scene({
+        'type': 'irrcache',
+        'gather_samples': 128,
+        'rr_depth': 100,
+        'max_depth': 64
+    }, reflectance=reflectance)
+
+    image = mi.render(scene)
+    expected = 1.0 / (1.0 - reflectance)
+    assert dr.allclose(dr.mean(image.array), expected, rtol=5e-2)
@@ -116,6 +116,9 @@ public:
         Mask specular_chain = active && !m_hide_emitters;
         UInt32 depth = 0;
 
+        // Ray visibility type of the current ray (see \ref RayFlags)
+        UInt32 ray_types = +RayFlags::CameraRay;
+
         UInt32 channel = 0;
         if (is_rgb_v<Spectrum>) {
             uint32_t n_channels = (uint32_t) dr::array_size_v<Spectrum>;
@@ -134,7 +137,7 @@ public:
                             /* loop state: */ active, depth, ray, throughput,
                             result, si, mei, medium, eta, last_scatter_event,
                             last_scatter_direction_pdf, needs_intersection,
-                            specular_chain, valid_ray, sampler);
+                            specular_chain, valid_ray, ray_types, sampler);
 
         while (loop(active)) {
             // ----------------- Handle termination of paths ------------------
@@ -171,7 +174,9 @@ public:
                 dr::masked(ray.maxt, active_medium && medium->is_homogeneous() && mei.is_valid()) = mei.t;
                 Mask intersect = needs_intersection && active_medium;
                 if (dr::any_or<true>(intersect))
-                    dr::masked(si, intersect) = scene->ray_intersect(ray, intersect);
+                    dr::masked(si, intersect) =
+                        scene->ray_intersect(ray, +RayFlags::All, ray_types,
+                                             /* coherent = */ false, intersect);
                 needs_intersection &= !active_medium;
 
                 dr::masked(mei.t, active_medium && (si.t < mei.t)) = dr::Infinity<Float>;
@@ -241,6 +246,7 @@ public:
                 act_medium_scatter &= phase_pdf > 0.f;
                 Ray3f new_ray  = mei.spawn_ray(wo);
                 dr::masked(ray, act_medium_scatter) = new_ray;
+                dr::masked(ray_types, act_medium_scatter) = +RayFlags::DiffuseRay;
                 needs_intersection |= act_medium_scatter;
                 dr::masked(last_scatter_direction_pdf, act_medium_scatter) = phase_pdf;
                 dr::masked(throughput, act_medium_scatter) *= phase_weight;
@@ -250,7 +256,9 @@ public:
             active_surface |= escaped_medium;
             Mask intersect = active_surface && needs_intersection;
             if (dr::any_or<true>(intersect))
-                dr::masked(si, intersect) = scene->ray_intersect(ray, intersect);
+                dr::masked(si, intersect) =
+                    scene->ray_intersect(ray, +RayFlags::All, ray_types,
+                                         /* coherent = */ false, intersect);
 
             if (dr::any_or<true>(active_surface)) {
                 // ---------------- Intersection with emitters ----------------
@@ -314,6 +322,10 @@ public:
 
                 valid_ray |= non_null_bsdf;
                 specular_chain |= non_null_bsdf && has_flag(bs.sampled_type, BSDFFlags::Delta);
+                dr::masked(ray_types, non_null_bsdf) =
+                    dr::select(has_flag(bs.sampled_type, BSDFFlags::Delta),
+                               UInt32(+RayFlags::SpecularRay),
+                               UInt32(+RayFlags::DiffuseRay));
                 specular_chain &= !(active_surface && has_flag(bs.sampled_type, BSDFFlags::Smooth));
                 act_null_scatter |= active_surface && has_flag(bs.sampled_type, BSDFFlags::Null);
                 Mask has_medium_trans                = active_surface && si.is_medium_transition();
@@ -374,7 +386,9 @@ public:
                 dr::masked(ray.maxt, active_medium && medium->is_homogeneous() && mei.is_valid()) = dr::minimum(mei.t, remaining_dist);
                 Mask intersect = needs_intersection && active_medium;
                 if (dr::any_or<true>(intersect))
-                    dr::masked(si, intersect) = scene->ray_intersect(ray, intersect);
+                    dr::masked(si, intersect) = scene->ray_intersect(
+                        ray, +RayFlags::All | +RayFlags::ShadowRay,
+                        /* coherent = */ false, intersect);
 
                 dr::masked(mei.t, active_medium && (si.t < mei.t)) = dr::Infinity<Float>;
                 needs_intersection &= !active_medium;
@@ -414,7 +428,9 @@ public:
             // Handle interactions with surfaces
             Mask intersect = active_surface && needs_intersection;
             if (dr::any_or<true>(intersect))
-                dr::masked(si, intersect)    = scene->ray_intersect(ray, intersect);
+                dr::masked(si, intersect) = scene->ray_intersect(
+                    ray, +RayFlags::All | +RayFlags::ShadowRay,
+                    /* coherent = */ false, intersect);
             needs_intersection &= !intersect;
             active_surface |= escaped_medium;
             dr::masked(total_dist, active_surface) += si.t;
@@ -150,6 +150,8 @@ public:
 
         Mask specular_chain = active && !m_hide_emitters;
         UInt32 depth = 0;
+        // Ray visibility type of the current ray (see \ref RayFlags)
+        UInt32 ray_types = +RayFlags::CameraRay;
         WeightMatrix p_over_f = dr::full<WeightMatrix>(1.f);
         WeightMatrix p_over_f_nee = dr::full<WeightMatrix>(1.f);
 
@@ -171,7 +173,8 @@ public:
                             /* loop state: */
                             active, depth, ray, p_over_f, p_over_f_nee, result,
                             si, mei, medium, eta, last_scatter_event, sampler,
-                            needs_intersection, specular_chain, valid_ray);
+                            needs_intersection, specular_chain, valid_ray,
+                            ray_types);
 
         while (loop(active)) {
             // ----------------- Handle termination of paths ------------------
@@ -212,7 +215,9 @@ public:
                 dr::masked(ray.maxt, active_medium && medium->is_homogeneous() && mei.is_valid()) = mei.t;
                 Mask intersect = needs_intersection && active_medium;
                 if (dr::any_or<true>(intersect))
-                    dr::masked(si, intersect) = scene->ray_intersect(ray, intersect);
+                    dr::masked(si, intersect) =
+                        scene->ray_intersect(ray, +RayFlags::All, ray_types,
+                                             /* coherent = */ false, intersect);
                 needs_intersection &= !active_medium;
                 dr::masked(mei.t, active_medium && (si.t < mei.t)) = dr::Infinity<Float>;
 
@@ -291,6 +296,7 @@ public:
                         act_medium_scatter);
                     Ray3f new_ray  = mei.spawn_ray(wo);
                     dr::masked(ray, act_medium_scatter) = new_ray;
+                    dr::masked(ray_types, act_medium_scatter) = +RayFlags::DiffuseRay;
                     needs_intersection |= act_medium_scatter;
 
                     update_weights(p_over_f, phase_pdf, unpolarized_spectrum(phase_weight * phase_pdf), channel, act_medium_scatter);
@@ -303,7 +309,9 @@ public:
             active_surface |= escaped_medium;
             Mask intersect = active_surface && needs_intersection;
             if (dr::any_or<true>(intersect))
-                dr::masked(si, intersect) = scene->ray_intersect(ray, intersect);
+                dr::masked(si, intersect) =
+                    scene->ray_intersect(ray, +RayFlags::All, ray_types,
+                                         /* coherent = */ false, intersect);
 
 
             if (dr::any_or<true>(active_surface)) {
@@ -356,6 +364,10 @@ public:
                 Mask non_null_bsdf = active_surface && !has_flag(bs.sampled_type, BSDFFlags::Null);
                 valid_ray |= non_null_bsdf || invalid_bsdf_sample;
                 specular_chain |= non_null_bsdf && has_flag(bs.sampled_type, BSDFFlags::Delta);
+                dr::masked(ray_types, non_null_bsdf) =
+                    dr::select(has_flag(bs.sampled_type, BSDFFlags::Delta),
+                               UInt32(+RayFlags::SpecularRay),
+                               UInt32(+RayFlags::DiffuseRay));
                 specular_chain &= !(active_surface && has_flag(bs.sampled_type, BSDFFlags::Smooth));
                 dr::masked(depth, non_null_bsdf) += 1;
                 dr::masked(last_scatter_event, non_null_bsdf) = si;
@@ -425,7 +437,9 @@ public:
                 dr::masked(ray.maxt, active_medium && medium->is_homogeneous() && mei.is_valid()) = dr::minimum(mei.t, remaining_dist);
                 Mask intersect = needs_intersection && active_medium;
                 if (dr::any_or<true>(intersect))
-                    dr::masked(si, intersect) = scene->ray_intersect(ray, intersect);
+                    dr::masked(si, intersect) = scene->ray_intersect(
+                        ray, +RayFlags::All | +RayFlags::ShadowRay,
+                        /* coherent = */ false, intersect);
                 dr::masked(mei.t, active_medium && (si.t < mei.t)) = dr::Infinity<Float>;
                 needs_intersection &= !active_medium;
 
@@ -467,7 +481,9 @@ public:
             // Handle interactions with surfaces
             Mask intersect = active_surface && needs_intersection;
             if (dr::any_or<true>(intersect))
-                dr::masked(si, intersect)    = scene->ray_intersect(ray, intersect);
+                dr::masked(si, intersect) = scene->ray_intersect(
+                    ray, +RayFlags::All | +RayFlags::ShadowRay,
+                    /* coherent = */ false, intersect);
             active_surface |= escaped_medium;
             dr::masked(total_dist, active_surface) += si.t;
 
@@ -65,6 +65,15 @@ Options:
     -o <filename>, --output <filename>
         Write the output image to the file "filename".
 
+    -p, --profile-objects
+        Report the rendering costs of individual BSDFs, textures, emitters
+        and shapes at the end of the render (scalar variants only).
+
+    -T <filename>, --trace <filename>
+        Record a timeline of scene loading and rendering, and write it
+        to the file "filename" in the Chrome trace format (which can be
+        opened with chrome://tracing or https://ui.perfetto.dev).
+
  === The following options are only relevant for JIT (CUDA/LLVM) modes ===
 
     -O [0-5]
@@ -170,6 +179,8 @@ int main(int argc, char *argv[]) {
     auto arg_help      = parser.add(StringVec{ "-h", "--help" });
     auto arg_mode      = parser.add(StringVec{ "-m", "--mode" }, true);
     auto arg_paths     = parser.add(StringVec{ "-a" }, true);
+    auto arg_trace     = parser.add(StringVec{ "-T", "--trace" }, true);
+    auto arg_profile   = parser.add(StringVec{ "-p", "--profile-objects" });
     auto arg_extra     = parser.add("", true);
 
     // Specialized flags for the JIT compiler
@@ -306,6 +317,10 @@ int main(int argc, char *argv[]) {
             Throw("Specified an argument that only makes sense in a JIT (LLVM/CUDA) mode!");
 
         Profiler::static_initialization();
+        if (*arg_trace && !Tracer::enabled())
+            Tracer::start(arg_trace->as_string());
+        if (*arg_profile)
+            ObjectProfiler::set_enabled(true);
         color_management_static_initialization(cuda, llvm);
 
         MI_INVOKE_VARIANT(mode, scene_static_accel_initialization);
@@ -10,6 +10,7 @@
 MI_PY_DECLARE(atomic);
 MI_PY_DECLARE(filesystem);
 MI_PY_DECLARE(Object);
+MI_PY_DECLARE(ParameterRegistry);
 MI_PY_DECLARE(Cast);
 MI_PY_DECLARE(Struct);
 MI_PY_DECLARE(Appender);
@@ -19,6 +20,7 @@ MI_PY_DECLARE(Formatter);
 MI_PY_DECLARE(FileResolver);
 MI_PY_DECLARE(Logger);
 MI_PY_DECLARE(MemoryMappedFile);
+MI_PY_DECLARE(SharedMemoryRegion);
 MI_PY_DECLARE(Stream);
 MI_PY_DECLARE(DummyStream);
 MI_PY_DECLARE(FileStream);
@@ -27,7 +29,10 @@ MI_PY_DECLARE(ZStream);
 MI_PY_DECLARE(ProgressReporter);
 MI_PY_DECLARE(rfilter);
 MI_PY_DECLARE(Thread);
+MI_PY_DECLARE(TiledEXRWriter);
 MI_PY_DECLARE(Timer);
+MI_PY_DECLARE(Tracer);
+MI_PY_DECLARE(ObjectProfiler);
 MI_PY_DECLARE(util);
 
 // render
@@ -116,6 +121,7 @@ PYBIND11_MODULE(mitsuba_ext, m) {
     MI_PY_IMPORT(atomic);
     MI_PY_IMPORT(filesystem);
     MI_PY_IMPORT(Object);
+    MI_PY_IMPORT(ParameterRegistry);
     MI_PY_IMPORT(Cast);
     MI_PY_IMPORT(Struct);
     MI_PY_IMPORT(Appender);
@@ -127,13 +133,17 @@ PYBIND11_MODULE(mitsuba_ext, m) {
     MI_PY_IMPORT(FileResolver);
     MI_PY_IMPORT(Logger);
     MI_PY_IMPORT(MemoryMappedFile);
+    MI_PY_IMPORT(SharedMemoryRegion);
     MI_PY_IMPORT(DummyStream);
     MI_PY_IMPORT(FileStream);
     MI_PY_IMPORT(MemoryStream);
     MI_PY_IMPORT(ZStream);
     MI_PY_IMPORT(ProgressReporter);
     MI_PY_IMPORT(Thread);
+    MI_PY_IMPORT(TiledEXRWriter);
     MI_PY_IMPORT(Timer);
+    MI_PY_IMPORT(Tracer);
+    MI_PY_IMPORT(ObjectProfiler);
     MI_PY_IMPORT(util);
 
     MI_PY_IMPORT(BSDFContext);
@@ -23,6 +23,15 @@ class ADIntegrator(mi.CppADIntegrator):
          the *russian roulette* path termination criterion. For example, if set to
          1, then path generation many randomly cease after encountering directly
          visible surfaces. (Default: 5)
+     * - max_spp_per_pass
+       - |int|
+       - Maximum number of samples per pixel rendered by a single pass of the
+         differentiable rendering steps (``render_forward()`` and
+         ``render_backward()``). Larger sample counts are split into several
+         passes with independent seeds, whose gradients are accumulated. This
+         bounds the peak memory usage of the AD graph and path state, at the
+         cost of additional kernel launches. A value of 0 renders all samples
+         in a single pass. (Default: 0)
     """
 
     def __init__(self, props = mi.Properties()):
@@ -39,6 +48,10 @@ class ADIntegrator(mi.CppADIntegrator):
         if self.rr_depth <= 0:
             raise Exception("\"rr_depth\" must be set to a value greater than zero!")
 
+        self.max_spp_per_pass = props.get('max_spp_per_pass', 0)
+        if self.max_spp_per_pass < 0:
+            raise Exception("\"max_spp_per_pass\" must be set to a value >= 0")
+
     def to_string(self):
         return f'{type(self).__name__}[max_depth = {self.max_depth},' \
                f' rr_depth = { self.rr_depth }]'
@@ -121,6 +134,104 @@ class ADIntegrator(mi.CppADIntegrator):
         if isinstance(sensor, int):
             sensor = scene.sensors()[sensor]
 
+        return self._accumulate_passes(
+            sensor, seed, spp,
+            lambda seed, spp: ADIntegrator._render_forward_pass(
+                self, scene, sensor, seed, spp))
+
+    def render_backward(self: mi.SamplingIntegrator,
+                        scene: mi.Scene,
+                        params: Any,
+                        grad_in: mi.TensorXf,
+                        sensor: Union[int, mi.Sensor] = 0,
+                        seed: int = 0,
+                        spp: int = 0) -> None:
+
+        if isinstance(sensor, int):
+            sensor = scene.sensors()[sensor]
+
+        for seed_pass, spp_pass, weight in self.split_spp(sensor, seed, spp):
+            ADIntegrator._render_backward_pass(
+                self, scene, grad_in if weight == 1.0 else grad_in * weight,
+                sensor, seed_pass, spp_pass)
+
+    def split_spp(self,
+                  sensor: mi.Sensor,
+                  seed: int,
+                  spp: int) -> List[Tuple[int, int, float]]:
+        """
+        Split the samples per pixel of a differentiable rendering step into
+        passes of at most ``max_spp_per_pass`` samples.
+
+        Returns a list of ``(seed, spp, weight)`` tuples, one per pass. The
+        first pass uses the provided seed, while the following ones use seeds
+        derived from it. The weights are proportional to the number of samples
+        of each pass and sum to one, so that the weighted sum of the images of
+        all passes estimates the image of a single pass with ``spp`` samples.
+        """
+
+        spp_total = spp if spp != 0 else sensor.sampler().sample_count()
+        max_spp = self.max_spp_per_pass
+
+        if max_spp == 0 or spp_total <= max_spp:
+            return [(seed, spp, 1.0)]
+
+        n_passes = (spp_total + max_spp - 1) // max_spp
+
+        passes = []
+        for i in range(n_passes):
+            spp_pass = spp_total // n_passes + (1 if i < spp_total % n_passes else 0)
+
+            # Hash the pass index into the seed, so that the passes of calls
+            # with consecutive seeds don't reuse the same random numbers
+            seed_pass = seed
+            if i > 0:
+                seed_pass = (seed ^ (i * 0x9e3779b9)) & 0xffffffff
+                seed_pass ^= seed_pass >> 16
+                seed_pass = (seed_pass * 0x7feb352d) & 0xffffffff
+                seed_pass ^= seed_pass >> 15
+                seed_pass = (seed_pass * 0x846ca68b) & 0xffffffff
+                seed_pass ^= seed_pass >> 16
+
+            passes.append((seed_pass, spp_pass, spp_pass / spp_total))
+
+        return passes
+
+    def _accumulate_passes(self,
+                           sensor: mi.Sensor,
+                           seed: int,
+                           spp: int,
+                           render_pass: Callable[[int, int], mi.TensorXf]) -> mi.TensorXf:
+        """
+        Invoke ``render_pass(seed, spp)`` for the passes returned by
+        ``split_spp()`` and return the weighted sum of the resulting images
+        """
+
+        result = None
+        for seed_pass, spp_pass, weight in self.split_spp(sensor, seed, spp):
+            image = render_pass(seed_pass, spp_pass)
+
+            if weight != 1.0:
+                image = image * weight
+                if result is not None:
+                    image += result
+
+                # Evaluate the partial sum to release the state of this pass
+                dr.eval(image)
+
+            result = image
+
+        return result
+
+    def _render_forward_pass(self: mi.SamplingIntegrator,
+                             scene: mi.Scene,
+                             sensor: mi.Sensor,
+                             seed: int,
+                             spp: int) -> mi.TensorXf:
+        """
+        Render a single pass of ``render_forward()`` (see ``split_spp()``)
+        """
+
         film = sensor.film()
 
         # Disable derivatives in all of the following
@@ -163,16 +274,15 @@ class ADIntegrator(mi.CppADIntegrator):
 
         return dr.grad(result_img)
 
-    def render_backward(self: mi.SamplingIntegrator,
-                        scene: mi.Scene,
-                        params: Any,
-                        grad_in: mi.TensorXf,
-                        sensor: Union[int, mi.Sensor] = 0,
-                        seed: int = 0,
-                        spp: int = 0) -> None:
-
-        if isinstance(sensor, int):
-            sensor = scene.sensors()[sensor]
+    def _render_backward_pass(self: mi.SamplingIntegrator,
+                              scene: mi.Scene,
+                              grad_in: mi.TensorXf,
+                              sensor: mi.Sensor,
+                              seed: int,
+                              spp: int) -> None:
+        """
+        Render a single pass of ``render_backward()`` (see ``split_spp()``)
+        """
 
         film = sensor.film()
 
@@ -362,7 +472,8 @@ class ADIntegrator(mi.CppADIntegrator):
             raise Exception(
                 "The total number of Monte Carlo samples required by this "
                 "rendering task (%i) exceeds 2^32 = 4294967296. Please use "
-                "fewer samples per pixel or render using multiple passes."
+                "fewer samples per pixel or render using multiple passes "
+                "(see the 'max_spp_per_pass' parameter)."
                 % wavefront_size)
 
         sampler.seed(seed, wavefront_size)
@@ -554,12 +665,28 @@ class RBIntegrator(ADIntegrator):
         Parameter ``spp`` (``int``):
             Optional parameter to override the number of samples per pixel for the
             differential rendering step. The value provided within the original
-            scene specification takes precedence if ``spp=0``.
+            scene specification takes precedence if ``spp=0``. Sample counts
+            that exceed the integrator's ``max_spp_per_pass`` parameter are
+            rendered in several passes.
         """
 
         if isinstance(sensor, int):
             sensor = scene.sensors()[sensor]
 
+        return self._accumulate_passes(
+            sensor, seed, spp,
+            lambda seed, spp: RBIntegrator._render_forward_pass(
+                self, scene, sensor, seed, spp))
+
+    def _render_forward_pass(self: mi.SamplingIntegrator,
+                             scene: mi.Scene,
+                             sensor: mi.Sensor,
+                             seed: int,
+                             spp: int) -> mi.TensorXf:
+        """
+        Render a single pass of ``render_forward()`` (see ``split_spp()``)
+        """
+
         film = sensor.film()
 
         # Disable derivatives in all of the following
@@ -617,7 +744,7 @@ class RBIntegrator(ADIntegrator):
 
             # Explicitly delete any remaining unused variables
             del sampler, ray, weight, pos, L, valid, aovs, δL, δaovs, \
-                valid_2, params, state_out, state_out_2, block
+                valid_2, state_out, state_out_2, block
 
             # Probably a little overkill, but why not.. If there are any
             # DrJit arrays to be collected by Python's cyclic GC, then
@@ -682,12 +809,29 @@ class RBIntegrator(ADIntegrator):
         Parameter ``spp`` (``int``):
             Optional parameter to override the number of samples per pixel for the
             differential rendering step. The value provided within the original
-            scene specification takes precedence if ``spp=0``.
+            scene specification takes precedence if ``spp=0``. Sample counts
+            that exceed the integrator's ``max_spp_per_pass`` parameter are
+            rendered in several passes, whose gradients are accumulated.
         """
 
         if isinstance(sensor, int):
             sensor = scene.sensors()[sensor]
 
+        for seed_pass, spp_pass, weight in self.split_spp(sensor, seed, spp):
+            RBIntegrator._render_backward_pass(
+                self, scene, grad_in if weight == 1.0 else grad_in * weight,
+                sensor, seed_pass, spp_pass)
+
+    def _render_backward_pass(self: mi.SamplingIntegrator,
+                              scene: mi.Scene,
+                              grad_in: mi.TensorXf,
+                              sensor: mi.Sensor,
+                              seed: int,
+                              spp: int) -> None:
+        """
+        Render a single pass of ``render_backward()`` (see ``split_spp()``)
+        """
+
         film = sensor.film()
 
         # Disable derivatives in all of the following
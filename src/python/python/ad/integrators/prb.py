@@ -28,6 +28,14 @@ class PRBIntegrator(RBIntegrator):
          1, then path generation many randomly cease after encountering directly
          visible surfaces. (Default: 5)
 
+     * - max_spp_per_pass
+       - |int|
+       - Maximum number of samples per pixel rendered by a single pass of the
+         differentiable rendering steps. Larger sample counts are split into
+         several passes whose gradients are accumulated, which bounds the peak
+         memory usage. A value of 0 renders all samples in a single pass.
+         (Default: 0)
+
     This plugin implements a basic Path Replay Backpropagation (PRB) integrator
     with the following properties:
 
@@ -112,10 +120,19 @@ class PRBIntegrator(RBIntegrator):
             # Compute a surface interaction that tracks derivatives arising
             # from differentiable shape parameters (position, normals, etc.)
             # In primal mode, this is just an ordinary ray tracing operation.
+            # Classify the ray for per-shape visibility (see ``mi.RayFlags``)
+            ray_types = dr.select(
+                dr.eq(depth, 0), mi.UInt32(int(mi.RayFlags.CameraRay)),
+                dr.select(prev_bsdf_delta,
+                          mi.UInt32(int(mi.RayFlags.SpecularRay)),
+                          mi.UInt32(int(mi.RayFlags.DiffuseRay))))
+
             with dr.resume_grad(when=not primal):
                 si = scene.ray_intersect(ray,
                                          ray_flags=mi.RayFlags.All,
-                                         coherent=dr.eq(depth, 0))
+                                         ray_types=ray_types,
+                                         coherent=dr.eq(depth, 0),
+                                         active=active)
 
             # Get the BSDF, potentially computes texture-space differentials
             bsdf = si.bsdf(ray)
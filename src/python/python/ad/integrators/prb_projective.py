@@ -28,6 +28,13 @@ class PathProjectiveIntegrator(PSIntegrator):
          1, then path generation many randomly cease after encountering directly
          visible surfaces. (Default: 5)
 
+     * - max_spp_per_pass
+       - |int|
+       - Maximum number of samples per pixel rendered by a single pass of the
+         continuous derivative. Larger sample counts are split into several
+         passes whose gradients are accumulated, which bounds the peak memory
+         usage. A value of 0 renders all samples in a single pass. (Default: 0)
+
      * - sppc
        - |int|
        - Number of samples per pixel used to estimate the continuous
@@ -35,6 +35,14 @@ class PRBVolpathIntegrator(RBIntegrator):
          1, then path generation many randomly cease after encountering directly
          visible surfaces. (Default: 5)
 
+     * - max_spp_per_pass
+       - |int|
+       - Maximum number of samples per pixel rendered by a single pass of the
+         differentiable rendering steps. Larger sample counts are split into
+         several passes whose gradients are accumulated, which bounds the peak
+         memory usage. A value of 0 renders all samples in a single pass.
+         (Default: 0)
+
      * - hide_emitters
        - |bool|
        - Hide directly visible emitters. (Default: no, i.e. |false|)
@@ -130,6 +138,8 @@ class PRBVolpathIntegrator(RBIntegrator):
         depth = mi.UInt32(0)
         valid_ray = mi.Bool(False)
         specular_chain = mi.Bool(True)
+        # Ray visibility type of the current ray (see ``mi.RayFlags``)
+        ray_types = mi.UInt32(int(mi.RayFlags.CameraRay))
 
         if mi.is_rgb:
             # Sample a color channel to sample free-flight distances
@@ -140,7 +150,8 @@ class PRBVolpathIntegrator(RBIntegrator):
                        state=lambda: (sampler, active, depth, ray, medium, si,
                                       throughput, L, needs_intersection,
                                       last_scatter_event, specular_chain, η,
-                                      last_scatter_direction_pdf, valid_ray))
+                                      last_scatter_direction_pdf, valid_ray,
+                                      ray_types))
         while loop(active):
             active &= dr.any(dr.neq(throughput, 0.0))
 
@@ -164,7 +175,9 @@ class PRBVolpathIntegrator(RBIntegrator):
 
                 ray.maxt[active_medium & medium.is_homogeneous() & mei.is_valid()] = mei.t
                 intersect = needs_intersection & active_medium
-                si[intersect] = scene.ray_intersect(ray, intersect)
+                si[intersect] = scene.ray_intersect(ray, mi.RayFlags.All, ray_types,
+                                                    coherent=False,
+                                                    active=intersect)
 
                 needs_intersection &= ~active_medium
                 mei.t[active_medium & (si.t < mei.t)] = dr.inf
@@ -214,7 +227,9 @@ class PRBVolpathIntegrator(RBIntegrator):
 
                 active_surface |= escaped_medium
                 intersect = active_surface & needs_intersection
-                si[intersect] = scene.ray_intersect(ray, intersect)
+                si[intersect] = scene.ray_intersect(ray, mi.RayFlags.All, ray_types,
+                                                    coherent=False,
+                                                    active=intersect)
 
                 # ----------------- Intersection with emitters -----------------
 
@@ -293,6 +308,7 @@ class PRBVolpathIntegrator(RBIntegrator):
 
                 throughput[act_medium_scatter] *= phase_weight
                 ray[act_medium_scatter] = mei.spawn_ray(wo)
+                ray_types[act_medium_scatter] = mi.UInt32(int(mi.RayFlags.DiffuseRay))
                 needs_intersection |= act_medium_scatter
                 last_scatter_direction_pdf[act_medium_scatter] = phase_pdf
 
@@ -329,6 +345,10 @@ class PRBVolpathIntegrator(RBIntegrator):
 
                 valid_ray |= non_null_bsdf
                 specular_chain |= non_null_bsdf & mi.has_flag(bs.sampled_type, mi.BSDFFlags.Delta)
+                ray_types[non_null_bsdf] = dr.select(
+                    mi.has_flag(bs.sampled_type, mi.BSDFFlags.Delta),
+                    mi.UInt32(int(mi.RayFlags.SpecularRay)),
+                    mi.UInt32(int(mi.RayFlags.DiffuseRay)))
                 specular_chain &= ~(active_surface & mi.has_flag(bs.sampled_type, mi.BSDFFlags.Smooth))
                 has_medium_trans = active_surface & si.is_medium_transition()
                 medium[has_medium_trans] = si.target_medium(ray.d)
@@ -373,7 +393,9 @@ class PRBVolpathIntegrator(RBIntegrator):
 
             # This ray will not intersect if it reached the end of the segment
             needs_intersection &= active
-            si[needs_intersection] = scene.ray_intersect(ray, needs_intersection)
+            si[needs_intersection] = scene.ray_intersect(
+                ray, mi.RayFlags.All | mi.RayFlags.ShadowRay,
+                coherent=False, active=needs_intersection)
             needs_intersection &= False
 
             active_medium = active & dr.neq(medium, None)
@@ -1,5 +1,6 @@
 from contextlib import contextmanager
 from collections import defaultdict
+import math
 import drjit as dr
 import mitsuba as mi
 
@@ -108,6 +109,31 @@ class Optimizer:
         """
         pass
 
+    def _set_variable(self, key, p, value):
+        """
+        Store the updated value of a parameter and schedule its evaluation,
+        which is deferred to the end of ``step()`` so that the updates of all
+        parameters are compiled into as few kernels as possible.
+        """
+        value = type(p)(value)
+        dr.enable_grad(value)
+        self.variables[key] = value
+        dr.schedule(self.variables[key])
+
+    @staticmethod
+    def _upload_scalars(values):
+        """
+        Transfer per-parameter scalars (e.g. learning rates) to the device
+        using a single copy and return an opaque reference to each of them.
+
+        Creating one opaque variable per parameter would instead evaluate them
+        one by one, interleaved with the traced parameter updates.
+        """
+        Float = dr.detached_t(mi.Float)
+        UInt32 = dr.uint32_array_t(Float)
+        buffer = Float(values)
+        return [dr.gather(Float, buffer, UInt32(i)) for i in range(len(values))]
+
 
 class SGD(Optimizer):
     """
@@ -152,7 +178,13 @@ class SGD(Optimizer):
         super().__init__(lr, params)
 
     def step(self):
-        """Take a gradient step"""
+        """
+        Take a gradient step
+
+        The state and parameter updates of all parameters are traced first and
+        evaluated by a single ``dr.eval()``, which fuses them into one kernel
+        per distinct parameter size.
+        """
         for k, p in self.variables.items():
             g_p = dr.grad(p)
             shape = dr.shape(g_p)
@@ -176,11 +208,7 @@ class SGD(Optimizer):
             else:
                 value = dr.detach(p) - self.lr_v[k] * g_p
 
-
-            value = type(p)(value)
-            dr.enable_grad(value)
-            self.variables[k] = value
-            dr.schedule(self.variables[k])
+            self._set_variable(k, p, value)
 
         dr.eval()
 
@@ -261,43 +289,60 @@ class Adam(Optimizer):
         super().__init__(lr, params)
 
     def step(self):
-        """Take a gradient step"""
+        """
+        Take a gradient step
+
+        The moment updates, masking and parameter writes of all parameters are
+        traced first and evaluated by a single ``dr.eval()``, which fuses them
+        into one kernel per distinct parameter size. The bias-corrected
+        learning rates of all parameters are uploaded with a single transfer.
+        With ``uniform=True``, the moments are evaluated in a first pass, since
+        their maximum is needed before the parameters can be updated.
+        """
+        active = []
+        lr_t = []
         for k, p in self.variables.items():
             self.t[k] += 1
-            lr_scale = dr.sqrt(1 - self.beta_2 ** self.t[k]) / (1 - self.beta_1 ** self.t[k])
-            lr_scale = dr.opaque(dr.detached_t(mi.Float), lr_scale, shape=1)
-
-            lr_t = self.lr_v[k] * lr_scale
             g_p = dr.grad(p)
             shape = dr.shape(g_p)
 
             if shape == 0:
                 continue
-            elif shape != dr.shape(self.state[k][0]):
+
+            lr_t.append(self.lr[k] * math.sqrt(1 - self.beta_2 ** self.t[k]) /
+                        (1 - self.beta_1 ** self.t[k]))
+            active.append((k, p, g_p))
+
+            if shape != dr.shape(self.state[k][0]):
                 # Reset state if data size has changed
                 self.reset(k)
 
+        # Moment updates
+        nonzero = {}
+        for k, p, g_p in active:
             m_tp, v_tp = self.state[k]
             m_t = self.beta_1 * m_tp + (1 - self.beta_1) * g_p
             v_t = self.beta_2 * v_tp + (1 - self.beta_2) * dr.sqr(g_p)
             if self.mask_updates:
-                nonzero = dr.neq(g_p, 0.)
-                m_t = dr.select(nonzero, m_t, m_tp)
-                v_t = dr.select(nonzero, v_t, v_tp)
+                nonzero[k] = dr.neq(g_p, 0.)
+                m_t = dr.select(nonzero[k], m_t, m_tp)
+                v_t = dr.select(nonzero[k], v_t, v_tp)
             self.state[k] = (m_t, v_t)
             dr.schedule(self.state[k])
 
+        if self.uniform:
+            dr.eval()
+
+        # Parameter updates
+        for (k, p, g_p), lr_k in zip(active, self._upload_scalars(lr_t)):
+            m_t, v_t = self.state[k]
             if self.uniform:
-                step = lr_t * m_t / (dr.sqrt(dr.max(v_t)) + self.epsilon)
+                step = lr_k * m_t / (dr.sqrt(dr.max(v_t)) + self.epsilon)
             else:
-                step = lr_t * m_t / (dr.sqrt(v_t) + self.epsilon)
+                step = lr_k * m_t / (dr.sqrt(v_t) + self.epsilon)
             if self.mask_updates:
-                step = dr.select(nonzero, step, 0.)
-            u = dr.detach(p) - step
-            u = type(p)(u)
-            dr.enable_grad(u)
-            self.variables[k] = u
-            dr.schedule(self.variables[k])
+                step = dr.select(nonzero[k], step, 0.)
+            self._set_variable(k, p, dr.detach(p) - step)
 
         dr.eval()
 
@@ -312,3 +312,45 @@ def test06_variant_context():
     except RuntimeError:
         pass
     assert mi.variant() == "scalar_rgb"
+
+
+def test07_traverse_registry(variants_all_ad_rgb):
+    scene = mi.load_dict({
+        'type': 'scene',
+        'shape_0': {'type': 'sphere'},
+        'shape_1': {
+            'type': 'sphere',
+            'bsdf': {'type': 'roughconductor'}
+        }
+    })
+
+    params = mi.traverse(scene)
+    registry = mi.ParameterRegistry(scene)
+
+    # The graph is only traversed as far as queries require
+    assert not registry.complete()
+    assert len(registry) == len(params)
+    assert registry.complete()
+    assert list(registry) == list(params.keys())
+
+    key = 'shape_0.bsdf.reflectance.value'
+    assert key in registry and key in params
+    assert dr.allclose(params[key], 0.5)
+    assert registry.node(registry.root()) == (None, 0)
+
+    # Prefix filters are applied during the traversal
+    prefixed = mi.ParameterRegistry(scene, ['shape_1.bsdf'])
+    assert list(prefixed) == [k for k in params.keys() if k.startswith('shape_1.bsdf')]
+
+    filtered = mi.traverse(scene, r'shape_0\.bsdf\..*')
+    assert set(filtered.keys()) == {k for k in params.keys()
+                                    if k.startswith('shape_0.bsdf.')}
+
+    # Parameters can be updated through a filtered view
+    filtered[key] = 0.2
+    filtered.update()
+    assert dr.allclose(mi.traverse(scene)[key], 0.2)
+
+    n = len(params)
+    del params[key]
+    assert key not in params and len(params) == n - 1
@@ -29,6 +29,7 @@ class SceneParameters(Mapping):
         self.hierarchy  = hierarchy  if hierarchy  is not None else {}
         self.update_candidates = {}
         self.nodes_to_update = {}
+        self.dirty_keys = set()
 
         self.set_property = mi.set_property
         self.get_property = mi.get_property
@@ -167,6 +168,8 @@ class SceneParameters(Mapping):
                 "gradients enabled, unexpected results may occur!"
             )
 
+        self.dirty_keys.add(key)
+
         node_key = key
         while node is not None:
             parent, depth = self.hierarchy[node]
@@ -214,7 +217,8 @@ class SceneParameters(Mapping):
 
             self.set_dirty(key)
 
-        for key in self.keys():
+        # Only modified parameters can have pending computation
+        for key in self.dirty_keys:
             dr.schedule(self.__get_value(key))
 
         # Notify nodes from bottom to top
@@ -227,6 +231,7 @@ class SceneParameters(Mapping):
 
         self.nodes_to_update.clear()
         self.update_candidates.clear()
+        self.dirty_keys.clear()
         dr.eval()
 
         return out
@@ -246,11 +251,16 @@ class SceneParameters(Mapping):
 
         import re
         regexps = [re.compile(k).match for k in keys]
-        keys = [k for k in self.keys() if any (r(k) for r in regexps)]
+        keys = set(k for k in self.keys() if any (r(k) for r in regexps))
 
-        self.properties = {
-            k: v for k, v in self.properties.items() if k in keys
-        }
+        if isinstance(self.properties, _RegistryProperties):
+            # Remove entries without creating records for the others
+            for k in [k for k in self.keys() if k not in keys]:
+                del self.properties[k]
+        else:
+            self.properties = {
+                k: v for k, v in self.properties.items() if k in keys
+            }
 
 def _jit_id_hash(value: Any) -> int:
     """
@@ -289,65 +299,109 @@ def _jit_id_hash(value: Any) -> int:
 
     return hash(tuple(jit_ids(value)))
 
-def traverse(node: mi.Object) -> SceneParameters:
+class _RegistryProperties(Mapping):
+    """
+    Dictionary-like view of a :py:class:`mitsuba.ParameterRegistry` that
+    creates the ``(value, type, node, flags)`` records of
+    :py:class:`mitsuba.SceneParameters` on demand.
+    """
+
+    def __init__(self, registry):
+        self.registry = registry
+
+    def __getitem__(self, key: str):
+        return self.registry[key]
+
+    def __delitem__(self, key: str):
+        del self.registry[key]
+
+    def __contains__(self, key):
+        return isinstance(key, str) and key in self.registry
+
+    def __iter__(self):
+        return iter(self.registry)
+
+    def __len__(self) -> int:
+        return len(self.registry)
+
+
+class _RegistryHierarchy(Mapping):
+    """
+    Dictionary-like view mapping the nodes visited by a
+    :py:class:`mitsuba.ParameterRegistry` to their ``(parent, depth)`` pair.
+    """
+
+    def __init__(self, registry):
+        self.registry = registry
+
+    def __getitem__(self, node):
+        return self.registry.node(node)
+
+    def __iter__(self):
+        return iter(self.registry.nodes())
+
+    def __len__(self) -> int:
+        return self.registry.node_count()
+
+
+def _regex_literal_prefix(pattern: str) -> str:
+    """
+    Return the literal prefix of a regular expression, i.e. a string that
+    begins every key matched by ``re.match(pattern, key)``.
+    """
+    if '|' in pattern:
+        return ''
+    prefix, i = '', 0
+    while i < len(pattern):
+        c = pattern[i]
+        if c == '\\' and i + 1 < len(pattern) and not pattern[i + 1].isalnum():
+            c, i = pattern[i + 1], i + 1
+        elif c in '.^$*+?{}[]()\\':
+            break
+        # The previous character may be optional (e.g. 'ab?')
+        if i + 1 < len(pattern) and pattern[i + 1] in '*?{':
+            break
+        prefix += c
+        i += 1
+    return prefix
+
+
+def traverse(node: mi.Object,
+             keys: None | str | list[str] = None) -> SceneParameters:
     """
     Traverse a node of Mitsuba's scene graph and return a dictionary-like
     object that can be used to read and write associated scene parameters.
 
+    The traversal runs in C++ (see :py:class:`mitsuba.ParameterRegistry`)
+    and only advances as far as the accessed parameters require. Records of
+    individual parameters are also only created when they are accessed, which
+    keeps this function fast for very large scenes.
+
+    Parameter ``keys`` (``None``, ``str``, ``[str]``):
+        Optional regular expression(s) with the same meaning as in
+        :py:meth:`~mitsuba.SceneParameters.keep()`. The literal prefixes of
+        these patterns are used to skip unrelated parameters during the
+        traversal.
+
     See also :py:class:`mitsuba.SceneParameters`.
     """
 
-    class SceneTraversal(mi.TraversalCallback):
-        def __init__(self, node, parent=None, properties=None,
-                     hierarchy=None, prefixes=None, name=None, depth=0,
-                     flags=+mi.ParamFlags.Differentiable):
-            mi.TraversalCallback.__init__(self)
-            self.properties = dict() if properties is None else properties
-            self.hierarchy = dict() if hierarchy is None else hierarchy
-            self.prefixes = set() if prefixes is None else prefixes
-
-            if name is not None:
-                ctr, name_len = 1, len(name)
-                while name in self.prefixes:
-                    name = "%s_%i" % (name[:name_len], ctr)
-                    ctr += 1
-                self.prefixes.add(name)
-
-            self.name = name
-            self.node = node
-            self.depth = depth
-            self.hierarchy[node] = (parent, depth)
-            self.flags = flags
-
-        def put_parameter(self, name, ptr, flags, cpptype=None):
-            name = name if self.name is None else self.name + '.' + name
-
-            flags = self.flags | flags
-            # Non differentiable parameters shouldn't be flagged as discontinuous
-            if (flags & mi.ParamFlags.NonDifferentiable) != 0:
-                flags = flags & ~mi.ParamFlags.Discontinuous
-
-            self.properties[name] = (ptr, cpptype, self.node, self.flags | flags)
-
-        def put_object(self, name, node, flags):
-            if node is None or node in self.hierarchy:
-                return
-            cb = SceneTraversal(
-                node=node,
-                parent=self.node,
-                properties=self.properties,
-                hierarchy=self.hierarchy,
-                prefixes=self.prefixes,
-                name=name if self.name is None else self.name + '.' + name,
-                depth=self.depth + 1,
-                flags=self.flags | flags
-            )
-            node.traverse(cb)
+    prefixes = []
+    if keys is not None:
+        if type(keys) is not list:
+            keys = [keys]
+        prefixes = [_regex_literal_prefix(k) for k in keys]
+        if '' in prefixes:
+            prefixes = []
+
+    registry = mi.ParameterRegistry(node, prefixes)
+    params = SceneParameters(_RegistryProperties(registry),
+                             _RegistryHierarchy(registry))
 
-    cb = SceneTraversal(node)
-    node.traverse(cb)
+    if keys is not None:
+        params.keep(keys)
 
-    return SceneParameters(cb.properties, cb.hierarchy)
+    return params
 
 # ------------------------------------------------------------------------------
 #                          Rendering Custom Operation
@@ -1,8 +1,11 @@
 #include <cstring>
+#include <unordered_map>
 
 #include <mitsuba/render/bsdf.h>
 #include <mitsuba/render/texture.h>
+#include <mitsuba/core/profiler.h>
 #include <mitsuba/core/properties.h>
+#include <mitsuba/core/string.h>
 
 NAMESPACE_BEGIN(mitsuba)
 
@@ -294,6 +297,513 @@ std::ostream &operator<<(std::ostream &os, const TransportMode &mode) {
     return os;
 }
 
+/**
+ * \brief Chain of adapter BSDFs fused into a single object (see \ref
+ * BSDF::flatten())
+ *
+ * Each layer replicates the computation of the corresponding adapter plugin
+ * (\c twosided, \c normalmap, \c bumpmap, \c mask) and then proceeds with the
+ * next layer, which avoids a virtual function call per adapter. The adapters
+ * keep ownership of their textures and parameters, hence parameter updates
+ * remain visible to this object.
+ */
+template <typename Float, typename Spectrum>
+class FlattenedBSDF final : public BSDF<Float, Spectrum> {
+public:
+    MI_IMPORT_BASE(BSDF, m_flags, m_components)
+    MI_IMPORT_TYPES(Texture)
+
+    enum class LayerType : uint32_t { TwoSided, NormalMap, BumpMap, Mask };
+
+    struct Layer {
+        LayerType type;
+        /// The original adapter
+        ref<Base> bsdf;
+        /// Normal map, bump map, or opacity texture
+        ref<Texture> texture;
+        /// Bump map scale (owned by the adapter)
+        const ScalarFloat *scale = nullptr;
+    };
+
+    FlattenedBSDF(Base *outer, std::vector<Layer> &&layers, Base *leaf)
+        : Base(Properties()), m_layers(std::move(layers)), m_leaf(leaf) {
+        this->set_id(outer->id());
+        m_components.clear();
+        for (size_t i = 0; i < outer->component_count(); ++i)
+            m_components.push_back(outer->flags(i));
+        m_flags = outer->flags();
+        dr::set_attr(this, "flags", m_flags);
+    }
+
+    void traverse(TraversalCallback *callback) override {
+        // Expose the parameters of the original chain under the same names
+        m_layers[0].bsdf->traverse(callback);
+    }
+
+    void parameters_changed(const std::vector<std::string> &keys) override {
+        m_layers[0].bsdf->parameters_changed(keys);
+    }
+
+    std::pair<BSDFSample3f, Spectrum> sample(const BSDFContext &ctx,
+                                             const SurfaceInteraction3f &si,
+                                             Float sample1,
+                                             const Point2f &sample2,
+                                             Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::BSDFSample, active);
+        return sample_layer(0, ctx, si, sample1, sample2, active);
+    }
+
+    Spectrum eval(const BSDFContext &ctx, const SurfaceInteraction3f &si,
+                  const Vector3f &wo, Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::BSDFEvaluate, active);
+        return eval_layer(0, ctx, si, wo, active);
+    }
+
+    Float pdf(const BSDFContext &ctx, const SurfaceInteraction3f &si,
+              const Vector3f &wo, Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::BSDFEvaluate, active);
+        return pdf_layer(0, ctx, si, wo, active);
+    }
+
+    std::pair<Spectrum, Float> eval_pdf(const BSDFContext &ctx,
+                                        const SurfaceInteraction3f &si,
+                                        const Vector3f &wo,
+                                        Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::BSDFEvaluate, active);
+        return eval_pdf_layer(0, ctx, si, wo, active);
+    }
+
+    Spectrum eval_null_transmission(const SurfaceInteraction3f &si,
+                                    Mask active) const override {
+        return eval_null_transmission_layer(0, si, active);
+    }
+
+    Spectrum eval_diffuse_reflectance(const SurfaceInteraction3f &si,
+                                      Mask active) const override {
+        return eval_diffuse_reflectance_layer(0, si, active);
+    }
+
+    std::string to_string() const override {
+        std::ostringstream oss;
+        oss << "FlattenedBSDF[" << std::endl
+            << "  layers = [ ";
+        for (size_t i = 0; i < m_layers.size(); ++i)
+            oss << m_layers[i].bsdf->class_()->name()
+                << (i + 1 < m_layers.size() ? ", " : " ");
+        oss << "]," << std::endl
+            << "  leaf = " << string::indent(m_leaf) << std::endl
+            << "]";
+        return oss.str();
+    }
+
+    MI_DECLARE_CLASS()
+
+private:
+    /* The adapters enable all lanes in scalar variants when they use the
+       MI_MASKED_FUNCTION macro, which is replicated by this function */
+    static void enable_scalar(Mask &active) {
+        if constexpr (!dr::is_array_v<Float>)
+            active = true;
+    }
+
+    Float eval_opacity(const Layer &layer, const SurfaceInteraction3f &si,
+                       Mask active) const {
+        return dr::clamp(layer.texture->eval_1(si, active), 0.f, 1.f);
+    }
+
+    /// Perturbed shading frame of the \c normalmap and \c bumpmap adapters
+    Frame3f perturbed_frame(const Layer &layer, const SurfaceInteraction3f &si,
+                            Mask active) const {
+        Frame3f result;
+        if (layer.type == LayerType::NormalMap) {
+            Normal3f n = dr::fmadd(layer.texture->eval_3(si, active), 2, -1.f);
+            result.n = dr::normalize(n);
+        } else {
+            // Evaluate texture gradient
+            Vector2f grad_uv = *layer.scale * layer.texture->eval_1_grad(si, active);
+
+            // Compute perturbed differential geometry
+            Vector3f dp_du = dr::fmadd(si.sh_frame.n, grad_uv.x() - dr::dot(si.sh_frame.n, si.dp_du), si.dp_du);
+            Vector3f dp_dv = dr::fmadd(si.sh_frame.n, grad_uv.y() - dr::dot(si.sh_frame.n, si.dp_dv), si.dp_dv);
+
+            // Bump-mapped shading normal, flipped to align with the geometric normal
+            result.n = dr::normalize(dr::cross(dp_du, dp_dv));
+            result.n[dr::dot(si.n, result.n) < .0f] *= -1.f;
+
+            // Convert to small rotation from original shading frame
+            result.n = si.to_local(result.n);
+        }
+
+        // Gram-schmidt orthogonalization to compute local shading frame
+        result.s = dr::normalize(dr::fnmadd(result.n, dr::dot(result.n, si.dp_du), si.dp_du));
+        result.t = dr::cross(result.n, result.s);
+        return result;
+    }
+
+    /// Which lobes of a \c mask adapter are enabled by the context?
+    std::pair<bool, bool> mask_lobes(const Layer &layer, const BSDFContext &ctx) const {
+        uint32_t null_index = (uint32_t) layer.bsdf->component_count() - 1;
+        bool sample_transmission = ctx.is_enabled(BSDFFlags::Null, null_index);
+        bool sample_nested       = ctx.component == (uint32_t) -1 || ctx.component < null_index;
+        return { sample_transmission, sample_nested };
+    }
+
+    std::pair<BSDFSample3f, Spectrum> sample_layer(size_t index,
+                                                   const BSDFContext &ctx,
+                                                   const SurfaceInteraction3f &si,
+                                                   Float sample1,
+                                                   const Point2f &sample2,
+                                                   Mask active) const {
+        if (index == m_layers.size())
+            return m_leaf->sample(ctx, si, sample1, sample2, active);
+
+        const Layer &layer = m_layers[index];
+        switch (layer.type) {
+            case LayerType::TwoSided: {
+                enable_scalar(active);
+                SurfaceInteraction3f si2(si);
+                si2.wi.z() = dr::abs(si2.wi.z());
+                auto result = sample_layer(index + 1, ctx, si2, sample1, sample2, active);
+                result.first.wo.z() = dr::mulsign(result.first.wo.z(), si.wi.z());
+                return result;
+            }
+
+            case LayerType::NormalMap:
+            case LayerType::BumpMap: {
+                if (layer.type == LayerType::BumpMap)
+                    enable_scalar(active);
+
+                SurfaceInteraction3f perturbed_si(si);
+                perturbed_si.sh_frame = perturbed_frame(layer, si, active);
+                perturbed_si.wi = perturbed_si.to_local(si.wi);
+                auto [bs, weight] = sample_layer(index + 1, ctx, perturbed_si,
+                                                 sample1, sample2, active);
+                active &= dr::any(dr::neq(unpolarized_spectrum(weight), 0.f));
+                if (layer.type == LayerType::NormalMap && dr::none_or<false>(active))
+                    return { bs, 0.f };
+
+                // Transform sampled 'wo' back to original frame and check orientation
+                Vector3f perturbed_wo = perturbed_si.to_world(bs.wo);
+                active &= Frame3f::cos_theta(bs.wo) *
+                          Frame3f::cos_theta(perturbed_wo) > 0.f;
+                bs.wo = perturbed_wo;
+
+                return { bs, weight & active };
+            }
+
+            default: /* LayerType::Mask */ {
+                enable_scalar(active);
+                auto [sample_transmission, sample_nested] = mask_lobes(layer, ctx);
+
+                BSDFSample3f bs = dr::zeros<BSDFSample3f>();
+                Spectrum result(0.f);
+                if (unlikely(!sample_transmission && !sample_nested))
+                    return { bs, result };
+
+                Float opacity = eval_opacity(layer, si, active);
+                if (sample_transmission != sample_nested)
+                    opacity = sample_transmission ? 1.f : 0.f;
+
+                bs.wo                = -si.wi;
+                bs.eta               = 1.f;
+                bs.sampled_component = (uint32_t) layer.bsdf->component_count() - 1;
+                bs.sampled_type      = +BSDFFlags::Null;
+                bs.pdf               = 1.f - opacity;
+
+                result = 1.f;
+                if constexpr (dr::is_diff_v<Float>) {
+                    if (dr::grad_enabled(opacity)) {
+                        result = dr::replace_grad(
+                            result,
+                            Spectrum((1.f - opacity) / dr::detach(1.f - opacity)));
+                    }
+                }
+
+                Mask nested_mask = active && sample1 < opacity;
+                if (dr::any_or<true>(nested_mask)) {
+                    sample1 /= opacity;
+                    auto tmp = sample_layer(index + 1, ctx, si, sample1, sample2, nested_mask);
+                    dr::masked(bs, nested_mask) = tmp.first;
+                    dr::masked(result, nested_mask) = tmp.second * opacity / dr::detach(opacity);
+                    dr::masked(bs.pdf, nested_mask) *= opacity;
+                }
+
+                return { bs, result };
+            }
+        }
+    }
+
+    Spectrum eval_layer(size_t index, const BSDFContext &ctx,
+                        const SurfaceInteraction3f &si, const Vector3f &wo,
+                        Mask active) const {
+        if (index == m_layers.size())
+            return m_leaf->eval(ctx, si, wo, active);
+
+        const Layer &layer = m_layers[index];
+        switch (layer.type) {
+            case LayerType::TwoSided: {
+                enable_scalar(active);
+                SurfaceInteraction3f si2(si);
+                Vector3f wo2(wo);
+                wo2.z() = dr::mulsign(wo2.z(), si2.wi.z());
+                si2.wi.z() = dr::abs(si2.wi.z());
+                return eval_layer(index + 1, ctx, si2, wo2, active);
+            }
+
+            case LayerType::NormalMap:
+            case LayerType::BumpMap: {
+                if (layer.type == LayerType::BumpMap)
+                    enable_scalar(active);
+
+                SurfaceInteraction3f perturbed_si(si);
+                perturbed_si.sh_frame = perturbed_frame(layer, si, active);
+                perturbed_si.wi       = perturbed_si.to_local(si.wi);
+                Vector3f perturbed_wo = perturbed_si.to_local(wo);
+
+                active &= Frame3f::cos_theta(wo) *
+                          Frame3f::cos_theta(perturbed_wo) > 0.f;
+
+                Spectrum value = eval_layer(index + 1, ctx, perturbed_si, perturbed_wo, active);
+                if (layer.type == LayerType::NormalMap)
+                    return value & active;
+                else
+                    return dr::select(active, value, 0.f);
+            }
+
+            default: /* LayerType::Mask */ {
+                enable_scalar(active);
+                Float opacity = eval_opacity(layer, si, active);
+                return eval_layer(index + 1, ctx, si, wo, active) * opacity;
+            }
+        }
+    }
+
+    Float pdf_layer(size_t index, const BSDFContext &ctx,
+                    const SurfaceInteraction3f &si, const Vector3f &wo,
+                    Mask active) const {
+        if (index == m_layers.size())
+            return m_leaf->pdf(ctx, si, wo, active);
+
+        const Layer &layer = m_layers[index];
+        switch (layer.type) {
+            case LayerType::TwoSided: {
+                enable_scalar(active);
+                SurfaceInteraction3f si2(si);
+                Vector3f wo2(wo);
+                wo2.z() = dr::mulsign(wo2.z(), si2.wi.z());
+                si2.wi.z() = dr::abs(si2.wi.z());
+                return pdf_layer(index + 1, ctx, si2, wo2, active);
+            }
+
+            case LayerType::NormalMap:
+            case LayerType::BumpMap: {
+                if (layer.type == LayerType::BumpMap)
+                    enable_scalar(active);
+
+                SurfaceInteraction3f perturbed_si(si);
+                perturbed_si.sh_frame = perturbed_frame(layer, si, active);
+                perturbed_si.wi       = perturbed_si.to_local(si.wi);
+                Vector3f perturbed_wo = perturbed_si.to_local(wo);
+
+                active &= Frame3f::cos_theta(wo) *
+                          Frame3f::cos_theta(perturbed_wo) > 0.f;
+
+                return dr::select(active, pdf_layer(index + 1, ctx, perturbed_si, perturbed_wo, active), 0.f);
+            }
+
+            default: /* LayerType::Mask */ {
+                enable_scalar(active);
+                auto [sample_transmission, sample_nested] = mask_lobes(layer, ctx);
+                if (!sample_nested)
+                    return 0.f;
+
+                Float result = pdf_layer(index + 1, ctx, si, wo, active);
+                if (sample_transmission)
+                    result *= eval_opacity(layer, si, active);
+
+                return result;
+            }
+        }
+    }
+
+    std::pair<Spectrum, Float> eval_pdf_layer(size_t index,
+                                              const BSDFContext &ctx,
+                                              const SurfaceInteraction3f &si,
+                                              const Vector3f &wo,
+                                              Mask active) const {
+        if (index == m_layers.size())
+            return m_leaf->eval_pdf(ctx, si, wo, active);
+
+        const Layer &layer = m_layers[index];
+        switch (layer.type) {
+            case LayerType::TwoSided: {
+                enable_scalar(active);
+                SurfaceInteraction3f si2(si);
+                Vector3f wo2(wo);
+                wo2.z() = dr::mulsign(wo2.z(), si2.wi.z());
+                si2.wi.z() = dr::abs(si2.wi.z());
+                return eval_pdf_layer(index + 1, ctx, si2, wo2, active);
+            }
+
+            case LayerType::NormalMap:
+            case LayerType::BumpMap: {
+                enable_scalar(active);
+
+                SurfaceInteraction3f perturbed_si(si);
+                perturbed_si.sh_frame = perturbed_frame(layer, si, active);
+                perturbed_si.wi       = perturbed_si.to_local(si.wi);
+                Vector3f perturbed_wo = perturbed_si.to_local(wo);
+
+                active &= Frame3f::cos_theta(wo) *
+                          Frame3f::cos_theta(perturbed_wo) > 0.f;
+
+                auto [value, pdf] = eval_pdf_layer(index + 1, ctx, perturbed_si, perturbed_wo, active);
+                return { value & active, dr::select(active, pdf, 0.f) };
+            }
+
+            default: /* LayerType::Mask */ {
+                enable_scalar(active);
+                auto [sample_transmission, sample_nested] = mask_lobes(layer, ctx);
+
+                auto [value, pdf] = eval_pdf_layer(index + 1, ctx, si, wo, active);
+
+                Float opacity = eval_opacity(layer, si, active);
+                value *= opacity;
+
+                if (!sample_nested)
+                    pdf = 0.f;
+
+                if (sample_transmission)
+                    pdf *= opacity;
+
+                return { value, pdf };
+            }
+        }
+    }
+
+    Spectrum eval_null_transmission_layer(size_t index,
+                                          const SurfaceInteraction3f &si,
+                                          Mask active) const {
+        if (index == m_layers.size())
+            return m_leaf->eval_null_transmission(si, active);
+
+        // Only the mask adapter overrides the (zero-valued) default implementation
+        const Layer &layer = m_layers[index];
+        if (layer.type != LayerType::Mask)
+            return 0.f;
+
+        Float opacity = eval_opacity(layer, si, active);
+        return 1 - opacity * (1 - eval_null_transmission_layer(index + 1, si, active));
+    }
+
+    Spectrum eval_diffuse_reflectance_layer(size_t index,
+                                            const SurfaceInteraction3f &si,
+                                            Mask active) const {
+        if (index == m_layers.size())
+            return m_leaf->eval_diffuse_reflectance(si, active);
+
+        // The other adapters forward the query without perturbing the frame
+        if (m_layers[index].type == LayerType::TwoSided) {
+            SurfaceInteraction3f si2(si);
+            si2.wi.z() = dr::abs(si2.wi.z());
+            return eval_diffuse_reflectance_layer(index + 1, si2, active);
+        }
+
+        return eval_diffuse_reflectance_layer(index + 1, si, active);
+    }
+
+private:
+    std::vector<Layer> m_layers;
+    ref<Base> m_leaf;
+};
+
+/// Collects the child objects and parameters exposed by an adapter BSDF
+struct AdapterCallback : public TraversalCallback {
+    void put_object(const std::string &name, Object *obj, uint32_t) override {
+        objects[name] = obj;
+    }
+
+    void put_parameter_impl(const std::string &name, void *ptr, uint32_t,
+                            const std::type_info &) override {
+        parameters[name] = ptr;
+    }
+
+    std::unordered_map<std::string, Object *> objects;
+    std::unordered_map<std::string, void *> parameters;
+};
+
+MI_VARIANT std::pair<ref<BSDF<Float, Spectrum>>, ref<typename BSDF<Float, Spectrum>::Texture>>
+BSDF<Float, Spectrum>::split_opacity(BSDF *bsdf) {
+    if (!bsdf || std::string(bsdf->class_()->name()) != "MaskBSDF")
+        return { bsdf, nullptr };
+
+    AdapterCallback cb;
+    bsdf->traverse(&cb);
+
+    BSDF *nested     = dynamic_cast<BSDF *>(cb.objects["nested_bsdf"]);
+    Texture *opacity = dynamic_cast<Texture *>(cb.objects["opacity"]);
+    if (!nested || !opacity)
+        return { bsdf, nullptr };
+
+    return { nested, opacity };
+}
+
+MI_VARIANT ref<BSDF<Float, Spectrum>> BSDF<Float, Spectrum>::flatten(BSDF *bsdf) {
+    using Flattened = FlattenedBSDF<Float, Spectrum>;
+    using Layer     = typename Flattened::Layer;
+    using LayerType = typename Flattened::LayerType;
+
+    std::vector<Layer> layers;
+    BSDF *leaf = bsdf;
+
+    while (true) {
+        std::string name = leaf->class_()->name();
+        AdapterCallback cb;
+        leaf->traverse(&cb);
+
+        Layer layer;
+        BSDF *nested = nullptr;
+        if (name == "TwoSidedBRDF") {
+            // Two-sided adapters with distinct materials cannot be fused
+            if (cb.objects["brdf_0"] != cb.objects["brdf_1"])
+                break;
+            layer.type = LayerType::TwoSided;
+            nested = dynamic_cast<BSDF *>(cb.objects["brdf_0"]);
+        } else if (name == "NormalMap") {
+            layer.type = LayerType::NormalMap;
+            layer.texture = dynamic_cast<Texture *>(cb.objects["normalmap"]);
+            nested = dynamic_cast<BSDF *>(cb.objects["nested_bsdf"]);
+        } else if (name == "BumpMap") {
+            layer.type = LayerType::BumpMap;
+            layer.texture = dynamic_cast<Texture *>(cb.objects["nested_texture"]);
+            layer.scale = (const ScalarFloat *) cb.parameters["scale"];
+            nested = dynamic_cast<BSDF *>(cb.objects["nested_bsdf"]);
+        } else if (name == "MaskBSDF") {
+            layer.type = LayerType::Mask;
+            layer.texture = dynamic_cast<Texture *>(cb.objects["opacity"]);
+            nested = dynamic_cast<BSDF *>(cb.objects["nested_bsdf"]);
+        } else {
+            break;
+        }
+
+        if (!nested || (layer.type != LayerType::TwoSided && !layer.texture) ||
+            (layer.type == LayerType::BumpMap && !layer.scale))
+            break;
+
+        layer.bsdf = leaf;
+        layers.push_back(layer);
+        leaf = nested;
+    }
+
+    // A single adapter is already dispatched directly to its nested BSDF
+    if (layers.size() < 2)
+        return bsdf;
+
+    return new Flattened(bsdf, std::move(layers), leaf);
+}
+
 MI_IMPLEMENT_CLASS_VARIANT(BSDF, Object, "bsdf")
+MI_IMPLEMENT_CLASS_VARIANT(FlattenedBSDF, BSDF)
 MI_INSTANTIATE_CLASS(BSDF)
+MI_INSTANTIATE_CLASS(FlattenedBSDF)
 NAMESPACE_END(mitsuba)
@@ -88,6 +88,11 @@ Film<Float, Spectrum>::sensor_response_function() {
     return m_srf.get();
 }
 
+MI_VARIANT void Film<Float, Spectrum>::prepare_blocks(uint32_t /* block_size */,
+                                                     uint32_t /* passes */) { }
+
+MI_VARIANT bool Film<Float, Spectrum>::scanline_order() const { return false; }
+
 MI_VARIANT void Film<Float, Spectrum>::set_crop_window(const ScalarPoint2u &crop_offset,
                                                         const ScalarVector2u &crop_size) {
     if (dr::any(crop_offset + crop_size > m_size))
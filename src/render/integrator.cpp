@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <mutex>
 
 #include <drjit/morton.h>
@@ -17,6 +21,41 @@
 
 NAMESPACE_BEGIN(mitsuba)
 
+/**
+ * \brief Pixels of a block that is being rendered by SamplingIntegrator::render()
+ *
+ * Pixels are claimed in small chunks along the Morton curve through an atomic
+ * counter, which allows idle workers to help with the block.
+ */
+struct BlockPixelQueue {
+    std::atomic<uint32_t> next_pixel { 0 };
+    uint32_t pixel_count = 0;
+    uint32_t chunk_size = 0;
+
+    /// Invoked when render_block() starts claiming pixels through the queue
+    std::function<void()> on_share;
+
+    /// Claim the next chunk of pixels, returns \c false when none are left
+    bool next(uint32_t &begin, uint32_t &end) {
+        begin = next_pixel.fetch_add(chunk_size);
+        if (begin >= pixel_count)
+            return false;
+        end = std::min(begin + chunk_size, pixel_count);
+        return true;
+    }
+
+    /// Return the number of pixels that haven't been claimed yet
+    uint32_t remaining() const {
+        uint32_t next = next_pixel.load();
+        return next < pixel_count ? pixel_count - next : 0;
+    }
+};
+
+/* Queue of the block that the current thread is about to render through the
+   virtual render_block(). Only the default implementation consumes it, hence
+   blocks of integrators that override render_block() are never split. */
+static thread_local BlockPixelQueue *current_pixel_queue = nullptr;
+
 // -----------------------------------------------------------------------------
 
 MI_VARIANT Integrator<Float, Spectrum>::Integrator(const Properties & props)
@@ -25,6 +64,9 @@ MI_VARIANT Integrator<Float, Spectrum>::Integrator(const Properties & props)
 
     // Disable direct visibility of emitters if needed
     m_hide_emitters = props.get<bool>("hide_emitters", false);
+
+    // Memory budget of a JIT rendering pass (specified in MiB)
+    m_memory_budget = (size_t) props.get<uint32_t>("memory_budget", 0) << 20;
 }
 
 MI_VARIANT typename Integrator<Float, Spectrum>::TensorXf
@@ -91,6 +133,54 @@ MI_VARIANT void Integrator<Float, Spectrum>::cancel() {
     m_stop = true;
 }
 
+MI_VARIANT size_t
+Integrator<Float, Spectrum>::wavefront_sample_footprint(size_t n_channels) const {
+    /* State of the sampler (e.g. PCG32 state and increment), which is
+       written at the end of every pass */
+    size_t footprint = 2 * sizeof(uint64_t);
+
+    if constexpr (dr::is_jit_v<Float>) {
+        /* Without recorded loops and virtual function calls, the loop state
+           (rays, throughput, path depth, etc.) and the sampled channels are
+           stored in memory between kernel launches. Double buffering is needed
+           while the next iteration is being computed. */
+        if (!jit_flag(JitFlag::LoopRecord) || !jit_flag(JitFlag::VCallRecord))
+            footprint += 2 * sizeof(ScalarFloat) * (48 + n_channels);
+    } else {
+        DRJIT_MARK_USED(n_channels);
+    }
+
+    return footprint;
+}
+
+MI_VARIANT uint32_t
+Integrator<Float, Spectrum>::wavefront_samples_per_pass(size_t pixel_count,
+                                                        uint32_t spp_per_pass,
+                                                        size_t n_channels) const {
+    constexpr size_t wavefront_size_limit = 0xffffffffu;
+
+    size_t budget = m_memory_budget;
+    if (budget == 0 && dr::is_llvm_v<Float>)
+        budget = util::physical_memory() / 2;
+
+    size_t max_lanes = wavefront_size_limit;
+    if (budget > 0)
+        max_lanes = std::min(max_lanes, budget / wavefront_sample_footprint(n_channels));
+
+    size_t max_spp = std::max(max_lanes / std::max(pixel_count, (size_t) 1),
+                              (size_t) 1);
+    if (spp_per_pass <= max_spp)
+        return spp_per_pass;
+
+    /* Splitting must not change the total sample count, hence the number of
+       samples per pass must be a divisor of the requested value */
+    uint32_t result = (uint32_t) max_spp;
+    while (spp_per_pass % result != 0)
+        result--;
+
+    return result;
+}
+
 // -----------------------------------------------------------------------------
 
 MI_VARIANT SamplingIntegrator<Float, Spectrum>::SamplingIntegrator(const Properties &props)
@@ -183,6 +273,11 @@ SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
 
         Spiral spiral(film_size, film->crop_offset(), block_size, n_passes);
 
+        // Films that stream finished regions to disk need them to complete in order
+        if (film->scanline_order())
+            spiral.set_scanline_order(true);
+        film->prepare_blocks(block_size, n_passes);
+
         std::mutex mutex;
         ref<ProgressReporter> progress;
         Logger* logger = mitsuba::Thread::thread()->logger();
@@ -193,16 +288,39 @@ SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
         uint32_t total_blocks = spiral.block_count() * n_passes,
                  blocks_done = 0;
 
-        // Grain size for parallelization
-        uint32_t grain_size = std::max(total_blocks / (4 * n_threads), 1u);
-
         // Avoid overlaps in RNG seeding RNG when a seed is manually specified
         seed *= dr::prod(film_size);
 
+        /* Blocks that are currently being rendered. Once the spiral is
+           exhausted, idle workers help finishing the remaining pixels of
+           these blocks instead of waiting for the slowest thread. Samples are
+           seeded based on the block ID and pixel index, hence the same samples
+           are taken no matter how the work was distributed. With a box filter,
+           the image is identical. Other filters splat samples into neighboring
+           pixels, whose sums may then be accumulated in a different order
+           (i.e. the image only matches up to floating point rounding).
+           Contributions of helpers are merged into the block before it is
+           passed to the film. */
+        struct ActiveBlock {
+            ScalarPoint2i offset;
+            ScalarVector2u size;
+            uint32_t block_id;
+            BlockPixelQueue queue;
+            bool shared = false;                // Protected by 'active_mutex'
+            uint32_t helpers = 0;               // Protected by 'active_mutex'
+            std::vector<ref<ImageBlock>> parts; // Protected by 'active_mutex'
+            std::condition_variable cv;
+        };
+
+        std::mutex active_mutex;
+        std::vector<ActiveBlock *> active;
+        const uint32_t pixel_count = block_size * block_size,
+                       chunk_size  = std::min(pixel_count, 16u);
+
         ThreadEnvironment env;
         dr::parallel_for(
-            dr::blocked_range<uint32_t>(0, total_blocks, grain_size),
-            [&](const dr::blocked_range<uint32_t> &range) {
+            dr::blocked_range<uint32_t>(0, n_threads, 1),
+            [&](const dr::blocked_range<uint32_t> &) {
                 ScopedSetThreadEnvironment set_env(env);
                 // Fork a non-overlapping sampler for the current worker
                 ref<Sampler> sampler = sensor->sampler()->fork();
@@ -214,10 +332,11 @@ SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
 
                 std::unique_ptr<Float[]> aovs(new Float[n_channels]);
 
-                // Render up to 'grain_size' image blocks
-                for (uint32_t i = range.begin();
-                     i != range.end() && !should_stop(); ++i) {
+                // Render image blocks until the spiral is exhausted
+                while (!should_stop()) {
                     auto [offset, size, block_id] = spiral.next_block();
+                    if (block_id == (uint32_t) -1)
+                        break;
                     Assert(dr::prod(size) != 0);
 
                     if (film->sample_border())
@@ -226,8 +345,38 @@ SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
                     block->set_size(size);
                     block->set_offset(offset);
 
-                    render_block(scene, sensor, sampler, block, aovs.get(),
-                                 spp_per_pass, seed, block_id, block_size);
+                    ActiveBlock ab;
+                    ab.offset = offset;
+                    ab.size = size;
+                    ab.block_id = block_id;
+                    ab.queue.pixel_count = pixel_count;
+                    ab.queue.chunk_size = chunk_size;
+                    ab.queue.on_share = [&] {
+                        std::lock_guard<std::mutex> lock(active_mutex);
+                        active.push_back(&ab);
+                        ab.shared = true;
+                    };
+
+                    {
+                        ScopedTraceEvent trace("render", [&] {
+                            return tfm::format("Block %u", block_id);
+                        });
+
+                        current_pixel_queue = &ab.queue;
+                        render_block(scene, sensor, sampler, block, aovs.get(),
+                                     spp_per_pass, seed, block_id, block_size);
+                        current_pixel_queue = nullptr;
+
+                        // Wait for workers that are helping with this block
+                        std::unique_lock<std::mutex> lock(active_mutex);
+                        if (ab.shared) {
+                            active.erase(std::find(active.begin(), active.end(), &ab));
+                            ab.cv.wait(lock, [&] { return ab.helpers == 0; });
+                        }
+                    }
+
+                    for (const ref<ImageBlock> &part : ab.parts)
+                        block->put_block(part);
 
                     film->put_block(block);
 
@@ -238,30 +387,88 @@ SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
                         progress->update(blocks_done / (float) total_blocks);
                     }
                 }
+
+                // Help with the blocks that have the most remaining pixels
+                while (!should_stop()) {
+                    ActiveBlock *ab = nullptr;
+                    /* locked */ {
+                        std::lock_guard<std::mutex> lock(active_mutex);
+                        uint32_t max_remaining = chunk_size;
+                        for (ActiveBlock *candidate : active) {
+                            uint32_t remaining = candidate->queue.remaining();
+                            if (remaining > max_remaining) {
+                                ab = candidate;
+                                max_remaining = remaining;
+                            }
+                        }
+                        if (ab)
+                            ab->helpers++;
+                    }
+
+                    if (!ab)
+                        break;
+
+                    ref<ImageBlock> part = film->create_block(
+                        ScalarVector2u(block_size) /* size */,
+                        false /* normalize */,
+                        true /* border */);
+                    part->set_size(ab->size);
+                    part->set_offset(ab->offset);
+                    part->clear();
+
+                    {
+                        ScopedTraceEvent trace("render", [&] {
+                            return tfm::format("Block %u (helping)", ab->block_id);
+                        });
+                        uint32_t begin, end;
+                        while (!should_stop() && ab->queue.next(begin, end))
+                            render_block_pixels(scene, sensor, sampler, part,
+                                                aovs.get(), spp_per_pass, seed,
+                                                ab->block_id, block_size,
+                                                begin, end);
+                    }
+
+                    std::lock_guard<std::mutex> lock(active_mutex);
+                    ab->parts.push_back(part);
+                    if (--ab->helpers == 0)
+                        ab->cv.notify_all();
+                }
             }
         );
 
+        if (ObjectProfiler::enabled())
+            Log(Info, "%s", ObjectProfiler::report());
+
         if (develop)
             result = film->develop();
     } else {
-        size_t wavefront_size = (size_t) film_size.x() *
-                                (size_t) film_size.y() * (size_t) spp_per_pass,
-               wavefront_size_limit = 0xffffffffu;
-
-        if (wavefront_size > wavefront_size_limit) {
-            spp_per_pass /=
-                (uint32_t)((wavefront_size + wavefront_size_limit - 1) /
-                           wavefront_size_limit);
-            n_passes       = spp / spp_per_pass;
-            wavefront_size = (size_t) film_size.x() * (size_t) film_size.y() *
-                             (size_t) spp_per_pass;
-
-            Log(Warn,
-                "The requested rendering task involves %zu Monte Carlo "
-                "samples, which exceeds the upper limit of 2^32 = 4294967296 "
-                "for this variant. Mitsuba will instead split the rendering "
-                "task into %zu smaller passes to avoid exceeding the limits.",
-                wavefront_size, n_passes);
+        size_t pixel_count = (size_t) film_size.x() * (size_t) film_size.y(),
+               wavefront_size = pixel_count * (size_t) spp_per_pass;
+
+        /* Split the rendering task into smaller passes if the wavefront
+           exceeds the limits of this variant or the memory budget */
+        uint32_t spp_per_pass_split =
+            wavefront_samples_per_pass(pixel_count, spp_per_pass, n_channels);
+
+        if (spp_per_pass_split != spp_per_pass) {
+            size_t wavefront_size_split = pixel_count * (size_t) spp_per_pass_split;
+            spp_per_pass = spp_per_pass_split;
+            n_passes = spp / spp_per_pass;
+
+            if (wavefront_size > 0xffffffffu)
+                Log(Warn,
+                    "The requested rendering task involves %zu Monte Carlo "
+                    "samples, which exceeds the upper limit of 2^32 = 4294967296 "
+                    "for this variant. Mitsuba will instead split the rendering "
+                    "task into %u smaller passes to avoid exceeding the limits.",
+                    wavefront_size, n_passes);
+            else
+                Log(Info,
+                    "Splitting the rendering task into %u passes to stay "
+                    "within the memory budget (%s per sample).", n_passes,
+                    util::mem_string(wavefront_sample_footprint(n_channels)));
+
+            wavefront_size = wavefront_size_split;
         }
 
         dr::sync_thread(); // Separate from scene initialization (for timings)
@@ -317,6 +524,9 @@ SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
 
         // Potentially render multiple passes
         for (size_t i = 0; i < n_passes; i++) {
+            ScopedTraceEvent trace("render", [&] {
+                return tfm::format("Pass %zu", i);
+            });
             render_sample(scene, sensor, sampler, block, aovs.get(), pos,
                           diff_scale_factor);
 
@@ -356,6 +566,10 @@ SamplingIntegrator<Float, Spectrum>::render(Scene *scene,
             }
 
             dr::sync_thread();
+
+            if constexpr (dr::is_llvm_v<Float>)
+                Log(Debug, "Peak resident memory: %s",
+                    util::mem_string(util::peak_memory_usage()));
         }
     }
 
@@ -376,6 +590,53 @@ MI_VARIANT void SamplingIntegrator<Float, Spectrum>::render_block(const Scene *s
                                                                    uint32_t block_id,
                                                                    uint32_t block_size) const {
 
+    if constexpr (!dr::is_array_v<Float>) {
+        // Clear block (it's being reused)
+        block->clear();
+
+        BlockPixelQueue *queue = current_pixel_queue;
+        if (queue) {
+            // Claim pixels in chunks, so that idle workers of render() can help
+            current_pixel_queue = nullptr;
+            queue->on_share();
+
+            uint32_t begin, end;
+            while (!should_stop() && queue->next(begin, end))
+                render_block_pixels(scene, sensor, sampler, block, aovs,
+                                    sample_count, seed, block_id, block_size,
+                                    begin, end);
+        } else {
+            render_block_pixels(scene, sensor, sampler, block, aovs, sample_count,
+                                seed, block_id, block_size, 0,
+                                block_size * block_size);
+        }
+    } else {
+        DRJIT_MARK_USED(scene);
+        DRJIT_MARK_USED(sensor);
+        DRJIT_MARK_USED(sampler);
+        DRJIT_MARK_USED(block);
+        DRJIT_MARK_USED(aovs);
+        DRJIT_MARK_USED(sample_count);
+        DRJIT_MARK_USED(seed);
+        DRJIT_MARK_USED(block_id);
+        DRJIT_MARK_USED(block_size);
+        Throw("Not implemented for JIT arrays.");
+    }
+}
+
+MI_VARIANT void
+SamplingIntegrator<Float, Spectrum>::render_block_pixels(const Scene *scene,
+                                                         const Sensor *sensor,
+                                                         Sampler *sampler,
+                                                         ImageBlock *block,
+                                                         Float *aovs,
+                                                         uint32_t sample_count,
+                                                         uint32_t seed,
+                                                         uint32_t block_id,
+                                                         uint32_t block_size,
+                                                         uint32_t pixel_begin,
+                                                         uint32_t pixel_end) const {
+
     if constexpr (!dr::is_array_v<Float>) {
         uint32_t pixel_count = block_size * block_size;
 
@@ -385,10 +646,7 @@ MI_VARIANT void SamplingIntegrator<Float, Spectrum>::render_block(const Scene *s
         // Scale down ray differentials when tracing multiple rays per pixel
         Float diff_scale_factor = dr::rsqrt((Float) sample_count);
 
-        // Clear block (it's being reused)
-        block->clear();
-
-        for (uint32_t i = 0; i < pixel_count && !should_stop(); ++i) {
+        for (uint32_t i = pixel_begin; i < pixel_end && !should_stop(); ++i) {
             sampler->seed(seed + i);
 
             Point2u pos = dr::morton_decode<Point2u>(i);
@@ -412,6 +670,8 @@ MI_VARIANT void SamplingIntegrator<Float, Spectrum>::render_block(const Scene *s
         DRJIT_MARK_USED(seed);
         DRJIT_MARK_USED(block_id);
         DRJIT_MARK_USED(block_size);
+        DRJIT_MARK_USED(pixel_begin);
+        DRJIT_MARK_USED(pixel_end);
         Throw("Not implemented for JIT arrays.");
     }
 }
@@ -669,32 +929,41 @@ AdjointIntegrator<Float, Spectrum>::render(Scene *scene,
             }
         );
 
+        if (ObjectProfiler::enabled())
+            Log(Info, "%s", ObjectProfiler::report());
+
         if (develop)
             result = film->develop();
     } else {
+        size_t pixel_count = (size_t) film_size.x() * (size_t) film_size.y();
+        uint32_t spp_per_pass_split =
+            wavefront_samples_per_pass(pixel_count, spp_per_pass, 1);
+
+        if (spp_per_pass_split != spp_per_pass) {
+            spp_per_pass = spp_per_pass_split;
+            n_passes = spp / spp_per_pass;
+
+            if (samples_per_pass > 0xffffffffu)
+                Log(Warn,
+                    "The requested rendering task involves %zu Monte Carlo "
+                    "samples, which exceeds the upper limit of 2^32 = 4294967296 "
+                    "for this variant. Mitsuba will instead split the rendering "
+                    "task into %u smaller passes to avoid exceeding the limits.",
+                    samples_per_pass, n_passes);
+            else
+                Log(Info,
+                    "Splitting the rendering task into %u passes to stay "
+                    "within the memory budget.", n_passes);
+
+            samples_per_pass = pixel_count * (size_t) spp_per_pass;
+        }
+
         if (n_passes > 1 && !evaluate) {
             Log(Warn, "render(): forcing 'evaluate=true' since multi-pass "
                       "rendering was requested.");
             evaluate = true;
         }
 
-        constexpr size_t wavefront_size_limit = 0xffffffffu;
-        if (samples_per_pass > wavefront_size_limit) {
-            spp_per_pass /=
-                (uint32_t)((samples_per_pass + wavefront_size_limit - 1) /
-                           wavefront_size_limit);
-            n_passes = spp / spp_per_pass;
-            samples_per_pass = (size_t) film_size.x() * (size_t) film_size.y() *
-                               (size_t) spp_per_pass;
-
-            Log(Warn,
-                "The requested rendering task involves %zu Monte Carlo "
-                "samples, which exceeds the upper limit of 2^32 = 4294967296 "
-                "for this variant. Mitsuba will instead split the rendering "
-                "task into %zu smaller passes to avoid exceeding the limits.",
-                samples_per_pass, n_passes);
-        }
-
         Log(Info, "Starting render job (%ux%u, %u sample%s%s)",
             crop_size.x(), crop_size.y(), spp, spp == 1 ? "" : "s",
             n_passes > 1 ? tfm::format(", %u passes", n_passes) : "");
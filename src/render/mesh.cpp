@@ -1,4 +1,5 @@
 #include <mitsuba/core/fstream.h>
+#include <mitsuba/core/shmem.h>
 #include <mitsuba/core/timer.h>
 #include <mitsuba/core/transform.h>
 #include <mitsuba/core/util.h>
@@ -9,6 +10,8 @@
 #include <mitsuba/render/mesh.h>
 #include <mitsuba/render/records.h>
 #include <mitsuba/render/scene.h>
+#include <algorithm>
+#include <numeric>
 
 #if defined(MI_ENABLE_EMBREE)
     #include <embree3/rtcore.h>
@@ -30,6 +33,11 @@ MI_VARIANT Mesh<Float, Spectrum>::Mesh(const Properties &props) : Base(props) {
     m_face_normals = props.get<bool>("face_normals", false);
     m_flip_normals = props.get<bool>("flip_normals", false);
 
+    /* When set to ``false``, silhouette queries of large meshes perform a
+       linear scan over all edges instead of traversing a hierarchy over
+       them. Default: ``true`` */
+    m_silhouette_bvh = props.get<bool>("silhouette_bvh", true);
+
     m_discontinuity_types = (uint32_t) DiscontinuityFlags::PerimeterType;
     dr::set_attr(this, "silhouette_discontinuity_types", m_discontinuity_types);
 
@@ -124,6 +132,9 @@ MI_VARIANT void Mesh<Float, Spectrum>::parameters_changed(const std::vector<std:
 
     if (keys.empty() || string::contains(keys, "faces")) { // Topology changed
         m_E2E_outdated = true;
+        m_sil_bvh_nodes.clear();
+        m_sil_bvh_edges.clear();
+        m_sil_bvh_dirty = true;
         if (parameters_grad_enabled())
             build_directed_edges();
     }
@@ -140,6 +151,8 @@ MI_VARIANT void Mesh<Float, Spectrum>::parameters_changed(const std::vector<std:
         if (m_parameterization)
             m_parameterization = nullptr;
 
+        m_sil_bvh_dirty = true;
+
         if (parameters_grad_enabled()) {
             // A topology change could have been made in a first update, and
             // then the vertex enabled gradient tracking in a second update
@@ -161,6 +174,173 @@ MI_VARIANT void Mesh<Float, Spectrum>::parameters_changed(const std::vector<std:
     Base::parameters_changed();
 }
 
+MI_VARIANT void Mesh<Float, Spectrum>::set_buffers(FloatStorage vertex_positions,
+                                                   DynamicBuffer<UInt32> faces,
+                                                   FloatStorage vertex_texcoords) {
+    if (dr::width(vertex_positions) % 3 != 0)
+        Throw("Mesh::set_buffers(): the size of the vertex position buffer "
+              "(%zu) must be a multiple of 3!", dr::width(vertex_positions));
+    if (dr::width(faces) % 3 != 0)
+        Throw("Mesh::set_buffers(): the size of the face buffer (%zu) must be "
+              "a multiple of 3!", dr::width(faces));
+
+    std::vector<std::string> keys = { "vertex_positions", "faces" };
+    m_vertex_positions = std::move(vertex_positions);
+    m_faces = std::move(faces);
+
+    if (dr::width(vertex_texcoords) != 0) {
+        if (dr::width(vertex_texcoords) != dr::width(m_vertex_positions) / 3 * 2)
+            Throw("Mesh::set_buffers(): expected %zu texture coordinates, got %zu!",
+                  dr::width(m_vertex_positions) / 3 * 2, dr::width(vertex_texcoords));
+        m_vertex_texcoords = std::move(vertex_texcoords);
+        keys.push_back("vertex_texcoords");
+    }
+
+    parameters_changed(keys);
+}
+
+/// Header of a mesh published to the node-level shared memory cache
+struct SharedMeshHeader {
+    uint64_t vertex_count;
+    uint64_t face_count;
+    uint32_t has_normals;
+    uint32_t has_texcoords;
+    double bbox_min[3];
+    double bbox_max[3];
+};
+
+/// Byte offsets of the buffers within a shared memory region
+struct SharedMeshLayout {
+    size_t positions, normals, texcoords, faces, size;
+
+    SharedMeshLayout(const SharedMeshHeader &h, size_t float_size) {
+        using R = SharedMemoryRegion;
+        positions = R::align(sizeof(SharedMeshHeader));
+        normals   = R::align(positions + h.vertex_count * 3 * float_size);
+        texcoords = R::align(normals + (h.has_normals ? h.vertex_count * 3 * float_size : 0));
+        faces     = R::align(texcoords + (h.has_texcoords ? h.vertex_count * 2 * float_size : 0));
+        size      = faces + h.face_count * 3 * sizeof(uint32_t);
+    }
+};
+
+MI_VARIANT std::string
+Mesh<Float, Spectrum>::shared_cache_key(const fs::path &path,
+                                        const std::string &params) const {
+    const ScalarTransform4f &to_world = m_to_world.scalar();
+    std::string descr = tfm::format(
+        "mesh|%s|%s|%s|%i|", detail::get_variant<Float, Spectrum>(),
+        SharedMemoryRegion::file_descriptor(path), params, m_face_normals);
+
+    // Use the exact bit pattern of the transformation
+    descr.append((const char *) &to_world.matrix, sizeof(to_world.matrix));
+    return SharedMemoryRegion::make_key(descr);
+}
+
+MI_VARIANT bool Mesh<Float, Spectrum>::load_from_shared_cache(const std::string &key) {
+    ref<SharedMemoryRegion> region = SharedMemoryRegion::open(key);
+    if (!region)
+        return false;
+
+    auto corrupt = [&]() {
+        Log(Warn, "\"%s\": ignoring corrupt shared memory cache entry \"%s\".",
+            m_name, key);
+        return false;
+    };
+
+    SharedMeshHeader header;
+    if (region->size() < sizeof(SharedMeshHeader))
+        return corrupt();
+    memcpy(&header, region->data(), sizeof(SharedMeshHeader));
+
+    // Reject counts that would overflow the layout computation below
+    if (header.vertex_count > 0xFFFFFFFFull || header.face_count > 0xFFFFFFFFull)
+        return corrupt();
+
+    SharedMeshLayout layout(header, sizeof(InputFloat));
+    if (layout.size > region->size())
+        return corrupt();
+
+    // Face indices are used without further checks during rendering
+    const uint32_t *faces =
+        (const uint32_t *) ((const uint8_t *) region->data() + layout.faces);
+    for (size_t i = 0; i < header.face_count * 3; ++i) {
+        if (faces[i] >= header.vertex_count)
+            return corrupt();
+    }
+
+    m_vertex_count = (ScalarSize) header.vertex_count;
+    m_face_count = (ScalarSize) header.face_count;
+
+    m_vertex_positions =
+        region->view<FloatStorage>(layout.positions, m_vertex_count * 3);
+    m_vertex_normals = header.has_normals
+        ? region->view<FloatStorage>(layout.normals, m_vertex_count * 3)
+        : FloatStorage();
+    m_vertex_texcoords = header.has_texcoords
+        ? region->view<FloatStorage>(layout.texcoords, m_vertex_count * 2)
+        : FloatStorage();
+    m_faces = region->view<DynamicBuffer<UInt32>>(layout.faces, m_face_count * 3);
+
+    // JIT arrays keep the region mapped by themselves
+    if constexpr (!dr::is_jit_v<Float>)
+        m_shared_region = region;
+
+    m_bbox = ScalarBoundingBox3f(
+        ScalarPoint3f(header.bbox_min[0], header.bbox_min[1], header.bbox_min[2]),
+        ScalarPoint3f(header.bbox_max[0], header.bbox_max[1], header.bbox_max[2]));
+
+    Log(Debug, "\"%s\": mapped %i faces, %i vertices from the shared memory cache",
+        m_name, m_face_count, m_vertex_count);
+    return true;
+}
+
+MI_VARIANT void Mesh<Float, Spectrum>::publish_to_shared_cache(const std::string &key) {
+    if (!m_mesh_attributes.empty())
+        return;
+
+    SharedMeshHeader header;
+    header.vertex_count = m_vertex_count;
+    header.face_count = m_face_count;
+    header.has_normals = has_vertex_normals();
+    header.has_texcoords = has_vertex_texcoords();
+    for (int i = 0; i < 3; ++i) {
+        header.bbox_min[i] = (double) m_bbox.min[i];
+        header.bbox_max[i] = (double) m_bbox.max[i];
+    }
+    SharedMeshLayout layout(header, sizeof(InputFloat));
+
+    // Fails if another process is already publishing this mesh
+    ref<SharedMemoryRegion> region = SharedMemoryRegion::create(key, layout.size);
+    if (!region)
+        return;
+
+    auto&& vertex_positions = dr::migrate(m_vertex_positions, AllocType::Host);
+    auto&& vertex_normals   = dr::migrate(m_vertex_normals, AllocType::Host);
+    auto&& vertex_texcoords = dr::migrate(m_vertex_texcoords, AllocType::Host);
+    auto&& faces = dr::migrate(m_faces, AllocType::Host);
+
+    // Evaluate buffers if necessary
+    if constexpr (dr::is_jit_v<Float>)
+        dr::sync_thread();
+
+    uint8_t *ptr = (uint8_t *) region->data();
+    memcpy(ptr, &header, sizeof(SharedMeshHeader));
+    memcpy(ptr + layout.positions, vertex_positions.data(),
+           m_vertex_count * 3 * sizeof(InputFloat));
+    if (header.has_normals)
+        memcpy(ptr + layout.normals, vertex_normals.data(),
+               m_vertex_count * 3 * sizeof(InputFloat));
+    if (header.has_texcoords)
+        memcpy(ptr + layout.texcoords, vertex_texcoords.data(),
+               m_vertex_count * 2 * sizeof(InputFloat));
+    memcpy(ptr + layout.faces, faces.data(), m_face_count * 3 * sizeof(uint32_t));
+
+    region->publish();
+
+    // Drop the private copies in favor of the published buffers
+    load_from_shared_cache(key);
+}
+
 MI_VARIANT typename Mesh<Float, Spectrum>::ScalarBoundingBox3f
 Mesh<Float, Spectrum>::bbox() const {
     return m_bbox;
@@ -567,6 +747,75 @@ MI_VARIANT void Mesh<Float, Spectrum>::build_directed_edges() {
     m_E2E_outdated = false;
 }
 
+/// Host-side view of the mesh buffers used by the silhouette edge hierarchy
+template <typename ScalarFloat, typename InputFloat, typename ScalarIndex>
+struct SilhouetteEdgeData {
+    using ScalarPoint3f  = Point<ScalarFloat, 3>;
+    using ScalarVector3f = Vector<ScalarFloat, 3>;
+
+    const InputFloat *V;
+    const ScalarIndex *F;
+    const ScalarIndex *E2E;
+
+    ScalarPoint3f vertex(ScalarIndex index) const {
+        return ScalarPoint3f((ScalarFloat) V[3 * index],
+                             (ScalarFloat) V[3 * index + 1],
+                             (ScalarFloat) V[3 * index + 2]);
+    }
+
+    /// Start (\c k = 0), end (\c k = 1) or opposite (\c k = 2) vertex of a directed edge
+    ScalarPoint3f edge_vertex(ScalarIndex dedge, ScalarIndex k) const {
+        ScalarIndex face = dedge / 3, e = dedge % 3;
+        return vertex(F[3 * face + (e + k) % 3]);
+    }
+
+    /// Unit normal of a face, or zero if the face is degenerate
+    ScalarVector3f face_normal(ScalarIndex face) const {
+        ScalarPoint3f p0 = vertex(F[3 * face]),
+                      p1 = vertex(F[3 * face + 1]),
+                      p2 = vertex(F[3 * face + 2]);
+        ScalarVector3f n = dr::cross(p1 - p0, p2 - p0);
+        ScalarFloat length = dr::norm(n);
+        return length > 0.f ? n / length : ScalarVector3f(0.f);
+    }
+};
+
+/**
+ * \brief Returns a cone bounding the two normal cones <tt>(a0, t0)</tt>
+ * and <tt>(a1, t1)</tt>
+ *
+ * Cones are given by their unit axis and half-angle. A negative half-angle
+ * denotes an empty cone, and a half-angle of \c Pi covers the whole sphere.
+ */
+template <typename ScalarVector3f, typename ScalarFloat = dr::value_t<ScalarVector3f>>
+std::pair<ScalarVector3f, ScalarFloat>
+merge_normal_cones(const ScalarVector3f &a0, ScalarFloat t0,
+                   const ScalarVector3f &a1, ScalarFloat t1) {
+    const ScalarFloat pi = dr::Pi<ScalarFloat>;
+    if (t0 < 0.f)
+        return { a1, t1 };
+    if (t1 < 0.f)
+        return { a0, t0 };
+    if (t0 >= pi || t1 >= pi)
+        return { a0, pi };
+
+    ScalarFloat d = unit_angle(a0, a1);
+    if (d + t1 <= t0)
+        return { a0, t0 };
+    if (d + t0 <= t1)
+        return { a1, t1 };
+
+    ScalarFloat t = .5f * (t0 + d + t1);
+    ScalarVector3f w = a1 - a0 * dr::dot(a0, a1);
+    ScalarFloat w_norm = dr::norm(w);
+    if (t >= pi || !(w_norm > 1e-6f))
+        return { a0, pi };
+
+    // Rotate the first axis towards the second one
+    auto [s, c] = dr::sincos(t - t0);
+    return { dr::normalize(a0 * c + w * (s / w_norm)), t };
+}
+
 /**
  * \brief Picks a vertex index from \c vec using \c offset
  *
@@ -619,6 +868,165 @@ Mesh<Float, Spectrum>::build_indirect_silhouette_distribution() {
     m_sil_dedge_pmf = DiscreteDistribution<Float>(weight);
 }
 
+MI_VARIANT void Mesh<Float, Spectrum>::build_silhouette_bvh() {
+    if (m_E2E_outdated)
+        build_directed_edges();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_sil_bvh_dirty.load(std::memory_order_relaxed))
+        return; // Another thread already took care of this
+
+    Timer timer;
+    auto &&vertex_positions = dr::migrate(m_vertex_positions, AllocType::Host);
+    auto &&faces = dr::migrate(m_faces, AllocType::Host);
+    auto &&E2E   = dr::migrate(m_E2E, AllocType::Host);
+    if constexpr (dr::is_array_v<Float>)
+        dr::sync_thread();
+
+    SilhouetteEdgeData<ScalarFloat, InputFloat, ScalarIndex> data{
+        vertex_positions.data(), faces.data(), E2E.data()
+    };
+
+    struct EdgeBounds {
+        ScalarBoundingBox3f bbox;
+        ScalarVector3f cone_axis;
+        ScalarFloat cone_angle;
+    };
+
+    auto edge_bounds = [&](ScalarIndex dedge) {
+        EdgeBounds eb;
+        eb.bbox = ScalarBoundingBox3f(data.edge_vertex(dedge, 0));
+        eb.bbox.expand(data.edge_vertex(dedge, 1));
+
+        ScalarVector3f n0 = data.face_normal(dedge / 3);
+        ScalarIndex dedge_oppo = data.E2E[dedge];
+        eb.cone_axis = n0;
+        eb.cone_angle = dr::Pi<ScalarFloat>; // Boundary edges are never culled
+
+        if (dedge_oppo != m_invalid_dedge) {
+            ScalarVector3f n1 = data.face_normal(dedge_oppo / 3);
+            if (dr::squared_norm(n0) > 0.f && dr::squared_norm(n1) > 0.f)
+                std::tie(eb.cone_axis, eb.cone_angle) =
+                    merge_normal_cones(n0, ScalarFloat(0), n1, ScalarFloat(0));
+        }
+        return eb;
+    };
+
+    auto merge_into = [](SilhouetteBVHNode &node, const ScalarBoundingBox3f &bbox,
+                         const ScalarVector3f &cone_axis, ScalarFloat cone_angle) {
+        node.bbox.expand(bbox);
+        std::tie(node.cone_axis, node.cone_angle) = merge_normal_cones(
+            node.cone_axis, node.cone_angle, cone_axis, cone_angle);
+    };
+
+    auto reset = [](SilhouetteBVHNode &node) {
+        node.bbox = ScalarBoundingBox3f();
+        node.cone_axis = ScalarVector3f(0.f, 0.f, 1.f);
+        node.cone_angle = -1.f;
+    };
+
+    if (!m_sil_bvh_nodes.empty()) {
+        /* The topology did not change: refit the existing hierarchy bottom-up
+           (children are always stored after their parent) */
+        for (size_t i = m_sil_bvh_nodes.size(); i-- > 0; ) {
+            SilhouetteBVHNode &node = m_sil_bvh_nodes[i];
+            reset(node);
+            if (node.edge_count > 0) {
+                for (ScalarIndex j = 0; j < node.edge_count; ++j) {
+                    EdgeBounds eb = edge_bounds(m_sil_bvh_edges[node.offset + j]);
+                    merge_into(node, eb.bbox, eb.cone_axis, eb.cone_angle);
+                }
+            } else {
+                for (size_t child : { i + 1, (size_t) node.offset }) {
+                    const SilhouetteBVHNode &c = m_sil_bvh_nodes[child];
+                    merge_into(node, c.bbox, c.cone_axis, c.cone_angle);
+                }
+            }
+        }
+
+        m_sil_bvh_dirty.store(false, std::memory_order_release);
+        Log(Debug, "Mesh::build_silhouette_bvh(): refitted hierarchy of \"%s\" (took %s)",
+            m_name, util::time_string((float) timer.value()));
+        return;
+    }
+
+    // Collect all edges that can be part of a silhouette
+    struct BuildEdge {
+        ScalarIndex dedge;
+        ScalarPoint3f centroid;
+        EdgeBounds bounds;
+    };
+
+    std::vector<BuildEdge> edges;
+    edges.reserve(m_face_count * 3 / 2 + 1);
+    for (ScalarIndex dedge = 0; dedge < m_face_count * 3; ++dedge) {
+        ScalarIndex dedge_oppo = data.E2E[dedge];
+        // One edge can be represented by two dedge indices, we use the smaller index
+        if (dedge_oppo != m_invalid_dedge && dedge_oppo < dedge)
+            continue;
+        EdgeBounds eb = edge_bounds(dedge);
+        edges.push_back({ dedge, eb.bbox.center(), eb });
+    }
+
+    constexpr ScalarIndex max_leaf_size = 4;
+    m_sil_bvh_nodes.clear();
+    m_sil_bvh_nodes.reserve(2 * (edges.size() / max_leaf_size + 1));
+
+    // Recursive median split along the largest extent of the edge centroids
+    auto build = [&](auto &self, size_t start, size_t end) -> void {
+        size_t node_index = m_sil_bvh_nodes.size();
+        m_sil_bvh_nodes.emplace_back();
+        reset(m_sil_bvh_nodes[node_index]);
+
+        if (end - start <= max_leaf_size) {
+            SilhouetteBVHNode &node = m_sil_bvh_nodes[node_index];
+            node.offset = (ScalarIndex) start;
+            node.edge_count = (ScalarIndex) (end - start);
+            for (size_t i = start; i < end; ++i)
+                merge_into(node, edges[i].bounds.bbox,
+                           edges[i].bounds.cone_axis,
+                           edges[i].bounds.cone_angle);
+            return;
+        }
+
+        ScalarBoundingBox3f centroid_bbox;
+        for (size_t i = start; i < end; ++i)
+            centroid_bbox.expand(edges[i].centroid);
+        uint32_t axis = centroid_bbox.major_axis();
+
+        size_t mid = start + (end - start) / 2;
+        std::nth_element(edges.begin() + start, edges.begin() + mid,
+                         edges.begin() + end,
+                         [axis](const BuildEdge &a, const BuildEdge &b) {
+                             return a.centroid[axis] < b.centroid[axis];
+                         });
+
+        self(self, start, mid);
+        ScalarIndex right = (ScalarIndex) m_sil_bvh_nodes.size();
+        self(self, mid, end);
+
+        SilhouetteBVHNode &node = m_sil_bvh_nodes[node_index];
+        node.offset = right;
+        node.edge_count = 0;
+        for (size_t child : { node_index + 1, (size_t) right }) {
+            const SilhouetteBVHNode c = m_sil_bvh_nodes[child];
+            merge_into(node, c.bbox, c.cone_axis, c.cone_angle);
+        }
+    };
+
+    if (!edges.empty())
+        build(build, 0, edges.size());
+
+    m_sil_bvh_edges.resize(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i)
+        m_sil_bvh_edges[i] = edges[i].dedge;
+
+    m_sil_bvh_dirty.store(false, std::memory_order_release);
+    Log(Debug, "Mesh::build_silhouette_bvh(): \"%s\": %zu nodes over %zu edges (took %s)",
+        m_name, m_sil_bvh_nodes.size(), edges.size(),
+        util::time_string((float) timer.value()));
+}
+
 MI_VARIANT
 ref<Mesh<Float, Spectrum>>
 Mesh<Float, Spectrum>::merge(const Mesh *other) const {
@@ -746,16 +1154,8 @@ MI_VARIANT Float Mesh<Float, Spectrum>::surface_area() const {
 // =============================================================
 
 MI_VARIANT typename Mesh<Float, Spectrum>::PositionSample3f
-Mesh<Float, Spectrum>::sample_position(Float time, const Point2f &sample_, Mask active) const {
-    ensure_pmf_built();
-
-    using Index = dr::replace_scalar_t<Float, ScalarIndex>;
-    Index face_idx;
-    Point2f sample = sample_;
-
-    std::tie(face_idx, sample.y()) =
-        m_area_pmf.sample_reuse(sample.y(), active);
-
+Mesh<Float, Spectrum>::triangle_position_sample(Float time, const Index &face_idx,
+                                                const Point2f &b, Mask active) const {
     Vector3u fi = face_indices(face_idx, active);
 
     Point3f p0 = vertex_position(fi[0], active),
@@ -763,13 +1163,12 @@ Mesh<Float, Spectrum>::sample_position(Float time, const Point2f &sample_, Mask
             p2 = vertex_position(fi[2], active);
 
     Vector3f e0 = p1 - p0, e1 = p2 - p0;
-    Point2f b = warp::square_to_uniform_triangle(sample);
 
-    PositionSample3f ps;
-    ps.p     = dr::fmadd(e0, b.x(), dr::fmadd(e1, b.y(), p0));
-    ps.time  = time;
-    ps.pdf   = m_area_pmf.normalization();
-    ps.delta = false;
+    PositionSample3f ps = dr::zeros<PositionSample3f>();
+    ps.p          = dr::fmadd(e0, b.x(), dr::fmadd(e1, b.y(), p0));
+    ps.time       = time;
+    ps.delta      = false;
+    ps.prim_index = face_idx;
 
     if (has_vertex_texcoords()) {
         Point2f uv0 = vertex_texcoord(fi[0], active),
@@ -801,6 +1200,91 @@ Mesh<Float, Spectrum>::sample_position(Float time, const Point2f &sample_, Mask
     return ps;
 }
 
+MI_VARIANT typename Mesh<Float, Spectrum>::PositionSample3f
+Mesh<Float, Spectrum>::sample_position(Float time, const Point2f &sample_, Mask active) const {
+    ensure_pmf_built();
+
+    Index face_idx;
+    Point2f sample = sample_;
+
+    std::tie(face_idx, sample.y()) =
+        m_area_pmf.sample_reuse(sample.y(), active);
+
+    PositionSample3f ps = triangle_position_sample(
+        time, face_idx, warp::square_to_uniform_triangle(sample), active);
+    ps.pdf = m_area_pmf.normalization();
+
+    return ps;
+}
+
+MI_VARIANT typename Mesh<Float, Spectrum>::DirectionSample3f
+Mesh<Float, Spectrum>::sample_direction(const Interaction3f &it,
+                                        const Point2f &sample_,
+                                        Mask active) const {
+    MI_MASK_ARGUMENT(active);
+    ensure_pmf_built();
+
+    Index face_idx;
+    Point2f sample = sample_;
+
+    std::tie(face_idx, sample.y()) =
+        m_area_pmf.sample_reuse(sample.y(), active);
+
+    Vector3u fi = face_indices(face_idx, active);
+
+    Point3f p0 = vertex_position(fi[0], active),
+            p1 = vertex_position(fi[1], active),
+            p2 = vertex_position(fi[2], active);
+
+    Vector3f a = dr::normalize(p0 - it.p),
+             b = dr::normalize(p1 - it.p),
+             c = dr::normalize(p2 - it.p);
+
+    Float solid_angle = warp::spherical_triangle_solid_angle(a, b, c);
+
+    Mask solid_angle_mask = active &&
+                            solid_angle > SolidAngleSamplingMin &&
+                            solid_angle < SolidAngleSamplingMax;
+
+    // Barycentric coordinates of the sampled position
+    Point2f bary = warp::square_to_uniform_triangle(sample);
+
+    if (likely(dr::any_or<true>(solid_angle_mask))) {
+        Vector3f d = warp::square_to_uniform_spherical_triangle(sample, a, b, c);
+
+        // Intersect the sampled direction with the triangle (Möller-Trumbore)
+        Vector3f e0 = p1 - p0, e1 = p2 - p0,
+                 h  = dr::cross(d, e1),
+                 o  = it.p - p0,
+                 q  = dr::cross(o, e0);
+
+        Float inv_det = dr::rcp(dr::dot(e0, h));
+        Point2f bary_sa(dr::dot(o, h) * inv_det, dr::dot(d, q) * inv_det);
+
+        // Guard against roundoff near the edges
+        bary_sa = dr::maximum(bary_sa, 0.f);
+        bary_sa /= dr::maximum(bary_sa.x() + bary_sa.y(), 1.f);
+
+        dr::masked(bary, solid_angle_mask) = bary_sa;
+    }
+
+    DirectionSample3f ds(triangle_position_sample(it.time, face_idx, bary, active));
+    ds.d = ds.p - it.p;
+
+    Float dist_squared = dr::squared_norm(ds.d);
+    ds.dist = dr::sqrt(dist_squared);
+    ds.d /= ds.dist;
+
+    // Distant or tiny triangles: convert the area density to solid angles
+    Float x = dist_squared / dr::abs_dot(ds.d, ds.n);
+    ds.pdf = dr::select(
+        solid_angle_mask,
+        m_area_pmf.eval_pmf_normalized(face_idx, active) / solid_angle,
+        m_area_pmf.normalization() * dr::select(dr::isfinite(x), x, 0.f));
+
+    return ds;
+}
+
 MI_VARIANT
 
 typename Mesh<Float, Spectrum>::SurfaceInteraction3f
@@ -832,6 +1316,29 @@ MI_VARIANT Float Mesh<Float, Spectrum>::pdf_position(const PositionSample3f &, M
     return m_area_pmf.normalization();
 }
 
+MI_VARIANT Float Mesh<Float, Spectrum>::pdf_direction(const Interaction3f &it,
+                                                       const DirectionSample3f &ds,
+                                                       Mask active) const {
+    MI_MASK_ARGUMENT(active);
+    ensure_pmf_built();
+
+    Vector3u fi = face_indices(ds.prim_index, active);
+
+    Vector3f a = dr::normalize(vertex_position(fi[0], active) - it.p),
+             b = dr::normalize(vertex_position(fi[1], active) - it.p),
+             c = dr::normalize(vertex_position(fi[2], active) - it.p);
+
+    Float solid_angle = warp::spherical_triangle_solid_angle(a, b, c);
+
+    Mask solid_angle_mask = solid_angle > SolidAngleSamplingMin &&
+                            solid_angle < SolidAngleSamplingMax;
+
+    return dr::select(
+        solid_angle_mask,
+        m_area_pmf.eval_pmf_normalized(ds.prim_index, active) / solid_angle,
+        Base::pdf_direction(it, ds, active));
+}
+
 //! @}
 // =============================================================
 
@@ -1180,6 +1687,12 @@ std::tuple<DynamicBuffer<typename CoreAliases<Float>::UInt32>,
            DynamicBuffer<Float>>
 Mesh<Float, Spectrum>::precompute_silhouette(
     const ScalarPoint3f &viewpoint) const {
+    if constexpr (!dr::is_cuda_v<Float>) {
+        // Large meshes whose buffers live in host memory use the edge hierarchy
+        if (m_silhouette_bvh && m_face_count >= m_sil_bvh_min_faces)
+            return precompute_silhouette_bvh(viewpoint);
+    }
+
     if constexpr (!dr::is_jit_v<Float>) {
         using Vec3f = ScalarVector3f;
         using Pt3f  = ScalarPoint3f;
@@ -1299,6 +1812,114 @@ Mesh<Float, Spectrum>::precompute_silhouette(
     }
 }
 
+MI_VARIANT
+std::tuple<DynamicBuffer<typename CoreAliases<Float>::UInt32>,
+           DynamicBuffer<Float>>
+Mesh<Float, Spectrum>::precompute_silhouette_bvh(
+    const ScalarPoint3f &viewpoint) const {
+    ensure_silhouette_bvh_built();
+
+    auto &&vertex_positions = dr::migrate(m_vertex_positions, AllocType::Host);
+    auto &&faces = dr::migrate(m_faces, AllocType::Host);
+    auto &&E2E   = dr::migrate(m_E2E, AllocType::Host);
+    if constexpr (dr::is_array_v<Float>)
+        dr::sync_thread();
+
+    SilhouetteEdgeData<ScalarFloat, InputFloat, ScalarIndex> data{
+        vertex_positions.data(), faces.data(), E2E.data()
+    };
+
+    /* A node can be skipped if the viewpoint lies strictly in front of (or
+       strictly behind) the planes of all faces adjacent to its edges. The
+       directions from the node's bounding sphere to the viewpoint form a cone
+       of half-angle 'alpha', hence the angle between any such direction and
+       any face normal is within [beta - spread, beta + spread]. A small margin
+       accounts for rounding errors. */
+    const ScalarFloat half_pi = .5f * dr::Pi<ScalarFloat>,
+                      margin  = 1e-4f;
+    auto culled = [&](const SilhouetteBVHNode &node) {
+        if (node.cone_angle >= half_pi)
+            return false;
+        ScalarPoint3f center = node.bbox.center();
+        ScalarFloat radius = .5f * dr::norm(node.bbox.extents());
+        ScalarVector3f d = viewpoint - center;
+        ScalarFloat dist = dr::norm(d);
+        if (dist <= radius)
+            return false;
+        ScalarFloat alpha  = dr::safe_asin(radius / dist),
+                    beta   = unit_angle(d / dist, node.cone_axis),
+                    spread = alpha + node.cone_angle + margin;
+        return beta + spread < half_pi || beta - spread > half_pi;
+    };
+
+    std::vector<ScalarIndex> indices;
+    std::vector<ScalarFloat> weight;
+
+    ScalarIndex stack[64];
+    size_t stack_size = 0;
+    if (!m_sil_bvh_nodes.empty())
+        stack[stack_size++] = 0;
+
+    while (stack_size > 0) {
+        ScalarIndex node_index = stack[--stack_size];
+        const SilhouetteBVHNode &node = m_sil_bvh_nodes[node_index];
+        if (culled(node))
+            continue;
+
+        if (node.edge_count == 0) {
+            stack[stack_size++] = node.offset;
+            stack[stack_size++] = node_index + 1;
+            continue;
+        }
+
+        for (ScalarIndex i = 0; i < node.edge_count; ++i) {
+            ScalarIndex dedge_curr = m_sil_bvh_edges[node.offset + i],
+                        dedge_oppo = data.E2E[dedge_curr];
+
+            ScalarVector3f dir1 = dr::normalize(data.edge_vertex(dedge_curr, 0) - viewpoint),
+                           dir2 = dr::normalize(data.edge_vertex(dedge_curr, 1) - viewpoint);
+
+            if (dedge_oppo != m_invalid_dedge) {
+                ScalarVector3f n      = data.face_normal(dedge_curr / 3),
+                               n_oppo = data.face_normal(dedge_oppo / 3);
+
+                if (dr::squared_norm(n) == 0.f || dr::squared_norm(n_oppo) == 0.f ||
+                    dr::dot(dir1, n) * dr::dot(dir1, n_oppo) > 0.f ||
+                    dr::abs(dr::dot(n, n_oppo)) >= 1.f)
+                    continue;
+            }
+
+            indices.push_back(dedge_curr);
+            // The arclength weight is not perfect for perspective
+            // cameras. But it is a close approximation.
+            weight.push_back(unit_angle(dir1, dir2));
+        }
+    }
+
+    // Report the edges in a deterministic order, as the linear scan does
+    std::vector<ScalarIndex> perm(indices.size());
+    std::iota(perm.begin(), perm.end(), 0);
+    std::sort(perm.begin(), perm.end(), [&](ScalarIndex a, ScalarIndex b) {
+        return indices[a] < indices[b];
+    });
+
+    std::vector<ScalarIndex> sorted_indices(indices.size());
+    std::vector<ScalarFloat> sorted_weight(indices.size());
+    for (size_t i = 0; i < perm.size(); ++i) {
+        sorted_indices[i] = indices[perm[i]];
+        sorted_weight[i] = weight[perm[i]];
+    }
+
+    return std::make_tuple(
+        dr::load<DynamicBuffer<UInt32>>(sorted_indices.data(), sorted_indices.size()),
+        dr::load<DynamicBuffer<Float>>(sorted_weight.data(), sorted_weight.size()));
+}
+
+MI_VARIANT DynamicBuffer<typename CoreAliases<Float>::UInt32>
+Mesh<Float, Spectrum>::silhouette_edges(const ScalarPoint3f &viewpoint) const {
+    return std::get<0>(precompute_silhouette(viewpoint));
+}
+
 MI_VARIANT typename Mesh<Float, Spectrum>::SilhouetteSample3f
 Mesh<Float, Spectrum>::sample_precomputed_silhouette(const Point3f &viewpoint,
                                                      Index sample1 /*=dedge*/,
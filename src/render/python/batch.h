@@ -0,0 +1,250 @@
+#pragma once
+
+#include <mitsuba/core/thread.h>
+#include <mitsuba/python/python.h>
+#include <pybind11/numpy.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**
+ * \brief Groups scalar queries to a Python-implemented method into batches
+ *
+ * In scalar variants, every call to a method of a plugin implemented in
+ * Python must acquire the GIL, which serializes all render threads. Python
+ * subclasses can instead provide a batched version of a method (e.g.
+ * ``eval_batch``) that receives NumPy arrays with one row per query.
+ *
+ * Render threads submit their queries via \ref submit() and block. The first
+ * thread of each batch keeps it open while other threads are about to join or
+ * while a previous batch still occupies the GIL (but at most for the duration
+ * given by \ref set_timeout()). It then invokes the Python method once and
+ * hands the results back to the waiting threads. A thread that submits with
+ * no other query in flight is thus evaluated right away. Callers that already
+ * hold the GIL evaluate their query directly.
+ *
+ * Each query consists of a fixed list of named columns (e.g. ``wi`` and
+ * ``uv``) that are passed as keyword arguments. The Python method must return
+ * an array containing \c out_size values per query.
+ */
+template <typename Value> class BatchDispatcher {
+public:
+    struct Column {
+        const char *name;
+        size_t size;
+    };
+
+    BatchDispatcher(std::function<py::function()> lookup,
+                    std::vector<Column> columns, size_t out_size)
+        : m_lookup(std::move(lookup)), m_columns(std::move(columns)),
+          m_out_size(out_size) {
+        for (const Column &c : m_columns)
+            m_in_size += c.size;
+    }
+
+    /// Number of input values per query (the sum of all column sizes)
+    size_t in_size() const { return m_in_size; }
+
+    /// Number of output values per query
+    size_t out_size() const { return m_out_size; }
+
+    /// Maximum time that the first thread of a batch waits for others to join
+    std::chrono::microseconds timeout() const { return m_timeout; }
+
+    /// Set the maximum time that the first thread of a batch waits for others
+    void set_timeout(std::chrono::microseconds timeout) { m_timeout = timeout; }
+
+    /// Evaluate a single query, possibly as part of a larger batch
+    void submit(const Value *in, Value *out) {
+        if (PyGILState_Check()) {
+            evaluate(1, in, out);
+            return;
+        }
+
+        m_arriving.fetch_add(1, std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_arriving.fetch_sub(1, std::memory_order_relaxed);
+
+        if (!m_pending)
+            m_pending = std::make_shared<Batch>();
+
+        std::shared_ptr<Batch> batch = m_pending;
+        size_t slot = batch->size++;
+        batch->in.insert(batch->in.end(), in, in + m_in_size);
+
+        // Close the batch once every render thread has joined
+        size_t target = std::min(MaxBatchSize,
+                                 std::max((size_t) Thread::thread_count(), (size_t) 1));
+        if (batch->size >= target)
+            m_pending = nullptr;
+        batch->cv.notify_all();
+
+        if (slot == 0) {
+            /* Keep the batch open while other threads are about to join, or
+               while the GIL is held by the evaluation of a previous batch */
+            batch->cv.wait_for(lock, m_timeout, [&] {
+                return m_pending != batch ||
+                       (m_evaluating == 0 &&
+                        m_arriving.load(std::memory_order_relaxed) == 0);
+            });
+            if (m_pending == batch)
+                m_pending = nullptr;
+            m_evaluating++;
+            lock.unlock();
+
+            batch->out.resize(batch->size * m_out_size);
+            try {
+                evaluate(batch->size, batch->in.data(), batch->out.data());
+            } catch (const std::exception &e) {
+                batch->error = e.what();
+            }
+
+            lock.lock();
+            batch->done = true;
+            batch->cv.notify_all();
+            if (--m_evaluating == 0 && m_pending)
+                m_pending->cv.notify_all();
+        } else {
+            batch->cv.wait(lock, [&] { return batch->done; });
+        }
+
+        if (!batch->error.empty())
+            Throw("%s", batch->error);
+
+        std::copy(batch->out.begin() + slot * m_out_size,
+                  batch->out.begin() + (slot + 1) * m_out_size, out);
+    }
+
+protected:
+    /// Maximum number of queries per batch
+    static constexpr size_t MaxBatchSize = 1024;
+
+    struct Batch {
+        std::vector<Value> in, out;
+        size_t size = 0;
+        bool done = false;
+        std::string error;
+        std::condition_variable cv;
+    };
+
+    /// Invoke the Python method on \c n queries
+    void evaluate(size_t n, const Value *in, Value *out) const {
+        py::gil_scoped_acquire gil;
+        try {
+            py::function func = m_lookup();
+            if (!func)
+                Throw("BatchDispatcher: the batched method is not implemented!");
+
+            py::dict kwargs;
+            size_t offset = 0;
+            for (const Column &c : m_columns) {
+                std::vector<py::ssize_t> shape = { (py::ssize_t) n };
+                if (c.size > 1)
+                    shape.push_back((py::ssize_t) c.size);
+
+                py::array_t<Value> array(shape);
+                Value *ptr = array.mutable_data();
+                for (size_t i = 0; i < n; ++i)
+                    for (size_t j = 0; j < c.size; ++j)
+                        *ptr++ = in[i * m_in_size + offset + j];
+
+                kwargs[c.name] = array;
+                offset += c.size;
+            }
+
+            using Result = py::array_t<Value, py::array::c_style | py::array::forcecast>;
+            Result result = func(**kwargs).template cast<Result>();
+            if ((size_t) result.size() != n * m_out_size)
+                Throw("BatchDispatcher: expected %zu values from the batched "
+                      "method, got %zu!", n * m_out_size, (size_t) result.size());
+
+            std::copy(result.data(), result.data() + n * m_out_size, out);
+        } catch (py::error_already_set &e) {
+            // Convert while holding the GIL
+            Throw("%s", e.what());
+        }
+    }
+
+private:
+    std::function<py::function()> m_lookup;
+    std::vector<Column> m_columns;
+    size_t m_in_size = 0;
+    size_t m_out_size;
+    std::chrono::microseconds m_timeout { 100 };
+    std::mutex m_mutex;
+    std::shared_ptr<Batch> m_pending;
+    /// Number of batches currently being evaluated (guarded by \c m_mutex)
+    size_t m_evaluating = 0;
+    /// Number of threads that entered \ref submit() but haven't joined a batch
+    std::atomic<size_t> m_arriving { 0 };
+};
+
+/**
+ * \brief Optional batched method of a Python subclass
+ *
+ * Trampoline classes hold one instance per batched method. The first call to
+ * \ref get() checks whether the Python subclass implements the method and
+ * creates the associated \ref BatchDispatcher.
+ */
+template <typename Value> class BatchedMethod {
+public:
+    using Column = typename BatchDispatcher<Value>::Column;
+
+    BatchedMethod(const char *name, std::vector<Column> columns, size_t out_size)
+        : m_name(name), m_columns(std::move(columns)), m_out_size(out_size) { }
+
+    /// Return the dispatcher, or \c nullptr if the method is not implemented
+    template <typename Base> BatchDispatcher<Value> *get(const Base *self) const {
+        if (!m_checked.load(std::memory_order_acquire)) {
+            // Acquire the GIL before the lock to avoid lock order inversion
+            py::gil_scoped_acquire gil;
+            std::lock_guard<std::mutex> guard(m_mutex);
+            if (!m_checked.load(std::memory_order_relaxed)) {
+                if (py::get_override(self, m_name)) {
+                    const char *name = m_name;
+                    m_dispatcher = std::make_unique<BatchDispatcher<Value>>(
+                        [self, name] { return py::get_override(self, name); },
+                        m_columns, m_out_size);
+                }
+                m_checked.store(true, std::memory_order_release);
+            }
+        }
+        return m_dispatcher.get();
+    }
+
+private:
+    const char *m_name;
+    std::vector<Column> m_columns;
+    size_t m_out_size;
+    mutable std::atomic<bool> m_checked { false };
+    mutable std::mutex m_mutex;
+    mutable std::unique_ptr<BatchDispatcher<Value>> m_dispatcher;
+};
+
+/// Append the components of \c value to a query buffer
+template <typename Value, typename T> Value *batch_pack(Value *ptr, const T &value) {
+    if constexpr (dr::is_array_v<T>) {
+        for (size_t i = 0; i < dr::size_v<T>; ++i)
+            *ptr++ = (Value) value[i];
+    } else {
+        *ptr++ = (Value) value;
+    }
+    return ptr;
+}
+
+/// Convert the results of a query into an instance of \c T
+template <typename T, typename Value> T batch_unpack(const Value *ptr) {
+    T result;
+    if constexpr (dr::is_array_v<T>) {
+        for (size_t i = 0; i < dr::size_v<T>; ++i)
+            result[i] = ptr[i];
+    } else {
+        result = ptr[0];
+    }
+    return result;
+}
+
+NAMESPACE_END(mitsuba)
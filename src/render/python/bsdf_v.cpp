@@ -2,6 +2,7 @@
 #include <mitsuba/render/shape.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/python/python.h>
+#include "batch.h"
 
 MI_PY_EXPORT(BSDFSample) {
     MI_PY_IMPORT_TYPES()
@@ -30,6 +31,42 @@ public:
 
     PyBSDF(const Properties &props) : BSDF(props) { }
 
+    /* Scalar variants batch eval() and pdf() queries if the Python subclass
+       implements 'eval_batch' and 'pdf_batch'. Both receive the keyword
+       arguments 'wi', 'wo' (local frame), 'uv', 'p' and, in spectral
+       variants, 'wavelengths' as NumPy arrays with one row per query. */
+    static constexpr bool Batched = !dr::is_jit_v<Float> && !is_polarized_v<Spectrum>;
+    using BatchColumns = std::vector<typename BatchDispatcher<ScalarFloat>::Column>;
+
+    static BatchColumns batch_columns() {
+        BatchColumns columns = { { "wi", 3 }, { "wo", 3 }, { "uv", 2 }, { "p", 3 } };
+        if constexpr (is_spectral_v<Spectrum>)
+            columns.push_back({ "wavelengths", dr::size_v<Wavelength> });
+        return columns;
+    }
+
+    /// Can this query be handled by the batched methods?
+    static bool batchable(const BSDFContext &ctx) {
+        return ctx.mode == TransportMode::Radiance &&
+               ctx.type_mask == +BSDFFlags::All &&
+               ctx.component == (uint32_t) -1;
+    }
+
+    template <typename T>
+    T eval_batched(BatchDispatcher<ScalarFloat> *dispatcher,
+                   const SurfaceInteraction3f &si, const Vector3f &wo) const {
+        ScalarFloat in[16], out[dr::size_v<UnpolarizedSpectrum> + 1];
+        ScalarFloat *ptr = in;
+        ptr = batch_pack(ptr, si.wi);
+        ptr = batch_pack(ptr, wo);
+        ptr = batch_pack(ptr, si.uv);
+        ptr = batch_pack(ptr, si.p);
+        if constexpr (is_spectral_v<Spectrum>)
+            ptr = batch_pack(ptr, si.wavelengths);
+        dispatcher->submit(in, out);
+        return batch_unpack<T>(out);
+    }
+
     std::pair<BSDFSample3f, Spectrum>
     sample(const BSDFContext &ctx, const SurfaceInteraction3f &si,
            Float sample1, const Point2f &sample2,
@@ -42,6 +79,15 @@ public:
                   const SurfaceInteraction3f &si,
                   const Vector3f &wo,
                   Mask active) const override {
+        if constexpr (Batched) {
+            if (batchable(ctx)) {
+                if (auto *dispatcher = m_eval_batch.template get<BSDF>(this)) {
+                    if (!active)
+                        return 0.f;
+                    return eval_batched<UnpolarizedSpectrum>(dispatcher, si, wo);
+                }
+            }
+        }
         PYBIND11_OVERRIDE_PURE(Spectrum, BSDF, eval, ctx, si, wo, active);
     }
 
@@ -49,6 +95,15 @@ public:
               const SurfaceInteraction3f &si,
               const Vector3f &wo,
               Mask active) const override {
+        if constexpr (Batched) {
+            if (batchable(ctx)) {
+                if (auto *dispatcher = m_pdf_batch.template get<BSDF>(this)) {
+                    if (!active)
+                        return 0.f;
+                    return eval_batched<Float>(dispatcher, si, wo);
+                }
+            }
+        }
         PYBIND11_OVERRIDE_PURE(Float, BSDF, pdf, ctx, si, wo, active);
     }
 
@@ -100,6 +155,11 @@ public:
 
     using BSDF::m_flags;
     using BSDF::m_components;
+
+private:
+    BatchedMethod<ScalarFloat> m_eval_batch { "eval_batch", batch_columns(),
+                                              dr::size_v<UnpolarizedSpectrum> };
+    BatchedMethod<ScalarFloat> m_pdf_batch { "pdf_batch", batch_columns(), 1 };
 };
 
 template <typename Ptr, typename Cls> void bind_bsdf_generic(Cls &cls) {
@@ -183,6 +243,10 @@ MI_PY_EXPORT(BSDF) {
             "index"_a, "active"_a = true, D(BSDF, flags, 2))
         .def_method(BSDF, component_count, "active"_a = true)
         .def_method(BSDF, id)
+        .def_static("flatten", [](BSDF *bsdf) { return BSDF::flatten(bsdf); },
+            "bsdf"_a, D(BSDF, flatten))
+        .def_static("split_opacity", [](BSDF *bsdf) { return BSDF::split_opacity(bsdf); },
+            "bsdf"_a, D(BSDF, split_opacity))
         .def_property("m_flags",
             [](PyBSDF &bsdf){ return bsdf.m_flags; },
             [](PyBSDF &bsdf, uint32_t flags){
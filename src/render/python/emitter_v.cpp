@@ -1,6 +1,7 @@
 #include <mitsuba/render/emitter.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/python/python.h>
+#include "batch.h"
 
 /// Trampoline for derived types implemented in Python
 MI_VARIANT class PyEmitter : public Emitter<Float, Spectrum> {
@@ -9,6 +10,20 @@ public:
 
     PyEmitter(const Properties &props) : Emitter(props) { }
 
+    /* Scalar variants batch eval() queries if the Python subclass implements
+       'eval_batch'. It receives the keyword arguments 'wi', 'uv', 'p', 'n'
+       and, in spectral variants, 'wavelengths' as NumPy arrays with one row
+       per query. */
+    static constexpr bool Batched = !dr::is_jit_v<Float> && !is_polarized_v<Spectrum>;
+    using BatchColumns = std::vector<typename BatchDispatcher<ScalarFloat>::Column>;
+
+    static BatchColumns batch_columns() {
+        BatchColumns columns = { { "wi", 3 }, { "uv", 2 }, { "p", 3 }, { "n", 3 } };
+        if constexpr (is_spectral_v<Spectrum>)
+            columns.push_back({ "wavelengths", dr::size_v<Wavelength> });
+        return columns;
+    }
+
     std::pair<Ray3f, Spectrum>
     sample_ray(Float time, Float sample1, const Point2f &sample2,
            const Point2f &sample3, Mask active) const override {
@@ -50,6 +65,22 @@ public:
     }
 
     Spectrum eval(const SurfaceInteraction3f &si, Mask active) const override {
+        if constexpr (Batched) {
+            if (auto *dispatcher = m_eval_batch.template get<Emitter>(this)) {
+                if (!active)
+                    return 0.f;
+                ScalarFloat in[15], out[dr::size_v<Spectrum>];
+                ScalarFloat *ptr = in;
+                ptr = batch_pack(ptr, si.wi);
+                ptr = batch_pack(ptr, si.uv);
+                ptr = batch_pack(ptr, si.p);
+                ptr = batch_pack(ptr, si.n);
+                if constexpr (is_spectral_v<Spectrum>)
+                    ptr = batch_pack(ptr, si.wavelengths);
+                dispatcher->submit(in, out);
+                return batch_unpack<Spectrum>(out);
+            }
+        }
         PYBIND11_OVERRIDE_PURE(Spectrum, Emitter, eval, si, active);
     }
 
@@ -80,6 +111,10 @@ public:
     using Emitter::m_flags;
     using Emitter::m_needs_sample_2;
     using Emitter::m_needs_sample_3;
+
+private:
+    BatchedMethod<ScalarFloat> m_eval_batch { "eval_batch", batch_columns(),
+                                              dr::size_v<Spectrum> };
 };
 
 MI_PY_EXPORT(Emitter) {
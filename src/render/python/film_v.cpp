@@ -60,6 +60,14 @@ public:
         PYBIND11_OVERRIDE_PURE(ref<ImageBlock>, Film, create_block, size, normalize, border);
     }
 
+    void prepare_blocks(uint32_t block_size, uint32_t passes) override {
+        PYBIND11_OVERRIDE(void, Film, prepare_blocks, block_size, passes);
+    }
+
+    bool scanline_order() const override {
+        PYBIND11_OVERRIDE(bool, Film, scanline_order,);
+    }
+
     std::string to_string() const override {
         PYBIND11_OVERRIDE_PURE(std::string, Film, to_string,);
     }
@@ -116,6 +124,8 @@ MI_PY_EXPORT(Film) {
             D(Film, prepare_sample))
         .def_method(Film, create_block, "size"_a = ScalarVector2u(0, 0),
                     "normalize"_a = false, "borders"_a = false)
+        .def_method(Film, prepare_blocks, "block_size"_a, "passes"_a)
+        .def_method(Film, scanline_order)
         .def_method(Film, schedule_storage)
         .def_method(Film, sensor_response_function)
         .def_method(Film, flags);
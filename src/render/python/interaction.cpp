@@ -12,6 +12,11 @@ MI_PY_EXPORT(RayFlags) {
         .def_value(RayFlags, ShadingFrame)
         .def_value(RayFlags, FollowShape)
         .def_value(RayFlags, DetachShape)
+        .def_value(RayFlags, CameraRay)
+        .def_value(RayFlags, ShadowRay)
+        .def_value(RayFlags, DiffuseRay)
+        .def_value(RayFlags, SpecularRay)
+        .def_value(RayFlags, RayTypes)
         .def_value(RayFlags, All)
         .def_value(RayFlags, AllNonDifferentiable);
 
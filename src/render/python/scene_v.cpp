@@ -47,18 +47,27 @@ MI_PY_EXPORT(Scene) {
         .def("ray_intersect_preliminary",
              py::overload_cast<const Ray3f &, Mask, Mask>(&Scene::ray_intersect_preliminary, py::const_),
              "ray"_a, "coherent"_a = false, "active"_a = true, D(Scene, ray_intersect_preliminary))
+        .def("ray_intersect_preliminary",
+             py::overload_cast<const Ray3f &, uint32_t, Mask, Mask>(&Scene::ray_intersect_preliminary, py::const_),
+             "ray"_a, "ray_flags"_a, "coherent"_a, "active"_a = true, D(Scene, ray_intersect_preliminary, 2))
         .def("ray_intersect",
              py::overload_cast<const Ray3f &, Mask>(&Scene::ray_intersect, py::const_),
              "ray"_a, "active"_a = true, D(Scene, ray_intersect))
         .def("ray_intersect",
              py::overload_cast<const Ray3f &, uint32_t, Mask, Mask>(&Scene::ray_intersect, py::const_),
              "ray"_a, "ray_flags"_a, "coherent"_a, "active"_a = true, D(Scene, ray_intersect, 2))
+        .def("ray_intersect",
+             py::overload_cast<const Ray3f &, uint32_t, const UInt32 &, Mask, Mask>(&Scene::ray_intersect, py::const_),
+             "ray"_a, "ray_flags"_a, "ray_types"_a, "coherent"_a, "active"_a = true, D(Scene, ray_intersect, 3))
         .def("ray_test",
              py::overload_cast<const Ray3f &, Mask>(&Scene::ray_test, py::const_),
              "ray"_a, "active"_a = true, D(Scene, ray_test))
         .def("ray_test",
              py::overload_cast<const Ray3f &, Mask, Mask>(&Scene::ray_test, py::const_),
              "ray"_a, "coherent"_a, "active"_a = true, D(Scene, ray_test, 2))
+        .def("ray_test",
+             py::overload_cast<const Ray3f &, uint32_t, Mask, Mask>(&Scene::ray_test, py::const_),
+             "ray"_a, "ray_flags"_a, "coherent"_a, "active"_a = true, D(Scene, ray_test, 3))
 #if !defined(MI_ENABLE_EMBREE)
         .def("ray_intersect_naive",
             &Scene::ray_intersect_naive,
@@ -10,6 +10,43 @@
 #include <mitsuba/python/python.h>
 #include <pybind11/numpy.h>
 
+/**
+ * \brief Convert a Python object into a storage buffer of a mesh
+ *
+ * Dr.Jit arrays are passed through without copying. Host arrays (NumPy,
+ * PyTorch, ...) are loaded with a single copy while the GIL is released.
+ */
+template <typename Storage> Storage mesh_buffer_from_python(py::handle value) {
+    using Value = dr::scalar_t<Storage>;
+    using HostArray =
+        py::array_t<Value, py::array::c_style | py::array::forcecast>;
+
+    if (value.is_none())
+        return Storage();
+
+    py::object view = host_array_view(value);
+    if (view.is_none())
+        return value.cast<Storage>();
+
+    // Don't let the conversion below silently truncate e.g. float indices
+    if constexpr (std::is_integral_v<Value>) {
+        char kind = py::array(view).dtype().kind();
+        if (kind != 'i' && kind != 'u')
+            throw py::type_error("Mesh.set_buffers(): expected an array of "
+                                 "integers for the face indices!");
+    }
+
+    HostArray host = HostArray::ensure(view);
+    if (!host)
+        throw py::type_error("Mesh.set_buffers(): unsupported array type!");
+
+    const Value *data = host.data();
+    size_t size = (size_t) host.size();
+
+    py::gil_scoped_release release;
+    return dr::load<Storage>(data, size);
+}
+
 MI_PY_EXPORT(SilhouetteSample) {
     MI_PY_IMPORT_TYPES()
 
@@ -224,7 +261,11 @@ MI_PY_EXPORT(Shape) {
         .def_method(Shape, parameters_grad_enabled)
         .def_method(Shape, primitive_count)
         .def_method(Shape, effective_primitive_count)
-        .def_method(Shape, precompute_silhouette, "viewpoint"_a);
+        .def_method(Shape, precompute_silhouette, "viewpoint"_a)
+        .def("alpha_texture", &Shape::alpha_texture, D(Shape, alpha_texture))
+        .def_method(Shape, set_alpha_texture, "texture"_a)
+        .def_method(Shape, ray_visibility)
+        .def_method(Shape, is_visible, "ray_flags"_a);
 
     bind_shape_generic<Shape *>(shape);
 
@@ -257,6 +298,19 @@ MI_PY_EXPORT(Shape) {
         .def("write_ply",
              py::overload_cast<Stream *>(&Mesh::write_ply, py::const_),
              "stream"_a, D(Mesh, write_ply, 2))
+        .def("set_buffers",
+             [](Mesh &mesh, py::handle vertex_positions, py::handle faces,
+                py::handle vertex_texcoords) {
+                using FloatStorage = typename Mesh::FloatStorage;
+                auto positions = mesh_buffer_from_python<FloatStorage>(vertex_positions);
+                auto indices   = mesh_buffer_from_python<DynamicBuffer<UInt32>>(faces);
+                auto texcoords = mesh_buffer_from_python<FloatStorage>(vertex_texcoords);
+
+                py::gil_scoped_release release;
+                mesh.set_buffers(std::move(positions), std::move(indices),
+                                 std::move(texcoords));
+             }, "vertex_positions"_a, "faces"_a, "vertex_texcoords"_a = py::none(),
+             D(Mesh, set_buffers))
         .def("add_attribute", &Mesh::add_attribute, "name"_a, "size"_a, "buffer"_a,
              D(Mesh, add_attribute), py::return_value_policy::reference_internal)
         .def("vertex_position", [](const Mesh &m, UInt32 index, Mask active) {
@@ -271,6 +325,7 @@ MI_PY_EXPORT(Shape) {
         .def("face_indices", [](const Mesh &m, UInt32 index, Mask active) {
                 return m.face_indices(index, active);
              }, D(Mesh, face_indices), "index"_a, "active"_a = true)
+        .def_method(Mesh, silhouette_edges, "viewpoint"_a)
         .def("ray_intersect_triangle", &Mesh::ray_intersect_triangle,
              "index"_a, "ray"_a, "active"_a = true,
              D(Mesh, ray_intersect_triangle));
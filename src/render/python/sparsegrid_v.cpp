@@ -0,0 +1,121 @@
+#include <mitsuba/render/sparsegrid.h>
+#include <mitsuba/core/filesystem.h>
+#include <mitsuba/core/stream.h>
+#include <pybind11/numpy.h>
+#include <mitsuba/python/python.h>
+
+MI_PY_EXPORT(SparseVolumeGrid) {
+    MI_PY_IMPORT_TYPES(SparseVolumeGrid)
+
+    using FloatArray = py::array_t<ScalarFloat, py::array::c_style | py::array::forcecast>;
+    using IndexArray = py::array_t<uint32_t, py::array::c_style | py::array::forcecast>;
+
+    // Return the background value per channel (or nullptr for zero)
+    auto background_ptr = [](const std::vector<ScalarFloat> &background,
+                             size_t channel_count) -> const ScalarFloat * {
+        if (background.empty())
+            return nullptr;
+        if (background.size() != channel_count)
+            throw py::value_error("The background must have one value per channel");
+        return background.data();
+    };
+
+    auto node_stats = [](const SparseVolumeGrid *grid, uint32_t level, bool max) {
+        if (level > 2)
+            throw py::value_error("The level must be 0 (leaf), 1 (lower) or 2 (upper)");
+        size_t count = level == 0 ? grid->leaf_count()
+                     : level == 1 ? grid->lower_count() : grid->upper_count();
+        const ScalarFloat *ptr = max ? grid->node_max(level) : grid->node_min(level);
+        FloatArray result({ (py::ssize_t) count, (py::ssize_t) grid->channel_count() });
+        std::copy(ptr, ptr + count * grid->channel_count(), result.mutable_data());
+        return result;
+    };
+
+    MI_PY_CLASS(SparseVolumeGrid, Object)
+        .def(py::init<const fs::path &>(), "path"_a,
+            py::call_guard<py::gil_scoped_release>())
+        .def(py::init<Stream *>(), "stream"_a,
+            py::call_guard<py::gil_scoped_release>())
+        .def(py::init([background_ptr](FloatArray obj,
+                                       std::vector<ScalarFloat> background) {
+            if (obj.ndim() != 3 && obj.ndim() != 4)
+                throw py::type_error("Expected an array of size 3 or 4");
+
+            size_t channel_count = obj.ndim() == 4 ? obj.shape()[3] : 1;
+            ScalarVector3u size((uint32_t) obj.shape()[2],
+                                (uint32_t) obj.shape()[1],
+                                (uint32_t) obj.shape()[0]);
+
+            return new SparseVolumeGrid(size, (uint32_t) channel_count, obj.data(),
+                                        background_ptr(background, channel_count));
+        }), "array"_a, "background"_a = std::vector<ScalarFloat>(),
+            "Initialize a SparseVolumeGrid from a dense NumPy array")
+        .def(py::init([background_ptr](const ScalarVector3u &size, IndexArray coords,
+                                       FloatArray values,
+                                       std::vector<ScalarFloat> background) {
+            if (coords.ndim() != 2 || coords.shape()[1] != 3)
+                throw py::type_error("Expected an array of voxel coordinates of shape (N, 3)");
+            if ((values.ndim() != 1 && values.ndim() != 2) ||
+                values.shape()[0] != coords.shape()[0])
+                throw py::type_error("Expected an array of voxel values of shape (N) or (N, C)");
+
+            size_t channel_count = values.ndim() == 2 ? values.shape()[1] : 1;
+            return new SparseVolumeGrid(size, (uint32_t) channel_count,
+                                        coords.data(), values.data(),
+                                        (size_t) coords.shape()[0],
+                                        background_ptr(background, channel_count));
+        }), "size"_a, "coords"_a, "values"_a,
+            "background"_a = std::vector<ScalarFloat>(),
+            "Initialize a SparseVolumeGrid from a list of active voxels")
+
+        .def_method(SparseVolumeGrid, size)
+        .def_method(SparseVolumeGrid, channel_count)
+        .def_method(SparseVolumeGrid, root_size)
+        .def_method(SparseVolumeGrid, upper_count)
+        .def_method(SparseVolumeGrid, lower_count)
+        .def_method(SparseVolumeGrid, leaf_count)
+        .def_method(SparseVolumeGrid, max)
+        .def_method(SparseVolumeGrid, buffer_size)
+        .def("background",
+            [](const SparseVolumeGrid *grid) {
+                return std::vector<ScalarFloat>(
+                    grid->background(), grid->background() + grid->channel_count());
+            },
+            D(SparseVolumeGrid, background))
+        .def("max_per_channel",
+            [](const SparseVolumeGrid *grid) {
+                std::vector<ScalarFloat> max_values(grid->channel_count());
+                grid->max_per_channel(max_values.data());
+                return max_values;
+            },
+            D(SparseVolumeGrid, max_per_channel))
+        .def("max_per_channel",
+            [](const SparseVolumeGrid *grid, const ScalarPoint3u &min,
+               const ScalarPoint3u &max) {
+                std::vector<ScalarFloat> max_values(grid->channel_count());
+                grid->max_per_channel(min, max, max_values.data());
+                return max_values;
+            },
+            "min"_a, "max"_a, D(SparseVolumeGrid, max_per_channel, 2))
+        .def("node_min",
+            [node_stats](const SparseVolumeGrid *grid, uint32_t level) {
+                return node_stats(grid, level, false);
+            },
+            "level"_a, D(SparseVolumeGrid, node_min))
+        .def("node_max",
+            [node_stats](const SparseVolumeGrid *grid, uint32_t level) {
+                return node_stats(grid, level, true);
+            },
+            "level"_a, D(SparseVolumeGrid, node_max))
+        .def("voxel",
+            [](const SparseVolumeGrid *grid, const ScalarPoint3u &p) {
+                const ScalarFloat *ptr = grid->voxel(p);
+                return std::vector<ScalarFloat>(ptr, ptr + grid->channel_count());
+            },
+            "p"_a, D(SparseVolumeGrid, voxel))
+        .def("write", py::overload_cast<Stream *>(&SparseVolumeGrid::write, py::const_),
+            "stream"_a, D(SparseVolumeGrid, write, 2), py::call_guard<py::gil_scoped_release>())
+        .def("write", py::overload_cast<const fs::path &>(
+                &SparseVolumeGrid::write, py::const_), "path"_a, D(SparseVolumeGrid, write),
+                py::call_guard<py::gil_scoped_release>());
+}
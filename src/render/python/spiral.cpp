@@ -10,5 +10,6 @@ MI_PY_EXPORT(Spiral) {
         .def_method(Spiral, max_block_size)
         .def_method(Spiral, block_count)
         .def_method(Spiral, reset)
+        .def_method(Spiral, set_scanline_order, "value"_a)
         .def_method(Spiral, next_block);
 }
@@ -2,6 +2,7 @@
 #include <mitsuba/render/interaction.h>
 #include <mitsuba/python/python.h>
 #include <mitsuba/core/properties.h>
+#include "batch.h"
 
 /// Trampoline for derived types implemented in Python
 MI_VARIANT class PyTexture : public Texture<Float, Spectrum> {
@@ -10,8 +11,41 @@ public:
 
     PyTexture(const Properties &props) : Texture(props) {}
 
+    /* Scalar variants batch eval(), eval_1() and eval_3() queries if the
+       Python subclass implements 'eval_batch', 'eval_1_batch' and
+       'eval_3_batch'. They receive the keyword arguments 'uv', 'p' and, in
+       spectral variants, 'wavelengths' as NumPy arrays with one row per
+       query. */
+    static constexpr bool Batched = !dr::is_jit_v<Float>;
+    using BatchColumns = std::vector<typename BatchDispatcher<ScalarFloat>::Column>;
+
+    static BatchColumns batch_columns() {
+        BatchColumns columns = { { "uv", 2 }, { "p", 3 } };
+        if constexpr (is_spectral_v<Spectrum>)
+            columns.push_back({ "wavelengths", dr::size_v<Wavelength> });
+        return columns;
+    }
+
+    template <typename T>
+    T eval_batched(BatchDispatcher<ScalarFloat> *dispatcher,
+                   const SurfaceInteraction3f &si) const {
+        ScalarFloat in[9], out[dr::size_v<UnpolarizedSpectrum> + 3];
+        ScalarFloat *ptr = in;
+        ptr = batch_pack(ptr, si.uv);
+        ptr = batch_pack(ptr, si.p);
+        if constexpr (is_spectral_v<Spectrum>)
+            ptr = batch_pack(ptr, si.wavelengths);
+        dispatcher->submit(in, out);
+        return batch_unpack<T>(out);
+    }
+
     UnpolarizedSpectrum eval(const SurfaceInteraction3f &si,
                              Mask active = true) const override {
+        if constexpr (Batched) {
+            if (auto *dispatcher = m_eval_batch.template get<Texture>(this))
+                return active ? eval_batched<UnpolarizedSpectrum>(dispatcher, si)
+                              : UnpolarizedSpectrum(0.f);
+        }
         PYBIND11_OVERRIDE_PURE(UnpolarizedSpectrum, Texture, eval, si, active);
     }
 
@@ -40,6 +74,10 @@ public:
 
     Float eval_1(const SurfaceInteraction3f &si,
                  Mask active = true) const override {
+        if constexpr (Batched) {
+            if (auto *dispatcher = m_eval_1_batch.template get<Texture>(this))
+                return active ? eval_batched<Float>(dispatcher, si) : Float(0.f);
+        }
         PYBIND11_OVERRIDE_PURE(Float, Texture, eval_1, si, active);
     }
 
@@ -50,6 +88,10 @@ public:
 
     Color3f eval_3(const SurfaceInteraction3f &si,
                    Mask active = true) const override {
+        if constexpr (Batched) {
+            if (auto *dispatcher = m_eval_3_batch.template get<Texture>(this))
+                return active ? eval_batched<Color3f>(dispatcher, si) : Color3f(0.f);
+        }
         PYBIND11_OVERRIDE_PURE(Color3f, Texture, eval_3, si, active);
     }
 
@@ -76,6 +118,12 @@ public:
     std::string to_string() const override {
         PYBIND11_OVERRIDE(std::string, Texture, to_string);
     }
+
+private:
+    BatchedMethod<ScalarFloat> m_eval_batch { "eval_batch", batch_columns(),
+                                              dr::size_v<UnpolarizedSpectrum> };
+    BatchedMethod<ScalarFloat> m_eval_1_batch { "eval_1_batch", batch_columns(), 1 };
+    BatchedMethod<ScalarFloat> m_eval_3_batch { "eval_3_batch", batch_columns(), 3 };
 };
 
 MI_PY_EXPORT(Texture) {
@@ -1,3 +1,5 @@
+#include <unordered_map>
+
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/plugin.h>
 #include <mitsuba/render/bsdf.h>
@@ -63,6 +65,40 @@ MI_VARIANT Scene<Float, Spectrum>::Scene(const Properties &props) {
         }
     }
 
+    /* Alpha-test the opacity of 'mask' BSDFs during ray traversal instead of
+       returning null interactions to the integrator (scalar variants only) */
+    if (props.get<bool>("alpha_test", false)) {
+        if constexpr (!dr::is_jit_v<Float>) {
+            for (Shape *shape : m_shapes) {
+                auto [nested, opacity] = BSDF::split_opacity(shape->bsdf());
+                if (!opacity)
+                    continue;
+                shape->set_alpha_texture(opacity.get());
+                shape->set_bsdf(nested.get());
+            }
+        } else {
+            Log(Warn, "Scene: alpha testing during ray traversal is only "
+                      "supported by the scalar variants, ignoring the "
+                      "\"alpha_test\" parameter.");
+        }
+    }
+
+    /* Fuse chains of adapter BSDFs (e.g. twosided/normalmap/bumpmap/mask)
+       into single objects. Shapes sharing a material keep sharing it. This
+       only saves virtual calls in the scalar variants: JIT variants already
+       inline the nested calls while tracing, hence it is opt-in there. */
+    if (props.get<bool>("flatten_bsdfs", !dr::is_jit_v<Float>)) {
+        std::unordered_map<BSDF *, ref<BSDF>> flattened;
+        for (Shape *shape : m_shapes) {
+            BSDF *bsdf = shape->bsdf();
+            auto it = flattened.find(bsdf);
+            if (it == flattened.end())
+                it = flattened.emplace(bsdf, BSDF::flatten(bsdf)).first;
+            if (it->second.get() != bsdf)
+                shape->set_bsdf(it->second.get());
+        }
+    }
+
     // Create sensors' shapes (environment sensors)
     for (Sensor *sensor: m_sensors)
         sensor->set_scene(this);
@@ -182,31 +218,57 @@ MI_VARIANT typename Scene<Float, Spectrum>::SurfaceInteraction3f
 Scene<Float, Spectrum>::ray_intersect(const Ray3f &ray, uint32_t ray_flags, Mask coherent, Mask active) const {
     MI_MASKED_FUNCTION(ProfilerPhase::RayIntersect, active);
     DRJIT_MARK_USED(coherent);
+    count_ray_query();
+
+    UInt32 ray_types(ray_flags & +RayFlags::RayTypes);
+    if constexpr (dr::is_cuda_v<Float>)
+        return ray_intersect_gpu(ray, ray_flags, ray_types, active);
+    else
+        return ray_intersect_cpu(ray, ray_flags, ray_types, coherent, active);
+}
+
+MI_VARIANT typename Scene<Float, Spectrum>::SurfaceInteraction3f
+Scene<Float, Spectrum>::ray_intersect(const Ray3f &ray, uint32_t ray_flags,
+                                      const UInt32 &ray_types, Mask coherent,
+                                      Mask active) const {
+    MI_MASKED_FUNCTION(ProfilerPhase::RayIntersect, active);
+    DRJIT_MARK_USED(coherent);
+    count_ray_query();
 
+    ray_flags &= ~(uint32_t) RayFlags::RayTypes;
     if constexpr (dr::is_cuda_v<Float>)
-        return ray_intersect_gpu(ray, ray_flags, active);
+        return ray_intersect_gpu(ray, ray_flags,
+                                 ray_types & +RayFlags::RayTypes, active);
     else
-        return ray_intersect_cpu(ray, ray_flags, coherent, active);
+        return ray_intersect_cpu(ray, ray_flags,
+                                 ray_types & +RayFlags::RayTypes, coherent,
+                                 active);
 }
 
 MI_VARIANT typename Scene<Float, Spectrum>::PreliminaryIntersection3f
-Scene<Float, Spectrum>::ray_intersect_preliminary(const Ray3f &ray, Mask coherent, Mask active) const {
+Scene<Float, Spectrum>::ray_intersect_preliminary(const Ray3f &ray, uint32_t ray_flags,
+                                                  Mask coherent, Mask active) const {
     DRJIT_MARK_USED(coherent);
+    count_ray_query();
+    UInt32 ray_types(ray_flags & +RayFlags::RayTypes);
     if constexpr (dr::is_cuda_v<Float>)
-        return ray_intersect_preliminary_gpu(ray, active);
+        return ray_intersect_preliminary_gpu(ray, ray_types, active);
     else
-        return ray_intersect_preliminary_cpu(ray, coherent, active);
+        return ray_intersect_preliminary_cpu(ray, ray_types, coherent, active);
 }
 
 MI_VARIANT typename Scene<Float, Spectrum>::Mask
-Scene<Float, Spectrum>::ray_test(const Ray3f &ray, Mask coherent, Mask active) const {
+Scene<Float, Spectrum>::ray_test(const Ray3f &ray, uint32_t ray_flags, Mask coherent,
+                                 Mask active) const {
     MI_MASKED_FUNCTION(ProfilerPhase::RayTest, active);
     DRJIT_MARK_USED(coherent);
+    count_ray_query();
 
+    UInt32 ray_types(ray_flags & +RayFlags::RayTypes);
     if constexpr (dr::is_cuda_v<Float>)
-        return ray_test_gpu(ray, active);
+        return ray_test_gpu(ray, ray_types, active);
     else
-        return ray_test_cpu(ray, coherent, active);
+        return ray_test_cpu(ray, ray_types, coherent, active);
 }
 
 MI_VARIANT typename Scene<Float, Spectrum>::SurfaceInteraction3f
@@ -328,7 +390,7 @@ Scene<Float, Spectrum>::sample_emitter_direction(const Interaction3f &ref, const
 
         // Mark occluded samples as invalid if requested by the user
         if (test_visibility && dr::any_or<true>(active)) {
-            Mask occluded = ray_test(ref.spawn_ray_to(ds.p), active);
+            Mask occluded = ray_test(ref.spawn_ray_to(ds.p), +RayFlags::ShadowRay, false, active);
             dr::masked(spec, occluded) = 0.f;
             dr::masked(ds.pdf, occluded) = 0.f;
         }
@@ -340,7 +402,7 @@ Scene<Float, Spectrum>::sample_emitter_direction(const Interaction3f &ref, const
 
         // Mark occluded samples as invalid if requested by the user
         if (test_visibility && dr::any_or<true>(active)) {
-            Mask occluded = ray_test(ref.spawn_ray_to(ds.p), active);
+            Mask occluded = ray_test(ref.spawn_ray_to(ds.p), +RayFlags::ShadowRay, false, active);
             dr::masked(spec, occluded) = 0.f;
             dr::masked(ds.pdf, occluded) = 0.f;
         }
@@ -580,15 +642,15 @@ MI_VARIANT void Scene<Float, Spectrum>::accel_release_gpu() {
     NotImplementedError("accel_release_gpu");
 }
 MI_VARIANT typename Scene<Float, Spectrum>::PreliminaryIntersection3f
-Scene<Float, Spectrum>::ray_intersect_preliminary_gpu(const Ray3f &, Mask) const {
+Scene<Float, Spectrum>::ray_intersect_preliminary_gpu(const Ray3f &, const UInt32 &, Mask) const {
     NotImplementedError("ray_intersect_preliminary_gpu");
 }
 MI_VARIANT typename Scene<Float, Spectrum>::SurfaceInteraction3f
-Scene<Float, Spectrum>::ray_intersect_gpu(const Ray3f &, uint32_t, Mask) const {
+Scene<Float, Spectrum>::ray_intersect_gpu(const Ray3f &, uint32_t, const UInt32 &, Mask) const {
     NotImplementedError("ray_intersect_naive_gpu");
 }
 MI_VARIANT typename Scene<Float, Spectrum>::Mask
-Scene<Float, Spectrum>::ray_test_gpu(const Ray3f &, Mask) const {
+Scene<Float, Spectrum>::ray_test_gpu(const Ray3f &, const UInt32 &, Mask) const {
     NotImplementedError("ray_test_gpu");
 }
 MI_VARIANT void Scene<Float, Spectrum>::static_accel_initialization_gpu() { }
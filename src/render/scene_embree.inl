@@ -81,6 +81,42 @@ void rtcIntersect32(const int *valid, RTCScene scene,
     }
 }
 
+/// Convert (per-lane) ray visibility flags of \ref RayFlags into an Embree ray mask
+template <typename UInt32> UInt32 embree_ray_mask(const UInt32 &ray_types) {
+    return dr::select(dr::eq(ray_types, 0u), UInt32((uint32_t) -1), ray_types);
+}
+
+/// Embree filter that alpha-tests candidate intersections with a shape
+template <typename Float, typename Spectrum>
+void embree_alpha_filter(const RTCFilterFunctionNArguments *args) {
+    MI_IMPORT_TYPES(Shape)
+    using ScalarRay3f = Ray<ScalarPoint3f, Spectrum>;
+
+    const Shape *shape = (const Shape *) args->geometryUserPtr;
+    RTCRayN *ray = args->ray;
+    RTCHitN *hit = args->hit;
+    uint32_t N   = args->N;
+
+    for (uint32_t i = 0; i < N; ++i) {
+        if (args->valid[i] == 0)
+            continue;
+
+        // Embree stores the distance of the candidate hit in 'tfar'
+        ScalarRay3f r(
+            ScalarPoint3f(RTCRayN_org_x(ray, N, i), RTCRayN_org_y(ray, N, i),
+                          RTCRayN_org_z(ray, N, i)),
+            ScalarVector3f(RTCRayN_dir_x(ray, N, i), RTCRayN_dir_y(ray, N, i),
+                           RTCRayN_dir_z(ray, N, i)),
+            RTCRayN_time(ray, N, i));
+
+        ScalarPoint2f prim_uv(RTCHitN_u(hit, N, i), RTCHitN_v(hit, N, i));
+
+        if (!shape->alpha_test_scalar(r, RTCRayN_tfar(ray, N, i), prim_uv,
+                                      RTCHitN_primID(hit, N, i)))
+            args->valid[i] = 0;
+    }
+}
+
 MI_VARIANT void
 Scene<Float, Spectrum>::accel_init_cpu(const Properties &props) {
     if (!embree_device) {
@@ -146,6 +182,16 @@ MI_VARIANT void Scene<Float, Spectrum>::accel_parameters_changed_cpu() {
 
     for (Shape *shape : m_shapes) {
         RTCGeometry geom = shape->embree_geometry(embree_device);
+        // Rays without visibility flags (mask 0xFFFFFFFF) intersect all shapes
+        rtcSetGeometryMask(geom, shape->ray_visibility() | ~(uint32_t) RayFlags::RayTypes);
+        if constexpr (!dr::is_jit_v<Float>) {
+            if (shape->alpha_texture()) {
+                rtcSetGeometryUserData(geom, (void *) shape);
+                rtcSetGeometryIntersectFilterFunction(geom, embree_alpha_filter<Float, Spectrum>);
+                rtcSetGeometryOccludedFilterFunction(geom, embree_alpha_filter<Float, Spectrum>);
+            }
+        }
+        rtcCommitGeometry(geom);
         s.geometries.push_back(rtcAttachGeometry(s.accel, geom));
         rtcReleaseGeometry(geom);
     }
@@ -216,6 +262,7 @@ MI_VARIANT void Scene<Float, Spectrum>::accel_release_cpu() {
 
 MI_VARIANT typename Scene<Float, Spectrum>::PreliminaryIntersection3f
 Scene<Float, Spectrum>::ray_intersect_preliminary_cpu(const Ray3f &ray,
+                                                      const UInt32 &ray_types,
                                                       Mask coherent,
                                                       Mask active) const {
     using Single = dr::float32_array_t<Float>;
@@ -241,7 +288,7 @@ Scene<Float, Spectrum>::ray_intersect_preliminary_cpu(const Ray3f &ray,
         dr::store(&rh.ray.org_x, dr::concat(Vector3s(ray.o), float(0.f)));
         dr::store(&rh.ray.dir_x, dr::concat(Vector3s(ray.d), float(ray.time)));
         rh.ray.tfar = ray_maxt;
-        rh.ray.mask = 0;
+        rh.ray.mask = embree_ray_mask(ray_types);
         rh.ray.id = 0;
         rh.ray.flags = 0;
         rh.hit.geomID = (uint32_t) -1;
@@ -296,7 +343,8 @@ Scene<Float, Spectrum>::ray_intersect_preliminary_cpu(const Ray3f &ray,
                scene_v = UInt64::steal(
                    jit_var_pointer(JitBackend::LLVM, scene_ptr, 0, 0));
 
-        UInt32 zero = dr::zeros<UInt32>();
+        UInt32 zero = dr::zeros<UInt32>(),
+               ray_mask(embree_ray_mask(ray_types));
 
         dr::Array<Single, 3> ray_o(ray.o), ray_d(ray.d);
         Single ray_mint(0.f), ray_time(ray.time);
@@ -306,7 +354,7 @@ Scene<Float, Spectrum>::ray_intersect_preliminary_cpu(const Ray3f &ray,
                             ray_o.z().index(), ray_mint.index(),
                             ray_d.x().index(), ray_d.y().index(),
                             ray_d.z().index(), ray_time.index(),
-                            ray_maxt.index(),  zero.index(),
+                            ray_maxt.index(),  ray_mask.index(),
                             zero.index(),      zero.index() };
 
         uint32_t out[6] { };
@@ -341,6 +389,7 @@ Scene<Float, Spectrum>::ray_intersect_preliminary_cpu(const Ray3f &ray,
         return pi;
     } else {
         DRJIT_MARK_USED(ray);
+        DRJIT_MARK_USED(ray_types);
         DRJIT_MARK_USED(coherent);
         DRJIT_MARK_USED(active);
         Throw("ray_intersect_preliminary_cpu() should only be called in CPU mode.");
@@ -348,13 +397,14 @@ Scene<Float, Spectrum>::ray_intersect_preliminary_cpu(const Ray3f &ray,
 }
 
 MI_VARIANT typename Scene<Float, Spectrum>::SurfaceInteraction3f
-Scene<Float, Spectrum>::ray_intersect_cpu(const Ray3f &ray, uint32_t ray_flags, Mask coherent, Mask active) const {
+Scene<Float, Spectrum>::ray_intersect_cpu(const Ray3f &ray, uint32_t ray_flags, const UInt32 &ray_types, Mask coherent, Mask active) const {
     if constexpr (!dr::is_cuda_v<Float>) {
-        PreliminaryIntersection3f pi = ray_intersect_preliminary_cpu(ray, coherent, active);
+        PreliminaryIntersection3f pi = ray_intersect_preliminary_cpu(ray, ray_types, coherent, active);
         return pi.compute_surface_interaction(ray, ray_flags, active);
     } else {
         DRJIT_MARK_USED(ray);
         DRJIT_MARK_USED(ray_flags);
+        DRJIT_MARK_USED(ray_types);
         DRJIT_MARK_USED(coherent);
         DRJIT_MARK_USED(active);
         Throw("ray_intersect_cpu() should only be called in CPU mode.");
@@ -362,7 +412,7 @@ Scene<Float, Spectrum>::ray_intersect_cpu(const Ray3f &ray, uint32_t ray_flags,
 }
 
 MI_VARIANT typename Scene<Float, Spectrum>::Mask
-Scene<Float, Spectrum>::ray_test_cpu(const Ray3f &ray, Mask coherent, Mask active) const {
+Scene<Float, Spectrum>::ray_test_cpu(const Ray3f &ray, const UInt32 &ray_types, Mask coherent, Mask active) const {
     using Single = dr::float32_array_t<Float>;
     EmbreeState<Float> &s = *(EmbreeState<Float> *) m_accel;
 
@@ -384,7 +434,7 @@ Scene<Float, Spectrum>::ray_test_cpu(const Ray3f &ray, Mask coherent, Mask activ
         dr::store(&ray2.org_x, dr::concat(Vector3s(ray.o), float(0.f)));
         dr::store(&ray2.dir_x, dr::concat(Vector3s(ray.d), float(ray.time)));
         ray2.tfar = (float) ray_maxt;
-        ray2.mask = 0;
+        ray2.mask = embree_ray_mask(ray_types);
         ray2.id = 0;
         ray2.flags = 0;
 
@@ -413,7 +463,8 @@ Scene<Float, Spectrum>::ray_test_cpu(const Ray3f &ray, Mask coherent, Mask activ
                scene_v = UInt64::steal(
                    jit_var_pointer(JitBackend::LLVM, scene_ptr, 0, 0));
 
-        UInt32 zero = dr::zeros<UInt32>();
+        UInt32 zero = dr::zeros<UInt32>(),
+               ray_mask(embree_ray_mask(ray_types));
 
         // Conversion, in case this is a double precision build
         dr::Array<Single, 3> ray_o(ray.o), ray_d(ray.d);
@@ -424,7 +475,7 @@ Scene<Float, Spectrum>::ray_test_cpu(const Ray3f &ray, Mask coherent, Mask activ
                             ray_o.z().index(), ray_mint.index(),
                             ray_d.x().index(), ray_d.y().index(),
                             ray_d.z().index(), ray_time.index(),
-                            ray_maxt.index(),  zero.index(),
+                            ray_maxt.index(),  ray_mask.index(),
                             zero.index(),      zero.index() };
 
         uint32_t out[1] { };
@@ -434,6 +485,7 @@ Scene<Float, Spectrum>::ray_test_cpu(const Ray3f &ray, Mask coherent, Mask activ
         return active && dr::neq(Single::steal(out[0]), ray_maxt);
     } else {
         DRJIT_MARK_USED(ray);
+        DRJIT_MARK_USED(ray_types);
         DRJIT_MARK_USED(coherent);
         DRJIT_MARK_USED(active);
         Throw("ray_test_cpu() should only be called in CPU mode.");
@@ -443,7 +495,7 @@ Scene<Float, Spectrum>::ray_test_cpu(const Ray3f &ray, Mask coherent, Mask activ
 MI_VARIANT typename Scene<Float, Spectrum>::SurfaceInteraction3f
 Scene<Float, Spectrum>::ray_intersect_naive_cpu(const Ray3f &ray,
                                                 Mask active) const {
-    return ray_intersect_cpu(ray, +RayFlags::All, false, active);
+    return ray_intersect_cpu(ray, +RayFlags::All, 0u, false, active);
 }
 
 NAMESPACE_END(mitsuba)
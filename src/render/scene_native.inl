@@ -146,12 +146,15 @@ void kdtree_trace_func_wrapper(const int *valid, void *ptr,
 
         ScalarRay3f ray = ScalarRay3f(ray_o, ray_d, ray_maxt, ray_time, wavelength_t<Spectrum>());
 
+        // The 'mask' field carries the ray visibility flags
+        uint32_t ray_flags = ((uint32_t*) &args[offsetof(RayHit, mask) * Width])[i];
+
         if constexpr (ShadowRay) {
-            bool hit = kdtree->template ray_intersect_scalar<true>(ray).is_valid();
+            bool hit = kdtree->template ray_intersect_scalar<true>(ray, ray_flags).is_valid();
             if (hit)
                 ray_maxt = 0.f;
         } else {
-            auto pi = kdtree->template ray_intersect_scalar<false>(ray);
+            auto pi = kdtree->template ray_intersect_scalar<false>(ray, ray_flags);
             if (pi.is_valid()) {
                 ScalarFloat& prim_u = ((ScalarFloat*) &args[offsetof(RayHit, u) * Width])[i];
                 ScalarFloat& prim_v = ((ScalarFloat*) &args[offsetof(RayHit, v) * Width])[i];
@@ -174,12 +177,13 @@ void kdtree_trace_func_wrapper(const int *valid, void *ptr,
 
 MI_VARIANT typename Scene<Float, Spectrum>::PreliminaryIntersection3f
 Scene<Float, Spectrum>::ray_intersect_preliminary_cpu(const Ray3f &ray,
+                                                      const UInt32 &ray_types,
                                                       Mask coherent,
                                                       Mask active) const {
     if constexpr (!dr::is_array_v<Float>) {
         DRJIT_MARK_USED(coherent);
         const ShapeKDTree *kdtree = (const ShapeKDTree *) m_accel;
-        return kdtree->template ray_intersect_preliminary<false>(ray, active);
+        return kdtree->template ray_intersect_preliminary<false>(ray, active, ray_types);
     } else {
         NativeState<Float, Spectrum> *s = (NativeState<Float, Spectrum> *) m_accel;
         void *func_ptr = nullptr,
@@ -210,7 +214,7 @@ Scene<Float, Spectrum>::ray_intersect_preliminary_cpu(const Ray3f &ray,
                             ray.o.z().index(), ray_mint.index(),
                             ray.d.x().index(), ray.d.y().index(),
                             ray.d.z().index(), ray.time.index(),
-                            ray.maxt.index(),  zero.index(),
+                            ray.maxt.index(),  ray_types.index(),
                             zero.index(),      zero.index() };
         uint32_t out[6] { };
 
@@ -247,14 +251,16 @@ Scene<Float, Spectrum>::ray_intersect_preliminary_cpu(const Ray3f &ray,
 
 MI_VARIANT typename Scene<Float, Spectrum>::SurfaceInteraction3f
 Scene<Float, Spectrum>::ray_intersect_cpu(const Ray3f &ray, uint32_t ray_flags,
+                                          const UInt32 &ray_types,
                                           Mask coherent, Mask active) const {
     if constexpr (!dr::is_cuda_v<Float>) {
         PreliminaryIntersection3f pi =
-            ray_intersect_preliminary_cpu(ray, coherent, active);
+            ray_intersect_preliminary_cpu(ray, ray_types, coherent, active);
         return pi.compute_surface_interaction(ray, ray_flags, active);
     } else {
         DRJIT_MARK_USED(ray);
         DRJIT_MARK_USED(ray_flags);
+        DRJIT_MARK_USED(ray_types);
         DRJIT_MARK_USED(coherent);
         DRJIT_MARK_USED(active);
         Throw("ray_intersect_cpu() should only be called in CPU mode.");
@@ -262,12 +268,12 @@ Scene<Float, Spectrum>::ray_intersect_cpu(const Ray3f &ray, uint32_t ray_flags,
 }
 
 MI_VARIANT typename Scene<Float, Spectrum>::Mask
-Scene<Float, Spectrum>::ray_test_cpu(const Ray3f &ray,
+Scene<Float, Spectrum>::ray_test_cpu(const Ray3f &ray, const UInt32 &ray_types,
                                      Mask coherent, Mask active) const {
     if constexpr (!dr::is_jit_v<Float>) {
         DRJIT_MARK_USED(coherent);
         const ShapeKDTree *kdtree = (const ShapeKDTree *) m_accel;
-        return kdtree->template ray_intersect_preliminary<true>(ray, active).is_valid();
+        return kdtree->template ray_intersect_preliminary<true>(ray, active, ray_types).is_valid();
     } else {
         void *func_ptr = nullptr, *scene_ptr = m_accel;
 
@@ -296,7 +302,7 @@ Scene<Float, Spectrum>::ray_test_cpu(const Ray3f &ray,
                             ray.o.z().index(), ray_mint.index(),
                             ray.d.x().index(), ray.d.y().index(),
                             ray.d.z().index(), ray.time.index(),
-                            ray.maxt.index(),  zero.index(),
+                            ray.maxt.index(),  ray_types.index(),
                             zero.index(),      zero.index() };
         uint32_t out[1] { };
 
@@ -380,6 +380,11 @@ MI_VARIANT void Scene<Float, Spectrum>::accel_init_gpu(const Properties &props)
                 has_bspline_curves   |= (type == +ShapeType::BSplineCurve);
                 has_linear_curves    |= (type == +ShapeType::LinearCurve);
                 has_others           |= !shape->is_mesh() && !shape->is_instance();
+
+                if (shape->ray_visibility() != (uint32_t) RayFlags::RayTypes)
+                    Log(Warn, "Shape \"%s\": per-shape ray visibility is not "
+                              "supported by the OptiX backend and will be ignored.",
+                        shape->id());
             }
 
             for (auto& shape : m_shapegroups) {
@@ -590,7 +595,9 @@ MI_VARIANT void Scene<Float, Spectrum>::static_accel_shutdown_gpu() {
 
 MI_VARIANT typename Scene<Float, Spectrum>::PreliminaryIntersection3f
 Scene<Float, Spectrum>::ray_intersect_preliminary_gpu(const Ray3f &ray,
+                                                      const UInt32 & /* ray_types */,
                                                       Mask active) const {
+    // Meshes share a single OptiX instance: visibility flags are not supported
     if constexpr (dr::is_cuda_v<Float>) {
         OptixSceneState &s = *(OptixSceneState *) m_accel;
         const OptixConfig &config = optix_configs[s.config_index];
@@ -664,20 +671,23 @@ Scene<Float, Spectrum>::ray_intersect_preliminary_gpu(const Ray3f &ray,
 
 MI_VARIANT typename Scene<Float, Spectrum>::SurfaceInteraction3f
 Scene<Float, Spectrum>::ray_intersect_gpu(const Ray3f &ray, uint32_t ray_flags,
+                                          const UInt32 &ray_types,
                                           Mask active) const {
     if constexpr (dr::is_cuda_v<Float>) {
-        PreliminaryIntersection3f pi = ray_intersect_preliminary_gpu(ray, active);
+        PreliminaryIntersection3f pi = ray_intersect_preliminary_gpu(ray, ray_types, active);
         return pi.compute_surface_interaction(ray, ray_flags, active);
     } else {
         DRJIT_MARK_USED(ray);
         DRJIT_MARK_USED(ray_flags);
+        DRJIT_MARK_USED(ray_types);
         DRJIT_MARK_USED(active);
         Throw("ray_intersect_gpu() should only be called in GPU mode.");
     }
 }
 
 MI_VARIANT typename Scene<Float, Spectrum>::Mask
-Scene<Float, Spectrum>::ray_test_gpu(const Ray3f &ray, Mask active) const {
+Scene<Float, Spectrum>::ray_test_gpu(const Ray3f &ray, const UInt32 & /* ray_types */,
+                                     Mask active) const {
     if constexpr (dr::is_cuda_v<Float>) {
         OptixSceneState &s = *(OptixSceneState *) m_accel;
         const OptixConfig &config = optix_configs[s.config_index];
@@ -1,9 +1,11 @@
 #include <mitsuba/core/properties.h>
+#include <mitsuba/core/random.h>
 #include <mitsuba/render/mesh.h>
 #include <mitsuba/render/emitter.h>
 #include <mitsuba/render/bsdf.h>
 #include <mitsuba/render/sensor.h>
 #include <mitsuba/render/medium.h>
+#include <mitsuba/render/texture.h>
 #include <mitsuba/core/plugin.h>
 
 #if defined(MI_ENABLE_EMBREE)
@@ -71,6 +73,16 @@ MI_VARIANT Shape<Float, Spectrum>::Shape(const Properties &props) : m_id(props.i
 
     m_silhouette_sampling_weight = props.get<ScalarFloat>("silhouette_sampling_weight", 1.0f);
 
+    m_ray_visibility = 0;
+    if (props.get<bool>("visible_camera", true))
+        m_ray_visibility |= +RayFlags::CameraRay;
+    if (props.get<bool>("visible_shadow", true))
+        m_ray_visibility |= +RayFlags::ShadowRay;
+    if (props.get<bool>("visible_diffuse", true))
+        m_ray_visibility |= +RayFlags::DiffuseRay;
+    if (props.get<bool>("visible_specular", true))
+        m_ray_visibility |= +RayFlags::SpecularRay;
+
     dr::set_attr(this, "emitter", m_emitter.get());
     dr::set_attr(this, "sensor", m_sensor.get());
     dr::set_attr(this, "bsdf", m_bsdf.get());
@@ -142,8 +154,22 @@ void embree_intersect_scalar(int* valid,
 
     // Check whether this is a shadow ray or not
     if (rtc_hit) {
-        PreliminaryIntersection3f pi = shape->ray_intersect_preliminary(ray, primID, true);
-        if (dr::all(pi.is_valid())) {
+        PreliminaryIntersection3f pi;
+        if constexpr (!dr::is_jit_v<Float>) {
+            if (unlikely(shape->alpha_texture())) {
+                // Skip over rejected hits to the far side of the shape
+                pi = dr::zeros<PreliminaryIntersection3f>();
+                pi.prim_index = primID;
+                std::tie(pi.t, pi.prim_uv) =
+                    shape->ray_intersect_alpha_tested_scalar(ray, primID);
+            } else {
+                pi = shape->ray_intersect_preliminary(ray, primID, true);
+            }
+        } else {
+            pi = shape->ray_intersect_preliminary(ray, primID, true);
+        }
+        Mask hit = pi.is_valid();
+        if (dr::all(hit)) {
             rtc_ray->tfar      = (float) dr::slice(pi.t);
             rtc_hit->u         = (float) dr::slice(pi.prim_uv.x());
             rtc_hit->v         = (float) dr::slice(pi.prim_uv.y());
@@ -157,7 +183,19 @@ void embree_intersect_scalar(int* valid,
 #endif
         }
     } else {
-        if (dr::all(shape->ray_test(ray, primID, true)))
+        Mask hit;
+        if constexpr (!dr::is_jit_v<Float>) {
+            if (unlikely(shape->alpha_texture())) {
+                // Alpha-tested shapes need the full intersection record
+                hit = shape->ray_intersect_alpha_tested_scalar(ray, primID).first !=
+                      dr::Infinity<ScalarFloat>;
+            } else {
+                hit = shape->ray_test(ray, primID, true);
+            }
+        } else {
+            hit = shape->ray_test(ray, primID, true);
+        }
+        if (dr::all(hit))
             rtc_ray->tfar = -dr::Infinity<float>;
     }
 }
@@ -583,6 +621,8 @@ Shape<Float, Spectrum>::effective_primitive_count() const {
 
 MI_VARIANT void Shape<Float, Spectrum>::traverse(TraversalCallback *callback) {
     callback->put_object("bsdf", m_bsdf.get(), +ParamFlags::Differentiable);
+    if (m_alpha_texture)
+        callback->put_object("alpha_texture", m_alpha_texture.get(), +ParamFlags::NonDifferentiable);
     if (m_emitter)
         callback->put_object("emitter",         m_emitter.get(),         +ParamFlags::Differentiable);
     if (m_sensor)
@@ -644,6 +684,99 @@ Shape<Float, Spectrum>::eval_parameterization(const Point2f &, uint32_t, Mask) c
     NotImplementedError("eval_parameterization");
 }
 
+MI_VARIANT void Shape<Float, Spectrum>::set_bsdf(BSDF *bsdf) {
+    m_bsdf = bsdf;
+    dr::set_attr(this, "bsdf", m_bsdf.get());
+}
+
+MI_VARIANT void Shape<Float, Spectrum>::set_alpha_texture(Texture *texture) {
+    if constexpr (dr::is_jit_v<Float>) {
+        if (texture)
+            Throw("set_alpha_texture(): alpha testing during ray traversal is "
+                  "only supported by the scalar variants!");
+    }
+    m_alpha_texture = texture;
+}
+
+MI_VARIANT bool
+Shape<Float, Spectrum>::alpha_test_scalar(const ScalarRay3f &ray, ScalarFloat t,
+                                          const ScalarPoint2f &prim_uv,
+                                          ScalarUInt32 prim_index) const {
+    if constexpr (!dr::is_jit_v<Float>) {
+        if (!m_alpha_texture)
+            return true;
+
+        PreliminaryIntersection3f pi = dr::zeros<PreliminaryIntersection3f>();
+        pi.t          = t;
+        pi.prim_uv    = prim_uv;
+        pi.prim_index = prim_index;
+        pi.shape      = this;
+
+        SurfaceInteraction3f si = compute_surface_interaction(
+            ray, pi, +RayFlags::Minimal | RayFlags::UV);
+        si.shape       = this;
+        si.wavelengths = ray.wavelengths;
+
+        ScalarFloat opacity = dr::clamp(m_alpha_texture->eval_1(si), 0.f, 1.f);
+        if (opacity >= 1.f)
+            return true;
+        else if (opacity <= 0.f)
+            return false;
+
+        // Hash the ray, distance, and primitive so that the decision is deterministic
+        uint32_t v0 = prim_index, v1 = dr::reinterpret_array<uint32_t>((float) t);
+        for (size_t i = 0; i < 3; ++i) {
+            v0 = v0 * 0x9E3779B9u ^ dr::reinterpret_array<uint32_t>((float) ray.o[i]);
+            v1 = v1 * 0x9E3779B9u ^ dr::reinterpret_array<uint32_t>((float) ray.d[i]);
+        }
+
+        return sample_tea_float32(v0, v1) < opacity;
+    } else {
+        DRJIT_MARK_USED(ray);
+        DRJIT_MARK_USED(t);
+        DRJIT_MARK_USED(prim_uv);
+        DRJIT_MARK_USED(prim_index);
+        Throw("alpha_test_scalar(): only supported by the scalar variants!");
+    }
+}
+
+MI_VARIANT std::pair<typename Shape<Float, Spectrum>::ScalarFloat,
+                     typename Shape<Float, Spectrum>::ScalarPoint2f>
+Shape<Float, Spectrum>::ray_intersect_alpha_tested_scalar(const ScalarRay3f &ray,
+                                                          ScalarUInt32 prim_index) const {
+    if constexpr (!dr::is_jit_v<Float>) {
+        /* Analytic shapes have at most a handful of intersections along a
+           ray, the iteration count only guards against degenerate cases */
+        ScalarFloat t_offset = 0.f;
+        for (int i = 0; i < 8 && t_offset < ray.maxt; ++i) {
+            ScalarRay3f ray2(ray(t_offset), ray.d, ray.maxt - t_offset,
+                             ray.time, ray.wavelengths);
+            auto [t, prim_uv, shape_index, prim_index_2] =
+                ray_intersect_preliminary_scalar(ray2);
+            DRJIT_MARK_USED(shape_index);
+            DRJIT_MARK_USED(prim_index_2);
+            if (t == dr::Infinity<ScalarFloat>)
+                break;
+
+            // The decision is based on the distance along the original ray
+            t += t_offset;
+            if (alpha_test_scalar(ray, t, prim_uv, prim_index))
+                return { t, prim_uv };
+
+            // Continue past the rejected surface
+            ScalarPoint3f p = ray(t);
+            t_offset = t + (1.f + dr::max(dr::abs(p))) * math::RayEpsilon<ScalarFloat>;
+        }
+
+        return { dr::Infinity<ScalarFloat>, ScalarPoint2f(0.f) };
+    } else {
+        DRJIT_MARK_USED(ray);
+        DRJIT_MARK_USED(prim_index);
+        Throw("ray_intersect_alpha_tested_scalar(): only supported by the "
+              "scalar variants!");
+    }
+}
+
 MI_VARIANT std::string Shape<Float, Spectrum>::get_children_string() const {
     std::vector<std::pair<std::string, const Object*>> children;
     children.push_back({ "bsdf", m_bsdf });
@@ -0,0 +1,463 @@
+#include <mitsuba/render/sparsegrid.h>
+#include <mitsuba/core/stream.h>
+#include <mitsuba/core/logger.h>
+#include <mitsuba/core/fstream.h>
+#include <mitsuba/core/util.h>
+
+NAMESPACE_BEGIN(mitsuba)
+
+MI_VARIANT
+SparseVolumeGrid<Float, Spectrum>::SparseVolumeGrid(Stream *stream) { read(stream); }
+
+MI_VARIANT
+SparseVolumeGrid<Float, Spectrum>::SparseVolumeGrid(const fs::path &filename) {
+    ref<FileStream> fs = new FileStream(filename);
+    read(fs);
+}
+
+MI_VARIANT
+SparseVolumeGrid<Float, Spectrum>::SparseVolumeGrid(ScalarVector3u size,
+                                                    uint32_t channel_count,
+                                                    const ScalarFloat *data,
+                                                    const ScalarFloat *background) {
+    init(size, channel_count, background);
+
+    const uint32_t block = 1u << LeafLog2;
+    ScalarVector3u blocks = (size + (block - 1)) >> LeafLog2;
+    auto dense_index = [&](uint32_t x, uint32_t y, uint32_t z) {
+        return (((size_t) z * size.y() + y) * size.x() + x) * channel_count;
+    };
+
+    for (uint32_t bz = 0; bz < blocks.z(); ++bz) {
+        for (uint32_t by = 0; by < blocks.y(); ++by) {
+            for (uint32_t bx = 0; bx < blocks.x(); ++bx) {
+                ScalarPoint3u origin(bx * block, by * block, bz * block),
+                              end = dr::minimum(origin + block, size);
+
+                // Only store blocks that differ from the background
+                bool active = false;
+                for (uint32_t z = origin.z(); z < end.z() && !active; ++z)
+                    for (uint32_t y = origin.y(); y < end.y() && !active; ++y)
+                        for (uint32_t x = origin.x(); x < end.x() && !active; ++x)
+                            for (uint32_t c = 0; c < channel_count; ++c)
+                                active |= data[dense_index(x, y, z) + c] != m_background[c];
+                if (!active)
+                    continue;
+
+                uint32_t leaf = touch_leaf(origin);
+                for (uint32_t z = origin.z(); z < end.z(); ++z) {
+                    for (uint32_t y = origin.y(); y < end.y(); ++y) {
+                        for (uint32_t x = origin.x(); x < end.x(); ++x) {
+                            size_t index = ((size_t) leaf * LeafSize +
+                                            child_offset(ScalarPoint3u(x, y, z), LeafLog2, 0)) *
+                                           channel_count;
+                            for (uint32_t c = 0; c < channel_count; ++c)
+                                m_values[index + c] = data[dense_index(x, y, z) + c];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    update_bounds();
+}
+
+MI_VARIANT
+SparseVolumeGrid<Float, Spectrum>::SparseVolumeGrid(ScalarVector3u size,
+                                                    uint32_t channel_count,
+                                                    const uint32_t *coords,
+                                                    const ScalarFloat *values,
+                                                    size_t count,
+                                                    const ScalarFloat *background) {
+    init(size, channel_count, background);
+
+    for (size_t i = 0; i < count; ++i) {
+        ScalarPoint3u p = dr::load<ScalarPoint3u>(coords + 3 * i);
+        if (dr::any(p >= size))
+            Throw("SparseVolumeGrid: voxel %s is outside of the grid (size %s)!",
+                  p, size);
+
+        uint32_t leaf = touch_leaf(p);
+        size_t index = ((size_t) leaf * LeafSize + child_offset(p, LeafLog2, 0)) *
+                       channel_count;
+        for (uint32_t c = 0; c < channel_count; ++c)
+            m_values[index + c] = values[i * channel_count + c];
+    }
+
+    update_bounds();
+}
+
+MI_VARIANT
+void SparseVolumeGrid<Float, Spectrum>::init(ScalarVector3u size,
+                                             uint32_t channel_count,
+                                             const ScalarFloat *background) {
+    if (dr::any(dr::eq(size, 0u)) || channel_count == 0)
+        Throw("SparseVolumeGrid: the grid must contain at least one voxel and "
+              "one channel!");
+
+    m_size = size;
+    m_channel_count = channel_count;
+    m_bbox = ScalarBoundingBox3f(ScalarPoint3f(0.f), ScalarPoint3f(1.f));
+    m_background.assign(channel_count, 0.f);
+    if (background)
+        std::copy(background, background + channel_count, m_background.begin());
+
+    m_root_size = (size + ((1u << UpperSpanLog2) - 1)) >> UpperSpanLog2;
+    m_root.assign(dr::prod(m_root_size), Empty);
+    m_upper.clear();
+    m_lower.clear();
+    m_values.clear();
+}
+
+MI_VARIANT
+uint32_t SparseVolumeGrid<Float, Spectrum>::touch_leaf(const ScalarPoint3u &p) {
+    ScalarPoint3u r = p >> UpperSpanLog2;
+    uint32_t &upper = m_root[(r.z() * m_root_size.y() + r.y()) * m_root_size.x() + r.x()];
+    if (upper == Empty) {
+        upper = (uint32_t) upper_count();
+        m_upper.resize(m_upper.size() + UpperSize, Empty);
+    }
+
+    size_t i = (size_t) upper * UpperSize + child_offset(p, UpperLog2, LowerSpanLog2);
+    if (m_upper[i] == Empty) {
+        m_upper[i] = (uint32_t) lower_count();
+        m_lower.resize(m_lower.size() + LowerSize, Empty);
+    }
+
+    size_t j = (size_t) m_upper[i] * LowerSize + child_offset(p, LowerLog2, LeafSpanLog2);
+    if (m_lower[j] == Empty) {
+        m_lower[j] = (uint32_t) leaf_count();
+        m_values.reserve(m_values.size() + LeafSize * m_channel_count);
+        for (uint32_t k = 0; k < LeafSize; ++k)
+            m_values.insert(m_values.end(), m_background.begin(), m_background.end());
+    }
+
+    return m_lower[j];
+}
+
+MI_VARIANT
+void SparseVolumeGrid<Float, Spectrum>::update_bounds() {
+    const uint32_t cc = m_channel_count;
+
+    // Accumulate the statistics of a node or of the background into another node
+    auto expand = [&](ScalarFloat *min, ScalarFloat *max, const ScalarFloat *cmin,
+                      const ScalarFloat *cmax) {
+        for (uint32_t c = 0; c < cc; ++c) {
+            min[c] = dr::minimum(min[c], cmin[c]);
+            max[c] = dr::maximum(max[c], cmax[c]);
+        }
+    };
+
+    auto reset = [&](uint32_t level, size_t count) {
+        m_node_min[level].assign(count * cc, dr::Infinity<ScalarFloat>);
+        m_node_max[level].assign(count * cc, -dr::Infinity<ScalarFloat>);
+    };
+
+    const ScalarFloat *bg = m_background.data();
+
+    reset(0, leaf_count());
+    for (size_t i = 0; i < leaf_count(); ++i)
+        for (uint32_t k = 0; k < LeafSize; ++k) {
+            const ScalarFloat *v = m_values.data() + (i * LeafSize + k) * cc;
+            expand(m_node_min[0].data() + i * cc, m_node_max[0].data() + i * cc, v, v);
+        }
+
+    // Internal nodes, bottom-up
+    for (uint32_t level = 1; level < 3; ++level) {
+        const std::vector<uint32_t> &table = level == 1 ? m_lower : m_upper;
+        uint32_t size = level == 1 ? LowerSize : UpperSize;
+        size_t count = table.size() / size;
+
+        reset(level, count);
+        for (size_t i = 0; i < count; ++i) {
+            ScalarFloat *min = m_node_min[level].data() + i * cc,
+                        *max = m_node_max[level].data() + i * cc;
+            for (uint32_t k = 0; k < size; ++k) {
+                uint32_t child = table[i * size + k];
+                if (child == Empty)
+                    expand(min, max, bg, bg);
+                else
+                    expand(min, max, m_node_min[level - 1].data() + (size_t) child * cc,
+                           m_node_max[level - 1].data() + (size_t) child * cc);
+            }
+        }
+    }
+
+    std::vector<ScalarFloat> min(cc, dr::Infinity<ScalarFloat>);
+    m_max_per_channel.assign(cc, -dr::Infinity<ScalarFloat>);
+    for (uint32_t upper : m_root) {
+        if (upper == Empty)
+            expand(min.data(), m_max_per_channel.data(), bg, bg);
+        else
+            expand(min.data(), m_max_per_channel.data(),
+                   m_node_min[2].data() + (size_t) upper * cc,
+                   m_node_max[2].data() + (size_t) upper * cc);
+    }
+
+    m_max = -dr::Infinity<ScalarFloat>;
+    for (uint32_t c = 0; c < cc; ++c)
+        m_max = dr::maximum(m_max, m_max_per_channel[c]);
+}
+
+MI_VARIANT
+const typename SparseVolumeGrid<Float, Spectrum>::ScalarFloat *
+SparseVolumeGrid<Float, Spectrum>::voxel(const ScalarPoint3u &p) const {
+    if (dr::any(p >= m_size))
+        return m_background.data();
+
+    ScalarPoint3u r = p >> UpperSpanLog2;
+    uint32_t upper = m_root[(r.z() * m_root_size.y() + r.y()) * m_root_size.x() + r.x()];
+    if (upper == Empty)
+        return m_background.data();
+
+    uint32_t lower = m_upper[(size_t) upper * UpperSize +
+                             child_offset(p, UpperLog2, LowerSpanLog2)];
+    if (lower == Empty)
+        return m_background.data();
+
+    uint32_t leaf = m_lower[(size_t) lower * LowerSize +
+                            child_offset(p, LowerLog2, LeafSpanLog2)];
+    if (leaf == Empty)
+        return m_background.data();
+
+    return m_values.data() +
+           ((size_t) leaf * LeafSize + child_offset(p, LeafLog2, 0)) * m_channel_count;
+}
+
+MI_VARIANT
+void SparseVolumeGrid<Float, Spectrum>::max_per_channel(ScalarFloat *out) const {
+    for (size_t i = 0; i < m_channel_count; ++i)
+        out[i] = m_max_per_channel[i];
+}
+
+MI_VARIANT
+void SparseVolumeGrid<Float, Spectrum>::max_per_channel(const ScalarPoint3u &min,
+                                                        const ScalarPoint3u &max_,
+                                                        ScalarFloat *out) const {
+    for (uint32_t c = 0; c < m_channel_count; ++c)
+        out[c] = -dr::Infinity<ScalarFloat>;
+
+    ScalarPoint3u max = dr::minimum(max_, m_size - 1u);
+    if (dr::any(min > max))
+        return;
+
+    ScalarPoint3u r0 = min >> UpperSpanLog2, r1 = max >> UpperSpanLog2;
+    for (uint32_t z = r0.z(); z <= r1.z(); ++z) {
+        for (uint32_t y = r0.y(); y <= r1.y(); ++y) {
+            for (uint32_t x = r0.x(); x <= r1.x(); ++x) {
+                uint32_t upper =
+                    m_root[(z * m_root_size.y() + y) * m_root_size.x() + x];
+                if (upper == Empty) {
+                    for (uint32_t c = 0; c < m_channel_count; ++c)
+                        out[c] = dr::maximum(out[c], m_background[c]);
+                } else {
+                    region_max(2, upper, ScalarPoint3u(x, y, z) << UpperSpanLog2,
+                               min, max, out);
+                }
+            }
+        }
+    }
+}
+
+MI_VARIANT
+void SparseVolumeGrid<Float, Spectrum>::region_max(uint32_t level, uint32_t index,
+                                                   const ScalarPoint3u &origin,
+                                                   const ScalarPoint3u &min,
+                                                   const ScalarPoint3u &max,
+                                                   ScalarFloat *out) const {
+    const uint32_t cc = m_channel_count;
+    const uint32_t span_log2 = level == 2 ? UpperSpanLog2
+                             : level == 1 ? LowerSpanLog2 : LeafSpanLog2;
+    ScalarPoint3u last = origin + ((1u << span_log2) - 1u);
+
+    // Nodes that are fully contained in the region provide a tight bound
+    if (dr::all(origin >= min && last <= max)) {
+        const ScalarFloat *node_max = m_node_max[level].data() + (size_t) index * cc;
+        for (uint32_t c = 0; c < cc; ++c)
+            out[c] = dr::maximum(out[c], node_max[c]);
+        return;
+    }
+
+    ScalarPoint3u lo = dr::maximum(origin, min) - origin,
+                  hi = dr::minimum(last, max) - origin;
+
+    if (level == 0) {
+        for (uint32_t z = lo.z(); z <= hi.z(); ++z)
+            for (uint32_t y = lo.y(); y <= hi.y(); ++y)
+                for (uint32_t x = lo.x(); x <= hi.x(); ++x) {
+                    const ScalarFloat *v =
+                        m_values.data() +
+                        ((size_t) index * LeafSize +
+                         child_offset(ScalarPoint3u(x, y, z), LeafLog2, 0)) * cc;
+                    for (uint32_t c = 0; c < cc; ++c)
+                        out[c] = dr::maximum(out[c], v[c]);
+                }
+        return;
+    }
+
+    const std::vector<uint32_t> &table = level == 2 ? m_upper : m_lower;
+    const uint32_t log2 = level == 2 ? UpperLog2 : LowerLog2,
+                   child_span_log2 = span_log2 - log2;
+
+    lo = lo >> child_span_log2;
+    hi = hi >> child_span_log2;
+    for (uint32_t z = lo.z(); z <= hi.z(); ++z) {
+        for (uint32_t y = lo.y(); y <= hi.y(); ++y) {
+            for (uint32_t x = lo.x(); x <= hi.x(); ++x) {
+                uint32_t slot  = (x << (2 * log2)) | (y << log2) | z,
+                         child = table[((size_t) index << (3 * log2)) + slot];
+                if (child == Empty) {
+                    for (uint32_t c = 0; c < cc; ++c)
+                        out[c] = dr::maximum(out[c], m_background[c]);
+                } else {
+                    region_max(level - 1, child,
+                               origin + (ScalarPoint3u(x, y, z) << child_span_log2),
+                               min, max, out);
+                }
+            }
+        }
+    }
+}
+
+MI_VARIANT
+size_t SparseVolumeGrid<Float, Spectrum>::buffer_size() const {
+    return (m_root.size() + m_upper.size() + m_lower.size()) * sizeof(uint32_t) +
+           m_values.size() * sizeof(ScalarFloat);
+}
+
+MI_VARIANT
+void SparseVolumeGrid<Float, Spectrum>::read(Stream *stream) {
+    char header[3];
+    stream->read(header, 3);
+
+    if (header[0] != 'S' || header[1] != 'V' || header[2] != 'L')
+        Throw("Invalid sparse volume file!");
+    uint8_t version;
+    stream->read(version);
+
+    if (version != 1)
+        Throw("Invalid version, currently only version 1 is supported (found %d)", version);
+
+    int32_t data_type;
+    stream->read(data_type);
+    if (data_type != 1)
+        Throw("Wrong type, currently only type == 1 (Float32) data is "
+              "supported (found type = %d)", data_type);
+
+    int32_t size[3], channel_count;
+    stream->read_array(size, 3);
+    stream->read(channel_count);
+
+    float dims[6];
+    stream->read_array(dims, 6);
+
+    std::vector<float> background(channel_count);
+    stream->read_array(background.data(), channel_count);
+    std::vector<ScalarFloat> background_f(background.begin(), background.end());
+
+    init(ScalarVector3u((uint32_t) size[0], (uint32_t) size[1], (uint32_t) size[2]),
+         (uint32_t) channel_count, background_f.data());
+    m_bbox = ScalarBoundingBox3f(ScalarPoint3f(dims[0], dims[1], dims[2]),
+                                 ScalarPoint3f(dims[3], dims[4], dims[5]));
+
+    uint32_t upper_count, lower_count, leaf_count;
+    stream->read(upper_count);
+    stream->read(lower_count);
+    stream->read(leaf_count);
+
+    // The node tables are stored as is, no pointers need to be fixed up
+    m_upper.resize((size_t) upper_count * UpperSize);
+    m_lower.resize((size_t) lower_count * LowerSize);
+    stream->read_array(m_root.data(), m_root.size());
+    stream->read_array(m_upper.data(), m_upper.size());
+    stream->read_array(m_lower.data(), m_lower.size());
+
+    auto validate = [](const std::vector<uint32_t> &table, uint32_t count) {
+        for (uint32_t index : table)
+            if (index != Empty && index >= count)
+                Throw("Invalid sparse volume file: node index out of range!");
+    };
+    validate(m_root, upper_count);
+    validate(m_upper, lower_count);
+    validate(m_lower, leaf_count);
+
+    m_values.resize((size_t) leaf_count * LeafSize * m_channel_count);
+    if constexpr (std::is_same<ScalarFloat, float>::value) {
+        stream->read_array(m_values.data(), m_values.size());
+    } else {
+        std::vector<float> values(m_values.size());
+        stream->read_array(values.data(), values.size());
+        std::copy(values.begin(), values.end(), m_values.begin());
+    }
+
+    update_bounds();
+
+    Log(Debug, "Loaded sparse grid volume data: dimensions %s, %zu leaf nodes "
+        "(%s), max value %f", m_size, leaf_count, util::mem_string(buffer_size()),
+        m_max);
+}
+
+MI_VARIANT
+void SparseVolumeGrid<Float, Spectrum>::write(const fs::path &path) const {
+    ref<FileStream> fs = new FileStream(path, FileStream::ETruncReadWrite);
+    write(fs);
+}
+
+MI_VARIANT
+void SparseVolumeGrid<Float, Spectrum>::write(Stream *stream) const {
+    stream->write("SVL", 3);
+    stream->write(uint8_t(1)); // file format version
+    stream->write(int32_t(1)); // data_type
+    stream->write(int32_t(m_size.x()));
+    stream->write(int32_t(m_size.y()));
+    stream->write(int32_t(m_size.z()));
+    stream->write(int32_t(m_channel_count));
+
+    stream->write(float(m_bbox.min.x()));
+    stream->write(float(m_bbox.min.y()));
+    stream->write(float(m_bbox.min.z()));
+    stream->write(float(m_bbox.max.x()));
+    stream->write(float(m_bbox.max.y()));
+    stream->write(float(m_bbox.max.z()));
+
+    for (ScalarFloat value : m_background)
+        stream->write(float(value));
+
+    stream->write(uint32_t(upper_count()));
+    stream->write(uint32_t(lower_count()));
+    stream->write(uint32_t(leaf_count()));
+    stream->write_array(m_root.data(), m_root.size());
+    stream->write_array(m_upper.data(), m_upper.size());
+    stream->write_array(m_lower.data(), m_lower.size());
+
+    if constexpr (std::is_same<ScalarFloat, float>::value)
+        stream->write_array(m_values.data(), m_values.size());
+    else {
+        // Need to convert data to single precision before writing to disk
+        std::vector<float> output(m_values.begin(), m_values.end());
+        stream->write_array(output.data(), output.size());
+    }
+}
+
+MI_VARIANT
+std::string SparseVolumeGrid<Float, Spectrum>::to_string() const {
+    size_t dense_size = (size_t) m_size.x() * m_size.y() * m_size.z() *
+                        m_channel_count * sizeof(ScalarFloat);
+    std::ostringstream oss;
+    oss << "SparseVolumeGrid[" << std::endl
+        << "  size = " << m_size << "," << std::endl
+        << "  channels = " << m_channel_count << "," << std::endl
+        << "  nodes = [ " << upper_count() << " upper, " << lower_count()
+        << " lower, " << leaf_count() << " leaf ]," << std::endl
+        << "  max = " << m_max << "," << std::endl
+        << "  data = [ " << util::mem_string(buffer_size())
+        << " of volume data, dense: " << util::mem_string(dense_size) << " ]" << std::endl
+        << "]";
+    return oss.str();
+}
+
+MI_IMPLEMENT_CLASS_VARIANT(SparseVolumeGrid, Object)
+MI_INSTANTIATE_CLASS(SparseVolumeGrid)
+
+NAMESPACE_END(mitsuba)
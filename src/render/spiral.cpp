@@ -7,7 +7,7 @@ NAMESPACE_BEGIN(mitsuba)
 Spiral::Spiral(const Vector2u &size, const Vector2u &offset,
                uint32_t block_size, uint32_t passes)
     : m_size(size), m_offset(offset), m_passes_left(passes),
-      m_block_size(block_size) {
+      m_block_size(block_size), m_passes(passes), m_scanline(false) {
 
     m_blocks = (size + (block_size - 1)) / block_size;
     m_block_count = dr::prod(m_blocks);
@@ -27,6 +27,23 @@ std::tuple<Spiral::Vector2i, Spiral::Vector2u, uint32_t> Spiral::next_block() {
     // Reimplementation of the spiraling block generator by Adam Arbree.
     std::lock_guard<std::mutex> lock(m_mutex);
 
+    if (m_scanline) {
+        /* Row-major traversal, where each block is repeated for all passes.
+           In this mode, 'm_block_counter' counts across all passes. */
+        if (m_block_counter == m_block_count * m_passes)
+            return { 0, 0, (uint32_t) -1 };
+
+        uint32_t block = m_block_counter / m_passes,
+                 pass  = m_block_counter % m_passes;
+        ++m_block_counter;
+
+        Vector2u position(block % m_blocks.x(), block / m_blocks.x()),
+                 offset = position * m_block_size,
+                 size   = dr::minimum(m_block_size, m_size - offset);
+
+        return { offset + m_offset, size, block + pass * m_block_count };
+    }
+
     if (m_block_counter == m_block_count) {
         if (m_passes_left > 1) {
             --m_passes_left;
@@ -462,3 +462,40 @@ def test07_masked_updates(variants_all_ad_rgb, opt):
 
         prev_x = mi.Float(params['x'])
         prev_state = [mi.Float(vv) for vv in ensure_iterable(opt.state['x'])]
+
+
+@pytest.mark.parametrize('uniform', [False, True])
+def test08_optimizer_multiple_parameters(variants_all_ad_rgb, uniform):
+    params = {
+        'a': mi.Float([1.0, 2.0, 3.0]),
+        'b': mi.Float([1.0, 2.0, 3.0, 4.0, 5.0]),
+        'c': mi.TensorXf(dr.full(mi.Float, 2.0, 6), shape=(2, 3))
+    }
+    grads = {
+        'a': mi.Float([-1.0, 0.5, 2.0]),
+        'b': mi.Float([4.0, -2.0, 1.0, 0.0, -1.0]),
+        'c': mi.TensorXf(mi.Float([1, -1, 2, -2, 4, -4]), shape=(2, 3))
+    }
+    lr = { 'a': 0.1, 'b': 0.2 }
+
+    opt = mi.ad.Adam(lr=0.05, params=params, uniform=uniform)
+    opt.set_learning_rate(lr)
+
+    for k, g in grads.items():
+        dr.set_grad(opt[k], g)
+    opt.step()
+
+    def flat(x):
+        return x.array if dr.is_tensor_v(x) else x
+
+    # The first step of Adam moves each entry by the learning rate in the
+    # direction of its gradient (normalized by the largest one if uniform)
+    for k, g in grads.items():
+        g = flat(g)
+        if uniform:
+            step = g / dr.max(dr.abs(g))
+        else:
+            step = dr.select(dr.neq(g, 0), dr.sign(g), 0)
+        expected = flat(params[k]) - lr.get(k, 0.05) * step
+        assert dr.shape(opt[k]) == dr.shape(params[k])
+        assert dr.allclose(flat(opt[k]), expected, rtol=1e-4, atol=1e-5)
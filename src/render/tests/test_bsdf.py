@@ -63,4 +63,233 @@ def test03_bsdf_attributes(variants_vec_backends_once_rgb):
     assert dr.all(bsdf.has_attribute('tint'))
     assert not dr.all(bsdf.has_attribute('foo'))
     assert dr.allclose(color, bsdf.eval_attribute('tint', si))
-    assert dr.allclose(0.0, bsdf.eval_attribute('foo', si))
\ No newline at end of file
+    assert dr.allclose(0.0, bsdf.eval_attribute('foo', si))
+
+def make_adapter_stack():
+    rng = np.random.default_rng(seed=0)
+    normals = np.array([0.5, 0.5, 1.0]) + 0.2 * (rng.random((4, 4, 3)) - 0.5)
+    heights = rng.random((8, 8, 1))
+
+    return {
+        'type': 'twosided',
+        'material': {
+            'type': 'normalmap',
+            'normalmap': {
+                'type': 'bitmap',
+                'data': mi.TensorXf(normals),
+                'raw': True
+            },
+            'bsdf': {
+                'type': 'bumpmap',
+                'texture': {
+                    'type': 'bitmap',
+                    'data': mi.TensorXf(heights),
+                    'raw': True
+                },
+                'scale': 0.5,
+                'bsdf': {
+                    'type': 'mask',
+                    'opacity': 0.7,
+                    'bsdf': {
+                        'type': 'roughplastic',
+                        'alpha': 0.2
+                    }
+                }
+            }
+        }
+    }
+
+
+def test04_flatten_adapters(variants_vec_backends_once_rgb):
+    bsdf = mi.load_dict(make_adapter_stack())
+    flat = mi.BSDF.flatten(bsdf)
+    assert 'FlattenedBSDF' in str(flat)
+    assert flat.flags() == bsdf.flags()
+    assert flat.component_count() == bsdf.component_count()
+
+    # A single adapter is not worth flattening
+    single = mi.load_dict({'type': 'twosided', 'material': {'type': 'diffuse'}})
+    assert 'FlattenedBSDF' not in str(mi.BSDF.flatten(single))
+
+    n = 1024
+    rng = np.random.default_rng(seed=1)
+
+    def directions():
+        d = rng.normal(size=(n, 3))
+        return mi.Vector3f(d / np.linalg.norm(d, axis=1, keepdims=True))
+
+    si = dr.zeros(mi.SurfaceInteraction3f, n)
+    si.uv = mi.Point2f(rng.random(n), rng.random(n))
+    si.n = mi.Normal3f(0, 0, 1)
+    si.sh_frame = mi.Frame3f(si.n)
+    si.dp_du = mi.Vector3f(1, 0, 0)
+    si.dp_dv = mi.Vector3f(0, 1, 0)
+    si.wi = directions()
+    wo = directions()
+    sample1 = mi.Float(rng.random(n))
+    sample2 = mi.Point2f(rng.random(n), rng.random(n))
+
+    ctx = mi.BSDFContext()
+    contexts = [ctx, mi.BSDFContext(mi.TransportMode.Radiance,
+                                    mi.BSDFFlags.All, bsdf.component_count() - 1)]
+
+    for ctx in contexts:
+        assert dr.allclose(flat.eval(ctx, si, wo), bsdf.eval(ctx, si, wo))
+        assert dr.allclose(flat.pdf(ctx, si, wo), bsdf.pdf(ctx, si, wo))
+
+        value_ref, pdf_ref = bsdf.eval_pdf(ctx, si, wo)
+        value, pdf = flat.eval_pdf(ctx, si, wo)
+        assert dr.allclose(value, value_ref)
+        assert dr.allclose(pdf, pdf_ref)
+
+        bs_ref, weight_ref = bsdf.sample(ctx, si, sample1, sample2)
+        bs, weight = flat.sample(ctx, si, sample1, sample2)
+        assert dr.allclose(bs.wo, bs_ref.wo)
+        assert dr.allclose(bs.pdf, bs_ref.pdf)
+        assert dr.all(bs.sampled_component == bs_ref.sampled_component)
+        assert dr.allclose(weight, weight_ref)
+
+    assert dr.allclose(flat.eval_null_transmission(si),
+                       bsdf.eval_null_transmission(si))
+    assert dr.allclose(flat.eval_diffuse_reflectance(si),
+                       bsdf.eval_diffuse_reflectance(si))
+
+
+def test05_flatten_scene(variants_all_rgb):
+    scene_dict = {
+        'type': 'scene',
+        'material': make_adapter_stack(),
+        'shape_1': {
+            'type': 'rectangle',
+            'bsdf': {'type': 'ref', 'id': 'material'}
+        },
+        'shape_2': {
+            'type': 'sphere',
+            'bsdf': {'type': 'ref', 'id': 'material'}
+        }
+    }
+
+    # Only the scalar variants flatten adapters by default
+    scene = mi.load_dict(scene_dict)
+    flattened = 'FlattenedBSDF' in str(scene.shapes()[0].bsdf())
+    assert flattened == mi.variant().startswith('scalar')
+
+    scene_dict['flatten_bsdfs'] = True
+    scene = mi.load_dict(scene_dict)
+    shapes = scene.shapes()
+    assert 'FlattenedBSDF' in str(shapes[0].bsdf())
+
+    # Shapes sharing a material still share it
+    assert shapes[0].bsdf() is shapes[1].bsdf()
+
+    # Parameter names are unaffected
+    scene_dict['flatten_bsdfs'] = False
+    keys = set(mi.traverse(scene).keys())
+    keys_ref = set(mi.traverse(mi.load_dict(scene_dict)).keys())
+    assert keys == keys_ref
+
+
+def test06_python_bsdf_batched(variant_scalar_rgb):
+    class BatchedDiffuse(mi.BSDF):
+        def __init__(self, props):
+            mi.BSDF.__init__(self, props)
+            self.m_flags = mi.BSDFFlags.DiffuseReflection | mi.BSDFFlags.FrontSide
+            self.m_components = [self.m_flags]
+            self.queries = 0
+
+        def sample(self, ctx, si, sample1, sample2, active):
+            bs = mi.BSDFSample3f()
+            bs.wo = mi.warp.square_to_cosine_hemisphere(sample2)
+            bs.pdf = mi.warp.square_to_cosine_hemisphere_pdf(bs.wo)
+            bs.eta = 1.0
+            bs.sampled_type = +mi.BSDFFlags.DiffuseReflection
+            bs.sampled_component = 0
+            active = active and mi.Frame3f.cos_theta(si.wi) > 0 and bs.pdf > 0
+            return (bs, mi.Color3f(0.5 if active else 0.0))
+
+        # Called with one row per query, from any number of render threads
+        def eval_batch(self, wi, wo, uv, p):
+            self.queries += wi.shape[0]
+            valid = (wi[:, 2] > 0) & (wo[:, 2] > 0)
+            value = np.where(valid, 0.5 * wo[:, 2] / np.pi, 0)
+            return np.repeat(value[:, None], 3, axis=1)
+
+        def pdf_batch(self, wi, wo, uv, p):
+            valid = (wi[:, 2] > 0) & (wo[:, 2] > 0)
+            return np.where(valid, wo[:, 2] / np.pi, 0)
+
+        def to_string(self):
+            return 'BatchedDiffuse[]'
+
+    mi.register_bsdf('batched_diffuse', BatchedDiffuse)
+
+    bsdf = mi.load_dict({'type': 'batched_diffuse'})
+    ctx = mi.BSDFContext()
+    si = dr.zeros(mi.SurfaceInteraction3f)
+    si.wi = [0, 0, 1]
+    wo = mi.Vector3f(0, 0.6, 0.8)
+
+    assert dr.allclose(bsdf.eval(ctx, si, wo), 0.4 / dr.pi)
+    assert dr.allclose(bsdf.pdf(ctx, si, wo), 0.8 / dr.pi)
+    assert dr.allclose(bsdf.eval(ctx, si, -wo), 0)
+    assert bsdf.queries == 2
+
+    def render(bsdf_type):
+        scene = mi.load_dict({
+            'type': 'scene',
+            'integrator': {'type': 'path', 'max_depth': 3},
+            'sensor': {
+                'type': 'perspective',
+                'to_world': mi.ScalarTransform4f.look_at(
+                    origin=[0, 0, 4], target=[0, 0, 0], up=[0, 1, 0]),
+                'film': {'type': 'hdrfilm', 'width': 16, 'height': 16,
+                         'rfilter': {'type': 'box'}},
+                'sampler': {'type': 'independent', 'sample_count': 4}
+            },
+            'emitter': {'type': 'constant'},
+            'shape': {'type': 'sphere', 'bsdf': bsdf_type}
+        })
+        return mi.render(scene), scene.shapes()[0].bsdf()
+
+    image_ref, _ = render({'type': 'diffuse', 'reflectance': 0.5})
+    image, bsdf = render({'type': 'batched_diffuse'})
+    assert bsdf.queries > 0
+    assert dr.allclose(image, image_ref, rtol=1e-3, atol=1e-4)
+
+
+def test07_flatten_adapters_scalar(variant_scalar_rgb):
+    bsdf = mi.load_dict(make_adapter_stack())
+    flat = mi.BSDF.flatten(bsdf)
+    assert 'FlattenedBSDF' in str(flat)
+
+    rng = np.random.default_rng(seed=1)
+
+    def direction():
+        d = rng.normal(size=3)
+        return mi.Vector3f(d / np.linalg.norm(d))
+
+    ctx = mi.BSDFContext()
+    for i in range(64):
+        si = dr.zeros(mi.SurfaceInteraction3f)
+        si.uv = mi.Point2f(rng.random(), rng.random())
+        si.n = mi.Normal3f(0, 0, 1)
+        si.sh_frame = mi.Frame3f(si.n)
+        si.dp_du = mi.Vector3f(1, 0, 0)
+        si.dp_dv = mi.Vector3f(0, 1, 0)
+        si.wi = direction()
+        wo = direction()
+        sample1 = rng.random()
+        sample2 = mi.Point2f(rng.random(), rng.random())
+
+        assert dr.allclose(flat.eval(ctx, si, wo), bsdf.eval(ctx, si, wo))
+        assert dr.allclose(flat.pdf(ctx, si, wo), bsdf.pdf(ctx, si, wo))
+
+        bs_ref, weight_ref = bsdf.sample(ctx, si, sample1, sample2)
+        bs, weight = flat.sample(ctx, si, sample1, sample2)
+        assert dr.allclose(bs.wo, bs_ref.wo)
+        assert dr.allclose(bs.pdf, bs_ref.pdf)
+        assert bs.sampled_component == bs_ref.sampled_component
+        assert dr.allclose(weight, weight_ref)
+
+        assert dr.allclose(flat.eval_null_transmission(si),
+                           bsdf.eval_null_transmission(si))
@@ -0,0 +1,110 @@
+import pytest
+import drjit as dr
+import mitsuba as mi
+
+
+def make_scene(res, rfilter='box'):
+    return mi.load_dict({
+        'type': 'scene',
+        'sphere': {
+            'type': 'sphere',
+            'bsdf': {'type': 'diffuse'}
+        },
+        'emitter': {'type': 'constant'},
+        'sensor': {
+            'type': 'perspective',
+            'to_world': mi.ScalarTransform4f.look_at(origin=[0, 0, 4],
+                                                     target=[0, 0, 0],
+                                                     up=[0, 1, 0]),
+            'film': {
+                'type': 'hdrfilm',
+                'width': res,
+                'height': res,
+                'rfilter': {'type': rfilter}
+            },
+            'sampler': {
+                'type': 'stateless',
+                'sample_count': 12
+            }
+        }
+    })
+
+
+def test01_memory_budget_wavefront_split(variants_vec_backends_once_rgb):
+    # 256x256 pixels occupy at least 1 MiB of sampler state per sample
+    scene = make_scene(256)
+
+    with dr.scoped_set_flag(dr.JitFlag.KernelHistory, True):
+        integrator = mi.load_dict({'type': 'path', 'max_depth': 3})
+        ref = integrator.render(scene, seed=1)
+        history_ref = dr.kernel_history([dr.KernelType.JIT])
+
+        integrator = mi.load_dict({'type': 'path', 'max_depth': 3,
+                                   'memory_budget': 1})
+        img = integrator.render(scene, seed=1)
+        history = dr.kernel_history([dr.KernelType.JIT])
+
+    # The budget-limited render must be split into several passes ..
+    assert len(history) > len(history_ref)
+
+    # .. while producing the same image (up to the order of accumulation)
+    assert dr.allclose(img, ref, rtol=1e-4, atol=1e-5)
+
+
+def test02_memory_budget_divisor(variants_vec_backends_once_rgb):
+    # Passes must evenly divide the sample count (here: 6 passes of 2 spp)
+    scene = make_scene(256)
+    integrator = mi.load_dict({'type': 'path', 'max_depth': 2,
+                               'memory_budget': 2})
+    img = integrator.render(scene, seed=0, spp=12)
+    ref = mi.load_dict({'type': 'path', 'max_depth': 2}).render(scene, seed=0, spp=12)
+    assert dr.allclose(img, ref, rtol=1e-4, atol=1e-5)
+
+
+def test03_object_profiler(variant_scalar_rgb):
+    scene = make_scene(16)
+    integrator = mi.load_dict({'type': 'path', 'max_depth': 3})
+
+    mi.ObjectProfiler.reset()
+    mi.ObjectProfiler.set_enabled(True)
+    try:
+        integrator.render(scene, seed=0, spp=4)
+    finally:
+        mi.ObjectProfiler.set_enabled(False)
+
+    records = mi.ObjectProfiler.records()
+    bsdf_records = [r for r in records if isinstance(r[0], mi.BSDF)]
+    assert any(r[1] == 'BSDF::sample()' for r in bsdf_records)
+    assert all(r[2] > 0 for r in records)
+    assert 'BSDF::sample()' in mi.ObjectProfiler.report()
+
+    mi.ObjectProfiler.reset()
+    assert len(mi.ObjectProfiler.records()) == 0
+
+
+def test04_tail_splitting_deterministic(variant_scalar_rgb):
+    # A single large block forces idle workers to help with its pixels
+    scene = make_scene(32)
+    integrator = mi.load_dict({'type': 'path', 'max_depth': 3,
+                               'block_size': 32})
+
+    images = [integrator.render(scene, seed=3, spp=8) for _ in range(3)]
+    for img in images[1:]:
+        assert dr.all(dr.eq(img.array, images[0].array))
+
+
+def test05_tail_splitting_gaussian(variant_scalar_rgb):
+    # Samples splat into neighboring pixels, which may be accumulated in a
+    # different order depending on how the work was distributed
+    scene = make_scene(32, 'gaussian')
+    integrator = mi.load_dict({'type': 'path', 'max_depth': 3,
+                               'block_size': 32})
+    ref = mi.load_dict({'type': 'path', 'max_depth': 3,
+                        'block_size': 8}).render(scene, seed=3, spp=8)
+
+    images = [integrator.render(scene, seed=3, spp=8) for _ in range(3)]
+    for img in images[1:]:
+        assert dr.allclose(img, images[0], rtol=1e-5, atol=1e-6)
+
+    # The blocks are seeded differently, but the estimates agree
+    assert dr.allclose(dr.mean(images[0]), dr.mean(ref), rtol=0.05)
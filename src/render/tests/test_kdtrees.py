@@ -113,3 +113,4 @@ def test02_depth_scalar_bunny(variant_scalar_rgb):
             res_shadow = scene.ray_test(r)
             assert dr.all(res_shadow == res_naive.is_valid())
             compare_results(res_naive, res)
+
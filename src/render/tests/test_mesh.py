@@ -1221,3 +1221,192 @@ def test33_rebuild_area_pmf(variants_vec_rgb):
     surface_area_after = mesh.surface_area()
 
     assert surface_area_after == 4 * surface_area_before
+
+
+def test34_silhouette_bvh(variants_vec_rgb):
+    if not dr.is_diff_v(mi.Float):
+        pytest.skip("Only relevant in AD-enabled variants!")
+
+    # Torus with enough faces to use the edge hierarchy
+    n, m = 48, 32
+    i, j = dr.meshgrid(dr.arange(mi.UInt32, n), dr.arange(mi.UInt32, m), indexing='ij')
+    phi = mi.Float(i) * (2 * dr.pi / n)
+    theta = mi.Float(j) * (2 * dr.pi / m)
+    r = 1 + 0.3 * dr.cos(theta)
+    positions = mi.Point3f(r * dr.cos(phi), r * dr.sin(phi), 0.3 * dr.sin(theta))
+
+    i1, j1 = (i + 1) % n, (j + 1) % m
+    v00, v10, v01, v11 = i * m + j, i1 * m + j, i * m + j1, i1 * m + j1
+    faces = dr.ravel(mi.Vector3u(dr.concat(v00, v00), dr.concat(v10, v11), dr.concat(v11, v01)))
+
+    def make_mesh(use_bvh):
+        props = mi.Properties()
+        props['silhouette_bvh'] = use_bvh
+        mesh = mi.Mesh("MyMesh", n * m, 2 * n * m, props)
+        params = mi.traverse(mesh)
+        params['vertex_positions'] = dr.ravel(positions)
+        params['faces'] = faces
+        params.update()
+        dr.enable_grad(params['vertex_positions'])
+        params.update()
+        return mesh, params
+
+    mesh_bvh, params_bvh = make_mesh(True)
+    mesh_ref, params_ref = make_mesh(False)
+
+    def check():
+        for viewpoint in [mi.ScalarPoint3f(0, 0, 4), mi.ScalarPoint3f(3, -2, 1),
+                          mi.ScalarPoint3f(0.1, 0.2, 0.05)]:
+            idx_bvh, w_bvh = mesh_bvh.precompute_silhouette(viewpoint)
+            idx_ref, w_ref = mesh_ref.precompute_silhouette(viewpoint)
+            assert dr.width(idx_bvh) > 0
+            assert dr.all(dr.eq(idx_bvh, idx_ref))
+            assert dr.allclose(w_bvh, w_ref)
+            assert dr.all(dr.eq(mesh_bvh.silhouette_edges(viewpoint), idx_ref))
+
+    check()
+
+    # Changing the vertex positions refits the hierarchy
+    for params in [params_bvh, params_ref]:
+        params['vertex_positions'] = dr.ravel(mi.Transform4f.scale([1, 2, 0.5]) @ positions)
+        dr.enable_grad(params['vertex_positions'])
+        params.update()
+
+    check()
+
+
+def test35_set_buffers(variants_all_rgb):
+    import numpy as np
+
+    mesh = mi.Mesh("MyMesh", 3, 1, has_vertex_texcoords=True)
+    positions = np.array([0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1, 0], dtype=np.float32)
+    faces = np.array([0, 1, 2, 1, 3, 2], dtype=np.uint32)
+    texcoords = np.array([0, 0, 1, 0, 0, 1, 1, 1], dtype=np.float32)
+    mesh.set_buffers(positions, faces, texcoords)
+
+    assert mesh.vertex_count() == 4
+    assert mesh.face_count() == 2
+    assert dr.allclose(mesh.surface_area(), 1.0)
+
+    params = mi.traverse(mesh)
+    assert dr.allclose(params['vertex_positions'], positions)
+    assert dr.allclose(params['faces'], faces)
+    assert dr.allclose(params['vertex_texcoords'], texcoords)
+
+    # Dr.Jit arrays are adopted as-is
+    mesh.set_buffers(params['vertex_positions'] * 2, params['faces'])
+    assert dr.allclose(mesh.surface_area(), 4.0)
+
+    with pytest.raises(Exception):
+        mesh.set_buffers(positions[:-1], faces)
+
+    # Face indices are not truncated from floating point arrays
+    with pytest.raises(TypeError):
+        mesh.set_buffers(positions, faces.astype(np.float32))
+
+
+@fresolver_append_path
+def test36_shared_memory_cache(variants_all_rgb):
+    import os
+    if not os.path.isdir('/dev/shm'):
+        pytest.skip('POSIX shared memory is not available')
+
+    def entries():
+        return set(f for f in os.listdir('/dev/shm') if f.startswith('mi-'))
+
+    props = {
+        'type' : 'obj',
+        'filename' : 'resources/data/common/meshes/sphere.obj',
+        'to_world' : mi.ScalarTransform4f.scale(2.0)
+    }
+
+    before = entries()
+    mi.SharedMemoryRegion.set_enabled(True)
+    try:
+        mesh_ref = mi.load_dict(props)
+        published = entries() - before
+        assert len(published) == 1
+
+        # The second load maps the published buffers
+        mesh = mi.load_dict(props)
+        params_ref, params = mi.traverse(mesh_ref), mi.traverse(mesh)
+        for key in ['vertex_positions', 'vertex_normals', 'vertex_texcoords', 'faces']:
+            assert dr.all(dr.eq(params[key], params_ref[key]))
+        assert mesh.bbox() == mesh_ref.bbox()
+
+        # Changes remain private to the mesh
+        params['vertex_positions'] *= 2
+        params.update()
+        mesh_2 = mi.load_dict(props)
+        assert dr.all(dr.eq(mi.traverse(mesh_2)['vertex_positions'],
+                            params_ref['vertex_positions']))
+
+        # Regions are private to the current user
+        name = list(published)[0]
+        assert os.stat('/dev/shm/' + name).st_mode & 0o777 == 0o600
+
+        # Corrupt entries (here, an out-of-bounds face index) are ignored
+        import numpy as np
+        with open('/dev/shm/' + name, 'rb') as f:
+            data = bytearray(f.read()[64:]) # Skip the region header
+        data[-4:] = (0xFFFFFFF0).to_bytes(4, 'little')
+        mi.SharedMemoryRegion.remove('/' + name)
+        region = mi.SharedMemoryRegion.create('/' + name, len(data))
+        np.array(region, copy=False)[:] = np.frombuffer(data, dtype=np.uint8)
+        region.publish()
+        mesh_3 = mi.load_dict(props)
+        assert dr.all(dr.eq(mi.traverse(mesh_3)['faces'], params_ref['faces']))
+
+        # A different transformation results in a different entry
+        props['to_world'] = mi.ScalarTransform4f.scale(3.0)
+        mi.load_dict(props)
+        assert len(entries() - before) == 2
+    finally:
+        mi.SharedMemoryRegion.set_enabled(False)
+        for name in entries() - before:
+            mi.SharedMemoryRegion.remove('/' + name)
+
+
+def test37_sample_direction(variant_scalar_rgb):
+    positions = [mi.ScalarPoint3f(-1.0, -1.0, 0.0), mi.ScalarPoint3f(2.0, -1.0, 0.3),
+                 mi.ScalarPoint3f(1.5, 1.0, 0.0), mi.ScalarPoint3f(-1.0, 0.5, -0.2)]
+    faces = [[0, 1, 2], [0, 2, 3]]
+
+    mesh = mi.Mesh("MyMesh", 4, 2)
+    params = mi.traverse(mesh)
+    params['vertex_positions'] = [x for p in positions for x in p]
+    params['faces'] = [i for f in faces for i in f]
+    params.update()
+
+    scene = mi.load_dict({ 'type': 'scene', 'mesh': mesh })
+
+    def solid_angle(p, face):
+        a, b, c = [dr.normalize(positions[i] - p) for i in face]
+        return mi.warp.spherical_triangle_solid_angle(a, b, c)
+
+    area = mesh.surface_area()
+    areas = [dr.norm(dr.cross(positions[f[1]] - positions[f[0]],
+                              positions[f[2]] - positions[f[0]])) / 2 for f in faces]
+
+    it = dr.zeros(mi.Interaction3f)
+    it.p = [0.2, 0.1, 1.0]
+
+    for xi_1 in dr.linspace(mi.Float, 1e-3, 1 - 1e-3, 10):
+        for xi_2 in dr.linspace(mi.Float, 1e-3, 1 - 1e-3, 10):
+            ds = mesh.sample_direction(it, [xi_1, xi_2])
+            expected = areas[ds.prim_index] / area / solid_angle(it.p, faces[ds.prim_index])
+            assert dr.allclose(ds.pdf, expected, rtol=1e-4)
+
+            # The density can be recovered from an intersection
+            si = scene.ray_intersect(mi.Ray3f(it.p, ds.d))
+            assert si.is_valid() and si.prim_index == ds.prim_index
+            assert dr.allclose(si.t, ds.dist, rtol=1e-4)
+            ds_si = mi.DirectionSample3f(scene, si, it)
+            assert dr.allclose(mesh.pdf_direction(it, ds_si), ds.pdf, rtol=1e-4)
+
+    # Distant reference points revert to area sampling
+    it.p = [0.1, 0.2, 1000]
+    ds = mesh.sample_direction(it, [0.3, 0.6])
+    area_pdf = dr.sqr(ds.dist) / (area * dr.abs_dot(ds.d, ds.n))
+    assert dr.allclose(ds.pdf, area_pdf)
+    assert dr.allclose(mesh.pdf_direction(it, ds), area_pdf)
@@ -24,6 +24,7 @@ def test01_position_sample_construction_single(variant_scalar_rgb):
   time = 0,
   pdf = 0.002,
   delta = 0,
+  prim_index = 0,
 ]"""
 
     # SurfaceInteraction constructor
@@ -90,6 +91,7 @@ def test04_direction_sample_construction_single(variant_scalar_rgb):
   time = 0,
   pdf = 0.002,
   delta = 0,
+  prim_index = 0,
   emitter = nullptr,
   d = [0, 42, -1],
   dist = 0.13
@@ -315,3 +315,149 @@ def test11_sample_silhouette_bijective(variants_vec_rgb):
     out = scene.invert_silhouette_sample(ss)
     assert dr.all(dr.neq(ss.discontinuity_type, mi.DiscontinuityFlags.Empty.value))
     assert dr.allclose(valid_samples, valid_out, atol=1e-6)
+
+
+@pytest.mark.parametrize('shape_type, hit_ratio', [('rectangle', 0.5),
+                                                   ('sphere', 0.75),
+                                                   ('cube', 0.75)])
+def test12_alpha_test_during_traversal(variant_scalar_rgb, shape_type, hit_ratio):
+    def make_scene(opacity):
+        return mi.load_dict({
+            'type': 'scene',
+            'alpha_test': True,
+            'shape': {
+                'type': shape_type,
+                'bsdf': {
+                    'type': 'mask',
+                    'opacity': opacity,
+                    'bsdf': { 'type': 'diffuse' }
+                }
+            }
+        })
+
+    ray = mi.Ray3f([0.1, 0.2, -5], [0, 0, 1])
+
+    # The mask BSDF is replaced by its nested BSDF
+    scene = make_scene(1.0)
+    shape = scene.shapes()[0]
+    assert shape.alpha_texture() is not None
+    assert not mi.has_flag(shape.bsdf().flags(), mi.BSDFFlags.Null)
+    assert scene.ray_test(ray)
+    assert scene.ray_intersect(ray).is_valid()
+
+    scene = make_scene(0.0)
+    assert not scene.ray_test(ray)
+    assert not scene.ray_intersect(ray).is_valid()
+
+    # Stochastic opacity: both sides of the sphere and faces of the cube are
+    # tested independently, matching the result of the mask BSDF
+    scene = make_scene(0.5)
+    sampler = mi.load_dict({'type': 'independent'})
+    sampler.seed(0)
+    n, hits, hits_shadow = 2000, 0, 0
+    for i in range(n):
+        o = mi.Point3f(*(0.5 * (mi.Point2f(sampler.next_2d()) - 0.5)), -5)
+        ray = mi.Ray3f(o, [0, 0, 1])
+        hits += scene.ray_intersect(ray).is_valid()
+        hits_shadow += scene.ray_test(ray)
+    assert abs(hits / n - hit_ratio) < 0.05
+    assert hits == hits_shadow
+
+
+def test13_ray_visibility(variants_all_backends_once):
+    if mi.variant().startswith('cuda'):
+        pytest.skip('Per-shape ray visibility is not supported by OptiX')
+
+    scene = mi.load_dict({
+        'type': 'scene',
+        'blocker': {
+            'type': 'rectangle',
+            'visible_camera': False,
+            'visible_shadow': False,
+        },
+        'wall': {
+            'type': 'rectangle',
+            'to_world': mi.ScalarTransform4f.translate([0, 0, 1]),
+        }
+    })
+
+    blocker, wall = scene.shapes()
+    if blocker.id() == 'wall':
+        blocker, wall = wall, blocker
+    assert blocker.ray_visibility() == (mi.RayFlags.DiffuseRay | mi.RayFlags.SpecularRay)
+    assert not blocker.is_visible(mi.RayFlags.CameraRay)
+    assert blocker.is_visible(mi.RayFlags.CameraRay | mi.RayFlags.DiffuseRay)
+    assert blocker.is_visible(mi.RayFlags.Empty)
+    assert wall.ray_visibility() == mi.RayFlags.RayTypes
+
+    ray = mi.Ray3f([0.1, 0.2, -5], [0, 0, 1])
+
+    # Rays without visibility flags intersect all shapes
+    si = scene.ray_intersect(ray)
+    assert dr.allclose(si.t, 5)
+    assert dr.allclose(scene.ray_intersect_preliminary(ray).t, 5)
+
+    for flags in [mi.RayFlags.CameraRay, mi.RayFlags.ShadowRay]:
+        si = scene.ray_intersect(ray, flags | mi.RayFlags.All, False)
+        assert dr.allclose(si.t, 6)
+        assert dr.allclose(scene.ray_intersect_preliminary(ray, flags, False).t, 6)
+
+    si = scene.ray_intersect(ray, mi.RayFlags.All | mi.RayFlags.DiffuseRay, False)
+    assert dr.allclose(si.t, 5)
+
+    # Shadow rays ignore the blocker, but not the wall
+    ray.maxt = 5.5
+    assert scene.ray_test(ray)
+    assert not scene.ray_test(ray, mi.RayFlags.ShadowRay, False)
+    assert scene.ray_test(ray, mi.RayFlags.SpecularRay, False)
+
+    # Per-lane ray types
+    if dr.is_jit_v(mi.Float):
+        ray = mi.Ray3f(mi.Point3f([0.1, 0.1, 0.1], [0.2, 0.2, 0.2], -5), [0, 0, 1])
+        ray_types = mi.UInt32([int(mi.RayFlags.CameraRay),
+                               int(mi.RayFlags.DiffuseRay), 0])
+        si = scene.ray_intersect(ray, mi.RayFlags.All, ray_types, False, True)
+        assert dr.allclose(si.t, [6, 5, 5])
+    else:
+        ray = mi.Ray3f([0.1, 0.2, -5], [0, 0, 1])
+        for ray_type, t in [(mi.RayFlags.CameraRay, 6), (mi.RayFlags.DiffuseRay, 5)]:
+            si = scene.ray_intersect(ray, mi.RayFlags.All, int(ray_type), False, True)
+            assert dr.allclose(si.t, t)
+
+
+@pytest.mark.parametrize('integrator', ['path', 'volpath', 'volpathmis', 'direct', 'prb'])
+def test14_ray_visibility_integrators(variants_all_backends_once, integrator):
+    if mi.variant().startswith('cuda'):
+        pytest.skip('Per-shape ray visibility is not supported by OptiX')
+    if integrator == 'prb' and not dr.is_diff_v(mi.Float):
+        pytest.skip('Differentiable integrators require an AD variant')
+
+    def render(**shapes):
+        scene = mi.load_dict({
+            'type': 'scene',
+            **shapes,
+            'emitter': {'type': 'constant'},
+            'sensor': {
+                'type': 'perspective',
+                'fov': 10,
+                'to_world': mi.ScalarTransform4f.look_at(origin=[0, 0, 4],
+                                                         target=[0, 0, 0],
+                                                         up=[0, 1, 0]),
+                'film': {'type': 'hdrfilm', 'width': 4, 'height': 4,
+                         'rfilter': {'type': 'box'}},
+                'sampler': {'type': 'independent', 'sample_count': 4},
+            },
+            'integrator': {'type': integrator},
+        })
+        return mi.TensorXf(mi.render(scene))
+
+    def blocker(visible_camera):
+        return {
+            'type': 'rectangle',
+            'visible_camera': visible_camera,
+            'bsdf': {'type': 'diffuse', 'reflectance': 0.0},
+        }
+
+    # The black blocker covers the entire image, unless camera rays skip it
+    assert dr.allclose(render(blocker=blocker(True)), 0.0)
+    assert dr.allclose(render(blocker=blocker(False)), render())
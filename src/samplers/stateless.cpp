@@ -0,0 +1,152 @@
+#include <mitsuba/core/profiler.h>
+#include <mitsuba/core/properties.h>
+#include <mitsuba/core/random.h>
+#include <mitsuba/core/spectrum.h>
+#include <mitsuba/render/sampler.h>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**!
+
+.. _sampler-stateless:
+
+Stateless independent sampler (:monosp:`stateless`)
+---------------------------------------------------
+
+.. pluginparameters::
+
+ * - sample_count
+   - |int|
+   - Number of samples per pixel (Default: 4)
+
+ * - seed
+   - |int|
+   - Seed offset (Default: 0)
+
+Like the :ref:`independent <sampler-independent>` sampler, this plugin produces
+a stream of independent and uniformly distributed pseudorandom numbers. However,
+it does not maintain any random number generator state. Instead, every call to
+``next_1d()`` or ``next_2d()`` evaluates a counter-based hash function
+(the ``pcg4d`` hash by Jarzynski and Olano) of the sequence index (i.e. the
+pixel within the current wavefront), the sample index, the dimension, and the
+seed.
+
+In JIT variants, the :ref:`independent <sampler-independent>` sampler stores
+the 64-bit state and increment of a PCG32 generator for every lane of the
+wavefront, which amounts to gigabytes of memory for wavefronts containing
+hundreds of millions of samples, and this state must be read and written by
+every rendering kernel. The stateless sampler only depends on the lane index
+and a few scalar counters, hence it requires no per-lane memory at all. This
+makes it a good choice for very large wavefronts.
+
+Results are fully deterministic: they only depend on the seed and on the
+position of each sample in the wavefront, and distinct lanes, samples, and
+dimensions produce decorrelated values.
+
+.. tabs::
+    .. code-tab:: xml
+        :name: stateless-sampler
+
+        <sampler type="stateless">
+            <integer name="sample_count" value="64"/>
+        </sampler>
+
+    .. code-tab:: python
+
+        'type': 'stateless',
+        'sample_count': '64'
+
+ */
+
+template <typename Float, typename Spectrum>
+class StatelessSampler final : public Sampler<Float, Spectrum> {
+public:
+    MI_IMPORT_BASE(Sampler, m_sample_count, m_base_seed, seeded,
+                   m_samples_per_wavefront, m_wavefront_size,
+                   m_dimension_index, current_sample_index)
+    MI_IMPORT_TYPES()
+
+    StatelessSampler(const Properties &props) : Base(props) { }
+
+    ref<Sampler<Float, Spectrum>> fork() override {
+        StatelessSampler *sampler = new StatelessSampler(Properties());
+        sampler->m_sample_count          = m_sample_count;
+        sampler->m_samples_per_wavefront = m_samples_per_wavefront;
+        sampler->m_base_seed             = m_base_seed;
+        return sampler;
+    }
+
+    ref<Sampler<Float, Spectrum>> clone() override {
+        return new StatelessSampler(*this);
+    }
+
+    void seed(uint32_t seed, uint32_t wavefront_size) override {
+        Base::seed(seed, wavefront_size);
+        // Scalar counter (not a per-lane array), which avoids recompilation
+        m_seed = dr::opaque<UInt32>(m_base_seed + seed);
+    }
+
+    Float next_1d(Mask /*active*/ = true) override {
+        Assert(seeded());
+        auto v = hash();
+        return to_float(v[0], v[1]);
+    }
+
+    Point2f next_2d(Mask /*active*/ = true) override {
+        Assert(seeded());
+        auto v = hash();
+        return Point2f(to_float(v[0], v[1]), to_float(v[2], v[3]));
+    }
+
+    void schedule_state() override {
+        Base::schedule_state();
+        dr::schedule(m_seed);
+    }
+
+    std::string to_string() const override {
+        std::ostringstream oss;
+        oss << "StatelessSampler[" << std::endl
+            << "  base_seed = " << m_base_seed << std::endl
+            << "  sample_count = " << m_sample_count << std::endl
+            << "  samples_per_wavefront = " << m_samples_per_wavefront << std::endl
+            << "  wavefront_size = " << m_wavefront_size << std::endl
+            << "]";
+        return oss.str();
+    }
+
+    MI_DECLARE_CLASS()
+
+private:
+    StatelessSampler(const StatelessSampler &sampler) : Base(sampler) {
+        m_seed = sampler.m_seed;
+    }
+
+    /// Hash the sequence index, sample index, dimension and seed (consumes one dimension)
+    std::array<UInt32, 4> hash() {
+        UInt32 sequence_idx = 0;
+        if constexpr (dr::is_array_v<Float>)
+            sequence_idx = dr::arange<UInt32>(m_wavefront_size) / m_samples_per_wavefront;
+
+        return sample_pcg4d<UInt32>(sequence_idx, current_sample_index(),
+                                    m_dimension_index++, m_seed);
+    }
+
+    /// Map random bits to a value on the interval [0, 1) (\c v1 is only used in double precision)
+    static Float to_float(const UInt32 &v0, const UInt32 &v1) {
+        if constexpr (std::is_same_v<ScalarFloat, double>) {
+            using UInt64 = dr::uint64_array_t<UInt32>;
+            UInt64 v = UInt64(v0) + dr::sl<32>(UInt64(v1));
+            return dr::reinterpret_array<Float>(dr::sr<12>(v) | 0x3ff0000000000000ull) - 1.0;
+        } else {
+            DRJIT_MARK_USED(v1);
+            return dr::reinterpret_array<Float>(dr::sr<9>(v0) | 0x3f800000u) - 1.f;
+        }
+    }
+
+    /// Seed of the current sequence (a scalar, not a per-lane array)
+    UInt32 m_seed;
+};
+
+MI_IMPLEMENT_CLASS_VARIANT(StatelessSampler, Sampler)
+MI_EXPORT_PLUGIN(StatelessSampler, "Stateless Sampler");
+NAMESPACE_END(mitsuba)
@@ -0,0 +1,95 @@
+import pytest
+import drjit as dr
+import mitsuba as mi
+
+from .utils import check_deep_copy_sampler_scalar, check_deep_copy_sampler_wavefront
+
+
+def test01_construct(variant_scalar_rgb):
+    sampler = mi.load_dict({
+        "type": "stateless",
+        "sample_count": 58
+    })
+    assert sampler is not None
+    assert sampler.sample_count() == 58
+
+
+def test02_pcg4d_reference(variant_scalar_rgb):
+    # Reference implementation from "Hash Functions for GPU Rendering"
+    def pcg4d(v):
+        m = 0xffffffff
+        v = [(x * 1664525 + 1013904223) & m for x in v]
+        def mix(v):
+            v[0] = (v[0] + v[1] * v[3]) & m
+            v[1] = (v[1] + v[2] * v[0]) & m
+            v[2] = (v[2] + v[0] * v[1]) & m
+            v[3] = (v[3] + v[1] * v[2]) & m
+        mix(v)
+        v = [x ^ (x >> 16) for x in v]
+        mix(v)
+        return v
+
+    for v in [(0, 0, 0, 0), (1, 2, 3, 4), (123456, 7, 0xffffffff, 42)]:
+        assert list(mi.sample_pcg4d(*v)) == pcg4d(list(v))
+
+
+def test03_deterministic_scalar(variant_scalar_rgb):
+    sampler = mi.load_dict({"type": "stateless", "sample_count": 8})
+
+    def draw(seed):
+        sampler.seed(seed)
+        values = []
+        for i in range(4):
+            values.append(sampler.next_1d())
+            values.append(sampler.next_2d()[1])
+            sampler.advance()
+        return values
+
+    v0 = draw(0)
+    assert v0 == draw(0)
+    assert len(set(v0)) == len(v0)
+    assert all(0 <= v < 1 for v in v0)
+    assert v0 != draw(1)
+
+
+def test04_wavefront_statistics(variants_vec_backends_once):
+    sampler = mi.load_dict({"type": "stateless", "sample_count": 4})
+    sampler.set_samples_per_wavefront(4)
+    n = 1 << 16
+    sampler.seed(0, n)
+
+    v1 = sampler.next_1d()
+    v2 = sampler.next_2d()
+
+    for v in [v1, v2.x, v2.y]:
+        assert dr.all((v >= 0) & (v < 1))
+        assert dr.allclose(dr.mean(v), 0.5, atol=1e-2)
+        assert dr.allclose(dr.mean(v * v), 1.0 / 3.0, atol=1e-2)
+
+    # Dimensions and lanes are decorrelated
+    assert dr.allclose(dr.mean(v1 * v2.x), 0.25, atol=1e-2)
+    assert dr.allclose(dr.mean(v2.x * v2.y), 0.25, atol=1e-2)
+    v1_np = v1.numpy()
+    assert abs((v1_np[1:] * v1_np[:-1]).mean() - 0.25) < 1e-2
+
+    # Re-seeding reproduces the same sequence
+    sampler.seed(0, n)
+    assert dr.all(sampler.next_1d() == v1)
+
+
+def test05_copy_sampler_scalar(variants_any_scalar):
+    sampler = mi.load_dict({
+        "type": "stateless",
+        "sample_count": 1024
+    })
+
+    check_deep_copy_sampler_scalar(sampler)
+
+
+def test06_copy_sampler_wavefront(variants_vec_backends_once):
+    sampler = mi.load_dict({
+        "type": "stateless",
+        "sample_count": 1024
+    })
+
+    check_deep_copy_sampler_wavefront(sampler)
@@ -55,6 +55,13 @@ surface normal points into the positive Z-direction.
 To change the disk scale, rotation, or translation, use the
 :monosp:`to_world` parameter.
 
+When the disk is used as an area emitter, direct illumination samples are drawn
+uniformly within the solid angle subtended by its bounding square (following
+Ureña et al. :cite:`Urena2013Spherical`), and the directions that miss the disk
+are discarded. This reduces variance for large light sources that are close to
+the receivers. Distant or tiny disks and disks with a sheared
+:monosp:`to_world` transformation are sampled by area instead.
+
 The following XML snippet instantiates an example of a textured disk shape:
 
 .. tabs::
@@ -88,7 +95,8 @@ class Disk final : public Shape<Float, Spectrum> {
 public:
     MI_IMPORT_BASE(Shape, m_to_world, m_to_object, m_is_instance,
                    m_discontinuity_types, m_shape_type, initialize, mark_dirty,
-                   get_children_string, parameters_grad_enabled)
+                   get_children_string, parameters_grad_enabled,
+                   SolidAngleSamplingMin, SolidAngleSamplingMax)
     MI_IMPORT_TYPES()
 
     using typename Base::ScalarIndex;
@@ -123,6 +131,12 @@ public:
         m_frame = Frame3f(dp_du / m_du, dp_dv / m_dv, n);
         m_inv_surface_area = dr::rcp(surface_area());
 
+        // Solid angle sampling requires orthogonal axes (no shearing)
+        ScalarVector3f ex = m_to_world.scalar() * ScalarVector3f(1.f, 0.f, 0.f),
+                       ey = m_to_world.scalar() * ScalarVector3f(0.f, 1.f, 0.f);
+        m_solid_angle_sampling =
+            dr::abs(dr::dot(ex, ey)) <= 1e-4f * dr::norm(ex) * dr::norm(ey);
+
         dr::make_opaque(m_frame, m_inv_surface_area);
         mark_dirty();
    }
@@ -196,6 +210,80 @@ public:
         return m_inv_surface_area;
     }
 
+    DirectionSample3f sample_direction(const Interaction3f &it, const Point2f &sample,
+                                       Mask active) const override {
+        MI_MASK_ARGUMENT(active);
+
+        if (!m_solid_angle_sampling)
+            return Base::sample_direction(it, sample, active);
+
+        DirectionSample3f result = dr::zeros<DirectionSample3f>();
+
+        /* Uniformly sample the solid angle subtended by the square that
+           bounds the disk. Directions that miss the disk are rejected. */
+        Vector3f o  = m_to_world.value().transform_affine(Point3f(-1.f, -1.f, 0.f)) - it.p,
+                 ex = m_frame.s * (2.f * m_du),
+                 ey = m_frame.t * (2.f * m_dv);
+        Float solid_angle = warp::spherical_rectangle_solid_angle(o, ex, ey);
+
+        Mask solid_angle_mask = active &&
+                                solid_angle > SolidAngleSamplingMin &&
+                                solid_angle < SolidAngleSamplingMax;
+
+        if (likely(dr::any_or<true>(solid_angle_mask))) {
+            Vector3f local = warp::square_to_uniform_spherical_rectangle(
+                                 sample, o, ex, ey) - o;
+
+            // Position within the bounding square [-1, 1]^2
+            Point2f p(dr::fmsub(dr::dot(local, ex), 2.f * dr::rcp(dr::squared_norm(ex)), 1.f),
+                      dr::fmsub(dr::dot(local, ey), 2.f * dr::rcp(dr::squared_norm(ey)), 1.f));
+            Float r2 = dr::squared_norm(p);
+
+            DirectionSample3f ds = dr::zeros<DirectionSample3f>();
+            ds.p     = m_to_world.value().transform_affine(Point3f(p.x(), p.y(), 0.f));
+            ds.n     = m_frame.n;
+            ds.time  = it.time;
+            ds.delta = false;
+            ds.d     = ds.p - it.p;
+            ds.dist  = dr::norm(ds.d);
+            ds.d    /= ds.dist;
+            ds.pdf   = dr::select(r2 <= 1.f, dr::rcp(solid_angle), 0.f);
+
+            Float v = dr::atan2(p.y(), p.x()) * dr::InvTwoPi<Float>;
+            dr::masked(v, v < 0.f) += 1.f;
+            ds.uv = Point2f(dr::sqrt(r2), v);
+
+            dr::masked(result, solid_angle_mask) = ds;
+        }
+
+        // Distant or tiny disks: fall back to area sampling
+        Mask area_mask = dr::andnot(active, solid_angle_mask);
+        if (unlikely(dr::any_or<true>(area_mask)))
+            dr::masked(result, area_mask) =
+                Base::sample_direction(it, sample, area_mask);
+
+        return result;
+    }
+
+    Float pdf_direction(const Interaction3f &it, const DirectionSample3f &ds,
+                        Mask active) const override {
+        MI_MASK_ARGUMENT(active);
+
+        if (!m_solid_angle_sampling)
+            return Base::pdf_direction(it, ds, active);
+
+        Vector3f o  = m_to_world.value().transform_affine(Point3f(-1.f, -1.f, 0.f)) - it.p,
+                 ex = m_frame.s * (2.f * m_du),
+                 ey = m_frame.t * (2.f * m_dv);
+        Float solid_angle = warp::spherical_rectangle_solid_angle(o, ex, ey);
+
+        Mask solid_angle_mask = solid_angle > SolidAngleSamplingMin &&
+                                solid_angle < SolidAngleSamplingMax;
+
+        return dr::select(solid_angle_mask, dr::rcp(solid_angle),
+                          Base::pdf_direction(it, ds, active));
+    }
+
 
     SurfaceInteraction3f eval_parameterization(const Point2f &uv,
                                                uint32_t ray_flags,
@@ -554,6 +642,7 @@ private:
     Frame3f m_frame;
     Float m_du, m_dv;
     Float m_inv_surface_area;
+    bool m_solid_angle_sampling;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(Disk, Shape)
@@ -1,5 +1,6 @@
 #include <mitsuba/render/mesh.h>
 #include <mitsuba/core/fresolver.h>
+#include <mitsuba/core/shmem.h>
 #include <mitsuba/core/fstream.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/mmap.h>
@@ -133,7 +134,9 @@ public:
     MI_IMPORT_BASE(Mesh, m_name, m_bbox, m_to_world, m_vertex_count,
                     m_face_count, m_vertex_positions, m_vertex_normals,
                     m_vertex_texcoords, m_faces, m_face_normals,
-                    recompute_vertex_normals, has_vertex_normals, initialize)
+                    recompute_vertex_normals, has_vertex_normals, initialize,
+                    shared_cache_key, load_from_shared_cache,
+                    publish_to_shared_cache)
     MI_IMPORT_TYPES()
 
     using typename Base::ScalarSize;
@@ -164,6 +167,15 @@ public:
         if (!fs::exists(file_path))
             fail("file not found");
 
+        std::string shared_key;
+        if (SharedMemoryRegion::enabled()) {
+            shared_key = shared_cache_key(file_path, tfm::format("obj|%i", flip_tex_coords));
+            if (load_from_shared_cache(shared_key)) {
+                initialize();
+                return;
+            }
+        }
+
         ScopedPhase phase(ProfilerPhase::LoadGeometry);
 
         using ScalarIndex3 = std::array<ScalarIndex, 3>;
@@ -405,6 +417,9 @@ public:
                 util::time_string((float) timer2.value()));
         }
 
+        if (!shared_key.empty())
+            publish_to_shared_cache(shared_key);
+
         initialize();
     }
 
@@ -2,6 +2,7 @@
 #include <mitsuba/core/fstream.h>
 #include <mitsuba/core/mstream.h>
 #include <mitsuba/core/fresolver.h>
+#include <mitsuba/core/shmem.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/util.h>
 #include <mitsuba/core/timer.h>
@@ -134,7 +135,8 @@ public:
                    m_vertex_texcoords, m_faces, add_attribute,
                    m_face_normals, has_vertex_normals,
                    has_vertex_texcoords, recompute_vertex_normals,
-                   initialize)
+                   initialize, shared_cache_key, load_from_shared_cache,
+                   publish_to_shared_cache)
     MI_IMPORT_TYPES()
 
     using typename Base::ScalarSize;
@@ -184,6 +186,15 @@ public:
         if (!fs::exists(file_path))
             fail("file not found");
 
+        std::string shared_key;
+        if (SharedMemoryRegion::enabled()) {
+            shared_key = shared_cache_key(file_path, tfm::format("ply|%i", flip_tex_coords));
+            if (load_from_shared_cache(shared_key)) {
+                initialize();
+                return;
+            }
+        }
+
         ref<Stream> stream = new FileStream(file_path);
         ScopedPhase phase(ProfilerPhase::LoadGeometry);
         Timer timer;
@@ -448,6 +459,9 @@ public:
                 util::time_string((float) timer2.value()));
         }
 
+        if (!shared_key.empty())
+            publish_to_shared_cache(shared_key);
+
         initialize();
     }
 
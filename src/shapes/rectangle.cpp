@@ -55,6 +55,13 @@ and has a surface normal that points into the positive Z-direction.
 To change the rectangle scale, rotation, or translation, use the
 :monosp:`to_world` parameter.
 
+When the rectangle is used as an area emitter, direct illumination samples are
+drawn uniformly within the solid angle it subtends from the shading point
+(following Ureña et al. :cite:`Urena2013Spherical`). This considerably reduces
+variance for large light sources that are close to the receivers (e.g.,
+softboxes or ceiling panels). Distant or tiny rectangles and rectangles with a
+sheared :monosp:`to_world` transformation are sampled by area instead.
+
 
 The following XML snippet showcases a simple example of a textured rectangle:
 
@@ -90,7 +97,8 @@ class Rectangle final : public Shape<Float, Spectrum> {
 public:
     MI_IMPORT_BASE(Shape, m_to_world, m_to_object, m_is_instance,
                    m_discontinuity_types, m_shape_type, initialize, mark_dirty,
-                   get_children_string, parameters_grad_enabled)
+                   get_children_string, parameters_grad_enabled,
+                   SolidAngleSamplingMin, SolidAngleSamplingMax)
     MI_IMPORT_TYPES()
 
     using typename Base::ScalarSize;
@@ -121,6 +129,12 @@ public:
         m_frame = Frame3f(dp_du, dp_dv, normal);
         m_inv_surface_area = dr::rcp(surface_area());
 
+        // Solid angle sampling requires orthogonal edges (no shearing)
+        ScalarVector3f ex = m_to_world.scalar() * ScalarVector3f(1.f, 0.f, 0.f),
+                       ey = m_to_world.scalar() * ScalarVector3f(0.f, 1.f, 0.f);
+        m_solid_angle_sampling =
+            dr::abs(dr::dot(ex, ey)) <= 1e-4f * dr::norm(ex) * dr::norm(ey);
+
         dr::make_opaque(m_frame, m_inv_surface_area);
         mark_dirty();
     }
@@ -184,6 +198,73 @@ public:
         return m_inv_surface_area;
     }
 
+    DirectionSample3f sample_direction(const Interaction3f &it, const Point2f &sample,
+                                       Mask active) const override {
+        MI_MASK_ARGUMENT(active);
+
+        if (!m_solid_angle_sampling)
+            return Base::sample_direction(it, sample, active);
+
+        DirectionSample3f result = dr::zeros<DirectionSample3f>();
+
+        Vector3f o = m_to_world.value().transform_affine(Point3f(-1.f, -1.f, 0.f)) - it.p;
+        Float solid_angle = warp::spherical_rectangle_solid_angle(o, m_frame.s, m_frame.t);
+
+        Mask solid_angle_mask = active &&
+                                solid_angle > SolidAngleSamplingMin &&
+                                solid_angle < SolidAngleSamplingMax;
+
+        if (likely(dr::any_or<true>(solid_angle_mask))) {
+            Vector3f rel = warp::square_to_uniform_spherical_rectangle(
+                sample, o, m_frame.s, m_frame.t);
+
+            // Project onto the edges to recover the UV coordinates
+            Vector3f local = rel - o;
+            Point2f uv(dr::dot(local, m_frame.s) * dr::rcp(dr::squared_norm(m_frame.s)),
+                       dr::dot(local, m_frame.t) * dr::rcp(dr::squared_norm(m_frame.t)));
+            uv = dr::clamp(uv, 0.f, 1.f);
+
+            DirectionSample3f ds = dr::zeros<DirectionSample3f>();
+            ds.p = m_to_world.value().transform_affine(
+                Point3f(dr::fmsub(uv.x(), 2.f, 1.f), dr::fmsub(uv.y(), 2.f, 1.f), 0.f));
+            ds.n     = m_frame.n;
+            ds.uv    = uv;
+            ds.time  = it.time;
+            ds.delta = false;
+            ds.d     = ds.p - it.p;
+            ds.dist  = dr::norm(ds.d);
+            ds.d    /= ds.dist;
+            ds.pdf   = dr::rcp(solid_angle);
+
+            dr::masked(result, solid_angle_mask) = ds;
+        }
+
+        // Distant or tiny rectangles: fall back to area sampling
+        Mask area_mask = dr::andnot(active, solid_angle_mask);
+        if (unlikely(dr::any_or<true>(area_mask)))
+            dr::masked(result, area_mask) =
+                Base::sample_direction(it, sample, area_mask);
+
+        return result;
+    }
+
+    Float pdf_direction(const Interaction3f &it, const DirectionSample3f &ds,
+                        Mask active) const override {
+        MI_MASK_ARGUMENT(active);
+
+        if (!m_solid_angle_sampling)
+            return Base::pdf_direction(it, ds, active);
+
+        Vector3f o = m_to_world.value().transform_affine(Point3f(-1.f, -1.f, 0.f)) - it.p;
+        Float solid_angle = warp::spherical_rectangle_solid_angle(o, m_frame.s, m_frame.t);
+
+        Mask solid_angle_mask = solid_angle > SolidAngleSamplingMin &&
+                                solid_angle < SolidAngleSamplingMax;
+
+        return dr::select(solid_angle_mask, dr::rcp(solid_angle),
+                          Base::pdf_direction(it, ds, active));
+    }
+
     SurfaceInteraction3f eval_parameterization(const Point2f &uv,
                                                uint32_t ray_flags,
                                                Mask active) const override {
@@ -602,6 +683,7 @@ public:
 private:
     Frame3f m_frame;
     Float m_inv_surface_area;
+    bool m_solid_angle_sampling;
 };
 
 MI_IMPLEMENT_CLASS_VARIANT(Rectangle, Shape)
@@ -2,6 +2,7 @@
 #include <mitsuba/core/fstream.h>
 #include <mitsuba/core/zstream.h>
 #include <mitsuba/core/fresolver.h>
+#include <mitsuba/core/shmem.h>
 #include <mitsuba/core/properties.h>
 #include <mitsuba/core/timer.h>
 #include <mitsuba/core/profiler.h>
@@ -207,7 +208,8 @@ public:
                     m_vertex_texcoords, m_faces, m_face_normals,
                     has_vertex_normals, has_vertex_texcoords,
                     recompute_vertex_normals, vertex_position, vertex_normal,
-                    initialize)
+                    initialize, shared_cache_key, load_from_shared_cache,
+                    publish_to_shared_cache)
     MI_IMPORT_TYPES()
 
     using typename Base::ScalarSize;
@@ -254,6 +256,15 @@ public:
 
         m_name = tfm::format("%s@%i", file_path.filename(), shape_index);
 
+        std::string shared_key;
+        if (SharedMemoryRegion::enabled()) {
+            shared_key = shared_cache_key(file_path, tfm::format("serialized|%i", shape_index));
+            if (load_from_shared_cache(shared_key)) {
+                initialize();
+                return;
+            }
+        }
+
         ref<Stream> stream = new FileStream(file_path);
         ScopedPhase phase(ProfilerPhase::LoadGeometry);
         Timer timer;
@@ -400,6 +411,9 @@ public:
                 util::time_string((float) timer2.value()));
         }
 
+        if (!shared_key.empty())
+            publish_to_shared_cache(shared_key);
+
         initialize();
     }
 
@@ -423,3 +423,42 @@ def test16_sample_precomputed_silhouette(variants_vec_rgb):
 def test17_shape_type(variant_scalar_rgb):
     disk = mi.load_dict({ 'type': 'disk' })
     assert disk.shape_type() == mi.ShapeType.Disk.value;
+
+
+def test18_sample_direction(variant_scalar_rgb):
+    disk = mi.load_dict({
+        'type': 'disk',
+        'to_world': mi.ScalarTransform4f.scale((1.5, 0.5, 1.0))
+    })
+
+    it = dr.zeros(mi.Interaction3f)
+    it.p = [0.3, -0.2, 0.8]
+    solid_angle = mi.warp.spherical_rectangle_solid_angle(
+        mi.Vector3f(-1.5, -0.5, 0) - it.p, [3, 0, 0], [0, 1, 0])
+
+    hits = 0
+    for xi_1 in dr.linspace(Float, 1e-3, 1 - 1e-3, 10):
+        for xi_2 in dr.linspace(Float, 1e-3, 1 - 1e-3, 10):
+            ds = disk.sample_direction(it, [xi_1, xi_2])
+            si = disk.ray_intersect(mi.Ray3f(it.p, ds.d))
+
+            # Directions that miss the disk are rejected
+            if ds.pdf == 0:
+                assert not si.is_valid()
+                continue
+
+            hits += 1
+            assert dr.allclose(ds.pdf, 1 / solid_angle)
+            assert dr.allclose(disk.pdf_direction(it, ds), ds.pdf)
+            assert si.is_valid()
+            assert dr.allclose(si.t, ds.dist, rtol=1e-4)
+            assert dr.allclose(si.p, ds.p, atol=1e-4)
+
+    assert hits > 50
+
+    # Distant reference points revert to area sampling
+    it.p = [0.1, 0.2, 1000]
+    ds = disk.sample_direction(it, [0.3, 0.6])
+    area_pdf = dr.sqr(ds.dist) / (0.75 * dr.pi * dr.abs(ds.d.z))
+    assert dr.allclose(ds.pdf, area_pdf)
+    assert dr.allclose(disk.pdf_direction(it, ds), area_pdf)
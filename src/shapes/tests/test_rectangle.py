@@ -424,3 +424,34 @@ def test17_sample_precomputed_silhouette(variants_vec_rgb):
 def test18_shape_type(variant_scalar_rgb):
     rectangle = mi.load_dict({ 'type': 'rectangle' })
     assert rectangle.shape_type() == mi.ShapeType.Rectangle.value;
+
+
+def test19_sample_direction(variant_scalar_rgb):
+    rectangle = mi.load_dict({
+        'type': 'rectangle',
+        'to_world': mi.ScalarTransform4f.scale((1.5, 0.5, 1.0))
+    })
+
+    it = dr.zeros(mi.Interaction3f)
+    it.p = [0.3, -0.2, 0.8]
+    solid_angle = mi.warp.spherical_rectangle_solid_angle(
+        mi.Vector3f(-1.5, -0.5, 0) - it.p, [3, 0, 0], [0, 1, 0])
+
+    for xi_1 in dr.linspace(Float, 1e-3, 1 - 1e-3, 10):
+        for xi_2 in dr.linspace(Float, 1e-3, 1 - 1e-3, 10):
+            ds = rectangle.sample_direction(it, [xi_1, xi_2])
+            assert dr.allclose(ds.pdf, 1 / solid_angle)
+            assert dr.allclose(rectangle.pdf_direction(it, ds), ds.pdf)
+
+            si = rectangle.ray_intersect(mi.Ray3f(it.p, ds.d))
+            assert si.is_valid()
+            assert dr.allclose(si.t, ds.dist, rtol=1e-4)
+            assert dr.allclose(si.p, ds.p, atol=1e-4)
+            assert dr.allclose(si.uv, ds.uv, atol=1e-4)
+
+    # Distant reference points revert to area sampling
+    it.p = [0.1, 0.2, 1000]
+    ds = rectangle.sample_direction(it, [0.3, 0.6])
+    area_pdf = dr.sqr(ds.dist) / (3 * dr.abs(ds.d.z))
+    assert dr.allclose(ds.pdf, area_pdf)
+    assert dr.allclose(rectangle.pdf_direction(it, ds), area_pdf)
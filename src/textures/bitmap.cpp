@@ -2,6 +2,7 @@
 #include <mitsuba/core/fresolver.h>
 #include <mitsuba/core/plugin.h>
 #include <mitsuba/core/properties.h>
+#include <mitsuba/core/shmem.h>
 #include <mitsuba/core/spectrum.h>
 #include <mitsuba/core/distr_2d.h>
 #include <mitsuba/render/interaction.h>
@@ -124,6 +125,7 @@ public:
 
         ref<Bitmap> bitmap = nullptr;
         TensorXf* tensor = nullptr;
+        fs::path file_path;
 
         if (props.has_property("bitmap")) {
             // Creates a Bitmap texture directly from an existing Bitmap object
@@ -139,10 +141,9 @@ public:
         } else if (props.has_property("filename")) {
             // Creates a Bitmap texture by loading an image from the filesystem
             FileResolver* fs = Thread::thread()->file_resolver();
-            fs::path file_path = fs->resolve(props.string("filename"));
+            file_path = fs->resolve(props.string("filename"));
             m_name = file_path.filename().string();
             Log(Debug, "Loading bitmap texture from \"%s\" ..", m_name);
-            bitmap = new Bitmap(file_path);
         } else if (props.has_property("data")) {
             tensor = props.tensor<TensorXf>("data");
             if (tensor->ndim() != 3)
@@ -180,6 +181,16 @@ public:
         m_raw = props.get<bool>("raw", false);
         m_accel = props.get<bool>("accel", true);
 
+        // Look up the decoded texture in the node-level shared memory cache
+        std::string shared_key;
+        if (!file_path.empty() && SharedMemoryRegion::enabled()) {
+            shared_key = SharedMemoryRegion::make_key(tfm::format(
+                "bitmap|%s|%s|%i", detail::get_variant<Float, Spectrum>(),
+                SharedMemoryRegion::file_descriptor(file_path), m_raw));
+            if (load_from_shared_cache(shared_key, filter_mode, wrap_mode))
+                return;
+        }
+
         if (tensor) {
             Log(Debug, "Loading bitmap texture from tensor...");
             if (!m_raw)
@@ -187,7 +198,7 @@ public:
                       "initializing using tensor data! Use a `Bitmap` "
                       "object or a file if transformation of color data is "
                       "required.");
-            m_texture = Texture2f(TensorXf(*tensor), m_accel, m_accel, filter_mode, wrap_mode);
+            m_texture = Texture2f(*tensor, m_accel, m_accel, filter_mode, wrap_mode);
             const size_t pixel_count = tensor->shape(1) * tensor->shape(0);
             const size_t ch_count = tensor->shape(2);
 
@@ -210,6 +221,9 @@ public:
                 m_mean = dr::sum(tensor->array()) / pixel_count;
 
         } else {
+            if (!bitmap)
+                bitmap = new Bitmap(file_path);
+
             /* Convert to linear RGB float bitmap, will be converted
                into spectral profile coefficients below (in place) */
             Bitmap::PixelFormat pixel_format = bitmap->pixel_format();
@@ -302,6 +316,12 @@ public:
             size_t shape[3] = { (size_t) res.y(), (size_t) res.x(), channels };
             m_texture = Texture2f(TensorXf(bitmap->data(), 3, shape), m_accel,
                                   m_accel, filter_mode, wrap_mode);
+
+            if (!shared_key.empty()) {
+                // Reference the published copy instead of the private one
+                if (publish_to_shared_cache(shared_key, bitmap, mean / pixel_count))
+                    load_from_shared_cache(shared_key, filter_mode, wrap_mode);
+            }
         }
     }
 
@@ -775,6 +795,75 @@ protected:
                 m_name);
     }
 
+    /// Header of a texture published to the node-level shared memory cache
+    struct SharedTextureHeader {
+        uint64_t height, width, channels;
+        double mean;
+    };
+
+    /// Initialize the texture from the node-level shared memory cache
+    bool load_from_shared_cache(const std::string &key,
+                                dr::FilterMode filter_mode,
+                                dr::WrapMode wrap_mode) {
+        ref<SharedMemoryRegion> region = SharedMemoryRegion::open(key);
+        if (!region)
+            return false;
+
+        auto corrupt = [&]() {
+            Log(Warn, "\"%s\": ignoring corrupt shared memory cache entry \"%s\".",
+                m_name, key);
+            return false;
+        };
+
+        SharedTextureHeader header;
+        size_t offset = SharedMemoryRegion::align(sizeof(SharedTextureHeader));
+        if (region->size() < offset)
+            return corrupt();
+        memcpy(&header, region->data(), sizeof(SharedTextureHeader));
+
+        // Reject sizes that would overflow the computation below
+        size_t available = (region->size() - offset) / sizeof(ScalarFloat);
+        if (header.height == 0 || header.width == 0 ||
+            (header.channels != 1 && header.channels != 3) ||
+            header.width > available / header.height ||
+            header.width * header.height > available / header.channels)
+            return corrupt();
+        size_t count = header.height * header.width * header.channels;
+
+        size_t shape[3] = { (size_t) header.height, (size_t) header.width,
+                            (size_t) header.channels };
+        m_texture = Texture2f(
+            TensorXf(region->view<DynamicBuffer<Float>>(offset, count), 3, shape),
+            m_accel, m_accel, filter_mode, wrap_mode);
+        m_mean = Float(header.mean);
+
+        // JIT arrays keep the region mapped by themselves
+        if constexpr (!dr::is_jit_v<Float>)
+            m_shared_region = region;
+
+        Log(Debug, "\"%s\": mapped texture from the shared memory cache", m_name);
+        return true;
+    }
+
+    /// Publish the decoded texture to the node-level shared memory cache
+    bool publish_to_shared_cache(const std::string &key, const Bitmap *bitmap,
+                                 double mean) {
+        SharedTextureHeader header { bitmap->height(), bitmap->width(),
+                                     bitmap->channel_count(), mean };
+        size_t offset = SharedMemoryRegion::align(sizeof(SharedTextureHeader));
+
+        ref<SharedMemoryRegion> region =
+            SharedMemoryRegion::create(key, offset + bitmap->buffer_size());
+        if (!region)
+            return false;
+
+        uint8_t *ptr = (uint8_t *) region->data();
+        memcpy(ptr, &header, sizeof(SharedTextureHeader));
+        memcpy(ptr + offset, bitmap->data(), bitmap->buffer_size());
+        region->publish();
+        return true;
+    }
+
     /// Construct 2D distribution upon first access, avoid races
     MI_INLINE void init_distr() const {
         std::lock_guard<std::mutex> lock(m_mutex);
@@ -792,6 +881,9 @@ protected:
     Float m_mean;
     std::string m_name;
 
+    /// Shared memory region backing the texture data (scalar variants)
+    ref<SharedMemoryRegion> m_shared_region;
+
     // Optional: distribution for importance sampling
     mutable std::mutex m_mutex;
     std::unique_ptr<DiscreteDistribution2D<Float>> m_distr2d;
@@ -0,0 +1,520 @@
+#include <mitsuba/render/texture.h>
+#include <mitsuba/render/interaction.h>
+#include <mitsuba/core/properties.h>
+#include <mitsuba/core/string.h>
+#include <mitsuba/core/transform.h>
+
+NAMESPACE_BEGIN(mitsuba)
+
+/**!
+
+.. _texture-noise:
+
+Procedural noise texture (:monosp:`noise`)
+------------------------------------------
+
+.. pluginparameters::
+
+ * - noise_type
+   - |string|
+   - Basis function of the noise. The following options are currently available:
+
+     - ``perlin`` (default): Perlin gradient noise :cite:`Perlin2002Improving`.
+
+     - ``simplex``: Simplex noise, which has fewer directional artifacts and
+       is cheaper to evaluate in 3D :cite:`Gustavson2005Simplex`.
+
+     - ``worley``: Distance to the closest feature point of a cellular
+       pattern, with one random feature point per unit cell
+       :cite:`Worley1996Cellular`.
+
+ * - fractal
+   - |string|
+   - Specifies how multiple octaves of the noise are combined:
+
+     - ``fbm`` (default): fractional Brownian motion, i.e. a sum of the
+       octaves. With a single octave, this is the plain basis noise.
+
+     - ``turbulence``: sum of the absolute values of the octaves, which
+       produces creases where the noise crosses zero.
+
+ * - octaves
+   - |int|
+   - Number of octaves. (Default: 1)
+
+ * - lacunarity
+   - |float|
+   - Frequency ratio between consecutive octaves. (Default: 2)
+
+ * - gain
+   - |float|
+   - Amplitude ratio between consecutive octaves. (Default: 0.5)
+
+ * - seed
+   - |int|
+   - Seed of the random pattern. (Default: 0)
+
+ * - domain
+   - |string|
+   - Domain in which the noise is evaluated. ``uv`` (default) evaluates 2D
+     noise in texture space, ``position`` evaluates 3D noise at the position
+     of the interaction, which doesn't require a UV parameterization.
+
+ * - color0, color1
+   - |spectrum| or |texture|
+   - Values that are blended according to the noise. (Default: 0 and 1)
+   - |exposed|, |differentiable|
+
+ * - to_uv
+   - |transform|
+   - Specifies an optional 3x3 UV transformation matrix when ``domain`` is
+     ``uv``, e.g. to scale the frequency of the noise. A 4x4 matrix can also
+     be provided. In that case, the last row and columns will be ignored.
+     (Default: none)
+   - |exposed|
+
+ * - to_world
+   - |transform|
+   - Specifies an optional 4x4 transformation matrix that maps the noise
+     domain to world space when ``domain`` is ``position``. (Default: none)
+
+This plugin provides fractal noise patterns that are evaluated on the fly,
+which is much more memory efficient than baking them into large bitmaps. The
+noise is normalized to the range :math:`[0, 1]` and used to blend
+``color0`` and ``color1``.
+
+The lattice of the noise is randomized with an integer hash function instead
+of a permutation table, which avoids memory lookups and vectorizes well in
+both scalar and JIT variants. The maximum of the texture is computed from the
+maximum of the two colors, while its mean is known analytically for fBm of
+gradient noise and is otherwise estimated numerically when the plugin is
+created.
+
+.. tabs::
+    .. code-tab:: xml
+        :name: noise-texture
+
+        <texture type="noise">
+            <string name="noise_type" value="simplex"/>
+            <integer name="octaves" value="6"/>
+            <rgb name="color0" value="0.1, 0.1, 0.1"/>
+            <rgb name="color1" value="0.5, 0.4, 0.3"/>
+            <transform name="to_uv">
+                <scale x="64" y="64"/>
+            </transform>
+        </texture>
+
+    .. code-tab:: python
+
+        'type': 'noise',
+        'noise_type': 'simplex',
+        'octaves': 6,
+        'color0': [0.1, 0.1, 0.1],
+        'color1': [0.5, 0.4, 0.3],
+        'to_uv': mi.ScalarTransform4f.scale([64, 64, 1])
+
+ */
+
+template <typename Float, typename Spectrum>
+class NoiseTexture final : public Texture<Float, Spectrum> {
+public:
+    MI_IMPORT_TYPES(Texture)
+
+    enum class NoiseType { Perlin, Simplex, Worley };
+
+    NoiseTexture(const Properties &props) : Texture(props) {
+        std::string noise_type = props.string("noise_type", "perlin");
+        if (noise_type == "perlin")
+            m_noise_type = NoiseType::Perlin;
+        else if (noise_type == "simplex")
+            m_noise_type = NoiseType::Simplex;
+        else if (noise_type == "worley")
+            m_noise_type = NoiseType::Worley;
+        else
+            Throw("Invalid noise type \"%s\", must be one of: \"perlin\", "
+                  "\"simplex\", or \"worley\"!", noise_type);
+
+        std::string fractal = props.string("fractal", "fbm");
+        if (fractal == "fbm")
+            m_turbulence = false;
+        else if (fractal == "turbulence")
+            m_turbulence = true;
+        else
+            Throw("Invalid fractal type \"%s\", must be one of: \"fbm\" or "
+                  "\"turbulence\"!", fractal);
+
+        std::string domain = props.string("domain", "uv");
+        if (domain == "uv")
+            m_position = false;
+        else if (domain == "position")
+            m_position = true;
+        else
+            Throw("Invalid domain \"%s\", must be one of: \"uv\" or "
+                  "\"position\"!", domain);
+
+        int octaves = props.get<int>("octaves", 1);
+        if (octaves < 1)
+            Throw("The number of octaves must be positive!");
+        m_octaves = (uint32_t) octaves;
+        m_lacunarity = props.get<ScalarFloat>("lacunarity", 2.f);
+        m_gain = props.get<ScalarFloat>("gain", .5f);
+        m_seed = (uint32_t) props.get<int>("seed", 0);
+
+        m_color0 = props.texture<Texture>("color0", 0.f);
+        m_color1 = props.texture<Texture>("color1", 1.f);
+        m_transform = props.get<ScalarTransform3f>("to_uv", ScalarTransform3f());
+        m_to_local = props.get<ScalarTransform4f>("to_world", ScalarTransform4f()).inverse();
+
+        m_mean = estimate_mean();
+    }
+
+    void traverse(TraversalCallback *callback) override {
+        callback->put_parameter("to_uv", m_transform,    +ParamFlags::NonDifferentiable);
+        callback->put_object("color0",   m_color0.get(), +ParamFlags::Differentiable);
+        callback->put_object("color1",   m_color1.get(), +ParamFlags::Differentiable);
+    }
+
+    UnpolarizedSpectrum eval(const SurfaceInteraction3f &it, Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+        Float n = noise(it);
+        return dr::lerp(m_color0->eval(it, active), m_color1->eval(it, active), n);
+    }
+
+    Float eval_1(const SurfaceInteraction3f &it, Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+        Float n = noise(it);
+        return dr::lerp(m_color0->eval_1(it, active), m_color1->eval_1(it, active), n);
+    }
+
+    Color3f eval_3(const SurfaceInteraction3f &it, Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+        Float n = noise(it);
+        return dr::lerp(m_color0->eval_3(it, active), m_color1->eval_3(it, active), n);
+    }
+
+    Float mean() const override {
+        return dr::lerp(m_color0->mean(), m_color1->mean(), m_mean);
+    }
+
+    ScalarFloat max() const override {
+        return dr::maximum(m_color0->max(), m_color1->max());
+    }
+
+    bool is_spatially_varying() const override { return true; }
+
+    std::string to_string() const override {
+        std::ostringstream oss;
+        oss << "NoiseTexture[" << std::endl
+            << "  noise_type = " << (m_noise_type == NoiseType::Perlin ? "perlin" :
+                                     m_noise_type == NoiseType::Simplex ? "simplex" : "worley") << "," << std::endl
+            << "  fractal = " << (m_turbulence ? "turbulence" : "fbm") << "," << std::endl
+            << "  octaves = " << m_octaves << "," << std::endl
+            << "  lacunarity = " << m_lacunarity << "," << std::endl
+            << "  gain = " << m_gain << "," << std::endl
+            << "  seed = " << m_seed << "," << std::endl
+            << "  domain = " << (m_position ? "position" : "uv") << "," << std::endl
+            << "  color0 = " << string::indent(m_color0) << "," << std::endl
+            << "  color1 = " << string::indent(m_color1) << "," << std::endl
+            << "  transform = " << string::indent(m_position ? m_to_local.inverse() : m_transform) << std::endl
+            << "]";
+        return oss.str();
+    }
+
+    MI_DECLARE_CLASS()
+
+protected:
+    /// Evaluate the normalized noise at an interaction
+    Float noise(const SurfaceInteraction3f &it) const {
+        if (m_position) {
+            Point3f p = m_to_local.transform_affine(it.p);
+            return fractal<Float>(p.x(), p.y(), p.z());
+        } else {
+            Point2f uv = m_transform.transform_affine(it.uv);
+            return fractal<Float>(uv.x(), uv.y(), 0.f);
+        }
+    }
+
+    /// Estimate the mean of the normalized noise
+    ScalarFloat estimate_mean() const {
+        // Gradient noise has zero mean
+        if (m_noise_type != NoiseType::Worley && !m_turbulence)
+            return .5f;
+
+        // Average over a low-discrepancy point set (R_3 sequence)
+        const uint32_t count = 4096;
+        const double a1 = 0.8191725133961645, a2 = 0.6710436067037893,
+                     a3 = 0.5497004779019703;
+        double sum = 0.0;
+        for (uint32_t i = 0; i < count; ++i) {
+            double x = .5 + a1 * i, y = .5 + a2 * i, z = .5 + a3 * i;
+            sum += fractal<ScalarFloat>(ScalarFloat(64.0 * (x - std::floor(x))),
+                                        ScalarFloat(64.0 * (y - std::floor(y))),
+                                        ScalarFloat(m_position ? 64.0 * (z - std::floor(z)) : 0.0));
+        }
+        return ScalarFloat(sum / count);
+    }
+
+    /// Sum the octaves of the noise and map the result to [0, 1]
+    template <typename Value>
+    Value fractal(Value x, Value y, Value z) const {
+        Value sum = 0.f;
+        ScalarFloat amplitude = 1.f, norm = 0.f;
+
+        for (uint32_t i = 0; i < m_octaves; ++i) {
+            Value n = basis<Value>(x, y, z, m_seed + i);
+            if (m_turbulence)
+                n = dr::abs(n);
+            sum = dr::fmadd(n, amplitude, sum);
+            norm += amplitude;
+            amplitude *= m_gain;
+            x *= m_lacunarity;
+            y *= m_lacunarity;
+            z *= m_lacunarity;
+        }
+
+        sum /= norm;
+        if (!m_turbulence)
+            sum = dr::fmadd(sum, .5f, .5f);
+        return dr::clamp(sum, 0.f, 1.f);
+    }
+
+    /// Evaluate one octave of the basis noise, in the range [-1, 1]
+    template <typename Value>
+    Value basis(const Value &x, const Value &y, const Value &z, uint32_t seed) const {
+        switch (m_noise_type) {
+            case NoiseType::Perlin:
+                return m_position ? perlin_3d(x, y, z, seed) : perlin_2d(x, y, seed);
+            case NoiseType::Simplex:
+                return m_position ? simplex_3d(x, y, z, seed) : simplex_2d(x, y, seed);
+            default:
+                return dr::fmadd(dr::minimum(m_position ? worley_3d(x, y, z, seed)
+                                                        : worley_2d(x, y, seed), 1.f),
+                                 2.f, -1.f);
+        }
+    }
+
+    /// Hash the integer coordinates of a lattice point
+    template <typename UInt>
+    static UInt hash(const UInt &x, const UInt &y, const UInt &z, uint32_t seed) {
+        UInt h = (x * 0x8da6b343u) ^ (y * 0xd8163841u) ^ (z * 0xcb1ab31fu) ^ seed;
+        h ^= h >> 16;
+        h *= 0x7feb352du;
+        h ^= h >> 15;
+        h *= 0x846ca68bu;
+        h ^= h >> 16;
+        return h;
+    }
+
+    /// Quintic interpolation curve
+    template <typename Value> static Value fade(const Value &t) {
+        return t * t * t * dr::fmadd(t, dr::fmadd(t, 6.f, -15.f), 10.f);
+    }
+
+    /// Dot product with one of 8 gradient directions selected by the hash
+    template <typename Value, typename UInt>
+    static Value grad_2d(const UInt &h, const Value &x, const Value &y) {
+        auto first = (h & 7u) < 4u;
+        Value u = dr::select(first, x, y),
+              v = dr::select(first, y, x) * 2.f;
+        return dr::select(dr::neq(h & 1u, 0u), -u, u) +
+               dr::select(dr::neq(h & 2u, 0u), -v, v);
+    }
+
+    /// Dot product with one of 12 gradient directions selected by the hash
+    template <typename Value, typename UInt>
+    static Value grad_3d(const UInt &h, const Value &x, const Value &y, const Value &z) {
+        UInt hh = h & 15u;
+        Value u = dr::select(hh < 8u, x, y),
+              v = dr::select(hh < 4u, y,
+                             dr::select(dr::eq(hh, 12u) || dr::eq(hh, 14u), x, z));
+        return dr::select(dr::neq(h & 1u, 0u), -u, u) +
+               dr::select(dr::neq(h & 2u, 0u), -v, v);
+    }
+
+    template <typename Value>
+    static Value perlin_2d(const Value &x, const Value &y, uint32_t seed) {
+        using UInt = dr::uint32_array_t<Value>;
+        using Int  = dr::int32_array_t<Value>;
+
+        Value xf = dr::floor(x), yf = dr::floor(y),
+              fx = x - xf, fy = y - yf;
+        UInt xi = UInt(Int(xf)), yi = UInt(Int(yf)), zi = 0u;
+
+        Value n00 = grad_2d(hash(xi,      yi,      zi, seed), fx,       fy),
+              n10 = grad_2d(hash(xi + 1u, yi,      zi, seed), fx - 1.f, fy),
+              n01 = grad_2d(hash(xi,      yi + 1u, zi, seed), fx,       fy - 1.f),
+              n11 = grad_2d(hash(xi + 1u, yi + 1u, zi, seed), fx - 1.f, fy - 1.f);
+
+        Value u = fade(fx), v = fade(fy);
+        return .507f * dr::lerp(dr::lerp(n00, n10, u), dr::lerp(n01, n11, u), v);
+    }
+
+    template <typename Value>
+    static Value perlin_3d(const Value &x, const Value &y, const Value &z, uint32_t seed) {
+        using UInt = dr::uint32_array_t<Value>;
+        using Int  = dr::int32_array_t<Value>;
+
+        Value xf = dr::floor(x), yf = dr::floor(y), zf = dr::floor(z),
+              fx = x - xf, fy = y - yf, fz = z - zf;
+        UInt xi = UInt(Int(xf)), yi = UInt(Int(yf)), zi = UInt(Int(zf));
+        Value u = fade(fx), v = fade(fy), w = fade(fz);
+
+        Value n[2];
+        for (uint32_t k = 0; k < 2; ++k) {
+            Value zk = fz - (ScalarFloat) k;
+            UInt zik = zi + k;
+            Value n00 = grad_3d(hash(xi,      yi,      zik, seed), fx,       fy,       zk),
+                  n10 = grad_3d(hash(xi + 1u, yi,      zik, seed), fx - 1.f, fy,       zk),
+                  n01 = grad_3d(hash(xi,      yi + 1u, zik, seed), fx,       fy - 1.f, zk),
+                  n11 = grad_3d(hash(xi + 1u, yi + 1u, zik, seed), fx - 1.f, fy - 1.f, zk);
+            n[k] = dr::lerp(dr::lerp(n00, n10, u), dr::lerp(n01, n11, u), v);
+        }
+
+        return .936f * dr::lerp(n[0], n[1], w);
+    }
+
+    template <typename Value>
+    static Value simplex_2d(const Value &x, const Value &y, uint32_t seed) {
+        using UInt = dr::uint32_array_t<Value>;
+        using Int  = dr::int32_array_t<Value>;
+
+        const ScalarFloat F2 = ScalarFloat(0.36602540378443865),
+                          G2 = ScalarFloat(0.21132486540518713);
+
+        // Skew the input space to determine the simplex cell
+        Value s  = (x + y) * F2,
+              xf = dr::floor(x + s), yf = dr::floor(y + s),
+              t  = (xf + yf) * G2,
+              x0 = x - (xf - t), y0 = y - (yf - t);
+
+        // Offsets of the middle corner
+        auto lower = x0 > y0;
+        Value i1 = dr::select(lower, Value(1.f), Value(0.f)),
+              j1 = 1.f - i1;
+
+        UInt xi = UInt(Int(xf)), yi = UInt(Int(yf)), zi = 0u;
+        Value x1 = x0 - i1 + G2,         y1 = y0 - j1 + G2,
+              x2 = x0 - 1.f + 2.f * G2,  y2 = y0 - 1.f + 2.f * G2;
+
+        auto corner = [&](const Value &cx, const Value &cy, const UInt &h) {
+            Value c = dr::maximum(.5f - cx * cx - cy * cy, 0.f);
+            c *= c;
+            return c * c * grad_2d(h, cx, cy);
+        };
+
+        return 40.f * (corner(x0, y0, hash(xi, yi, zi, seed)) +
+                       corner(x1, y1, hash(xi + UInt(i1), yi + UInt(j1), zi, seed)) +
+                       corner(x2, y2, hash(xi + 1u, yi + 1u, zi, seed)));
+    }
+
+    template <typename Value>
+    static Value simplex_3d(const Value &x, const Value &y, const Value &z, uint32_t seed) {
+        using UInt = dr::uint32_array_t<Value>;
+        using Int  = dr::int32_array_t<Value>;
+
+        const ScalarFloat F3 = ScalarFloat(1.0 / 3.0),
+                          G3 = ScalarFloat(1.0 / 6.0);
+
+        // Skew the input space to determine the simplex cell
+        Value s  = (x + y + z) * F3,
+              xf = dr::floor(x + s), yf = dr::floor(y + s), zf = dr::floor(z + s),
+              t  = (xf + yf + zf) * G3,
+              x0 = x - (xf - t), y0 = y - (yf - t), z0 = z - (zf - t);
+
+        // Offsets of the two middle corners, based on the rank of the coordinates
+        Value gx = dr::select(x0 >= y0, Value(1.f), Value(0.f)),
+              gy = dr::select(y0 >= z0, Value(1.f), Value(0.f)),
+              gz = dr::select(z0 >= x0, Value(1.f), Value(0.f));
+        Value i1 = dr::minimum(gx, 1.f - gz), i2 = dr::maximum(gx, 1.f - gz),
+              j1 = dr::minimum(gy, 1.f - gx), j2 = dr::maximum(gy, 1.f - gx),
+              k1 = dr::minimum(gz, 1.f - gy), k2 = dr::maximum(gz, 1.f - gy);
+
+        UInt xi = UInt(Int(xf)), yi = UInt(Int(yf)), zi = UInt(Int(zf));
+
+        auto corner = [&](const Value &ox, const Value &oy, const Value &oz,
+                          ScalarFloat g) {
+            Value cx = x0 - ox + g, cy = y0 - oy + g, cz = z0 - oz + g;
+            Value c = dr::maximum(.6f - cx * cx - cy * cy - cz * cz, 0.f);
+            c *= c;
+            UInt h = hash(xi + UInt(ox), yi + UInt(oy), zi + UInt(oz), seed);
+            return c * c * grad_3d(h, cx, cy, cz);
+        };
+
+        return 32.f * (corner(0.f, 0.f, 0.f, 0.f) +
+                       corner(i1, j1, k1, G3) +
+                       corner(i2, j2, k2, 2.f * G3) +
+                       corner(1.f, 1.f, 1.f, 3.f * G3));
+    }
+
+    /// Position of the feature point of a cell, extracted from its hash
+    template <typename Value, typename UInt>
+    static Value feature(const UInt &h, uint32_t shift) {
+        return Value((h >> shift) & 1023u) * (1.f / 1024.f) + (.5f / 1024.f);
+    }
+
+    template <typename Value>
+    static Value worley_2d(const Value &x, const Value &y, uint32_t seed) {
+        using UInt = dr::uint32_array_t<Value>;
+        using Int  = dr::int32_array_t<Value>;
+
+        Value xf = dr::floor(x), yf = dr::floor(y),
+              fx = x - xf, fy = y - yf;
+        UInt xi = UInt(Int(xf)), yi = UInt(Int(yf)), zi = 0u;
+
+        Value dist2 = dr::Infinity<ScalarFloat>;
+        for (int i = -1; i <= 1; ++i) {
+            for (int j = -1; j <= 1; ++j) {
+                UInt h = hash(xi + UInt((uint32_t) i), yi + UInt((uint32_t) j), zi, seed);
+                Value dx = feature<Value>(h, 0) + (ScalarFloat) i - fx,
+                      dy = feature<Value>(h, 10) + (ScalarFloat) j - fy;
+                dist2 = dr::minimum(dist2, dx * dx + dy * dy);
+            }
+        }
+
+        return dr::sqrt(dist2);
+    }
+
+    template <typename Value>
+    static Value worley_3d(const Value &x, const Value &y, const Value &z, uint32_t seed) {
+        using UInt = dr::uint32_array_t<Value>;
+        using Int  = dr::int32_array_t<Value>;
+
+        Value xf = dr::floor(x), yf = dr::floor(y), zf = dr::floor(z),
+              fx = x - xf, fy = y - yf, fz = z - zf;
+        UInt xi = UInt(Int(xf)), yi = UInt(Int(yf)), zi = UInt(Int(zf));
+
+        Value dist2 = dr::Infinity<ScalarFloat>;
+        for (int i = -1; i <= 1; ++i) {
+            for (int j = -1; j <= 1; ++j) {
+                for (int k = -1; k <= 1; ++k) {
+                    UInt h = hash(xi + UInt((uint32_t) i), yi + UInt((uint32_t) j), zi + UInt((uint32_t) k), seed);
+                    Value dx = feature<Value>(h, 0) + (ScalarFloat) i - fx,
+                          dy = feature<Value>(h, 10) + (ScalarFloat) j - fy,
+                          dz = feature<Value>(h, 20) + (ScalarFloat) k - fz;
+                    dist2 = dr::minimum(dist2, dx * dx + dy * dy + dz * dz);
+                }
+            }
+        }
+
+        return dr::sqrt(dist2);
+    }
+
+protected:
+    NoiseType m_noise_type;
+    bool m_turbulence;
+    bool m_position;
+    uint32_t m_octaves;
+    ScalarFloat m_lacunarity;
+    ScalarFloat m_gain;
+    uint32_t m_seed;
+    ScalarFloat m_mean;
+
+    ref<Texture> m_color0;
+    ref<Texture> m_color1;
+    ScalarTransform3f m_transform;
+    ScalarTransform4f m_to_local;
+};
+
+MI_IMPLEMENT_CLASS_VARIANT(NoiseTexture, Texture)
+MI_EXPORT_PLUGIN(NoiseTexture, "Procedural noise texture")
+NAMESPACE_END(mitsuba)
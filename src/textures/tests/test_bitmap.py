@@ -247,4 +247,44 @@ def test06_tensor_load(variants_all_rgb):
         'raw' : True
     })
 
-    assert dr.allclose(bitmap.mean(), 3.0);
\ No newline at end of file
+    assert dr.allclose(bitmap.mean(), 3.0);
+
+@fresolver_append_path
+def test07_shared_memory_cache(variants_all_rgb):
+    import os
+    if not os.path.isdir('/dev/shm'):
+        pytest.skip('POSIX shared memory is not available')
+
+    def entries():
+        return set(f for f in os.listdir('/dev/shm') if f.startswith('mi-'))
+
+    props = {
+        'type' : 'bitmap',
+        'filename' : 'resources/data/common/textures/carrot.png'
+    }
+
+    before = entries()
+    mi.SharedMemoryRegion.set_enabled(True)
+    try:
+        data_ref = mi.traverse(mi.load_dict(props))['data']
+        published = entries() - before
+        assert len(published) == 1
+
+        # The second load maps the published texture
+        assert dr.all(dr.eq(mi.traverse(mi.load_dict(props))['data'], data_ref))
+
+        # Entries with an inconsistent header (here, a huge width) are ignored
+        import numpy as np
+        name = list(published)[0]
+        with open('/dev/shm/' + name, 'rb') as f:
+            data = bytearray(f.read()[64:]) # Skip the region header
+        data[8:16] = (1 << 62).to_bytes(8, 'little')
+        mi.SharedMemoryRegion.remove('/' + name)
+        region = mi.SharedMemoryRegion.create('/' + name, len(data))
+        np.array(region, copy=False)[:] = np.frombuffer(data, dtype=np.uint8)
+        region.publish()
+        assert dr.all(dr.eq(mi.traverse(mi.load_dict(props))['data'], data_ref))
+    finally:
+        mi.SharedMemoryRegion.set_enabled(False)
+        for name in entries() - before:
+            mi.SharedMemoryRegion.remove('/' + name)
@@ -0,0 +1,109 @@
+import pytest
+import drjit as dr
+import mitsuba as mi
+
+
+def make_si(n=4096):
+    sampler = mi.load_dict({'type': 'independent'})
+    sampler.seed(0, n)
+    si = dr.zeros(mi.SurfaceInteraction3f, n)
+    si.uv = sampler.next_2d() * 64.0 - 32.0
+    si.p = mi.Point3f(sampler.next_1d(), sampler.next_1d(),
+                      sampler.next_1d()) * 64.0 - 32.0
+    return si
+
+
+def test01_perlin_lattice(variants_vec_backends_once):
+    # Gradient noise vanishes at the lattice points
+    for domain in ['uv', 'position']:
+        texture = mi.load_dict({
+            'type': 'noise',
+            'domain': domain
+        })
+        si = dr.zeros(mi.SurfaceInteraction3f, 4)
+        si.uv = mi.Point2f([0, 1, -3, 7], [0, 2, 5, -1])
+        si.p = mi.Point3f([0, 1, -3, 7], [0, 2, 5, -1], [0, -4, 2, 3])
+        assert dr.allclose(texture.eval_1(si), 0.5)
+
+
+@pytest.mark.parametrize('noise_type', ['perlin', 'simplex', 'worley'])
+@pytest.mark.parametrize('fractal', ['fbm', 'turbulence'])
+@pytest.mark.parametrize('domain', ['uv', 'position'])
+def test02_range_and_mean(variants_vec_backends_once, noise_type, fractal, domain):
+    texture = mi.load_dict({
+        'type': 'noise',
+        'noise_type': noise_type,
+        'fractal': fractal,
+        'domain': domain,
+        'octaves': 4,
+        'seed': 3
+    })
+
+    value = texture.eval_1(make_si())
+    assert dr.all(value >= 0) and dr.all(value <= 1)
+    assert dr.max(value) - dr.min(value) > 0.2
+    assert dr.allclose(dr.mean(value), texture.mean(), atol=0.05)
+    assert dr.allclose(texture.max(), 1.0)
+
+
+def test03_colors(variants_vec_backends_once_rgb):
+    texture = mi.load_dict({
+        'type': 'noise',
+        'noise_type': 'simplex',
+        'color0': {'type': 'rgb', 'value': [0.2, 0.4, 0.6]},
+        'color1': {'type': 'rgb', 'value': [0.8, 0.4, 0.1]}
+    })
+    reference = mi.load_dict({'type': 'noise', 'noise_type': 'simplex'})
+
+    si = make_si(128)
+    n = reference.eval_1(si)
+    expected = mi.Color3f(dr.lerp(0.2, 0.8, n), dr.lerp(0.4, 0.4, n),
+                          dr.lerp(0.6, 0.1, n))
+    assert dr.allclose(texture.eval_3(si), expected)
+    assert dr.allclose(texture.max(), 0.8)
+
+    # Different seeds give different patterns
+    other = mi.load_dict({'type': 'noise', 'noise_type': 'simplex', 'seed': 1})
+    assert not dr.allclose(other.eval_1(si), n)
+
+
+def test04_invalid(variants_vec_backends_once):
+    with pytest.raises(RuntimeError):
+        mi.load_dict({'type': 'noise', 'noise_type': 'value'})
+    with pytest.raises(RuntimeError):
+        mi.load_dict({'type': 'noise', 'octaves': 0})
+
+
+def test05_scalar(variant_scalar_rgb):
+    import numpy as np
+
+    # Gradient noise vanishes at the lattice points
+    for domain in ['uv', 'position']:
+        texture = mi.load_dict({'type': 'noise', 'domain': domain})
+        for p in [[0, 0, 0], [1, 2, -4], [-3, 5, 2], [7, -1, 3]]:
+            si = dr.zeros(mi.SurfaceInteraction3f)
+            si.uv = mi.Point2f(p[0], p[1])
+            si.p = mi.Point3f(p)
+            assert dr.allclose(texture.eval_1(si), 0.5)
+
+    rng = np.random.default_rng(0)
+    points = rng.random((512, 3)) * 64.0 - 32.0
+    for noise_type in ['perlin', 'simplex', 'worley']:
+        texture = mi.load_dict({
+            'type': 'noise',
+            'noise_type': noise_type,
+            'domain': 'position',
+            'octaves': 4,
+            'seed': 3
+        })
+
+        values = []
+        for p in points:
+            si = dr.zeros(mi.SurfaceInteraction3f)
+            si.p = mi.Point3f(*[float(v) for v in p])
+            values.append(texture.eval_1(si))
+        values = np.array(values)
+
+        assert np.all(values >= 0) and np.all(values <= 1)
+        assert values.max() - values.min() > 0.2
+        assert abs(values.mean() - texture.mean()) < 0.05
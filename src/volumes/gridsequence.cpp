@@ -0,0 +1,312 @@
+#include <mitsuba/core/fresolver.h>
+#include <mitsuba/core/plugin.h>
+#include <mitsuba/core/properties.h>
+#include <mitsuba/core/string.h>
+#include <mitsuba/core/thread.h>
+#include <mitsuba/core/transform.h>
+#include <mitsuba/render/volume.h>
+#include <mitsuba/render/volumegrid.h>
+#include <nanothread/nanothread.h>
+#include <unordered_map>
+
+NAMESPACE_BEGIN(mitsuba)
+
+
+/**!
+.. _volume-gridsequence:
+
+Animated grid-based volume data source (:monosp:`gridsequence`)
+---------------------------------------------------------------
+
+.. pluginparameters::
+
+ * - filename
+   - |string|
+   - Filename pattern of the volume sequence. The last run of ``#`` characters
+     is replaced by the zero-padded frame number, e.g. ``smoke_####.vol``
+     refers to ``smoke_0000.vol``, ``smoke_0001.vol``, etc.
+
+ * - frame_start
+   - |int|
+   - Number of the first frame of the sequence. (Default: 0)
+
+ * - frame_count
+   - |int|
+   - Number of frames of the sequence. By default, consecutive frames are
+     used until the first missing file.
+
+ * - frame
+   - |int|
+   - Frame that is initially loaded. (Default: :paramtype:`frame_start`)
+   - |exposed|
+
+ * - prefetch
+   - |int|
+   - Number of frames following the current one that are loaded on background
+     threads. (Default: 2)
+
+ * - filter_type, wrap_mode, raw, accel, use_grid_bbox, max_value, to_world
+   - |string|, |bool|, |float|, |transform|
+   - Forwarded to the :ref:`gridvolume <volume-gridvolume>` instance of each
+     frame, please refer to its documentation.
+
+This plugin renders a sequence of volume files, e.g. the frames of a cached
+fluid simulation. Only the grid of the current frame is resident in the form of
+a :ref:`gridvolume <volume-gridvolume>`, while the files of the next
+:paramtype:`prefetch` frames are read and decoded by background threads in the
+meantime. Changing the ``frame`` parameter swaps in the requested frame when the
+scene parameters are updated, which only waits for the decoding of that frame if
+it hasn't completed yet. Other objects of the scene are left untouched, except
+for the parents of the volume (e.g. a medium updating its majorant).
+
+.. tabs::
+    .. code-tab:: xml
+
+        <medium type="heterogeneous" id="smoke">
+            <volume type="gridsequence" name="sigma_t">
+                <string name="filename" value="cache/smoke_####.vol"/>
+            </volume>
+        </medium>
+
+    .. code-tab:: python
+
+        'type': 'heterogeneous',
+        'sigma_t': {
+            'type': 'gridsequence',
+            'filename': 'cache/smoke_####.vol'
+        }
+
+The frames are then rendered as follows:
+
+.. code-block:: python
+
+    params = mi.traverse(scene)
+    for frame in range(100):
+        params['smoke.sigma_t.frame'] = frame
+        params.update()
+        mi.util.write_bitmap(f'frame_{frame:04d}.exr', mi.render(scene, params))
+
+*/
+
+template <typename Float, typename Spectrum>
+class GridSequenceVolume final : public Volume<Float, Spectrum> {
+public:
+    MI_IMPORT_BASE(Volume, m_bbox, m_channel_count)
+    MI_IMPORT_TYPES(VolumeGrid)
+
+    GridSequenceVolume(const Properties &props) : Base(props) {
+        std::string pattern = props.string("filename");
+        size_t end = pattern.find_last_of('#');
+        if (end == std::string::npos)
+            Throw("The filename \"%s\" must contain a run of '#' characters "
+                  "that is replaced by the frame number!", pattern);
+        size_t start = pattern.find_last_not_of('#', end);
+        start = start == std::string::npos ? 0 : start + 1;
+        m_prefix = pattern.substr(0, start);
+        m_suffix = pattern.substr(end + 1);
+        m_digits = end + 1 - start;
+
+        m_frame_start = props.get<ScalarInt32>("frame_start", 0);
+        FileResolver *fs = Thread::thread()->file_resolver();
+        if (props.has_property("frame_count")) {
+            ScalarInt32 count = props.get<ScalarInt32>("frame_count");
+            if (count <= 0)
+                Throw("The frame count must be positive!");
+            for (ScalarInt32 i = 0; i < count; ++i) {
+                fs::path path = fs->resolve(filename(m_frame_start + i));
+                if (!fs::exists(path))
+                    Log(Error, "\"%s\": file does not exist!", path);
+                m_paths.push_back(path);
+            }
+        } else {
+            while (true) {
+                fs::path path = fs->resolve(filename(m_frame_start + (ScalarInt32) m_paths.size()));
+                if (!fs::exists(path))
+                    break;
+                m_paths.push_back(path);
+            }
+            if (m_paths.empty())
+                Log(Error, "\"%s\": file does not exist!", filename(m_frame_start));
+        }
+
+        m_prefetch = props.get<ScalarInt32>("prefetch", 2);
+        if (m_prefetch < 0)
+            Throw("The number of prefetched frames must be non-negative!");
+
+        // Properties that are forwarded to the volume of each frame
+        m_props = Properties("gridvolume");
+        for (const char *name : { "filter_type", "wrap_mode", "raw", "accel",
+                                  "use_grid_bbox", "max_value", "to_world" }) {
+            if (props.has_property(name)) {
+                m_props.copy_attribute(props, name, name);
+                props.mark_queried(name);
+            }
+        }
+
+        m_frame = props.get<ScalarInt32>("frame", m_frame_start);
+        set_frame(m_frame);
+    }
+
+    ~GridSequenceVolume() {
+        for (auto &[frame, pending] : m_pending)
+            task_wait_and_release(pending->task);
+    }
+
+    void traverse(TraversalCallback *callback) override {
+        callback->put_parameter("frame", m_frame, +ParamFlags::NonDifferentiable);
+        Base::traverse(callback);
+    }
+
+    void parameters_changed(const std::vector<std::string> &keys) override {
+        if ((keys.empty() || string::contains(keys, "frame")) &&
+            m_frame != m_current_frame)
+            set_frame(m_frame);
+    }
+
+    UnpolarizedSpectrum eval(const Interaction3f &it,
+                             Mask active) const override {
+        return m_volume->eval(it, active);
+    }
+
+    Float eval_1(const Interaction3f &it, Mask active = true) const override {
+        return m_volume->eval_1(it, active);
+    }
+
+    Vector3f eval_3(const Interaction3f &it,
+                    Mask active = true) const override {
+        return m_volume->eval_3(it, active);
+    }
+
+    dr::Array<Float, 6> eval_6(const Interaction3f &it,
+                               Mask active = true) const override {
+        return m_volume->eval_6(it, active);
+    }
+
+    void eval_n(const Interaction3f &it, Float *out, Mask active = true) const override {
+        m_volume->eval_n(it, out, active);
+    }
+
+    ScalarFloat max() const override { return m_volume->max(); }
+
+    void max_per_channel(ScalarFloat *out) const override {
+        m_volume->max_per_channel(out);
+    }
+
+    ScalarVector3i resolution() const override {
+        return m_volume->resolution();
+    };
+
+    std::string to_string() const override {
+        std::ostringstream oss;
+        oss << "GridSequenceVolume[" << std::endl
+            << "  filename = \"" << filename(m_current_frame) << "\"," << std::endl
+            << "  frame = " << m_current_frame << "," << std::endl
+            << "  frames = [" << m_frame_start << ", "
+            << m_frame_start + (ScalarInt32) m_paths.size() << ")," << std::endl
+            << "  prefetch = " << m_prefetch << "," << std::endl
+            << "  volume = " << string::indent(m_volume) << std::endl
+            << "]";
+        return oss.str();
+    }
+
+    MI_DECLARE_CLASS()
+
+protected:
+    /// Volume grid of a frame that is being loaded on a background thread
+    struct PendingFrame {
+        Task *task = nullptr;
+        ref<VolumeGrid> grid;
+        std::exception_ptr error;
+    };
+
+    /// Return the filename of a frame (before resolution)
+    std::string filename(ScalarInt32 frame) const {
+        std::string number = std::to_string(frame);
+        if (number.size() < m_digits)
+            number.insert(0, m_digits - number.size(), '0');
+        return m_prefix + number + m_suffix;
+    }
+
+    /// Make a frame resident and prefetch the following ones
+    void set_frame(ScalarInt32 frame) {
+        if (frame < m_frame_start ||
+            frame >= m_frame_start + (ScalarInt32) m_paths.size())
+            Throw("Frame %i is outside of the range [%i, %i) of the sequence!",
+                  frame, m_frame_start, m_frame_start + (ScalarInt32) m_paths.size());
+
+        ref<VolumeGrid> grid;
+        auto it = m_pending.find(frame);
+        if (it != m_pending.end()) {
+            std::shared_ptr<PendingFrame> pending = it->second;
+            m_pending.erase(it);
+            task_wait_and_release(pending->task);
+            if (pending->error)
+                std::rethrow_exception(pending->error);
+            grid = pending->grid;
+        } else {
+            grid = new VolumeGrid(m_paths[frame - m_frame_start]);
+        }
+
+        Properties props(m_props);
+        props.set_object("grid", grid.get());
+        m_volume = PluginManager::instance()->create_object<Base>(props);
+        m_bbox = m_volume->bbox();
+        m_channel_count = m_volume->channel_count();
+        m_frame = m_current_frame = frame;
+
+        prefetch(frame);
+    }
+
+    /// Start loading the frames following \c frame and cancel stale requests
+    void prefetch(ScalarInt32 frame) {
+        ScalarInt32 last = dr::minimum(frame + m_prefetch,
+                                       m_frame_start + (ScalarInt32) m_paths.size() - 1);
+
+        /* Release the handles of frames that are no longer needed. Tasks that
+           are still running keep their result alive until they complete. */
+        for (auto it = m_pending.begin(); it != m_pending.end();) {
+            if (it->first <= frame || it->first > last) {
+                task_release(it->second->task);
+                it = m_pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        for (ScalarInt32 i = frame + 1; i <= last; ++i) {
+            if (m_pending.find(i) != m_pending.end())
+                continue;
+
+            auto pending = std::make_shared<PendingFrame>();
+            fs::path path = m_paths[i - m_frame_start];
+            ThreadEnvironment env;
+            pending->task = dr::do_async([pending, path, env]() mutable {
+                ScopedSetThreadEnvironment set_env(env);
+                try {
+                    pending->grid = new VolumeGrid(path);
+                } catch (...) {
+                    pending->error = std::current_exception();
+                }
+            });
+            m_pending[i] = pending;
+        }
+    }
+
+protected:
+    std::string m_prefix, m_suffix;
+    size_t m_digits;
+    std::vector<fs::path> m_paths;
+    ScalarInt32 m_frame_start;
+    ScalarInt32 m_prefetch;
+    Properties m_props;
+
+    ScalarInt32 m_frame;
+    ScalarInt32 m_current_frame;
+    ref<Base> m_volume;
+    std::unordered_map<ScalarInt32, std::shared_ptr<PendingFrame>> m_pending;
+};
+
+MI_IMPLEMENT_CLASS_VARIANT(GridSequenceVolume, Volume)
+MI_EXPORT_PLUGIN(GridSequenceVolume, "GridSequenceVolume texture")
+
+NAMESPACE_END(mitsuba)
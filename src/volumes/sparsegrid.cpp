@@ -0,0 +1,508 @@
+#include <mitsuba/core/fresolver.h>
+#include <mitsuba/core/properties.h>
+#include <mitsuba/core/spectrum.h>
+#include <mitsuba/core/string.h>
+#include <mitsuba/core/transform.h>
+#include <mitsuba/render/srgb.h>
+#include <mitsuba/render/volume.h>
+#include <mitsuba/render/sparsegrid.h>
+#include <drjit/dynamic.h>
+
+NAMESPACE_BEGIN(mitsuba)
+
+
+/**!
+.. _volume-sparsegridvolume:
+
+Sparse grid-based volume data source (:monosp:`sparsegridvolume`)
+-----------------------------------------------------------------
+
+.. pluginparameters::
+
+ * - filename
+   - |string|
+   - Filename of the sparse volume to be loaded
+
+ * - grid
+   - :monosp:`SparseVolumeGrid object`
+   - When creating a sparse grid volume at runtime, e.g. from Python or C++,
+     an existing ``SparseVolumeGrid`` instance can be passed directly rather
+     than loading it from the filesystem with :paramtype:`filename`.
+
+ * - use_grid_bbox
+   - |bool|
+   - When set to ``true``, the bounding box information contained in the
+     ``SparseVolumeGrid`` object (or the file it was loaded from) will be used.
+     By default, it is assumed that the grid is defined in the unit cube
+     spanning (0, 0, 0) x (1, 1, 1). Evaluations outside of the bounding box
+     are clamped to its boundary. (Default: false)
+
+ * - filter_type
+   - |string|
+   - Specifies how voxel values are interpolated. The following options are
+     currently available:
+
+     - ``trilinear`` (default): perform trilinear interpolation.
+
+     - ``nearest``: disable interpolation. In this mode, the plugin
+       performs nearest neighbor lookups of volume values.
+
+ * - raw
+   - |bool|
+   - Should the transformation to the stored color data (e.g. sRGB to linear,
+     spectral upsampling) be disabled? You will want to enable this when working
+     with non-color, 3-channel volume data. (Default: false)
+
+ * - max_value
+   - |float|
+   - Optional maximum value of the volume, which overrides the value computed
+     from the grid.
+
+ * - to_world
+   - |transform|
+   - Specifies an optional 4x4 transformation matrix that will be applied to volume coordinates.
+
+This plugin provides the same functionality as :ref:`gridvolume
+<volume-gridvolume>` for sparse data such as smoke and clouds, which mostly
+consist of empty space and become very large when stored as a dense grid.
+
+The voxels are stored in a shallow tree that uses the same configuration as
+NanoVDB :cite:`Museth2021NanoVDB`: a root table references upper internal
+nodes spanning :math:`4096^3` voxels, which reference lower internal nodes
+spanning :math:`128^3` voxels, which reference leaf nodes holding blocks of
+:math:`8^3` voxels. Voxels that aren't covered by any leaf take the background
+value of the grid. The nodes are stored in flat arrays and reference their
+children by index, so the tree needs no pointer fix-up when it is loaded and is
+traversed in the same way on the CPU and on the GPU. Evaluating the volume walks
+the tree once per interpolation corner, and corners that fall into the leaf of
+the first corner reuse it.
+
+Each node also records the per-channel minimum and maximum of the voxels below
+it. These bounds are accessible from Python and C++ via the ``node_min()``,
+``node_max()`` and ``max_per_channel(min, max)`` methods of
+``SparseVolumeGrid`` to build local majorants.
+
+Sparse grids can be created from a dense NumPy array (only the blocks that
+differ from the background are stored), or from a list of active voxels, e.g.
+as exported from OpenVDB, which avoids building a dense grid altogether:
+
+.. code-block:: python
+
+    # coords: (N, 3) array of integer voxel coordinates, values: (N) or (N, C) array
+    grid = mi.SparseVolumeGrid(size=[512, 256, 512], coords=coords, values=values)
+    grid.write('smoke.svol')
+
+The file format uses a little endian encoding and is specified as follows:
+
+.. list-table:: Sparse volume file format
+   :widths: 8 30
+   :header-rows: 1
+
+   * - Position
+     - Content
+   * - Bytes 1-3
+     - ASCII Bytes ’S’, ’V’, and ’L’
+   * - Byte 4
+     - File format version number (currently 1)
+   * - Bytes 5-8
+     - Encoding identified (32-bit integer). Currently, only a value of 1 is
+       supported (float32-based representation)
+   * - Bytes 9-20
+     - Number of voxels along the X, Y and Z axes (32 bit integers)
+   * - Bytes 21-24
+     - Number of channels :math:`C` (32 bit integer, supported values: 1, 3 or 6)
+   * - Bytes 25-48
+     - Axis-aligned bounding box of the data stored in single precision (order:
+       xmin, ymin, zmin, xmax, ymax, zmax)
+   * - Next :math:`4C` bytes
+     - Background value of each channel (single precision)
+   * - Next 12 bytes
+     - Number of upper nodes :math:`U`, lower nodes :math:`L` and leaf nodes
+       :math:`N` (32 bit unsigned integers)
+   * - Following bytes
+     - Root table: one upper node index per block of :math:`4096^3` voxels
+       (32 bit unsigned integers, ordered so that :math:`x` varies the
+       fastest), followed by the :math:`32^3` lower node indices of each upper
+       node, the :math:`16^3` leaf node indices of each lower node, and the
+       :math:`8^3 \times C` values of each leaf node (single precision). Missing
+       children are marked by the index :math:`2^{32}-1`. Within internal and
+       leaf nodes, children and voxels are ordered as in NanoVDB, i.e. so that
+       the :math:`z` coordinate varies the fastest.
+
+.. tabs::
+    .. code-tab:: xml
+
+        <medium type="heterogeneous">
+            <volume type="sparsegridvolume" name="sigma_t">
+                <string name="filename" value="smoke.svol"/>
+            </volume>
+        </medium>
+
+    .. code-tab:: python
+
+        'type': 'heterogeneous',
+        'sigma_t': {
+            'type': 'sparsegridvolume',
+            'filename': 'smoke.svol'
+        }
+
+*/
+
+template <typename Float, typename Spectrum>
+class SparseGridVolume final : public Volume<Float, Spectrum> {
+public:
+    MI_IMPORT_BASE(Volume, update_bbox, m_to_local, m_bbox, m_channel_count)
+    MI_IMPORT_TYPES(SparseVolumeGrid)
+
+    using FloatStorage  = DynamicBuffer<Float>;
+    using UInt32Storage = DynamicBuffer<UInt32>;
+    using Grid          = SparseVolumeGrid;
+
+    SparseGridVolume(const Properties &props) : Base(props) {
+        std::string filter_type_str = props.string("filter_type", "trilinear");
+        if (filter_type_str == "nearest")
+            m_nearest = true;
+        else if (filter_type_str == "trilinear")
+            m_nearest = false;
+        else
+            Throw("Invalid filter type \"%s\", must be one of: \"nearest\" or "
+                  "\"trilinear\"!", filter_type_str);
+
+        m_raw = props.get<bool>("raw", false);
+
+        if (props.has_property("grid")) {
+            if (props.has_property("filename"))
+                Throw("Cannot specify both \"grid\" and \"filename\".");
+            // Note: ref-counted, so we don't have to worry about lifetime
+            ref<Object> other = props.object("grid");
+            m_grid = dynamic_cast<Grid *>(other.get());
+            if (!m_grid)
+                Throw("Property \"grid\" must be a SparseVolumeGrid instance.");
+        } else {
+            FileResolver *fs = Thread::thread()->file_resolver();
+            fs::path file_path = fs->resolve(props.string("filename"));
+            if (!fs::exists(file_path))
+                Log(Error, "\"%s\": file does not exist!", file_path);
+            m_grid = new Grid(file_path);
+        }
+
+        m_channel_count = m_grid->channel_count();
+        if (m_channel_count != 1 && m_channel_count != 3 && m_channel_count != 6)
+            Throw("Only sparse volumes with 1, 3 or 6 channels are supported "
+                  "(found %u)!", m_channel_count);
+
+        m_size = m_grid->size();
+        m_root_size = m_grid->root_size();
+
+        auto load_table = [](const uint32_t *ptr, size_t size) {
+            // Avoid empty arrays, lookups into them are always masked
+            if (size == 0)
+                return dr::full<UInt32Storage>(Grid::Empty, 1);
+            return dr::load<UInt32Storage>(ptr, size);
+        };
+
+        m_root  = load_table(m_grid->root(), dr::prod(m_root_size));
+        m_upper = load_table(m_grid->upper(), m_grid->upper_count() * Grid::UpperSize);
+        m_lower = load_table(m_grid->lower(), m_grid->lower_count() * Grid::LowerSize);
+
+        const ScalarFloat *values = m_grid->values();
+        size_t value_count = m_grid->leaf_count() * Grid::LeafSize * m_channel_count;
+        m_background.assign(m_grid->background(),
+                            m_grid->background() + m_channel_count);
+        m_max = m_grid->max();
+        m_max_per_channel.resize(m_channel_count);
+        m_grid->max_per_channel(m_max_per_channel.data());
+
+        // Apply spectral conversion if necessary
+        std::unique_ptr<ScalarFloat[]> scaled_data;
+        m_storage_channels = m_channel_count;
+        if (is_spectral_v<Spectrum> && m_channel_count == 3 && !m_raw) {
+            size_t voxel_count = value_count / 3;
+            scaled_data = std::unique_ptr<ScalarFloat[]>(new ScalarFloat[voxel_count * 4]);
+
+            auto convert = [](const ScalarFloat *in, ScalarFloat *out) {
+                ScalarColor3f rgb = dr::load<ScalarColor3f>(in);
+                ScalarFloat scale = dr::max(rgb) * 2.f;
+                ScalarColor3f rgb_norm = rgb / dr::maximum((ScalarFloat) 1e-8, scale);
+                ScalarVector3f coeff = srgb_model_fetch(rgb_norm);
+                dr::store(out, dr::concat(coeff, dr::Array<ScalarFloat, 1>(scale)));
+                return scale;
+            };
+
+            ScalarFloat max = 0.f;
+            for (size_t i = 0; i < voxel_count; ++i)
+                max = dr::maximum(max, convert(values + 3 * i, scaled_data.get() + 4 * i));
+
+            std::vector<ScalarFloat> background(4);
+            max = dr::maximum(max, convert(m_background.data(), background.data()));
+            m_background = background;
+
+            m_max = max;
+            m_storage_channels = 4;
+            values = scaled_data.get();
+            value_count = voxel_count * 4;
+        }
+
+        m_values = value_count > 0 ? dr::load<FloatStorage>(values, value_count)
+                                   : dr::zeros<FloatStorage>(1);
+
+        if (props.get<bool>("use_grid_bbox", false)) {
+            m_to_local = m_grid->bbox_transform() * m_to_local;
+            update_bbox();
+        }
+
+        if (props.has_property("max_value"))
+            m_max = props.get<ScalarFloat>("max_value");
+    }
+
+    UnpolarizedSpectrum eval(const Interaction3f &it,
+                             Mask active) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+
+        if (m_channel_count == 3 && is_spectral_v<Spectrum> && m_raw)
+            Throw("The SparseGridVolume texture %s was queried for a spectrum, "
+                  "but texture conversion into spectra was explicitly "
+                  "disabled! (raw=true)", to_string());
+        else if (m_channel_count != 3 && m_channel_count != 1)
+            Throw("The SparseGridVolume texture %s was queried for a spectrum, "
+                  "but has a number of channels which is not 1 or 3",
+                  to_string());
+
+        if (dr::none_or<false>(active))
+            return dr::zeros<UnpolarizedSpectrum>();
+
+        if (m_channel_count == 1)
+            return interpolate<1>(it, active).x();
+
+        if constexpr (is_monochromatic_v<Spectrum>)
+            return luminance(Color3f(interpolate<3>(it, active)));
+        else if constexpr (is_spectral_v<Spectrum>)
+            return interpolate_spectral(it, active);
+        else
+            return Color3f(interpolate<3>(it, active));
+    }
+
+    Float eval_1(const Interaction3f &it, Mask active = true) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+
+        if (m_channel_count == 3 && is_spectral_v<Spectrum> && !m_raw)
+            Throw("eval_1(): The SparseGridVolume texture %s was queried for a "
+                  "scalar value, but texture conversion into spectra was "
+                  "requested! (raw=false)", to_string());
+
+        if (dr::none_or<false>(active))
+            return dr::zeros<Float>();
+
+        if (m_channel_count == 1)
+            return interpolate<1>(it, active).x();
+        else if (m_channel_count == 3)
+            return luminance(Color3f(interpolate<3>(it, active)));
+        else // 6 channels
+            return dr::mean(interpolate<6>(it, active));
+    }
+
+    Vector3f eval_3(const Interaction3f &it,
+                    Mask active = true) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+
+        if (m_channel_count != 3)
+            Throw("eval_3(): The SparseGridVolume texture %s was queried for a "
+                  "3D vector, but it has %s channel(s)", to_string(), m_channel_count);
+        else if (is_spectral_v<Spectrum> && !m_raw)
+            Throw("eval_3(): The SparseGridVolume texture %s was queried for a "
+                  "3D vector, but texture conversion into spectra was "
+                  "requested! (raw=false)", to_string());
+
+        if (dr::none_or<false>(active))
+            return dr::zeros<Vector3f>();
+
+        return interpolate<3>(it, active);
+    }
+
+    dr::Array<Float, 6> eval_6(const Interaction3f &it,
+                               Mask active = true) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+
+        if (m_channel_count != 6)
+            Throw("eval_6(): The SparseGridVolume texture %s was queried for a "
+                  "6D vector, but it has %s channel(s)", to_string(), m_channel_count);
+
+        if (dr::none_or<false>(active))
+            return dr::zeros<dr::Array<Float, 6>>();
+
+        return interpolate<6>(it, active);
+    }
+
+    void eval_n(const Interaction3f &it, Float *out, Mask active = true) const override {
+        MI_MASKED_FUNCTION(ProfilerPhase::TextureEvaluate, active);
+
+        for (uint32_t c = 0; c < m_storage_channels; ++c)
+            out[c] = 0.f;
+
+        for_each_corner(it, active, [&](const Float &w, const UInt32 &leaf,
+                                        const Vector3u &q) {
+            for (uint32_t c = 0; c < m_storage_channels; ++c)
+                out[c] = dr::fmadd(w, fetch(leaf, q, c, active), out[c]);
+        });
+    }
+
+    ScalarFloat max() const override { return m_max; }
+
+    void max_per_channel(ScalarFloat *out) const override {
+        for (size_t i = 0; i < m_max_per_channel.size(); ++i)
+            out[i] = m_max_per_channel[i];
+    }
+
+    ScalarVector3i resolution() const override {
+        return ScalarVector3i(m_size);
+    };
+
+    std::string to_string() const override {
+        std::ostringstream oss;
+        oss << "SparseGridVolume[" << std::endl
+            << "  to_local = " << string::indent(m_to_local, 13) << "," << std::endl
+            << "  bbox = " << string::indent(m_bbox) << "," << std::endl
+            << "  grid = " << string::indent(m_grid) << std::endl
+            << "]";
+        return oss.str();
+    }
+
+    MI_DECLARE_CLASS()
+
+protected:
+    /// Return the index of the leaf node containing a voxel (or \c Empty)
+    UInt32 leaf_index(const Vector3u &p, Mask active) const {
+        Vector3u r = p >> Grid::UpperSpanLog2;
+        UInt32 upper = dr::gather<UInt32>(
+            m_root, dr::fmadd(dr::fmadd(r.z(), m_root_size.y(), r.y()), m_root_size.x(), r.x()),
+            active);
+        active &= dr::neq(upper, Grid::Empty);
+
+        UInt32 lower = dr::gather<UInt32>(
+            m_upper, dr::fmadd(upper, Grid::UpperSize,
+                               Grid::child_offset(p, Grid::UpperLog2, Grid::LowerSpanLog2)),
+            active);
+        active &= dr::neq(lower, Grid::Empty);
+
+        UInt32 leaf = dr::gather<UInt32>(
+            m_lower, dr::fmadd(lower, Grid::LowerSize,
+                               Grid::child_offset(p, Grid::LowerLog2, Grid::LeafSpanLog2)),
+            active);
+
+        return dr::select(active, leaf, Grid::Empty);
+    }
+
+    /// Fetch a channel of a voxel, which is the background if its leaf is missing
+    Float fetch(const UInt32 &leaf, const Vector3u &q, uint32_t channel,
+                Mask active) const {
+        active &= dr::neq(leaf, Grid::Empty);
+        UInt32 index = dr::fmadd(
+            dr::fmadd(leaf, Grid::LeafSize, Grid::child_offset(q, Grid::LeafLog2, 0)),
+            m_storage_channels, channel);
+        return dr::select(active, dr::gather<Float>(m_values, index, active),
+                          m_background[channel]);
+    }
+
+    /**
+     * \brief Invoke \c func(weight, leaf, voxel) for the voxels that
+     * contribute to the volume at the given interaction
+     */
+    template <typename Func>
+    MI_INLINE void for_each_corner(const Interaction3f &it, Mask active,
+                                   Func &&func) const {
+        Point3f p = m_to_local * it.p;
+        ScalarVector3i max_index = ScalarVector3i(m_size) - 1;
+
+        if (m_nearest) {
+            Vector3i q = dr::floor2int<Vector3i>(p * ScalarVector3f(m_size));
+            Vector3u qu = Vector3u(dr::clamp(q, 0, max_index));
+            func(Float(1.f), leaf_index(qu, active), qu);
+            return;
+        }
+
+        p = dr::fmadd(p, ScalarVector3f(m_size), -.5f);
+        Vector3i p_i = dr::floor2int<Vector3i>(p);
+
+        // Interpolation weights
+        Vector3f w1 = p - Point3f(p_i),
+                 w0 = 1.f - w1;
+
+        Vector3u lo = Vector3u(dr::clamp(p_i, 0, max_index)),
+                 hi = Vector3u(dr::clamp(p_i + 1, 0, max_index));
+
+        // Most corners fall into the leaf node of the first one
+        UInt32 leaf_0 = leaf_index(lo, active);
+        Vector3u block_0 = lo >> Grid::LeafSpanLog2;
+
+        for (uint32_t k = 0; k < 8; ++k) {
+            Vector3u q(k & 1 ? hi.x() : lo.x(),
+                       k & 2 ? hi.y() : lo.y(),
+                       k & 4 ? hi.z() : lo.z());
+            Float w = (k & 1 ? w1.x() : w0.x()) *
+                      (k & 2 ? w1.y() : w0.y()) *
+                      (k & 4 ? w1.z() : w0.z());
+
+            UInt32 leaf = leaf_0;
+            if (k > 0) {
+                Mask other = active &&
+                             !dr::all(dr::eq(q >> Grid::LeafSpanLog2, block_0));
+                if (dr::any_or<true>(other))
+                    dr::masked(leaf, other) = leaf_index(q, other);
+            }
+
+            func(w, leaf, q);
+        }
+    }
+
+    /// Interpolate the first \c N channels of the volume
+    template <size_t N>
+    MI_INLINE dr::Array<Float, N> interpolate(const Interaction3f &it,
+                                              Mask active) const {
+        dr::Array<Float, N> result = 0.f;
+        for_each_corner(it, active, [&](const Float &w, const UInt32 &leaf,
+                                        const Vector3u &q) {
+            for (size_t c = 0; c < N; ++c)
+                result[c] = dr::fmadd(w, fetch(leaf, q, (uint32_t) c, active), result[c]);
+        });
+        return result;
+    }
+
+    /**
+     * \brief Evaluates the volume at the given interaction using spectral
+     * upsampling
+     */
+    MI_INLINE UnpolarizedSpectrum interpolate_spectral(const Interaction3f &it,
+                                                       Mask active) const {
+        UnpolarizedSpectrum result = 0.f;
+        Float scale = 0.f;
+        for_each_corner(it, active, [&](const Float &w, const UInt32 &leaf,
+                                        const Vector3u &q) {
+            Vector3f coeff(fetch(leaf, q, 0, active), fetch(leaf, q, 1, active),
+                           fetch(leaf, q, 2, active));
+            result = dr::fmadd(
+                w, srgb_model_eval<UnpolarizedSpectrum>(coeff, it.wavelengths), result);
+            scale = dr::fmadd(w, fetch(leaf, q, 3, active), scale);
+        });
+        return result * scale;
+    }
+
+protected:
+    ref<Grid> m_grid;
+    ScalarVector3u m_size;
+    ScalarVector3u m_root_size;
+    UInt32Storage m_root;
+    UInt32Storage m_upper;
+    UInt32Storage m_lower;
+    FloatStorage m_values;
+    std::vector<ScalarFloat> m_background;
+    uint32_t m_storage_channels;
+    bool m_nearest;
+    bool m_raw;
+    ScalarFloat m_max;
+    std::vector<ScalarFloat> m_max_per_channel;
+};
+
+MI_IMPLEMENT_CLASS_VARIANT(SparseGridVolume, Volume)
+MI_EXPORT_PLUGIN(SparseGridVolume, "SparseGridVolume texture")
+
+NAMESPACE_END(mitsuba)
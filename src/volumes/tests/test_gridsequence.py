@@ -0,0 +1,82 @@
+import pytest
+import drjit as dr
+import mitsuba as mi
+import os
+
+
+def write_sequence(tmpdir, count):
+    for i in range(count):
+        grid = dr.full(mi.TensorXf, float(i + 1), [4, 4, 4])
+        mi.VolumeGrid(grid).write(os.path.join(str(tmpdir), f"smoke_{i:03d}.vol"))
+    return os.path.join(str(tmpdir), "smoke_###.vol")
+
+
+def test01_construct(variants_all, tmpdir):
+    pattern = write_sequence(tmpdir, 4)
+    vol = mi.load_dict({
+        'type': 'gridsequence',
+        'filename': pattern
+    })
+
+    it = dr.zeros(mi.Interaction3f, 1)
+    assert dr.allclose(vol.eval_1(it), 1.0)
+    assert dr.allclose(vol.max(), 1.0)
+    assert '[0, 4)' in str(vol)
+
+    vol = mi.load_dict({
+        'type': 'gridsequence',
+        'filename': pattern,
+        'frame_start': 1,
+        'frame_count': 2,
+        'frame': 2,
+        'filter_type': 'nearest'
+    })
+    assert dr.allclose(vol.eval_1(it), 3.0)
+    assert '[1, 3)' in str(vol)
+
+    with pytest.raises(RuntimeError):
+        mi.load_dict({
+            'type': 'gridsequence',
+            'filename': os.path.join(str(tmpdir), "smoke.vol")
+        })
+
+
+@pytest.mark.parametrize('prefetch', [0, 2])
+def test02_change_frame(variants_all, tmpdir, prefetch):
+    pattern = write_sequence(tmpdir, 5)
+    vol = mi.load_dict({
+        'type': 'gridsequence',
+        'filename': pattern,
+        'prefetch': prefetch
+    })
+    it = dr.zeros(mi.Interaction3f, 1)
+    params = mi.traverse(vol)
+
+    # Sequential access uses prefetched frames, random access loads them directly
+    for frame in [1, 2, 4, 0, 3]:
+        params['frame'] = frame
+        params.update()
+        assert dr.allclose(vol.eval_1(it), frame + 1.0)
+        assert dr.allclose(vol.max(), frame + 1.0)
+
+    params['frame'] = 5
+    with pytest.raises(RuntimeError):
+        params.update()
+
+
+def test03_medium_majorant(variants_all_rgb, tmpdir):
+    pattern = write_sequence(tmpdir, 3)
+    medium = mi.load_dict({
+        'type': 'heterogeneous',
+        'sigma_t': {
+            'type': 'gridsequence',
+            'filename': pattern
+        },
+        'scale': 2.0
+    })
+
+    mei = dr.zeros(mi.MediumInteraction3f, 1)
+    params = mi.traverse(medium)
+    params['sigma_t.frame'] = 2
+    params.update()
+    assert dr.allclose(medium.get_majorant(mei), 6.0)